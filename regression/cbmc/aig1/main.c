@@ -0,0 +1,17 @@
+int nondet_int();
+
+int main()
+{
+  unsigned x=nondet_int();
+  unsigned y=nondet_int();
+
+  __CPROVER_assume(x<100 && y<100);
+
+  // the multiplication commutes
+  __CPROVER_assert(x*y==y*x, "commutes");
+
+  // fails for x==y
+  __CPROVER_assert((x^y)!=0, "different");
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+int nondet_int();
+
+int main()
+{
+  unsigned a=nondet_int();
+  unsigned b=nondet_int();
+  unsigned c=nondet_int();
+
+  // the same sum, associated differently
+  __CPROVER_assert((a+b)+c==a+(b+c), "associative");
+  __CPROVER_assert((a&b)+(a|b)==a+b, "and plus or");
+
+  return 0;
+}
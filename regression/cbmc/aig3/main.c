@@ -0,0 +1,17 @@
+int nondet_int();
+
+int main()
+{
+  unsigned a=nondet_int();
+  unsigned b=nondet_int();
+  unsigned x=a*b+a;
+
+  // the properties share their cone, which must survive the solver's
+  // simplifier between the calls of the all-properties loop
+  __CPROVER_assert(x==a*(b+1), "distributive");
+  __CPROVER_assert(x!=12, "not twelve");
+  __CPROVER_assert((x^a)==((a*b+a)^a), "xor");
+  __CPROVER_assert(a<100 || x!=a, "small");
+
+  return 0;
+}
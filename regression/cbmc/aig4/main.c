@@ -0,0 +1,6 @@
+int main()
+{
+  int x;
+  __CPROVER_assert(x!=0, "nonzero");
+  return 0;
+}
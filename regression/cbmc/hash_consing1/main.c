@@ -0,0 +1,15 @@
+int nondet_int();
+
+int main()
+{
+  int x=nondet_int();
+  int y=x+1;
+  int z=x+1;
+
+  // the right-hand sides are structurally equal
+  __CPROVER_assert(y==z, "equal");
+  __CPROVER_assert((x+1)*2==y+z, "twice");
+  __CPROVER_assert(y!=z, "different");
+
+  return 0;
+}
@@ -0,0 +1,18 @@
+int nondet_int();
+
+int main()
+{
+  int n=nondet_int();
+  __CPROVER_assume(n>0 && n<100);
+
+  int sum=0;
+
+  for(int i=0; i<n; i++)
+  {
+    sum+=i;
+    // fails in the fifth iteration
+    __CPROVER_assert(sum<10, "sum bound");
+  }
+
+  return 0;
+}
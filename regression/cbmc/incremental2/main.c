@@ -0,0 +1,18 @@
+int nondet_int();
+
+int main()
+{
+  int n=nondet_int();
+  __CPROVER_assume(n>=0 && n<=3);
+
+  int a[4];
+  int i;
+
+  for(i=0; i<n; i++)
+    a[i]=i;
+
+  for(int j=0; j<i; j++)
+    __CPROVER_assert(a[j]==j, "initialized");
+
+  return 0;
+}
@@ -0,0 +1,13 @@
+int nondet_int();
+
+int main()
+{
+  int x=nondet_int();
+
+  while(x>0)
+    x--;
+
+  __CPROVER_assert(x<=0, "terminated");
+
+  return 0;
+}
@@ -0,0 +1,19 @@
+int nondet_int();
+
+int main()
+{
+  int x=nondet_int();
+  int y;
+
+  if(x>10)
+    y=1;
+  else
+    y=2;
+
+  if(x>20)
+    y+=10;
+
+  __CPROVER_assert(y<20, "y bound");
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+_Bool nondet_bool();
+int nondet_int();
+
+int main()
+{
+  int x=nondet_int();
+  _Bool a=nondet_bool(), b=nondet_bool();
+
+  if(a && x>0)
+  {
+    __CPROVER_assume(b || x<10);
+
+    if(!b)
+      __CPROVER_assert(x<10, "assumed");
+
+    // fails for x==5
+    __CPROVER_assert(b || x!=5, "not five");
+  }
+
+  return 0;
+}
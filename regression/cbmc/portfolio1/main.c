@@ -0,0 +1,11 @@
+int main()
+{
+  unsigned x, y;
+  __CPROVER_assume(x<100 && y<100);
+
+  unsigned z=x*y;
+  assert(z!=42);
+  assert(z<10000);
+
+  return 0;
+}
@@ -0,0 +1,20 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned x=nondet_unsigned();
+  unsigned y=x;
+
+  __CPROVER_assume(x<100);
+
+  // only the low bits of the product are read
+  unsigned t=x*y;
+  unsigned char c=t;
+
+  __CPROVER_assert(x*y<10000, "bounded");
+
+  // fails for x==3
+  __CPROVER_assert(c!=9, "not nine");
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+int nondet_int();
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned x=nondet_unsigned(), y=nondet_unsigned();
+  int a=nondet_int(), b=nondet_int();
+
+  if(y!=0)
+    __CPROVER_assert(x/y*y+x%y==x, "unsigned division");
+
+  if(b!=0 && b!=-1)
+    __CPROVER_assert(a/b*b+a%b==a, "signed division");
+
+  if(b!=0 && b!=-1)
+    __CPROVER_assert(a%b==0 || (a%b<0)==(a<0), "sign of remainder");
+
+  __CPROVER_assert(x*y==y*x, "commutative");
+
+  return 0;
+}
@@ -0,0 +1,15 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned x=nondet_unsigned(), y=nondet_unsigned();
+
+  __CPROVER_assume(x>1 && x<256 && y>1 && y<256);
+
+  // 251 and 241 are prime
+  __CPROVER_assert(x*y!=60491, "product of primes");
+
+  __CPROVER_assert(x%y!=7 || x/y!=3, "quotient and remainder");
+
+  return 0;
+}
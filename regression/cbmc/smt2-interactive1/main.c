@@ -0,0 +1,11 @@
+int main()
+{
+  unsigned x, y;
+  __CPROVER_assume(x<10 && y<10);
+
+  __CPROVER_assert(x*y!=42, "product");
+  __CPROVER_assert(x+y<=18, "sum");
+  __CPROVER_assert(x!=y, "difference");
+
+  return 0;
+}
@@ -0,0 +1,20 @@
+#include <stdlib.h>
+
+int nondet_int();
+
+int main()
+{
+  int x=nondet_int();
+  int *p=malloc(sizeof(int));
+  *p=x;
+
+  __CPROVER_assume(x>0);
+
+  if(x>100)
+    *p=0;
+
+  // fails for x>100 only
+  __CPROVER_assert(*p>0, "p positive");
+
+  return 0;
+}
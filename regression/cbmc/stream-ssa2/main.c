@@ -0,0 +1,18 @@
+int nondet_int();
+
+int main()
+{
+  int x=nondet_int();
+  int y=0;
+
+  for(int i=0; i<4; i++)
+    if(x>i)
+      y++;
+
+  __CPROVER_assume(x<2);
+
+  __CPROVER_assert(y<=4, "y bound");
+  __CPROVER_assert(y<2, "y bound after assumption");
+
+  return 0;
+}
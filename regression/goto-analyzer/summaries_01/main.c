@@ -0,0 +1,19 @@
+#include <assert.h>
+
+int x, y;
+
+void f()
+{
+  y=x;
+}
+
+int main()
+{
+  x=1;
+  f();
+  assert(y==1);
+
+  x=2;
+  f();
+  assert(y==2);
+}
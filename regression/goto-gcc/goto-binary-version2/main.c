@@ -0,0 +1,12 @@
+int unused(int x)
+{
+  return x+1;
+}
+
+int main()
+{
+  int x;
+  __CPROVER_assume(x<10);
+  __CPROVER_assert(x!=10, "bounded");
+  return 0;
+}
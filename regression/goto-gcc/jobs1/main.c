@@ -0,0 +1,13 @@
+struct pairt
+{
+  int a, b;
+};
+
+int sum(struct pairt *);
+int product(struct pairt *);
+
+int main()
+{
+  struct pairt p={ 2, 3 };
+  return sum(&p)+product(&p)==11 ? 0 : 1;
+}
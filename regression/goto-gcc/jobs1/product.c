@@ -0,0 +1,12 @@
+struct pairt
+{
+  int a, b;
+};
+
+static int count;
+
+int product(struct pairt *p)
+{
+  count++;
+  return p->a*p->b;
+}
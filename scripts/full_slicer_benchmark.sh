@@ -0,0 +1,32 @@
+#!/bin/bash
+
+# Compare the time and the peak memory that goto-instrument --full-slice
+# takes between two builds on the same goto binary, such as a large program
+# compiled with goto-cc.
+
+set -e
+
+if [[ "$#" -lt 3 ]]
+then
+  echo "Usage: $0 before-src-dir after-src-dir goto-binary"
+  echo "before-src-dir, after-src-dir - src folders of two builds of CBMC"
+  echo "goto-binary - the program to slice"
+  exit 1
+fi
+
+before=$1
+after=$2
+binary=$3
+
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+for build in before after
+do
+  dir=${!build}
+  /usr/bin/time -f "%e %M" -o "$tmp/time.txt" \
+    "$dir/goto-instrument/goto-instrument" --full-slice \
+    "$binary" "$tmp/sliced.gb" >/dev/null
+  read -r seconds kbytes < "$tmp/time.txt"
+  echo "$build: $seconds s, $kbytes kB peak"
+done
@@ -0,0 +1,71 @@
+#!/bin/bash
+
+# Compare the memory used by irep nodes between two builds, e.g., one with
+# the default layout and one with SUB_IS_SMALL_VECTOR and
+# NAMED_SUB_IS_VECTOR defined in src/util/irep.h, over the regression tests.
+
+set -e
+
+if [[ "$#" -lt 2 ]]
+then
+  echo "Usage: $0 before-src-dir after-src-dir [regression-dir]"
+  echo "before-src-dir, after-src-dir - src folders of two builds of CBMC"
+  echo "regression-dir - tests to use (default: regression/cbmc)"
+  exit 1
+fi
+
+absolute_repository_root=$(git rev-parse --show-toplevel)
+before=$1
+after=$2
+tests=${3:-$absolute_repository_root/regression/cbmc}
+
+goto_cc=$before/goto-cc/goto-cc
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+declare -A nodes bytes
+
+for build in before after
+do
+  nodes[$build]=0
+  bytes[$build]=0
+done
+
+count=0
+
+for f in "$tests"/*/main.c
+do
+  # tests that do not compile on their own are skipped
+  if ! "$goto_cc" "$f" -o "$tmp/main.gb" >/dev/null 2>&1
+  then
+    continue
+  fi
+
+  count=$((count+1))
+
+  for build in before after
+  do
+    dir=${!build}
+    "$dir/goto-instrument/goto-instrument" --print-irep-memory \
+      "$tmp/main.gb" > "$tmp/out.txt"
+    n=$(sed -n 's/^Irep nodes: \([0-9]*\)$/\1/p' "$tmp/out.txt")
+    b=$(sed -n 's/^Total: \([0-9]*\) bytes$/\1/p' "$tmp/out.txt")
+    nodes[$build]=$((nodes[$build]+n))
+    bytes[$build]=$((bytes[$build]+b))
+  done
+done
+
+echo "Tests: $count"
+
+for build in before after
+do
+  if [[ ${nodes[$build]} -gt 0 ]]
+  then
+    per_node=$(echo "scale=2; ${bytes[$build]}/${nodes[$build]}" | bc)
+  else
+    per_node=0
+  fi
+
+  echo "$build: ${nodes[$build]} nodes, ${bytes[$build]} bytes," \
+       "$per_node bytes per node"
+done
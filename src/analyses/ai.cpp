@@ -290,11 +290,61 @@ ai_baset::locationt ai_baset::get_next(
 {
   assert(!working_set.empty());
 
-  working_sett::iterator i=working_set.begin();
-  locationt l=i->second;
-  working_set.erase(i);
+  return working_set.pop();
+}
+
+/// Numbers the instructions of the given program in reverse postorder of a
+/// depth-first traversal from its first instruction. Instructions that are
+/// not reachable from there are numbered after all others, such that any
+/// instruction of the program has a number.
+void ai_baset::compute_rpo_numbers(const goto_programt &goto_program)
+{
+  if(goto_program.empty() ||
+     rpo_numbers.find(goto_program.instructions.begin())!=rpo_numbers.end())
+    return;
+
+  std::unordered_set<locationt, const_target_hash, pointee_address_equalt>
+    visited;
+  std::vector<locationt> postorder;
+  unsigned number=0;
+
+  // iterative depth-first search; the stack holds each location along with
+  // its successors that remain to be explored
+  typedef std::pair<locationt, std::list<locationt>> framet;
+  std::vector<framet> stack;
+
+  forall_goto_program_instructions(root, goto_program)
+  {
+    if(!visited.insert(root).second)
+      continue;
+
+    stack.push_back(framet(root, goto_program.get_successors(root)));
+
+    while(!stack.empty())
+    {
+      std::list<locationt> &successors=stack.back().second;
 
-  return l;
+      if(successors.empty())
+      {
+        postorder.push_back(stack.back().first);
+        stack.pop_back();
+        continue;
+      }
+
+      locationt next=successors.front();
+      successors.pop_front();
+
+      if(next!=goto_program.instructions.end() &&
+         visited.insert(next).second)
+        stack.push_back(framet(next, goto_program.get_successors(next)));
+    }
+
+    // number this tree after the ones found before
+    for(auto it=postorder.rbegin(); it!=postorder.rend(); it++)
+      rpo_numbers[*it]=number++;
+
+    postorder.clear();
+  }
 }
 
 bool ai_baset::fixedpoint(
@@ -302,6 +352,8 @@ bool ai_baset::fixedpoint(
   const goto_functionst &goto_functions,
   const namespacet &ns)
 {
+  compute_rpo_numbers(goto_program);
+
   working_sett working_set;
 
   // Put the first location in the working set
@@ -581,6 +633,8 @@ void ai_baset::concurrent_fixedpoint(
 
     for(const auto &wl_pair : thread_wl)
     {
+      compute_rpo_numbers(*(wl_pair.first));
+
       working_sett working_set;
       put_in_working_set(working_set, wl_pair.second);
 
@@ -15,6 +15,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <util/json.h>
 #include <util/xml.h>
@@ -25,6 +29,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 // forward reference
 class ai_baset;
+class ai_cachet;
 
 // don't use me -- I am just a base class
 // please derive from me
@@ -115,6 +120,19 @@ public:
   virtual bool ai_simplify_lhs(
     exprt &condition,
     const namespacet &ns) const;
+
+  // Writes the state for ai_cachet, such that equal states give equal
+  // bytes in any process; returns true if the domain cannot be written
+  virtual bool write(std::ostream &out) const
+  {
+    return true;
+  }
+
+  // Reads a state written by write(); returns true on error
+  virtual bool read(std::istream &in)
+  {
+    return true;
+  }
 };
 
 // don't use me -- I am just a base class
@@ -187,6 +205,15 @@ public:
 
   virtual void clear()
   {
+    rpo_numbers.clear();
+  }
+
+  /// Reuses the summaries of functions in the cache, and adds the ones that
+  /// are computed; the functions must have been set in the cache
+  /// \return true if the analysis does not compute summaries
+  virtual bool set_cache(ai_cachet &)
+  {
+    return true;
   }
 
   virtual void output(
@@ -299,8 +326,48 @@ protected:
     const irep_idt &identifier) const;
 
 
-  // the work-queue is sorted by location number
-  typedef std::map<unsigned, locationt> working_sett;
+  /// The work-queue yields the location that comes first in reverse
+  /// postorder of the control-flow graph of its function. Thus, the
+  /// predecessors of a location are usually visited before it, except along
+  /// back edges, and the states flowing into a loop are joined before the
+  /// loop is iterated. Each location is in the queue at most once.
+  class working_sett
+  {
+  public:
+    bool empty() const
+    {
+      return queue.empty();
+    }
+
+    void insert(unsigned priority, locationt l)
+    {
+      if(in_queue.insert(l).second)
+        queue.push(entryt(priority, l));
+    }
+
+    locationt pop()
+    {
+      locationt l=queue.top().second;
+      queue.pop();
+      in_queue.erase(l);
+      return l;
+    }
+
+  protected:
+    typedef std::pair<unsigned, locationt> entryt;
+
+    struct later_priorityt
+    {
+      bool operator()(const entryt &a, const entryt &b) const
+      {
+        return a.first>b.first;
+      }
+    };
+
+    std::priority_queue<entryt, std::vector<entryt>, later_priorityt> queue;
+    std::unordered_set<locationt, const_target_hash, pointee_address_equalt>
+      in_queue;
+  };
 
   locationt get_next(working_sett &working_set);
 
@@ -308,10 +375,20 @@ protected:
     working_sett &working_set,
     locationt l)
   {
+    rpo_numberst::const_iterator it=rpo_numbers.find(l);
     working_set.insert(
-      std::pair<unsigned, locationt>(l->location_number, l));
+      it==rpo_numbers.end()?l->location_number:it->second, l);
   }
 
+  /// The positions of the locations in reverse postorder of the control-flow
+  /// graph of their function, computed when a function is first visited
+  typedef std::
+    unordered_map<locationt, unsigned, const_target_hash, pointee_address_equalt>
+      rpo_numberst;
+  rpo_numberst rpo_numbers;
+
+  void compute_rpo_numbers(const goto_programt &);
+
   // true = found something new
   bool fixedpoint(
     const goto_programt &goto_program,
@@ -345,7 +422,7 @@ protected:
     const goto_functionst &goto_functions,
     const namespacet &ns);
 
-  bool do_function_call(
+  virtual bool do_function_call(
     locationt l_call, locationt l_return,
     const goto_functionst &goto_functions,
     const goto_functionst::function_mapt::const_iterator f_it,
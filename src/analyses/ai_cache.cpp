@@ -0,0 +1,548 @@
+/*******************************************************************\
+
+Module: Cache of Abstract Interpretation Summaries
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Cache of Abstract Interpretation Summaries
+
+#include "ai_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <unordered_set>
+
+#include <util/invariant.h>
+#include <util/irep_serialization.h>
+
+#define AI_CACHE_MAGIC "CPROVER AI cache 4"
+
+void write_ai_cache_string(std::ostream &out, const std::string &s)
+{
+  write_gb_word(out, s.size());
+  out.write(s.data(), s.size());
+}
+
+std::string read_ai_cache_string(std::istream &in)
+{
+  const std::size_t size=irep_serializationt::read_gb_word(in);
+
+  std::string result;
+  // do not trust the size of a truncated file
+  while(result.size()<size && in)
+  {
+    char buffer[4096];
+    in.read(
+      buffer,
+      std::min(sizeof(buffer), size-result.size()));
+    result.append(buffer, static_cast<std::size_t>(in.gcount()));
+  }
+
+  return result;
+}
+
+void write_ai_cache_integer(std::ostream &out, const mp_integer &i)
+{
+  if(i.is_long())
+  {
+    // zig-zag, such that small negative numbers give small words
+    const mp_integer::llong_t value=i.to_long();
+    const uint64_t word=
+      (static_cast<uint64_t>(value)<<1)^static_cast<uint64_t>(value>>63);
+
+    if(static_cast<std::size_t>(word)==word)
+    {
+      write_gb_word(out, 0);
+      write_gb_word(out, word);
+      return;
+    }
+  }
+
+  write_gb_word(out, 1);
+  write_ai_cache_string(out, integer2string(i));
+}
+
+mp_integer read_ai_cache_integer(std::istream &in)
+{
+  if(irep_serializationt::read_gb_word(in)!=0)
+    return string2integer(read_ai_cache_string(in));
+
+  const uint64_t word=irep_serializationt::read_gb_word(in);
+  return static_cast<mp_integer::llong_t>((word>>1)^(~(word&1)+1));
+}
+
+static void write_named_subs(
+  std::ostream &out,
+  const irept::named_subt &named_subs);
+
+void write_ai_cache_irep(std::ostream &out, const irept &irep)
+{
+  write_ai_cache_string(out, id2string(irep.id()));
+
+  write_gb_word(out, irep.get_sub().size());
+  for(const auto &sub : irep.get_sub())
+    write_ai_cache_irep(out, sub);
+
+  write_named_subs(out, irep.get_named_sub());
+  write_named_subs(out, irep.get_comments());
+}
+
+/// Writes the named subtrees ordered by their names rather than the
+/// numbers of the names, which differ between processes
+static void write_named_subs(
+  std::ostream &out,
+  const irept::named_subt &named_subs)
+{
+  std::vector<std::pair<std::string, const irept *>> sorted;
+
+  for(const auto &named_sub : named_subs)
+    sorted.push_back(
+      std::make_pair(id2string(named_sub.first), &named_sub.second));
+
+  std::sort(sorted.begin(), sorted.end());
+
+  write_gb_word(out, sorted.size());
+  for(const auto &named_sub : sorted)
+  {
+    write_ai_cache_string(out, named_sub.first);
+    write_ai_cache_irep(out, *named_sub.second);
+  }
+}
+
+void read_ai_cache_irep(std::istream &in, irept &irep)
+{
+  irep.clear();
+  irep.id(read_ai_cache_string(in));
+
+  irept::subt &sub=irep.get_sub();
+  sub.resize(irep_serializationt::read_gb_word(in));
+  for(auto &s : sub)
+  {
+    if(!in)
+      return;
+    read_ai_cache_irep(in, s);
+  }
+
+  for(std::size_t n=irep_serializationt::read_gb_word(in); n>0 && in; n--)
+  {
+    const irep_idt name=read_ai_cache_string(in);
+    read_ai_cache_irep(in, irep.add(name));
+  }
+
+  for(std::size_t n=irep_serializationt::read_gb_word(in); n>0 && in; n--)
+  {
+    const irep_idt name=read_ai_cache_string(in);
+    read_ai_cache_irep(in, irep.add(name));
+  }
+}
+
+/// Adds bytes to a 64-bit FNV-1a hash, which, unlike std::hash, is the
+/// same in any build
+static void fnv_add(uint64_t &h, const char *data, std::size_t size)
+{
+  for(std::size_t i=0; i<size; i++)
+  {
+    h^=static_cast<unsigned char>(data[i]);
+    h*=1099511628211ull;
+  }
+}
+
+static const uint64_t fnv_offset=14695981039346656037ull;
+
+static std::string fnv_hash(const std::string &s)
+{
+  uint64_t h=fnv_offset;
+  fnv_add(h, s.data(), s.size());
+
+  std::ostringstream result;
+  result << std::hex << std::setw(16) << std::setfill('0') << h
+         << '-' << s.size();
+  return result.str();
+}
+
+/// \return `h` combined with `value`
+static uint64_t mix(uint64_t h, uint64_t value)
+{
+  h^=value;
+  h*=0x9e3779b97f4a7c15ull;
+  return h^(h>>29);
+}
+
+/// Hashes ireps without their comments, such as the source locations,
+/// such that equal ireps give equal hashes in any process, which
+/// irept::hash does not guarantee as it hashes the numbers of the strings
+class ai_cache_irep_hashert
+{
+public:
+  uint64_t operator()(const irept &irep)
+  {
+    const bool shared=!irep.is_unshared();
+
+    // shared nodes are hashed once
+    if(shared)
+    {
+      const auto it=nodes.find(&irep.read());
+      if(it!=nodes.end())
+        return it->second;
+    }
+
+    uint64_t h=mix(string_hash(irep.id()), irep.get_sub().size());
+
+    for(const auto &sub : irep.get_sub())
+      h=mix(h, (*this)(sub));
+
+    // the order of the named subtrees is that of the numbers of their
+    // names, which differ between processes, hence a sum
+    uint64_t named=0;
+    for(const auto &named_sub : irep.get_named_sub())
+      named+=mix(string_hash(named_sub.first), (*this)(named_sub.second));
+
+    h=mix(h, named);
+
+    if(shared)
+      nodes[&irep.read()]=h;
+
+    return h;
+  }
+
+protected:
+  std::unordered_map<const void *, uint64_t> nodes;
+
+  // by the number of the string
+  std::vector<uint64_t> strings;
+
+  uint64_t string_hash(const irep_idt &id)
+  {
+    const std::size_t no=id.get_no();
+
+    if(no>=strings.size())
+      strings.resize(no+1, 0);
+
+    if(strings[no]==0)
+    {
+      const std::string &s=id2string(id);
+      uint64_t h=fnv_offset;
+      fnv_add(h, s.data(), s.size());
+      // zero is for strings that have not been hashed
+      strings[no]=h|1;
+    }
+
+    return strings[no];
+  }
+};
+
+/// \return the functions that `function` calls, ordered by their names,
+///   but not through function pointers
+static std::vector<irep_idt> direct_callees(
+  const goto_functionst &goto_functions,
+  const irep_idt &function)
+{
+  std::vector<irep_idt> result;
+
+  goto_functionst::function_mapt::const_iterator f_it=
+    goto_functions.function_map.find(function);
+
+  if(f_it==goto_functions.function_map.end())
+    return result;
+
+  forall_goto_program_instructions(i_it, f_it->second.body)
+  {
+    if(!i_it->is_function_call())
+      continue;
+
+    std::vector<const exprt *> targets(
+      1, &to_code_function_call(i_it->code).function());
+
+    while(!targets.empty())
+    {
+      const exprt &target=*targets.back();
+      targets.pop_back();
+
+      if(target.id()==ID_symbol)
+        result.push_back(to_symbol_expr(target).get_identifier());
+      else if(target.id()==ID_if && target.operands().size()==3)
+      {
+        targets.push_back(&target.op1());
+        targets.push_back(&target.op2());
+      }
+    }
+  }
+
+  std::sort(
+    result.begin(),
+    result.end(),
+    [](const irep_idt &a, const irep_idt &b)
+    {
+      return id2string(a)<id2string(b);
+    });
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+
+  return result;
+}
+
+void ai_cachet::set_functions(const goto_functionst &_goto_functions)
+{
+  goto_functions=&_goto_functions;
+  body_hashes.clear();
+  hashes.clear();
+
+  ai_cache_irep_hashert hash_irep;
+
+  // without the source locations, which do not change the summaries
+  forall_goto_functions(f_it, _goto_functions)
+  {
+    const goto_programt &body=f_it->second.body;
+
+    std::unordered_map<const void *, std::size_t> numbers;
+    forall_goto_program_instructions(i_it, body)
+      numbers.insert(std::make_pair(&*i_it, numbers.size()));
+
+    uint64_t h=mix(hash_irep(f_it->second.type), body.instructions.size());
+    h=mix(h, f_it->second.body_available());
+
+    forall_goto_program_instructions(i_it, body)
+    {
+      h=mix(h, static_cast<uint64_t>(i_it->type));
+      h=mix(h, hash_irep(i_it->code));
+      h=mix(h, hash_irep(i_it->guard));
+
+      h=mix(h, i_it->targets.size());
+      for(const auto &target : i_it->targets)
+        h=mix(h, numbers[&*target]);
+    }
+
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << h;
+    body_hashes[f_it->first]=out.str();
+  }
+}
+
+const std::string *ai_cachet::get_hash(const irep_idt &identifier)
+{
+  if(goto_functions==nullptr ||
+     goto_functions->function_map.find(identifier)==
+       goto_functions->function_map.end())
+    return nullptr;
+
+  std::unordered_set<irep_idt, irep_id_hash> stack;
+  hash_function(identifier, stack);
+
+  return &hashes[identifier];
+}
+
+/// Computes the hash of a function from the hash of its body and those of
+/// the functions it calls. The hash of a function that calls a recursive
+/// one is computed from the bodies of all functions it calls instead.
+/// \param stack: the functions whose hashes are being computed
+/// \return false if the function calls a recursive one
+bool ai_cachet::hash_function(
+  const irep_idt &identifier,
+  std::unordered_set<irep_idt, irep_id_hash> &stack)
+{
+  if(hashes.find(identifier)!=hashes.end())
+    return true;
+
+  if(!stack.insert(identifier).second)
+    return false;
+
+  bool recursive=false;
+
+  std::ostringstream out;
+  write_ai_cache_string(out, body_hashes[identifier]);
+
+  for(const auto &callee : direct_callees(*goto_functions, identifier))
+  {
+    write_ai_cache_string(out, id2string(callee));
+
+    if(goto_functions->function_map.find(callee)==
+       goto_functions->function_map.end())
+      write_ai_cache_string(out, "");
+    else if(hash_function(callee, stack))
+      write_ai_cache_string(out, hashes[callee]);
+    else
+      recursive=true;
+  }
+
+  stack.erase(identifier);
+
+  if(!recursive)
+  {
+    hashes[identifier]=fnv_hash(out.str());
+    return true;
+  }
+
+  std::set<irep_idt> closure;
+  std::vector<irep_idt> todo(1, identifier);
+
+  while(!todo.empty())
+  {
+    const irep_idt current=todo.back();
+    todo.pop_back();
+
+    if(closure.insert(current).second)
+    {
+      const std::vector<irep_idt> callees=
+        direct_callees(*goto_functions, current);
+      todo.insert(todo.end(), callees.begin(), callees.end());
+    }
+  }
+
+  // in an order that does not depend on the numbers of the names
+  std::vector<std::string> names;
+  for(const auto &callee : closure)
+    names.push_back(id2string(callee));
+  std::sort(names.begin(), names.end());
+
+  std::ostringstream closure_out;
+
+  for(const auto &name : names)
+  {
+    write_ai_cache_string(closure_out, name);
+
+    const auto b_it=body_hashes.find(name);
+    write_ai_cache_string(
+      closure_out, b_it==body_hashes.end()?"":b_it->second);
+  }
+
+  hashes[identifier]=fnv_hash(closure_out.str());
+  return false;
+}
+
+std::string ai_cachet::digest(const std::string &state)
+{
+  return fnv_hash(state);
+}
+
+const ai_cachet::summaryt *ai_cachet::find(
+  const irep_idt &function,
+  const std::string &entry)
+{
+  const std::string *hash=get_hash(function);
+
+  if(hash==nullptr)
+    return nullptr;
+
+  entriest::const_iterator e_it=
+    entries.find(std::make_pair(id2string(function), *hash));
+
+  if(e_it==entries.end())
+    return nullptr;
+
+  summariest::const_iterator s_it=e_it->second.find(entry);
+  return s_it==e_it->second.end()?nullptr:&s_it->second;
+}
+
+void ai_cachet::insert(
+  const irep_idt &function,
+  const std::string &entry,
+  const summaryt &summary)
+{
+  const std::string *hash=get_hash(function);
+
+  if(hash!=nullptr)
+    entries[std::make_pair(id2string(function), *hash)][entry]=summary;
+}
+
+bool ai_cachet::read(std::istream &in)
+{
+  if(read_ai_cache_string(in)!=AI_CACHE_MAGIC ||
+     read_ai_cache_string(in)!=tag)
+    return true;
+
+  entriest tmp;
+
+  for(std::size_t e=irep_serializationt::read_gb_word(in); e>0; e--)
+  {
+    const std::string function=read_ai_cache_string(in);
+    const std::string hash=read_ai_cache_string(in);
+    summariest &summaries=tmp[std::make_pair(function, hash)];
+
+    for(std::size_t n=irep_serializationt::read_gb_word(in); n>0; n--)
+    {
+      summaryt &summary=summaries[read_ai_cache_string(in)];
+      summary.entry=read_ai_cache_string(in);
+      summary.exit=read_ai_cache_string(in);
+
+      for(std::size_t i=irep_serializationt::read_gb_word(in);
+          i>0 && in;
+          i--)
+        summary.states.indices.push_back(
+          irep_serializationt::read_gb_word(in));
+
+      summary.states.data=read_ai_cache_string(in);
+
+      for(std::size_t c=irep_serializationt::read_gb_word(in);
+          c>0 && in;
+          c--)
+      {
+        const irep_idt callee=read_ai_cache_string(in);
+        summary.calls.push_back(
+          std::make_pair(callee, read_ai_cache_string(in)));
+      }
+
+      if(!in)
+        return true;
+    }
+
+    if(!in)
+      return true;
+  }
+
+  entries.swap(tmp);
+  return false;
+}
+
+void ai_cachet::write(std::ostream &out)
+{
+  std::vector<entriest::const_iterator> current;
+
+  for(entriest::const_iterator e_it=entries.begin();
+      e_it!=entries.end();
+      e_it++)
+  {
+    const std::string *hash=get_hash(e_it->first.first);
+
+    // drop the summaries of changed functions
+    if(hash!=nullptr && *hash==e_it->first.second)
+      current.push_back(e_it);
+  }
+
+  write_ai_cache_string(out, AI_CACHE_MAGIC);
+  write_ai_cache_string(out, tag);
+
+  write_gb_word(out, current.size());
+  for(const auto &e_it : current)
+  {
+    write_ai_cache_string(out, e_it->first.first);
+    write_ai_cache_string(out, e_it->first.second);
+
+    write_gb_word(out, e_it->second.size());
+    for(const auto &summary : e_it->second)
+    {
+      write_ai_cache_string(out, summary.first);
+      write_ai_cache_string(out, summary.second.entry);
+      write_ai_cache_string(out, summary.second.exit);
+
+      write_gb_word(out, summary.second.states.indices.size());
+      for(const auto &index : summary.second.states.indices)
+        write_gb_word(out, index);
+
+      write_ai_cache_string(out, summary.second.states.data);
+
+      write_gb_word(out, summary.second.calls.size());
+      for(const auto &call : summary.second.calls)
+      {
+        write_ai_cache_string(out, id2string(call.first));
+        write_ai_cache_string(out, call.second);
+      }
+    }
+  }
+}
@@ -0,0 +1,152 @@
+/*******************************************************************\
+
+Module: Cache of Abstract Interpretation Summaries
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// A cache of the summaries that summary_ait computes for functions,
+/// which can be kept on disk and reused by a later analysis of a program
+/// in which some functions have changed
+
+#ifndef CPROVER_ANALYSES_AI_CACHE_H
+#define CPROVER_ANALYSES_AI_CACHE_H
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <util/mp_arith.h>
+
+#include <goto-programs/goto_functions.h>
+
+/// Writes `irep` such that equal ireps give equal bytes, in any process,
+/// which irep_serializationt does not guarantee
+void write_ai_cache_irep(std::ostream &, const irept &);
+void read_ai_cache_irep(std::istream &, irept &);
+
+void write_ai_cache_string(std::ostream &, const std::string &);
+std::string read_ai_cache_string(std::istream &);
+
+/// Writes integers that fit into a long long as words rather than as
+/// strings, which are slow to read
+void write_ai_cache_integer(std::ostream &, const mp_integer &);
+mp_integer read_ai_cache_integer(std::istream &);
+
+/// The states of some of the locations of a function body, with the
+/// indices of their locations, as ai_domain_baset::write writes them one
+/// after the other
+struct ai_cache_statest
+{
+  std::vector<std::size_t> indices;
+  std::string data;
+};
+
+/*! \brief The summaries of functions, for summary_ait
+
+    A summary maps the state at the entry of a function to the state at
+    its end. It only depends on that state and on the bodies of the
+    function and the functions it calls, unless these are recursive. The
+    cache keys the summaries by the name of the function, a hash of these
+    bodies and a digest of the entry state, such that the summaries of a
+    function are reused until the function or one of its callees changes.
+
+    Along with the states at the entry and the end, the cache keeps the
+    states that the analysis of the body gives its locations, and the
+    summaries that its calls apply, which reusing the summary adds to the
+    analysis.
+*/
+class ai_cachet
+{
+public:
+  /// \param _tag: what is analysed, such as the domain; a cache
+  ///   that is read must have the same tag
+  explicit ai_cachet(const std::string &_tag):
+    hits(0),
+    misses(0),
+    tag(_tag),
+    enabled(true),
+    goto_functions(nullptr)
+  {
+  }
+
+  /// Sets the functions that are analysed and hashes their bodies, which
+  /// must be done before the analysis and before the cache is written
+  void set_functions(const goto_functionst &);
+
+  /// Reads the summaries stored by write()
+  /// \return true on error, including a tag that does not match
+  bool read(std::istream &);
+
+  /// Writes the summaries of the functions that are unchanged, and those
+  /// that have been computed
+  void write(std::ostream &);
+
+  /// the number of summaries that have been reused and computed
+  std::size_t hits, misses;
+
+  struct summaryt
+  {
+    std::string entry, exit;
+    ai_cache_statest states;
+    // the functions called, and the digests of their entry states, in the
+    // order in which the summaries of the calls have been applied first
+    std::vector<std::pair<irep_idt, std::string>> calls;
+  };
+
+  /// \return the digest of a state written by ai_domain_baset::write
+  static std::string digest(const std::string &state);
+
+  /// \return the summary of `function` for the entry state with the given
+  ///   digest, or nullptr if not known
+  const summaryt *find(const irep_idt &function, const std::string &entry);
+
+  void insert(
+    const irep_idt &function,
+    const std::string &entry,
+    const summaryt &summary);
+
+  bool is_enabled() const
+  {
+    return enabled;
+  }
+
+  /// Stops caching, as for a domain whose states cannot be written
+  void disable()
+  {
+    enabled=false;
+  }
+
+protected:
+  std::string tag;
+  bool enabled;
+
+  const goto_functionst *goto_functions;
+
+  // the hashes of the bodies alone
+  std::unordered_map<irep_idt, std::string, irep_id_hash> body_hashes;
+
+  // the hashes of the bodies and the bodies of all functions they call,
+  // computed when first needed
+  std::unordered_map<irep_idt, std::string, irep_id_hash> hashes;
+
+  const std::string *get_hash(const irep_idt &);
+  bool hash_function(
+    const irep_idt &,
+    std::unordered_set<irep_idt, irep_id_hash> &stack);
+
+  // digest of the entry state -> summary
+  typedef std::map<std::string, summaryt> summariest;
+
+  // function and hash -> summaries
+  typedef std::map<std::pair<std::string, std::string>, summariest>
+    entriest;
+  entriest entries;
+};
+
+#endif // CPROVER_ANALYSES_AI_CACHE_H
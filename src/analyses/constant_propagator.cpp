@@ -11,15 +11,20 @@ Author: Peter Schrammel
 
 #include "constant_propagator.h"
 
+#include <algorithm>
+
 #ifdef DEBUG
 #include <iostream>
 #endif
 
 #include <util/find_symbols.h>
 #include <util/arith_tools.h>
+#include <util/irep_serialization.h>
 #include <util/simplify_expr.h>
 #include <util/cprover_prefix.h>
 
+#include "ai_cache.h"
+
 void constant_propagator_domaint::assign_rec(
   valuest &values,
   const exprt &lhs,
@@ -270,6 +275,41 @@ bool constant_propagator_domaint::ai_simplify(
   return b;
 }
 
+bool constant_propagator_domaint::write(std::ostream &out) const
+{
+  // only the constants of the variables are kept
+  if(!values.replace_const.type_map.empty())
+    return true;
+
+  std::vector<std::pair<std::string, const exprt *>> sorted;
+  for(const auto &entry : values.replace_const.expr_map)
+    sorted.push_back(std::make_pair(id2string(entry.first), &entry.second));
+  std::sort(sorted.begin(), sorted.end());
+
+  write_gb_word(out, values.is_bottom);
+  write_gb_word(out, sorted.size());
+  for(const auto &entry : sorted)
+  {
+    write_ai_cache_string(out, entry.first);
+    write_ai_cache_irep(out, *entry.second);
+  }
+
+  return false;
+}
+
+bool constant_propagator_domaint::read(std::istream &in)
+{
+  values.set_to_bottom();
+  values.is_bottom=irep_serializationt::read_gb_word(in)!=0;
+
+  for(std::size_t n=irep_serializationt::read_gb_word(in); n>0 && in; n--)
+  {
+    const irep_idt identifier=read_ai_cache_string(in);
+    read_ai_cache_irep(in, values.replace_const.expr_map[identifier]);
+  }
+
+  return !in;
+}
 
 bool constant_propagator_domaint::valuest::is_constant(const exprt &expr) const
 {
@@ -42,6 +42,9 @@ public:
     exprt &condition,
     const namespacet &ns) const final override;
 
+  bool write(std::ostream &out) const override;
+  bool read(std::istream &in) override;
+
   virtual void make_bottom() final override
   {
     values.set_to_bottom();
@@ -29,33 +29,12 @@ bool dep_graph_domaint::merge(
   bool changed=has_values.is_false();
   has_values=tvt::unknown();
 
-  depst::iterator it=control_deps.begin();
-  for(const auto &c_dep : src.control_deps)
-  {
-    while(it!=control_deps.end() && *it<c_dep)
-      ++it;
-    if(it==control_deps.end() || c_dep<*it)
-    {
-      control_deps.insert(it, c_dep);
-      changed=true;
-    }
-    else if(it!=control_deps.end())
-      ++it;
-  }
+  // a word of the bit vectors at a time
+  if(control_deps.insert(src.control_deps))
+    changed=true;
 
-  it=data_deps.begin();
-  for(const auto &d_dep : src.data_deps)
-  {
-    while(it!=data_deps.end() && *it<d_dep)
-      ++it;
-    if(it==data_deps.end() || d_dep<*it)
-    {
-      data_deps.insert(it, d_dep);
-      changed=true;
-    }
-    else if(it!=data_deps.end())
-      ++it;
-  }
+  if(data_deps.insert(src.data_deps))
+    changed=true;
 
   return changed;
 }
@@ -74,29 +53,27 @@ void dep_graph_domaint::control_dependencies(
   // nodes; from is added if it is a goto or assume instruction
   if(from->is_goto() ||
      from->is_assume())
-    control_deps.insert(from);
+    control_deps.insert(dep_graph[from].get_node_id());
 
   const irep_idt id=goto_programt::get_function_id(from);
   const cfg_post_dominatorst &pd=dep_graph.cfg_post_dominators().at(id);
 
+  depst removed;
+
   // check all candidates for M
-  for(depst::iterator
-      it=control_deps.begin();
-      it!=control_deps.end();
-      ) // no ++it
+  for(const auto &node_id : control_deps)
   {
-    depst::iterator next=it;
-    ++next;
+    const goto_programt::const_targett m_loc=dep_graph[node_id].PC;
 
     // check all CFG successors
     // special case: assumptions also introduce a control dependency
-    bool post_dom_all=!(*it)->is_assume();
+    bool post_dom_all=!m_loc->is_assume();
     bool post_dom_one=false;
 
     // we could hard-code assume and goto handling here to improve
     // performance
     cfg_post_dominatorst::cfgt::entry_mapt::const_iterator e=
-      pd.cfg.entry_map.find(*it);
+      pd.cfg.entry_map.find(m_loc);
 
     assert(e!=pd.cfg.entry_map.end());
 
@@ -116,10 +93,10 @@ void dep_graph_domaint::control_dependencies(
 
     if(post_dom_all ||
        !post_dom_one)
-      control_deps.erase(it);
-
-    it=next;
+      removed.insert(node_id);
   }
+
+  control_deps.erase(removed);
 }
 
 static bool may_be_def_use_pair(
@@ -174,7 +151,7 @@ void dep_graph_domaint::data_dependencies(
                                  r_range.first, r_range.second))
           {
             // found a def-use pair
-            data_deps.insert(w_range.first);
+            data_deps.insert(dep_graph[w_range.first].get_node_id());
             found=true;
           }
     }
@@ -210,16 +187,7 @@ void dep_graph_domaint::transform(
         dynamic_cast<dep_graph_domaint*>(&(dep_graph->get_state(next)));
       assert(s!=nullptr);
 
-      depst::iterator it=s->control_deps.begin();
-      for(const auto &c_dep : control_deps)
-      {
-        while(it!=s->control_deps.end() && *it<c_dep)
-          ++it;
-        if(it==s->control_deps.end() || c_dep<*it)
-          s->control_deps.insert(it, c_dep);
-        else if(it!=s->control_deps.end())
-          ++it;
-      }
+      s->control_deps.insert(control_deps);
 
       control_deps.clear();
     }
@@ -235,6 +203,10 @@ void dep_graph_domaint::output(
   const ai_baset &ai,
   const namespacet &ns) const
 {
+  const dependence_grapht *dep_graph=
+    dynamic_cast<const dependence_grapht *>(&ai);
+  assert(dep_graph!=nullptr);
+
   if(!control_deps.empty())
   {
     out << "Control dependencies: ";
@@ -245,7 +217,7 @@ void dep_graph_domaint::output(
     {
       if(it!=control_deps.begin())
         out << ",";
-      out << (*it)->location_number;
+      out << (*dep_graph)[*it].PC->location_number;
     }
     out << '\n';
   }
@@ -260,7 +232,7 @@ void dep_graph_domaint::output(
     {
       if(it!=data_deps.begin())
         out << ",";
-      out << (*it)->location_number;
+      out << (*dep_graph)[*it].PC->location_number;
     }
     out << '\n';
   }
@@ -273,10 +245,16 @@ jsont dep_graph_domaint::output_json(
   const ai_baset &ai,
   const namespacet &ns) const
 {
+  const dependence_grapht *dep_graph=
+    dynamic_cast<const dependence_grapht *>(&ai);
+  assert(dep_graph!=nullptr);
+
   json_arrayt graph;
 
-  for(const auto &cd : control_deps)
+  for(const auto &c_dep : control_deps)
   {
+    const goto_programt::const_targett cd=(*dep_graph)[c_dep].PC;
+
     json_objectt &link=graph.push_back().make_object();
     link["locationNumber"]=
       json_numbert(std::to_string(cd->location_number));
@@ -284,8 +262,10 @@ jsont dep_graph_domaint::output_json(
     link["type"]=json_stringt("control");
   }
 
-  for(const auto &dd : data_deps)
+  for(const auto &d_dep : data_deps)
   {
+    const goto_programt::const_targett dd=(*dep_graph)[d_dep].PC;
+
     json_objectt &link=graph.push_back().make_object();
     link["locationNumber"]=
       json_numbert(std::to_string(dd->location_number));
@@ -302,9 +282,16 @@ void dependence_grapht::add_dep(
   goto_programt::const_targett from,
   goto_programt::const_targett to)
 {
-  const node_indext n_from=state_map[from].get_node_id();
+  add_dep(
+    kind, state_map[from].get_node_id(), state_map[to].get_node_id());
+}
+
+void dependence_grapht::add_dep(
+  dep_edget::kindt kind,
+  node_indext n_from,
+  node_indext n_to)
+{
   assert(n_from<size());
-  const node_indext n_to=state_map[to].get_node_id();
   assert(n_to<size());
 
   // add_edge is redundant as the subsequent operations also insert
@@ -318,8 +305,8 @@ void dep_graph_domaint::populate_dep_graph(
   dependence_grapht &dep_graph, goto_programt::const_targett this_loc) const
 {
   for(const auto &c_dep : control_deps)
-    dep_graph.add_dep(dep_edget::kindt::CTRL, c_dep, this_loc);
+    dep_graph.add_dep(dep_edget::kindt::CTRL, c_dep, node_id);
 
   for(const auto &d_dep : data_deps)
-    dep_graph.add_dep(dep_edget::kindt::DATA, d_dep, this_loc);
+    dep_graph.add_dep(dep_edget::kindt::DATA, d_dep, node_id);
 }
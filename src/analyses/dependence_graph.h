@@ -18,6 +18,8 @@ Date: August 2013
 #include <util/graph.h>
 #include <util/threeval.h>
 
+#include <util/sparse_bitset.h>
+
 #include "ai.h"
 #include "cfg_dominators.h"
 #include "reaching_definitions.h"
@@ -162,7 +164,8 @@ private:
   tvt has_values;
   node_indext node_id;
 
-  typedef std::set<goto_programt::const_targett> depst;
+  // the node ids of the locations depended on
+  typedef sparse_bitsett depst;
   depst control_deps, data_deps;
 
   friend const depst &
@@ -229,6 +232,11 @@ public:
     goto_programt::const_targett from,
     goto_programt::const_targett to);
 
+  void add_dep(
+    dep_edget::kindt kind,
+    node_indext from,
+    node_indext to);
+
   const post_dominators_mapt &cfg_post_dominators() const
   {
     return post_dominators;
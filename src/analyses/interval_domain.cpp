@@ -11,6 +11,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "interval_domain.h"
 
+#include <algorithm>
+
 #ifdef DEBUG
 #include <iostream>
 #endif
@@ -18,6 +20,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/simplify_expr.h>
 #include <util/std_expr.h>
 #include <util/arith_tools.h>
+#include <util/irep_serialization.h>
+
+#include "ai_cache.h"
 
 void interval_domaint::output(
   std::ostream &out,
@@ -488,3 +493,89 @@ bool interval_domaint::ai_simplify(
 
   return unchanged;
 }
+
+/// Orders the entries of `map` by the names of the symbols
+template<typename mapT>
+static std::vector<typename mapT::const_iterator> sorted(const mapT &map)
+{
+  std::vector<typename mapT::const_iterator> result;
+
+  for(typename mapT::const_iterator it=map.begin(); it!=map.end(); it++)
+    result.push_back(it);
+
+  std::sort(
+    result.begin(),
+    result.end(),
+    [](
+      const typename mapT::const_iterator &a,
+      const typename mapT::const_iterator &b)
+    {
+      return id2string(a->first)<id2string(b->first);
+    });
+
+  return result;
+}
+
+bool interval_domaint::write(std::ostream &out) const
+{
+  write_gb_word(out, bottom);
+
+  write_gb_word(out, int_map.size());
+  for(const auto &it : sorted(int_map))
+  {
+    write_ai_cache_string(out, id2string(it->first));
+    write_gb_word(out, it->second.lower_set);
+    write_ai_cache_integer(out, it->second.lower);
+    write_gb_word(out, it->second.upper_set);
+    write_ai_cache_integer(out, it->second.upper);
+  }
+
+  write_gb_word(out, float_map.size());
+  for(const auto &it : sorted(float_map))
+  {
+    write_ai_cache_string(out, id2string(it->first));
+    write_gb_word(out, it->second.lower_set);
+    if(it->second.lower_set)
+      write_ai_cache_irep(out, it->second.lower.to_expr());
+    write_gb_word(out, it->second.upper_set);
+    if(it->second.upper_set)
+      write_ai_cache_irep(out, it->second.upper.to_expr());
+  }
+
+  return false;
+}
+
+bool interval_domaint::read(std::istream &in)
+{
+  make_bottom();
+
+  bottom=irep_serializationt::read_gb_word(in)!=0;
+
+  for(std::size_t n=irep_serializationt::read_gb_word(in); n>0 && in; n--)
+  {
+    integer_intervalt &interval=int_map[read_ai_cache_string(in)];
+    interval.lower_set=irep_serializationt::read_gb_word(in)!=0;
+    interval.lower=read_ai_cache_integer(in);
+    interval.upper_set=irep_serializationt::read_gb_word(in)!=0;
+    interval.upper=read_ai_cache_integer(in);
+  }
+
+  for(std::size_t n=irep_serializationt::read_gb_word(in); n>0 && in; n--)
+  {
+    ieee_float_intervalt &interval=float_map[read_ai_cache_string(in)];
+
+    for(auto bound : { std::make_pair(&interval.lower_set, &interval.lower),
+                       std::make_pair(&interval.upper_set, &interval.upper) })
+    {
+      *bound.first=irep_serializationt::read_gb_word(in)!=0;
+      if(*bound.first)
+      {
+        exprt value;
+        read_ai_cache_irep(in, value);
+        bound.second->from_expr(to_constant_expr(value));
+      }
+    }
+  }
+
+  return !in;
+}
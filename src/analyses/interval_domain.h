@@ -111,6 +111,9 @@ public:
     exprt &condition,
     const namespacet &ns) const override;
 
+  bool write(std::ostream &out) const override;
+  bool read(std::istream &in) override;
+
 protected:
   bool bottom;
 
@@ -350,44 +350,32 @@ void rd_range_domaint::kill(
   if(entry==values.end())
     return;
 
-  bool clear_export_cache=false;
-  values_innert new_values;
+  values_innert killed, new_values;
 
-  for(values_innert::iterator
-      it=entry->second.begin();
-      it!=entry->second.end();
-     ) // no ++it
+  for(const auto &id : entry->second)
   {
-    const reaching_definitiont &v=bv_container->get(*it);
+    const reaching_definitiont &v=bv_container->get(id);
 
     if(v.bit_begin >= range_end)
-      ++it;
+      continue;
     else if(v.bit_end!=-1 &&
             v.bit_end <= range_start)
-      ++it;
+      continue;
     else if(v.bit_begin >= range_start &&
             v.bit_end!=-1 &&
             v.bit_end <= range_end) // rs <= a < b <= re
     {
-      clear_export_cache=true;
-
-      entry->second.erase(it++);
+      // nothing of it remains
     }
     else if(v.bit_begin >= range_start) // rs <= a <= re < b
     {
-      clear_export_cache=true;
-
       reaching_definitiont v_new=v;
       v_new.bit_begin=range_end;
       new_values.insert(bv_container->add(v_new));
-
-      entry->second.erase(it++);
     }
     else if(v.bit_end==-1 ||
             v.bit_end > range_end) // a <= rs < re < b
     {
-      clear_export_cache=true;
-
       reaching_definitiont v_new=v;
       v_new.bit_end=range_start;
 
@@ -396,39 +384,25 @@ void rd_range_domaint::kill(
 
       new_values.insert(bv_container->add(v_new));
       new_values.insert(bv_container->add(v_new2));
-
-      entry->second.erase(it++);
     }
     else // a <= rs < b <= re
     {
-      clear_export_cache=true;
-
       reaching_definitiont v_new=v;
       v_new.bit_end=range_start;
       new_values.insert(bv_container->add(v_new));
-
-      entry->second.erase(it++);
     }
+
+    killed.insert(id);
   }
 
-  if(clear_export_cache)
-    export_cache.erase(identifier);
+  if(killed.empty())
+    return;
 
-  values_innert::iterator it=entry->second.begin();
-  for(const auto &id : new_values)
-  {
-    while(it!=entry->second.end() && *it<id)
-      ++it;
-    if(it==entry->second.end() || id<*it)
-    {
-      entry->second.insert(it, id);
-    }
-    else if(it!=entry->second.end())
-    {
-      assert(*it==id);
-      ++it;
-    }
-  }
+  export_cache.erase(identifier);
+
+  // bit-wise, rather than one definition at a time
+  entry->second.erase(killed);
+  entry->second.insert(new_values);
 }
 
 void rd_range_domaint::kill_inf(
@@ -486,7 +460,7 @@ bool rd_range_domaint::gen(
   v.bit_begin=range_start;
   v.bit_end=range_end;
 
-  if(!values[identifier].insert(bv_container->add(v)).second)
+  if(!values[identifier].insert(bv_container->add(v)))
     return false;
 
   export_cache.erase(identifier);
@@ -581,50 +555,8 @@ bool rd_range_domaint::merge_inner(
   values_innert &dest,
   const values_innert &other)
 {
-  bool more=false;
-
-#if 0
-  ranges_at_loct::iterator itr=it->second.begin();
-  for(const auto &o : ito->second)
-  {
-    while(itr!=it->second.end() && itr->first<o.first)
-      ++itr;
-    if(itr==it->second.end() || o.first<itr->first)
-    {
-      it->second.insert(o);
-      more=true;
-    }
-    else if(itr!=it->second.end())
-    {
-      assert(itr->first==o.first);
-
-      for(const auto &o_range : o.second)
-        more=gen(itr->second, o_range.first, o_range.second) ||
-          more;
-
-      ++itr;
-    }
-  }
-#else
-  values_innert::iterator itr=dest.begin();
-  for(const auto &id : other)
-  {
-    while(itr!=dest.end() && *itr<id)
-      ++itr;
-    if(itr==dest.end() || id<*itr)
-    {
-      dest.insert(itr, id);
-      more=true;
-    }
-    else if(itr!=dest.end())
-    {
-      assert(*itr==id);
-      ++itr;
-    }
-  }
-#endif
-
-  return more;
+  // a word of the bit vectors at a time
+  return dest.insert(other);
 }
 
 /// \return returns true iff there is something new
@@ -0,0 +1,669 @@
+/*******************************************************************\
+
+Module: Summary-Based Interprocedural Abstract Interpretation
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Abstract interpretation that analyses a function body once for each
+/// abstract state the function is called in, and applies the resulting
+/// summary to all calls in that state
+
+#ifndef CPROVER_ANALYSES_SUMMARY_AI_H
+#define CPROVER_ANALYSES_SUMMARY_AI_H
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <set>
+#include <sstream>
+
+#include "ai.h"
+#include "ai_cache.h"
+#include "call_graph.h"
+
+/*! \brief An abstract interpreter that summarizes function calls
+
+    ait joins the states of all calls of a function at its entry and
+    analyses the body again whenever that state grows. Instead, this one
+    keeps summaries, each of which maps an entry state of a function to
+    the state at its end, and analyses a body only for an entry state it
+    has no summary for. The body is analysed with states of its own, and
+    the state at each location is the join over all summaries.
+
+    Summaries are computed when a call needs them, so that the summaries
+    of the callees are complete before those of their callers, one
+    strongly connected component of the call graph at a time. A recursive
+    call of a summary that is still being computed uses the current
+    approximation of its end state. Its body is then analysed again until
+    the approximation is stable, and the summaries of the component that
+    have been computed from the approximation meanwhile are discarded.
+
+    A function has at most `max_summaries` summaries. Further entry states
+    are joined into the last one.
+
+    With an ai_cachet, the summaries of functions that are not recursive
+    are taken from the cache if it has them, and stored in it otherwise.
+    Taking a summary from the cache adds the summaries of the calls that
+    computing it would add, in the same order, such that the analysis
+    gives the same states with a cache as without. A summary is not
+    stored if it depends on the summaries of calls analysed before, that
+    is, if a call has joined its entry state into the last summary of a
+    function, and it is not taken from the cache if that would add more
+    than `max_summaries` summaries to a function.
+*/
+template<typename domainT>
+class summary_ait:public ait<domainT>
+{
+public:
+  typedef typename ait<domainT>::statet statet;
+  typedef goto_programt::const_targett locationt;
+
+  /// \param _max_summaries: the number of summaries per function, beyond
+  ///   which the entry states of the function are joined
+  explicit summary_ait(std::size_t _max_summaries=8):
+    ait<domainT>(),
+    computed(0),
+    applied(0),
+    max_summaries(_max_summaries==0?1:_max_summaries),
+    next_id(0),
+    cache(nullptr)
+  {
+  }
+
+  bool set_cache(ai_cachet &_cache) override
+  {
+    cache=&_cache;
+    return false;
+  }
+
+  void clear() override
+  {
+    summaries.clear();
+    frames.clear();
+    sccs.clear();
+    scc_functions.clear();
+    ait<domainT>::clear();
+  }
+
+  /// the number of summaries that have been computed, and the number of
+  /// times that one has been applied without analysing the function
+  std::size_t computed, applied;
+
+protected:
+  typedef typename ait<domainT>::state_mapt state_mapt;
+
+  const std::size_t max_summaries;
+
+  struct summaryt
+  {
+    domainT entry, exit;
+    // in the order the summaries have been computed in
+    std::size_t id;
+    // the frame that computes the summary, if any
+    bool in_progress;
+    std::size_t frame;
+    // the digest of the entry state, if there is a cache, and whether the
+    // summary is in it
+    std::string digest;
+    bool cached;
+  };
+
+  typedef std::list<summaryt> summary_listt;
+  typedef std::unordered_map<irep_idt, summary_listt, irep_id_hash>
+    summariest;
+  summariest summaries;
+  std::size_t next_id;
+
+  /// The analysis of a function body for a summary
+  struct framet
+  {
+    std::size_t scc;
+    state_mapt states;
+    // a call has applied the approximation of the summary
+    bool used;
+    // the entry state of the summary has grown
+    bool entry_changed;
+    // whether the summary can be stored in the cache, with the summaries
+    // that the calls have applied
+    bool cacheable;
+    std::vector<std::pair<irep_idt, std::string>> calls;
+  };
+
+  // a deque, as the frames must stay in place as further ones are added
+  std::deque<framet> frames;
+
+  // the strongly connected components of the call graph
+  std::unordered_map<irep_idt, std::size_t, irep_id_hash> sccs;
+  std::vector<std::vector<irep_idt>> scc_functions;
+  // whether the functions of a component call each other
+  std::vector<bool> recursive;
+
+  ai_cachet *cache;
+
+  typedef std::pair<irep_idt, std::string> cache_keyt;
+
+  using ai_baset::initialize;
+
+  void initialize(const goto_functionst &goto_functions) override
+  {
+    ait<domainT>::initialize(goto_functions);
+
+    call_grapht call_graph(goto_functions);
+
+    // the call graph has the calls of symbols only, not those of the
+    // operands of an if
+    forall_goto_functions(f_it, goto_functions)
+    {
+      forall_goto_program_instructions(i_it, f_it->second.body)
+      {
+        if(!i_it->is_function_call() ||
+           to_code_function_call(i_it->code).function().id()!=ID_if)
+          continue;
+
+        std::vector<exprt> targets(
+          1, to_code_function_call(i_it->code).function());
+
+        while(!targets.empty())
+        {
+          const exprt target=targets.back();
+          targets.pop_back();
+
+          if(target.id()==ID_symbol)
+            call_graph.add(
+              f_it->first, to_symbol_expr(target).get_identifier());
+          else if(target.id()==ID_if && target.operands().size()==3)
+          {
+            targets.push_back(target.op1());
+            targets.push_back(target.op2());
+          }
+        }
+      }
+    }
+
+    const call_grapht::directed_grapht graph=
+      call_graph.get_directed_graph();
+
+    std::vector<call_grapht::directed_grapht::node_indext> scc_numbers;
+    scc_functions.resize(graph.SCCs(scc_numbers));
+
+    for(const auto &node : graph.get_nodes_by_name())
+    {
+      sccs[node.first]=scc_numbers[node.second];
+      scc_functions[scc_numbers[node.second]].push_back(node.first);
+    }
+
+    // the functions without calls are components of their own
+    forall_goto_functions(f_it, goto_functions)
+    {
+      if(sccs.insert(
+           std::make_pair(f_it->first, scc_functions.size())).second)
+        scc_functions.push_back(std::vector<irep_idt>(1, f_it->first));
+    }
+
+    recursive.assign(scc_functions.size(), false);
+
+    for(std::size_t scc=0; scc<scc_functions.size(); scc++)
+      recursive[scc]=scc_functions[scc].size()>1;
+
+    for(const auto &edge : call_graph.graph)
+      if(edge.first==edge.second)
+        recursive[sccs[edge.first]]=true;
+  }
+
+  // the states of the body that is being analysed, if any
+  statet &get_state(locationt l) override
+  {
+    if(frames.empty())
+      return ait<domainT>::get_state(l);
+
+    std::pair<typename state_mapt::iterator, bool> result=
+      frames.back().states.insert(std::make_pair(l, domainT()));
+
+    if(result.second)
+      result.first->second.make_bottom();
+
+    return result.first->second;
+  }
+
+  void fixedpoint(
+    const goto_functionst &goto_functions,
+    const namespacet &ns) override
+  {
+    goto_functionst::function_mapt::const_iterator f_it=
+      goto_functions.function_map.find(goto_functions.entry_point());
+
+    if(f_it==goto_functions.function_map.end() ||
+       !f_it->second.body_available())
+      return;
+
+    // as set by entry_state
+    const domainT entry=(*this)[f_it->second.body.instructions.begin()];
+    summarize(f_it, entry, goto_functions, ns);
+  }
+
+  bool do_function_call(
+    locationt l_call, locationt l_return,
+    const goto_functionst &goto_functions,
+    const goto_functionst::function_mapt::const_iterator f_it,
+    const exprt::operandst &arguments,
+    const namespacet &ns) override
+  {
+    if(!f_it->second.body_available())
+      return ai_baset::do_function_call(
+        l_call, l_return, goto_functions, f_it, arguments, ns);
+
+    const goto_programt &body=f_it->second.body;
+    const locationt l_begin=body.instructions.begin();
+    const locationt l_end=std::prev(body.instructions.end());
+
+    // the edge from the call site to the beginning of the function
+    domainT entry(static_cast<const domainT &>(this->get_state(l_call)));
+    entry.transform(
+      l_call, l_begin, *this, ns, ai_domain_baset::edge_typet::CALL);
+
+    // initialize state, if necessary
+    this->get_state(l_return);
+
+    if(entry.is_bottom())
+      return false;
+
+    domainT exit(summarize(f_it, entry, goto_functions, ns));
+
+    if(exit.is_bottom())
+      return false; // function exit point not reachable
+
+    // the edge from the end of the function to the return site
+    exit.transform(
+      l_end, l_return, *this, ns, ai_domain_baset::edge_typet::RETURN);
+
+    return this->merge(exit, l_end, l_return);
+  }
+
+  /// \return the state at the end of the function for the given entry
+  ///   state, which is an approximation if the summary is being computed
+  const domainT &summarize(
+    goto_functionst::function_mapt::const_iterator f_it,
+    const domainT &entry,
+    const goto_functionst &goto_functions,
+    const namespacet &ns)
+  {
+    summary_listt &list=summaries[f_it->first];
+    const locationt l_begin=f_it->second.body.instructions.begin();
+
+    for(auto &summary : list)
+      if(equal(summary.entry, entry, l_begin))
+        return apply(f_it->first, summary);
+
+    typename summary_listt::iterator s_it;
+
+    if(list.size()<max_summaries)
+    {
+      s_it=list.insert(list.end(), summaryt());
+      s_it->entry=entry;
+      s_it->in_progress=false;
+    }
+    else
+    {
+      // what the call gets then depends on the calls analysed before
+      if(!frames.empty())
+        frames.back().cacheable=false;
+
+      s_it=std::prev(list.end());
+
+      // the summary of a larger entry state is sound, if less precise
+      if(!s_it->entry.merge(entry, l_begin, l_begin))
+        return apply(f_it->first, *s_it);
+
+      if(s_it->in_progress)
+      {
+        frames[s_it->frame].entry_changed=true;
+        return apply(f_it->first, *s_it);
+      }
+    }
+
+    s_it->cached=false;
+    set_digest(*s_it);
+
+    if(!reuse(f_it, *s_it, goto_functions))
+      compute(f_it, *s_it, goto_functions, ns);
+
+    add_call(f_it->first, *s_it);
+    return s_it->exit;
+  }
+
+  const domainT &apply(const irep_idt &function, summaryt &summary)
+  {
+    if(summary.in_progress)
+      frames[summary.frame].used=true;
+
+    add_call(function, summary);
+
+    applied++;
+    return summary.exit;
+  }
+
+  /// Records that the body that is being analysed applies the summary
+  void add_call(const irep_idt &function, const summaryt &summary)
+  {
+    if(frames.empty())
+      return;
+
+    framet &frame=frames.back();
+
+    if(!summary.cached)
+      frame.cacheable=false;
+    else
+      frame.calls.push_back(std::make_pair(function, summary.digest));
+  }
+
+  /// Sets the digest of the entry state of the summary, if there is a
+  /// cache
+  void set_digest(summaryt &summary)
+  {
+    summary.digest.clear();
+
+    if(cache==nullptr || !cache->is_enabled())
+      return;
+
+    std::ostringstream entry;
+
+    if(summary.entry.write(entry))
+      cache->disable();
+    else
+      summary.digest=ai_cachet::digest(entry.str());
+  }
+
+  /// Analyses the body of the function from the entry state of the
+  /// summary, again as long as a recursive call has applied an
+  /// approximation of the summary that has changed
+  void compute(
+    goto_functionst::function_mapt::const_iterator f_it,
+    summaryt &summary,
+    const goto_functionst &goto_functions,
+    const namespacet &ns)
+  {
+    const goto_programt &body=f_it->second.body;
+    const locationt l_begin=body.instructions.begin();
+    const locationt l_end=std::prev(body.instructions.end());
+
+    summary.id=next_id++;
+    summary.exit.make_bottom();
+    summary.in_progress=true;
+    summary.frame=frames.size();
+
+    frames.push_back(framet());
+    framet &frame=frames.back();
+    frame.scc=sccs[f_it->first];
+
+    while(true)
+    {
+      // the summaries that are computed in this iteration
+      const std::size_t first_id=next_id;
+
+      frame.states.clear();
+      frame.used=false;
+      frame.entry_changed=false;
+      frame.cacheable=
+        !summary.digest.empty() && cache->is_enabled() &&
+        !recursive[frame.scc];
+      frame.calls.clear();
+
+      static_cast<domainT &>(this->get_state(l_begin))=summary.entry;
+      ai_baset::fixedpoint(body, goto_functions, ns);
+
+      const bool exit_changed=summary.exit.merge(
+        static_cast<const domainT &>(this->get_state(l_end)), l_end, l_end);
+
+      if(!frame.entry_changed && !(frame.used && exit_changed))
+        break;
+
+      discard(frame.scc, first_id);
+    }
+
+    computed++;
+
+    // the states at the locations are joined over all summaries
+    for(const auto &state : frame.states)
+      this->state_map[state.first].merge(
+        state.second, state.first, state.first);
+
+    if(frame.cacheable)
+      store(f_it, summary, frame);
+
+    summary.in_progress=false;
+    frames.pop_back();
+  }
+
+  /// Stores a summary that has been computed in the cache
+  void store(
+    goto_functionst::function_mapt::const_iterator f_it,
+    summaryt &summary,
+    framet &frame)
+  {
+    ai_cachet::summaryt cached;
+    std::ostringstream entry, exit, states;
+
+    if(summary.entry.write(entry) || summary.exit.write(exit))
+    {
+      cache->disable();
+      return;
+    }
+
+    std::size_t index=0;
+
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      typename state_mapt::const_iterator s_it=frame.states.find(i_it);
+
+      if(s_it!=frame.states.end())
+      {
+        if(s_it->second.write(states))
+        {
+          cache->disable();
+          return;
+        }
+
+        cached.states.indices.push_back(index);
+      }
+
+      index++;
+    }
+
+    cached.entry=entry.str();
+    cached.exit=exit.str();
+    cached.states.data=states.str();
+
+    // in the order in which the summaries have been applied first
+    std::set<cache_keyt> seen;
+    for(const auto &call : frame.calls)
+      if(seen.insert(call).second)
+        cached.calls.push_back(call);
+
+    cache->insert(f_it->first, summary.digest, cached);
+    summary.cached=true;
+  }
+
+  /// Takes the summary from the cache if it has one for the entry state,
+  /// adds the states of its body to the states of the analysis, and adds
+  /// the summaries that its calls apply, as computing it would
+  /// \return true if the summary has been taken from the cache
+  bool reuse(
+    goto_functionst::function_mapt::const_iterator f_it,
+    summaryt &summary,
+    const goto_functionst &goto_functions)
+  {
+    if(summary.digest.empty() ||
+       !cache->is_enabled() ||
+       recursive[sccs[f_it->first]])
+      return false;
+
+    const cache_keyt key(f_it->first, summary.digest);
+    std::vector<cache_keyt> added;
+
+    if(!get_added(key, added))
+    {
+      cache->misses++;
+      return false;
+    }
+
+    summary.id=next_id++;
+    summary.in_progress=false;
+    summary.cached=true;
+    read(key, summary, goto_functions);
+
+    for(const auto &current : added)
+    {
+      summaryt &s=
+        *summaries[current.first].insert(
+          summaries[current.first].end(), summaryt());
+
+      s.id=next_id++;
+      s.in_progress=false;
+      s.digest=current.second;
+      s.cached=true;
+      read(current, s, goto_functions);
+    }
+
+    cache->hits++;
+    return true;
+  }
+
+  /// Collects the summaries that computing the given one would add: those
+  /// that its calls apply, and that do not exist yet, in the order in
+  /// which computing them would add them
+  /// \return false if the cache does not have these summaries, or if they
+  ///   are more than a function can have
+  bool get_added(const cache_keyt &key, std::vector<cache_keyt> &added)
+  {
+    std::set<cache_keyt> seen;
+    std::unordered_map<irep_idt, std::size_t, irep_id_hash> sizes;
+    std::vector<cache_keyt> stack(1, key);
+
+    while(!stack.empty())
+    {
+      const cache_keyt current=stack.back();
+      stack.pop_back();
+
+      if(!seen.insert(current).second)
+        continue;
+
+      const ai_cachet::summaryt *cached=
+        cache->find(current.first, current.second);
+
+      if(cached==nullptr)
+        return false;
+
+      if(current!=key)
+      {
+        const summary_listt &list=summaries[current.first];
+
+        if(std::any_of(
+             list.begin(),
+             list.end(),
+             [&current](const summaryt &s)
+             {
+               return s.digest==current.second;
+             }))
+          continue;
+
+        std::size_t &size=sizes[current.first];
+        if(size==0)
+          size=list.size();
+
+        if(++size>max_summaries)
+          return false;
+
+        added.push_back(current);
+      }
+
+      stack.insert(stack.end(), cached->calls.rbegin(), cached->calls.rend());
+    }
+
+    return true;
+  }
+
+  /// Reads the entry and exit states of a summary from the cache, and adds
+  /// the states of its body to the states of the analysis
+  void read(
+    const cache_keyt &key,
+    summaryt &summary,
+    const goto_functionst &goto_functions)
+  {
+    const ai_cachet::summaryt &cached=*cache->find(key.first, key.second);
+    std::istringstream entry(cached.entry), exit(cached.exit);
+
+    if(summary.entry.read(entry) || summary.exit.read(exit))
+      throw "failed to read abstract state from cache";
+
+    const goto_programt &body=
+      goto_functions.function_map.at(key.first).body;
+
+    std::vector<locationt> locations;
+    forall_goto_program_instructions(i_it, body)
+      locations.push_back(i_it);
+
+    std::istringstream in(cached.states.data);
+
+    for(const auto &index : cached.states.indices)
+    {
+      if(index>=locations.size())
+        throw "failed to read abstract state from cache";
+
+      const locationt l=locations[index];
+      std::pair<typename state_mapt::iterator, bool> result=
+        this->state_map.insert(std::make_pair(l, domainT()));
+
+      if(result.second)
+        result.first->second.make_bottom();
+
+      // a state that is not joined with others is read in place
+      if(result.first->second.is_bottom())
+      {
+        if(result.first->second.read(in))
+          throw "failed to read abstract state from cache";
+      }
+      else
+      {
+        domainT state;
+        if(state.read(in))
+          throw "failed to read abstract state from cache";
+
+        result.first->second.merge(state, l, l);
+      }
+    }
+  }
+
+  /// Discards the summaries of the component that have been computed
+  /// since the given one, from approximations that have changed
+  void discard(std::size_t scc, std::size_t first_id)
+  {
+    for(const auto &function : scc_functions[scc])
+    {
+      typename summariest::iterator it=summaries.find(function);
+
+      if(it!=summaries.end())
+        it->second.remove_if(
+          [first_id](const summaryt &summary)
+          {
+            return !summary.in_progress && summary.id>=first_id;
+          });
+    }
+  }
+
+  /// \return true if both states are the same
+  static bool equal(const domainT &a, const domainT &b, locationt l)
+  {
+    domainT tmp(a);
+    if(tmp.merge(b, l, l))
+      return false;
+
+    tmp=b;
+    return !tmp.merge(a, l, l);
+  }
+};
+
+#endif // CPROVER_ANALYSES_SUMMARY_AI_H
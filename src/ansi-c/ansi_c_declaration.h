@@ -201,7 +201,7 @@ public:
 
   typet full_type(const ansi_c_declaratort &) const;
 
-  typedef std::vector<ansi_c_declaratort> declaratorst;
+  typedef irep_sub_vectort<ansi_c_declaratort> declaratorst;
 
   const declaratorst &declarators() const
   {
@@ -50,6 +50,39 @@ void bmc_all_propertiest::goal_covered(const cover_goalst::goalt &)
   }
 }
 
+/// Convert the equation and try to falsify the given goals
+/// \param goals: the goals to be checked
+/// \param [out] iterations: the number of solver calls made
+/// \return result of the last solver call
+decision_proceduret::resultt bmc_all_propertiest::solve_goals(
+  const goal_groupt &goals,
+  unsigned &iterations)
+{
+  bmc.do_conversion(solver);
+
+  do_before_solving();
+
+  cover_goalst cover_goals(solver);
+
+  cover_goals.set_message_handler(get_message_handler());
+  cover_goals.register_observer(*this);
+
+  for(const auto &g : goals)
+  {
+    // Our goal is to falsify a property, i.e., we will
+    // add the negation of the property as goal.
+    literalt p=!solver.convert(g->second.as_expr());
+    cover_goals.add(p);
+  }
+
+  status() << "Running " << solver.decision_procedure_text() << eom;
+
+  decision_proceduret::resultt result=cover_goals();
+  iterations=cover_goals.iterations();
+
+  return result;
+}
+
 safety_checkert::resultt bmc_all_propertiest::operator()()
 {
   status() << "Passing problem to " << solver.decision_procedure_text() << eom;
@@ -59,8 +92,6 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
   // stop the time
   absolute_timet sat_start=current_time();
 
-  bmc.do_conversion();
-
   // Collect _all_ goals in `goal_map'.
   // This maps property IDs to 'goalt'
   forall_goto_functions(f_it, goto_functions)
@@ -96,39 +127,35 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
     }
   }
 
-  do_before_solving();
-
-  cover_goalst cover_goals(solver);
-
-  cover_goals.set_message_handler(get_message_handler());
-  cover_goals.register_observer(*this);
-
-  for(const auto &g : goal_map)
-  {
-    // Our goal is to falsify a property, i.e., we will
-    // add the negation of the property as goal.
-    literalt p=!solver.convert(g.second.as_expr());
-    cover_goals.add(p);
-  }
-
-  status() << "Running " << solver.decision_procedure_text() << eom;
-
   bool error=false;
+  unsigned iterations=0;
 
-  decision_proceduret::resultt result=cover_goals();
+  const unsigned jobs=bmc.options.get_unsigned_int_option("jobs");
 
-  if(result==decision_proceduret::resultt::D_ERROR)
-  {
-    error=true;
-    for(auto &g : goal_map)
-      if(g.second.status==goalt::statust::UNKNOWN)
-        g.second.status=goalt::statust::ERROR;
-  }
+  if(jobs>1 && goal_map.size()>1)
+    error=solve_goals_in_jobs(jobs, iterations);
   else
   {
-    for(auto &g : goal_map)
-      if(g.second.status==goalt::statust::UNKNOWN)
-        g.second.status=goalt::statust::SUCCESS;
+    goal_groupt goals;
+    goals.reserve(goal_map.size());
+    for(goal_mapt::iterator it=goal_map.begin(); it!=goal_map.end(); it++)
+      goals.push_back(it);
+
+    decision_proceduret::resultt result=solve_goals(goals, iterations);
+
+    if(result==decision_proceduret::resultt::D_ERROR)
+    {
+      error=true;
+      for(auto &g : goal_map)
+        if(g.second.status==goalt::statust::UNKNOWN)
+          g.second.status=goalt::statust::ERROR;
+    }
+    else
+    {
+      for(auto &g : goal_map)
+        if(g.second.status==goalt::statust::UNKNOWN)
+          g.second.status=goalt::statust::SUCCESS;
+    }
   }
 
   // output runtime
@@ -140,12 +167,12 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
   }
 
   // report
-  report(cover_goals);
+  report(iterations);
 
   if(error)
     return safety_checkert::resultt::ERROR;
 
-  bool safe=(cover_goals.number_covered()==0);
+  bool safe=(number_failed()==0);
 
   if(safe)
     bmc.report_success(); // legacy, might go away
@@ -155,7 +182,7 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
   return safe?safety_checkert::resultt::SAFE:safety_checkert::resultt::UNSAFE;
 }
 
-void bmc_all_propertiest::report(const cover_goalst &cover_goals)
+void bmc_all_propertiest::report(unsigned iterations)
 {
   switch(bmc.ui)
   {
@@ -180,10 +207,10 @@ void bmc_all_propertiest::report(const cover_goalst &cover_goals)
       }
       result() << eom;
 
-      status() << "\n** " << cover_goals.number_covered()
-               << " of " << cover_goals.size() << " failed ("
-               << cover_goals.iterations() << " iteration"
-               << (cover_goals.iterations()==1?"":"s")
+      status() << "\n** " << number_failed()
+               << " of " << goal_map.size() << " failed ("
+               << iterations << " iteration"
+               << (iterations==1?"":"s")
                << ")" << eom;
     }
     break;
@@ -73,7 +73,7 @@ public:
 
     exprt as_expr() const
     {
-      std::vector<exprt> tmp;
+      exprt::operandst tmp;
       tmp.reserve(instances.size());
       for(const auto &inst : instances)
         tmp.push_back(literal_exprt(inst->cond_literal));
@@ -84,12 +84,28 @@ public:
   typedef std::map<irep_idt, goalt> goal_mapt;
   goal_mapt goal_map;
 
+  std::size_t number_failed() const
+  {
+    std::size_t result=0;
+    for(const auto &g : goal_map)
+      if(g.second.status==goalt::statust::FAILURE)
+        result++;
+    return result;
+  }
+
 protected:
   const goto_functionst &goto_functions;
   prop_convt &solver;
   bmct &bmc;
 
-  virtual void report(const cover_goalst &cover_goals);
+  typedef std::vector<goal_mapt::iterator> goal_groupt;
+
+  decision_proceduret::resultt solve_goals(
+    const goal_groupt &goals,
+    unsigned &iterations);
+  bool solve_goals_in_jobs(unsigned jobs, unsigned &iterations);
+
+  virtual void report(unsigned iterations);
   virtual void do_before_solving() {}
 };
 
@@ -0,0 +1,287 @@
+/*******************************************************************\
+
+Module: Symbolic Execution of ANSI-C
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Checking groups of properties in separate worker processes
+
+#include "all_properties_class.h"
+
+#include <fstream>
+#include <iostream>
+#include <list>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <cerrno>
+#include <sys/wait.h>
+#include <sys/types.h>
+#endif
+
+#include <util/irep_serialization.h>
+#include <util/tempfile.h>
+
+typedef std::map<unsigned, goto_programt::const_targett> location_mapt;
+
+static void write_goto_trace(
+  std::ostream &out,
+  irep_serializationt &irep_converter,
+  const goto_tracet &goto_trace)
+{
+  irep_converter.write_string_ref(out, goto_trace.mode);
+  write_gb_word(out, goto_trace.steps.size());
+
+  for(const auto &step : goto_trace.steps)
+  {
+    write_gb_word(out, step.step_nr);
+    write_gb_word(out, static_cast<std::size_t>(step.type));
+    write_gb_word(out, step.hidden);
+    write_gb_word(out, step.internal);
+    write_gb_word(out, static_cast<std::size_t>(step.assignment_type));
+    write_gb_word(out, step.pc->location_number);
+    write_gb_word(out, step.thread_nr);
+    write_gb_word(out, step.cond_value);
+    irep_converter.reference_convert(step.cond_expr, out);
+    write_gb_string(out, step.comment);
+    irep_converter.reference_convert(step.lhs_object, out);
+    irep_converter.reference_convert(step.full_lhs, out);
+    irep_converter.reference_convert(step.lhs_object_value, out);
+    irep_converter.reference_convert(step.full_lhs_value, out);
+    irep_converter.write_string_ref(out, step.format_string);
+    irep_converter.write_string_ref(out, step.io_id);
+    write_gb_word(out, step.io_args.size());
+    for(const auto &arg : step.io_args)
+      irep_converter.reference_convert(arg, out);
+    write_gb_word(out, step.formatted);
+    irep_converter.write_string_ref(out, step.identifier);
+  }
+}
+
+static bool read_goto_trace(
+  std::istream &in,
+  irep_serializationt &irep_converter,
+  const location_mapt &location_map,
+  goto_tracet &goto_trace)
+{
+  goto_trace.mode=irep_converter.read_string_ref(in);
+  std::size_t nr_steps=irep_serializationt::read_gb_word(in);
+
+  for(std::size_t i=0; i<nr_steps; i++)
+  {
+    goto_trace.steps.push_back(goto_trace_stept());
+    goto_trace_stept &step=goto_trace.steps.back();
+
+    step.step_nr=irep_serializationt::read_gb_word(in);
+    step.type=
+      static_cast<goto_trace_stept::typet>(
+        irep_serializationt::read_gb_word(in));
+    step.hidden=irep_serializationt::read_gb_word(in)!=0;
+    step.internal=irep_serializationt::read_gb_word(in)!=0;
+    step.assignment_type=
+      static_cast<goto_trace_stept::assignment_typet>(
+        irep_serializationt::read_gb_word(in));
+
+    location_mapt::const_iterator l_it=
+      location_map.find(irep_serializationt::read_gb_word(in));
+    if(l_it==location_map.end())
+      return true;
+    step.pc=l_it->second;
+
+    step.thread_nr=irep_serializationt::read_gb_word(in);
+    step.cond_value=irep_serializationt::read_gb_word(in)!=0;
+    irep_converter.reference_convert(in, step.cond_expr);
+    step.comment=id2string(irep_converter.read_gb_string(in));
+    irep_converter.reference_convert(in, step.lhs_object);
+    irep_converter.reference_convert(in, step.full_lhs);
+    irep_converter.reference_convert(in, step.lhs_object_value);
+    irep_converter.reference_convert(in, step.full_lhs_value);
+    step.format_string=irep_converter.read_string_ref(in);
+    step.io_id=irep_converter.read_string_ref(in);
+    std::size_t nr_io_args=irep_serializationt::read_gb_word(in);
+    for(std::size_t j=0; j<nr_io_args; j++)
+    {
+      step.io_args.push_back(exprt());
+      irep_converter.reference_convert(in, step.io_args.back());
+    }
+    step.formatted=irep_serializationt::read_gb_word(in)!=0;
+    step.identifier=irep_converter.read_string_ref(in);
+  }
+
+  return !in;
+}
+
+/// Split the goals into groups and check each group in a separate worker
+/// process, which converts the equation into its own copy of the solver.
+/// Worker processes are used instead of threads as neither the reference
+/// counts of irept nor the string table are safe for concurrent use.
+/// The results are merged into `goal_map' in a deterministic order.
+/// \param jobs: the number of worker processes
+/// \param [out] iterations: the total number of solver calls made
+/// \return true if any of the workers failed
+bool bmc_all_propertiest::solve_goals_in_jobs(
+  unsigned jobs,
+  unsigned &iterations)
+{
+  iterations=0;
+
+  #ifdef _WIN32
+  warning() << "--jobs is not supported on this platform, "
+            << "checking properties sequentially" << eom;
+
+  goal_groupt goals;
+  for(goal_mapt::iterator it=goal_map.begin(); it!=goal_map.end(); it++)
+    goals.push_back(it);
+
+  decision_proceduret::resultt result=solve_goals(goals, iterations);
+  bool error=result==decision_proceduret::resultt::D_ERROR;
+
+  for(auto &g : goal_map)
+    if(g.second.status==goalt::statust::UNKNOWN)
+      g.second.status=error?goalt::statust::ERROR:goalt::statust::SUCCESS;
+
+  return error;
+  #else
+  if(jobs>goal_map.size())
+    jobs=goal_map.size();
+
+  // distribute the goals round-robin
+  std::vector<goal_groupt> groups(jobs);
+
+  {
+    std::size_t i=0;
+    for(goal_mapt::iterator it=goal_map.begin(); it!=goal_map.end(); it++)
+      groups[(i++)%jobs].push_back(it);
+  }
+
+  status() << "Checking " << goal_map.size() << " properties using "
+           << jobs << " jobs" << eom;
+
+  // make sure no buffered output is duplicated into the workers
+  std::cout.flush();
+  std::cerr.flush();
+
+  std::list<temporary_filet> result_files;
+  std::vector<pid_t> workers(jobs, -1);
+
+  for(unsigned j=0; j<jobs; j++)
+  {
+    result_files.emplace_back("cbmc_job_", ".bin");
+    const std::string result_file=result_files.back()();
+
+    pid_t pid=fork();
+
+    if(pid==0)
+    {
+      // The worker process: stay quiet, solve, write the results for
+      // the goals in our group and exit without running any destructors
+      // of the parent's state.
+      null_message_handlert null_message_handler;
+      set_message_handler(null_message_handler);
+      solver.set_message_handler(null_message_handler);
+      bmc.set_message_handler(null_message_handler);
+
+      try
+      {
+        unsigned job_iterations=0;
+        decision_proceduret::resultt result=
+          solve_goals(groups[j], job_iterations);
+
+        std::ofstream out(result_file, std::ios::binary);
+        irep_serializationt::ireps_containert ireps_container;
+        irep_serializationt irep_converter(ireps_container);
+
+        write_gb_word(out, result==decision_proceduret::resultt::D_ERROR);
+        write_gb_word(out, job_iterations);
+
+        for(const auto &g : groups[j])
+        {
+          const bool is_failure=g->second.status==goalt::statust::FAILURE;
+          write_gb_word(out, is_failure);
+          if(is_failure)
+            write_goto_trace(out, irep_converter, g->second.goto_trace);
+        }
+
+        out.close();
+        _exit(out?0:1);
+      }
+
+      catch(...)
+      {
+        _exit(1);
+      }
+    }
+    else if(pid<0)
+      error() << "failed to start job " << j << eom;
+
+    workers[j]=pid;
+  }
+
+  // map location numbers back to instructions for the traces
+  location_mapt location_map;
+  forall_goto_functions(f_it, goto_functions)
+    forall_goto_program_instructions(i_it, f_it->second.body)
+      location_map[i_it->location_number]=i_it;
+
+  bool failed=false;
+
+  std::list<temporary_filet>::const_iterator file_it=result_files.begin();
+  for(unsigned j=0; j<jobs; j++, file_it++)
+  {
+    bool job_error=true;
+
+    int exit_status=0;
+    if(workers[j]>0)
+    {
+      while(waitpid(workers[j], &exit_status, 0)==-1 && errno==EINTR)
+      {
+      }
+    }
+
+    if(workers[j]>0 &&
+       WIFEXITED(exit_status) &&
+       WEXITSTATUS(exit_status)==0)
+    {
+      std::ifstream in((*file_it)(), std::ios::binary);
+      irep_serializationt::ireps_containert ireps_container;
+      irep_serializationt irep_converter(ireps_container);
+
+      job_error=irep_serializationt::read_gb_word(in)!=0;
+      iterations+=irep_serializationt::read_gb_word(in);
+
+      for(const auto &g : groups[j])
+      {
+        if(!in)
+        {
+          job_error=true;
+          break;
+        }
+
+        if(irep_serializationt::read_gb_word(in)!=0)
+        {
+          g->second.status=goalt::statust::FAILURE;
+          if(read_goto_trace(
+              in, irep_converter, location_map, g->second.goto_trace))
+            job_error=true;
+        }
+      }
+    }
+
+    if(job_error)
+    {
+      error() << "job " << j << " has failed" << eom;
+      failed=true;
+    }
+
+    for(const auto &g : groups[j])
+      if(g->second.status==goalt::statust::UNKNOWN)
+        g->second.status=
+          job_error?goalt::statust::ERROR:goalt::statust::SUCCESS;
+  }
+
+  return failed;
+  #endif
+}
@@ -15,11 +15,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 #include <memory>
 
+#include <util/profiler.h>
 #include <util/string2int.h>
 #include <util/source_location.h>
 #include <util/string_utils.h>
 #include <util/time_stopping.h>
 #include <util/message.h>
+#include <util/simplify_expr_cache.h>
 #include <util/json.h>
 #include <util/cprover_prefix.h>
 
@@ -31,6 +33,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/graphml_witness.h>
 
 #include <goto-symex/build_goto_trace.h>
+#include <goto-symex/preprocess_equation.h>
 #include <goto-symex/slice.h>
 #include <goto-symex/slice_by_trace.h>
 #include <goto-symex/memory_model_sc.h>
@@ -56,7 +59,7 @@ void bmct::freeze_program_variables()
   // this is a hook for cegis
 }
 
-void bmct::error_trace()
+void bmct::error_trace(const prop_convt &prop_conv)
 {
   status() << "Building error trace" << eom;
 
@@ -124,13 +127,15 @@ void bmct::output_graphml(
   }
 }
 
-void bmct::do_conversion()
+void bmct::do_conversion(prop_convt &prop_conv)
 {
   // convert HDL (hook for hw-cbmc)
   do_unwind_module();
 
   status() << "converting SSA" << eom;
 
+  profile_phaset phase("convert");
+
   // convert SSA
   equation.convert(prop_conv);
 
@@ -157,7 +162,7 @@ bmct::run_decision_procedure(prop_convt &prop_conv)
   // stop the time
   absolute_timet sat_start=current_time();
 
-  do_conversion();
+  do_conversion(prop_conv);
 
   status() << "Running " << prop_conv.decision_procedure_text() << eom;
 
@@ -342,6 +347,11 @@ void bmct::setup()
   get_memory_model();
   symex.options=options;
 
+  equation.set_hash_consing(options.get_bool_option("hash-consing"));
+
+  // the symbols are complete by now
+  ns.enable_simplify_cache();
+
   {
     const symbolt *init_symbol;
     if(!ns.lookup(CPROVER_PREFIX "initialize", init_symbol))
@@ -359,8 +369,24 @@ safety_checkert::resultt bmct::execute(const goto_functionst &goto_functions)
 {
   try
   {
+    if(options.get_bool_option("incremental"))
+      return incremental(goto_functions);
+
+    if(!options.get_option("paths").empty())
+      return paths(goto_functions);
+
+    if(options.get_bool_option("stream-ssa"))
+    {
+      prop_conv.set_message_handler(get_message_handler());
+      equation.stream_to(prop_conv);
+    }
+
     // perform symbolic execution
-    symex(goto_functions);
+    {
+      profile_phaset phase("symex");
+      symex(goto_functions);
+      profile_count("SSA steps", equation.SSA_steps.size());
+    }
 
     // add a partial ordering, if required
     if(equation.has_threads())
@@ -373,8 +399,28 @@ safety_checkert::resultt bmct::execute(const goto_functionst &goto_functions)
                << equation.SSA_steps.size()
                << " steps" << eom;
 
+    if(options.get_bool_option("hash-consing"))
+    {
+      statistics() << "size of hash-consing table: "
+                   << equation.get_hash_cons_table().size()
+                   << " nodes" << eom;
+
+      // the steps keep sharing the nodes
+      equation.clear_hash_cons_table();
+    }
+
+    const simplify_expr_cachet *simplify_cache=ns.get_simplify_cache();
+    if(simplify_cache!=nullptr)
+      progress() << "simplifier cache: "
+                 << simplify_cache->get_hits() << " hits, "
+                 << simplify_cache->get_misses() << " misses, "
+                 << simplify_cache->size() << " entries" << eom;
+
     slice();
 
+    if(options.get_bool_option("preprocess-ssa"))
+      preprocess();
+
     // coverage report
     std::string cov_out=options.get_option("symex-coverage-report");
     if(!cov_out.empty() &&
@@ -450,6 +496,8 @@ safety_checkert::resultt bmct::execute(const goto_functionst &goto_functions)
 
 void bmct::slice()
 {
+  profile_phaset phase("slicing");
+
   if(options.get_option("slice-by-trace")!="")
   {
     symex_slice_by_tracet symex_slice_by_trace(ns);
@@ -459,7 +507,12 @@ void bmct::slice()
         equation);
   }
   // any properties to check at all?
-  if(equation.has_threads())
+  if(equation.is_streaming())
+  {
+    // the steps have been converted already
+    statistics() << "no slicing due to streaming" << eom;
+  }
+  else if(equation.has_threads())
   {
     // we should build a thread-aware SSA slicer
     statistics() << "no slicing due to threads" << eom;
@@ -488,6 +541,33 @@ void bmct::slice()
                << symex.total_vccs<<" VCC(s), "
                << symex.remaining_vccs
                << " remaining after simplification" << eom;
+
+  profile_count("ignored SSA steps", equation.count_ignored_SSA_steps());
+}
+
+void bmct::preprocess()
+{
+  profile_phaset phase("preprocessing");
+
+  if(equation.has_threads())
+  {
+    statistics() << "no preprocessing due to threads" << eom;
+    return;
+  }
+
+  const preprocess_equation_statisticst stats=
+    preprocess_equation(equation, ns);
+
+  statistics() << "preprocessing made " << stats.substitutions
+               << " substitution(s), folded " << stats.constants
+               << " expression(s) into constants, and saved "
+               << stats.narrowed_bits+stats.sliced_bits << " bit(s): "
+               << stats.narrowed_bits << " of bounded inputs, "
+               << stats.sliced_bits << " of partially read definitions"
+               << eom;
+
+  profile_count(
+    "preprocessing saved bits", stats.narrowed_bits+stats.sliced_bits);
 }
 
 safety_checkert::resultt bmct::run(
@@ -541,7 +621,7 @@ safety_checkert::resultt bmct::stop_on_fail(
         counterexample_beautificationt()(
           dynamic_cast<bv_cbmct &>(prop_conv), equation, ns);
 
-      error_trace();
+      error_trace(prop_conv);
       output_graphml(resultt::UNSAFE, goto_functions);
     }
 
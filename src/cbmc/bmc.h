@@ -12,8 +12,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_CBMC_BMC_H
 #define CPROVER_CBMC_BMC_H
 
+#include <functional>
 #include <list>
 #include <map>
+#include <memory>
 
 #include <util/options.h>
 #include <util/ui_message.h>
@@ -31,6 +33,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/safety_checker.h>
 #include <goto-symex/memory_model.h>
 
+#include "cbmc_solvers.h"
 #include "symex_bmc.h"
 
 class bmct:public safety_checkert
@@ -62,6 +65,10 @@ public:
   // additional stuff
   expr_listt bmc_constraints;
 
+  /// Supplies a fresh solver for each path but the first in path
+  /// exploration
+  std::function<std::unique_ptr<cbmc_solverst::solvert>()> get_path_solver;
+
   void set_ui(ui_message_handlert::uit _ui) { ui=_ui; }
 
   // the safety_checkert interface
@@ -92,7 +99,7 @@ protected:
   // unwinding
   virtual void setup_unwind();
   virtual void do_unwind_module();
-  void do_conversion();
+  void do_conversion(prop_convt &prop_conv);
 
   virtual void freeze_program_variables();
 
@@ -111,17 +118,24 @@ protected:
   virtual resultt stop_on_fail(
     const goto_functionst &goto_functions,
     prop_convt &solver);
+  virtual resultt incremental(const goto_functionst &goto_functions);
+  resultt check_incremental(const goto_functionst &goto_functions);
+  virtual resultt paths(const goto_functionst &goto_functions);
+  resultt check_path(
+    const goto_functionst &goto_functions,
+    prop_convt &solver);
   virtual void show_program();
   virtual void report_success();
   virtual void report_failure();
 
-  virtual void error_trace();
+  virtual void error_trace(const prop_convt &prop_conv);
   void output_graphml(
     resultt result,
     const goto_functionst &goto_functions);
 
   void get_memory_model();
   void slice();
+  void preprocess();
   void show(const goto_functionst &);
 
   bool cover(
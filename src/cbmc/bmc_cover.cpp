@@ -86,7 +86,7 @@ public:
 
     exprt as_expr() const
     {
-      std::vector<exprt> tmp;
+      exprt::operandst tmp;
 
       for(const auto &goal_inst : instances)
         tmp.push_back(literal_exprt(goal_inst.condition));
@@ -213,7 +213,7 @@ bool bmc_covert::operator()()
 
   // Do conversion to next solver layer
 
-  bmc.do_conversion();
+  bmc.do_conversion(solver);
 
   // get the conditions for these goals from formula
   // collect all 'instances' of the goals
@@ -0,0 +1,223 @@
+/*******************************************************************\
+
+Module: Incremental Bounded Model Checking
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Incremental Bounded Model Checking
+
+#include "bmc.h"
+
+#include <limits>
+
+#include <util/time_stopping.h>
+
+#include "bv_cbmc.h"
+#include "counterexample_beautification.h"
+
+/// Solves under the given assumptions; the SAT back-ends drop all of
+/// them when one is trivially true, hence we leave those out.
+static decision_proceduret::resultt solve_under(
+  prop_convt &prop_conv,
+  const bvt &assumptions)
+{
+  bvt non_trivial;
+
+  for(const auto &l : assumptions)
+    if(!l.is_true())
+      non_trivial.push_back(l);
+
+  prop_conv.set_assumptions(non_trivial);
+
+  return prop_conv.dec_solve();
+}
+
+/// Converts the SSA steps added since the last call, and checks whether any
+/// of the assertions among them can fail. A failure is reported with the
+/// failed properties and, if requested, a trace.
+/// \return UNSAFE if an assertion fails, SAFE if none can, or ERROR
+safety_checkert::resultt bmct::check_incremental(
+  const goto_functionst &goto_functions)
+{
+  status() << "converting SSA" << eom;
+  literalt failure=equation.convert_incremental(prop_conv);
+
+  if(failure.is_false())
+    return resultt::SAFE;
+
+  status() << "Running " << prop_conv.decision_procedure_text() << eom;
+
+  switch(solve_under(prop_conv, bvt(1, failure)))
+  {
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    return resultt::SAFE;
+
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    break;
+
+  default:
+    error() << "decision procedure failed" << eom;
+    return resultt::ERROR;
+  }
+
+  for(const auto &step : equation.SSA_steps)
+  {
+    if(!step.is_assert() ||
+       step.ignore ||
+       !prop_conv.l_get(step.cond_literal).is_false())
+      continue;
+
+    // named as by --all-properties
+    irep_idt property_id;
+
+    if(step.source.pc->is_goto())
+      property_id=
+        id2string(step.source.pc->source_location.get_function())+
+        ".unwind."+std::to_string(step.source.pc->loop_number);
+    else
+      property_id=step.source.pc->source_location.get_property_id();
+
+    result() << "[" << property_id << "] " << step.comment
+             << ": FAILURE" << eom;
+  }
+
+  if(options.get_bool_option("trace"))
+  {
+    if(options.get_bool_option("beautify"))
+      counterexample_beautificationt()(
+        dynamic_cast<bv_cbmct &>(prop_conv), equation, ns);
+
+    error_trace(prop_conv);
+    output_graphml(resultt::UNSAFE, goto_functions);
+  }
+
+  report_failure();
+  return resultt::UNSAFE;
+}
+
+/// Checks the program with increasing unwinding limits, starting at
+/// unwind-min. For each limit, only the SSA steps of the paths that were
+/// paused at the previous limit are added, to the same solver instance,
+/// such that learnt clauses are retained across limits. The properties
+/// and the question whether the program is unwound completely are
+/// checked under assumptions.
+safety_checkert::resultt bmct::incremental(
+  const goto_functionst &goto_functions)
+{
+  if(!prop_conv.has_set_assumptions())
+  {
+    error() << "incremental BMC requires a solver that supports assumptions"
+            << eom;
+    return resultt::ERROR;
+  }
+
+  const unsigned unwind_min=options.get_unsigned_int_option("unwind-min");
+  const unsigned unwind_max=
+    options.get_option("unwind-max").empty()?
+    std::numeric_limits<unsigned>::max():
+    options.get_unsigned_int_option("unwind-max");
+  const bool unwinding_assertions=
+    options.get_bool_option("unwinding-assertions");
+
+  prop_conv.set_message_handler(get_message_handler());
+
+  status() << "Passing problem to "
+           << prop_conv.decision_procedure_text() << eom;
+
+  absolute_timet sat_start=current_time();
+
+  // the 'extra constraints'
+  forall_expr_list(it, bmc_constraints)
+    prop_conv.set_to_true(*it);
+
+  symex.set_incremental(true);
+
+  for(unsigned unwind=unwind_min; ; unwind++)
+  {
+    status() << "Unwinding to depth " << unwind << eom;
+
+    symex.set_unwind_limit(unwind);
+    symex.unwind_incrementally(goto_functions);
+
+    if(equation.has_threads())
+    {
+      error() << "incremental BMC does not support threads" << eom;
+      return resultt::ERROR;
+    }
+
+    statistics() << "size of program expression: "
+                 << equation.SSA_steps.size()
+                 << " steps" << eom;
+
+    const resultt check_result=check_incremental(goto_functions);
+
+    if(check_result!=resultt::SAFE)
+    {
+      status() << "Runtime decision procedure: "
+               << (current_time()-sat_start) << "s" << eom;
+      return check_result;
+    }
+
+    status() << "No property violated up to depth " << unwind << eom;
+
+    // can any path go beyond the current depth?
+    const exprt paused=symex.paused_paths();
+    bool complete=paused.is_false();
+
+    if(!complete && (unwind<unwind_max || unwinding_assertions))
+    {
+      bvt assumptions;
+      assumptions.push_back(equation.get_assumptions_literal());
+      assumptions.push_back(prop_conv.convert(paused));
+
+      switch(solve_under(prop_conv, assumptions))
+      {
+      case decision_proceduret::resultt::D_UNSATISFIABLE:
+        complete=true;
+        break;
+
+      case decision_proceduret::resultt::D_SATISFIABLE:
+        break;
+
+      default:
+        error() << "decision procedure failed" << eom;
+        return resultt::ERROR;
+      }
+    }
+
+    if(!complete && unwind>=unwind_max && unwinding_assertions)
+    {
+      result() << "Unwinding assertion violated at depth " << unwind << eom;
+
+      // the paused paths fail these
+      symex.assert_paused_paths();
+      const resultt check_result=check_incremental(goto_functions);
+
+      status() << "Runtime decision procedure: "
+               << (current_time()-sat_start) << "s" << eom;
+
+      if(check_result!=resultt::SAFE)
+        return check_result;
+
+      error() << "no paused path violates an unwinding assertion" << eom;
+      return resultt::ERROR;
+    }
+
+    if(complete || unwind>=unwind_max)
+    {
+      status() << "Runtime decision procedure: "
+               << (current_time()-sat_start) << "s" << eom;
+
+      if(complete)
+        status() << "Program is completely unwound at depth "
+                 << unwind << eom;
+
+      report_success();
+      output_graphml(resultt::SAFE, goto_functions);
+      return resultt::SAFE;
+    }
+  }
+}
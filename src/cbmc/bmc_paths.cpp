@@ -0,0 +1,162 @@
+/*******************************************************************\
+
+Module: Bounded Model Checking one Path at a Time
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Bounded Model Checking one Path at a Time
+
+#include "bmc.h"
+
+#include <iterator>
+#include <memory>
+
+#include <goto-symex/path_storage.h>
+
+#include "bv_cbmc.h"
+#include "counterexample_beautification.h"
+
+/// Explores the program one path at a time rather than merging the paths
+/// at the joins after branches. Symbolic execution saves the states at
+/// both successors of any branch and ends the current path there. The SSA
+/// steps of the saved paths are kept in segments that are shared between
+/// all paths that continue them, such that saving a path does not copy
+/// its prefix. The strategy given by the option
+/// "paths" decides which saved path is continued next. Each path is
+/// checked with a solver of its own, and exploration stops at the first
+/// path that violates a property.
+safety_checkert::resultt bmct::paths(const goto_functionst &goto_functions)
+{
+  std::unique_ptr<path_storaget> path_storage=
+    get_path_strategy(options.get_option("paths"));
+
+  if(path_storage==nullptr)
+  {
+    error() << "unknown path exploration strategy "
+            << options.get_option("paths") << eom;
+    return resultt::ERROR;
+  }
+
+  PRECONDITION(get_path_solver);
+
+  symex.set_path_exploration(true);
+
+  std::unique_ptr<cbmc_solverst::solvert> path_solver;
+  prop_convt *solver=&prop_conv;
+  std::size_t segment_count=0, path_count=0;
+
+  // the saved segments the current path continues, and their number of
+  // steps at the beginning of the equation
+  path_storaget::segment_ptrt prefix;
+  std::size_t prefix_size=0;
+
+  symex(goto_functions);
+
+  while(true)
+  {
+    segment_count++;
+
+    if(symex.branch_successors.empty())
+      path_count++;
+    else
+    {
+      // The assertions on the way so far are checked along with this
+      // path, and are hence left out of the saved segment.
+      symex_target_equationt::SSA_stepst steps;
+      auto it=std::next(equation.SSA_steps.begin(), prefix_size);
+      for(; it!=equation.SSA_steps.end(); it++)
+        if(!it->is_assert())
+          steps.push_back(*it);
+
+      path_storaget::segment_ptrt segment=
+        std::make_shared<path_storaget::segmentt>(prefix, std::move(steps));
+
+      for(const auto &state : symex.branch_successors)
+        path_storage->push(segment, state);
+
+      symex.branch_successors.clear();
+    }
+
+    status() << "Checking path segment " << segment_count << ", "
+             << path_storage->size() << " paths saved for later" << eom;
+
+    const resultt result=check_path(goto_functions, *solver);
+    if(result!=resultt::SAFE)
+      return result;
+
+    if(path_storage->empty())
+      break;
+
+    std::list<path_storaget::patht> next;
+    path_storage->pop(next);
+    path_storaget::patht &path=next.front();
+
+    equation.SSA_steps.clear();
+    path_storaget::get_SSA_steps(path.prefix, equation.SSA_steps);
+    prefix=std::move(path.prefix);
+    prefix_size=equation.SSA_steps.size();
+    symex.total_vccs=0;
+    symex.remaining_vccs=0;
+
+    path_solver=get_path_solver();
+    solver=&path_solver->prop_conv();
+
+    symex.resume_path(path.state, goto_functions);
+  }
+
+  status() << "Explored " << path_count << " paths" << eom;
+
+  report_success();
+  return resultt::SAFE;
+}
+
+/// Checks the properties along the path in the equation
+/// \return SAFE if there is no violation along the path, UNSAFE after
+///   reporting the violation, ERROR otherwise
+safety_checkert::resultt bmct::check_path(
+  const goto_functionst &goto_functions,
+  prop_convt &solver)
+{
+  // add a partial ordering, if required
+  if(equation.has_threads())
+  {
+    memory_model->set_message_handler(get_message_handler());
+    (*memory_model)(equation);
+  }
+
+  statistics() << "size of program expression: "
+               << equation.SSA_steps.size()
+               << " steps" << eom;
+
+  slice();
+
+  if(symex.remaining_vccs==0)
+    return resultt::SAFE;
+
+  switch(run_decision_procedure(solver))
+  {
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    return resultt::SAFE;
+
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    if(options.get_bool_option("trace"))
+    {
+      if(options.get_bool_option("beautify"))
+        counterexample_beautificationt()(
+          dynamic_cast<bv_cbmct &>(solver), equation, ns);
+
+      error_trace(solver);
+      output_graphml(resultt::UNSAFE, goto_functions);
+    }
+
+    report_failure();
+    return resultt::UNSAFE;
+
+  default:
+    error() << "decision procedure failed" << eom;
+    return resultt::ERROR;
+  }
+}
@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/string2int.h>
 #include <util/config.h>
 #include <util/language.h>
+#include <util/profiler.h>
 #include <util/unicode.h>
 #include <util/memory_info.h>
 #include <util/invariant.h>
@@ -31,8 +32,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/instrument_preconditions.h>
 #include <goto-programs/goto_convert_functions.h>
 #include <goto-programs/goto_inline.h>
+#include <goto-programs/lazy_goto_model.h>
 #include <goto-programs/link_to_library.h>
 #include <goto-programs/loop_ids.h>
+#include <goto-programs/mapped_goto_binary.h>
 #include <goto-programs/mm_io.h>
 #include <goto-programs/read_goto_binary.h>
 #include <goto-programs/remove_function_pointers.h>
@@ -54,6 +57,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-symex/rewrite_union.h>
 #include <goto-symex/adjust_float_expressions.h>
+#include <goto-symex/path_storage.h>
 
 #include <goto-instrument/full_slicer.h>
 #include <goto-instrument/nondet_static.h>
@@ -165,9 +169,107 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
       cmdline.get_value("localize-faults-method"));
   }
 
+  if(cmdline.isset("jobs"))
+  {
+    if(cmdline.isset("localize-faults"))
+    {
+      error() << "--jobs and --localize-faults "
+              << "must not be given together" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    // only the check of all properties runs in jobs
+    if(options.get_bool_option("stop-on-fail") ||
+       cmdline.isset("cover"))
+    {
+      error() << "--jobs must not be given together with --stop-on-fail, "
+              << "--dimacs, --outfile or --cover" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("jobs", cmdline.get_value("jobs"));
+  }
+
   if(cmdline.isset("unwind"))
     options.set_option("unwind", cmdline.get_value("unwind"));
 
+  if(cmdline.isset("incremental"))
+  {
+    if(cmdline.isset("unwind") ||
+       cmdline.isset("cover") ||
+       cmdline.isset("jobs") ||
+       cmdline.isset("portfolio"))
+    {
+      error() << "--incremental must not be given together with "
+              << "--unwind, --cover, --jobs or --portfolio" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("incremental", true);
+
+    if(cmdline.isset("unwind-min"))
+      options.set_option("unwind-min", cmdline.get_value("unwind-min"));
+    else
+      options.set_option("unwind-min", 1);
+
+    if(cmdline.isset("unwind-max"))
+      options.set_option("unwind-max", cmdline.get_value("unwind-max"));
+  }
+
+  if(cmdline.isset("paths"))
+  {
+    if(cmdline.isset("incremental") ||
+       cmdline.isset("cover") ||
+       cmdline.isset("jobs") ||
+       cmdline.isset("localize-faults") ||
+       cmdline.isset("show-vcc") ||
+       cmdline.isset("program-only") ||
+       cmdline.isset("dimacs") ||
+       cmdline.isset("outfile"))
+    {
+      error() << "--paths must not be given together with --incremental, "
+              << "--cover, --jobs, --localize-faults, --show-vcc, "
+              << "--program-only, --dimacs or --outfile" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    if(get_path_strategy(cmdline.get_value("paths"))==nullptr)
+    {
+      error() << "unknown path exploration strategy "
+              << cmdline.get_value("paths")
+              << " -- use one of dfs, bfs, random" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("paths", cmdline.get_value("paths"));
+  }
+
+  if(cmdline.isset("stream-ssa"))
+  {
+    if(cmdline.isset("incremental") ||
+       cmdline.isset("paths") ||
+       cmdline.isset("cover") ||
+       cmdline.isset("jobs") ||
+       cmdline.isset("portfolio") ||
+       cmdline.isset("localize-faults") ||
+       cmdline.isset("show-vcc") ||
+       cmdline.isset("program-only") ||
+       cmdline.isset("slice-formula") ||
+       cmdline.isset("slice-by-trace") ||
+       cmdline.isset("preprocess-ssa") ||
+       cmdline.isset("graphml-witness"))
+    {
+      error() << "--stream-ssa must not be given together with "
+              << "--incremental, --paths, --cover, --jobs, --portfolio, "
+              << "--localize-faults, --show-vcc, --program-only, "
+              << "--slice-formula, --slice-by-trace, --preprocess-ssa or "
+              << "--graphml-witness" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("stream-ssa", true);
+  }
+
   if(cmdline.isset("depth"))
     options.set_option("depth", cmdline.get_value("depth"));
 
@@ -233,6 +335,11 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     "slice-formula",
     cmdline.isset("slice-formula"));
 
+  // simplify the equation at word level before it is converted
+  options.set_option(
+    "preprocess-ssa",
+    cmdline.isset("preprocess-ssa"));
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
@@ -283,7 +390,22 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
       cmdline.get_value("max-node-refinement"));
 
   if(cmdline.isset("aig"))
+  {
+    // the AIG solver has no assumptions, which these need
+    if(cmdline.isset("beautify") ||
+       cmdline.isset("incremental") ||
+       cmdline.isset("localize-faults"))
+    {
+      error() << "--aig must not be given together with "
+              << "--beautify, --incremental or --localize-faults" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
     options.set_option("aig", true);
+  }
+
+  if(cmdline.isset("polarity-aware"))
+    options.set_option("polarity-aware", true);
 
   // SMT Options
   bool version_set=false;
@@ -295,7 +417,7 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     version_set=true;
   }
 
-  if(cmdline.isset("smt2"))
+  if(cmdline.isset("smt2") || cmdline.isset("smt2-interactive"))
   {
     // If both are given, smt2 takes precedence
     options.set_option("smt1", false);
@@ -303,6 +425,18 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     version_set=true;
   }
 
+  if(cmdline.isset("smt2-interactive"))
+  {
+    if(cmdline.isset("outfile"))
+    {
+      error() << "--smt2-interactive must not be given together with "
+              << "--outfile" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("smt2-interactive", true);
+  }
+
   if(cmdline.isset("fpa"))
     options.set_option("fpa", true);
 
@@ -389,6 +523,29 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   else
     options.set_option("sat-preprocessor", true);
 
+  if(cmdline.isset("portfolio"))
+  {
+    // these select a solver of their own, which get_solver() would pick
+    // over the portfolio
+    if(options.get_bool_option("dimacs") ||
+       options.get_bool_option("refine") ||
+       options.get_bool_option("refine-strings") ||
+       options.get_bool_option("smt1") ||
+       options.get_bool_option("smt2") ||
+       options.get_bool_option("aig"))
+    {
+      error() << "--portfolio must not be given together with "
+              << "--dimacs, --refine, --refine-arrays, --refine-arithmetic, "
+              << "--refine-strings, --aig or an SMT solver" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("portfolio", true);
+  }
+
+  if(cmdline.isset("hash-consing"))
+    options.set_option("hash-consing", true);
+
   options.set_option(
     "pretty-names",
     !cmdline.isset("no-pretty-names"));
@@ -569,6 +726,11 @@ int cbmc_parse_optionst::doit()
     get_message_handler(),
     prop_conv);
 
+  bmc.get_path_solver=[&cbmc_solvers]()
+  {
+    return cbmc_solvers.get_solver();
+  };
+
   // do actual BMC
   return do_bmc(bmc);
 }
@@ -616,7 +778,28 @@ int cbmc_parse_optionst::get_goto_program(
 
   try
   {
-    goto_model=initialize_goto_model(cmdline, get_message_handler());
+    if(cmdline.args.size()==1 &&
+       mapped_goto_binaryt::has_index(cmdline.args.front()))
+    {
+      // read the bodies of the functions that the entry point may reach
+      // only, and nothing else
+      lazy_goto_modelt lazy_goto_model(
+        [] (goto_model_functiont &) { },
+        [] (goto_modelt &) { return false; },
+        get_message_handler());
+      lazy_goto_model.initialize(cmdline);
+      lazy_goto_model.load_reachable_functions();
+
+      std::unique_ptr<goto_modelt> reachable_model=
+        lazy_goto_modelt::process_whole_model_and_freeze(
+          std::move(lazy_goto_model));
+      if(reachable_model==nullptr)
+        return CPROVER_EXIT_INTERNAL_ERROR;
+
+      goto_model=std::move(*reachable_model);
+    }
+    else
+      goto_model=initialize_goto_model(cmdline, get_message_handler());
 
     if(cmdline.isset("show-symbol-table"))
     {
@@ -739,41 +922,57 @@ bool cbmc_parse_optionst::process_goto_program(
 {
   try
   {
+    profile_phaset phase("remove_asm");
+
     // Remove inline assembler; this needs to happen before
     // adding the library.
     remove_asm(goto_model);
 
     // add the library
+    phase.next("link_to_library");
     link_to_library(goto_model, get_message_handler());
 
     if(cmdline.isset("string-abstraction"))
+    {
+      phase.next("string_instrumentation");
       string_instrumentation(goto_model, get_message_handler());
+    }
 
     // remove function pointers
     status() << "Removal of function pointers and virtual functions" << eom;
+    phase.next("remove_function_pointers");
     remove_function_pointers(
       get_message_handler(),
       goto_model,
       cmdline.isset("pointer-check"));
     // remove catch and throw (introduces instanceof)
+    phase.next("remove_exceptions");
     remove_exceptions(goto_model);
 
+    phase.next("mm_io");
     mm_io(goto_model);
 
     // instrument library preconditions
+    phase.next("instrument_preconditions");
     instrument_preconditions(goto_model);
 
     // remove returns, gcc vectors, complex
+    phase.next("remove_returns");
     remove_returns(goto_model);
+    phase.next("remove_vector");
     remove_vector(goto_model);
+    phase.next("remove_complex");
     remove_complex(goto_model);
+    phase.next("rewrite_union");
     rewrite_union(goto_model);
 
     // add generic checks
     status() << "Generic Property Instrumentation" << eom;
+    phase.next("goto_check");
     goto_check(options, goto_model);
 
     // checks don't know about adjusted float expressions
+    phase.next("adjust_float_expressions");
     adjust_float_expressions(goto_model);
 
     // ignore default/user-specified initialization
@@ -782,12 +981,14 @@ bool cbmc_parse_optionst::process_goto_program(
     {
       status() << "Adding nondeterministic initialization "
                   "of static/global variables" << eom;
+      phase.next("nondet_static");
       nondet_static(goto_model);
     }
 
     if(cmdline.isset("string-abstraction"))
     {
       status() << "String Abstraction" << eom;
+      phase.next("string_abstraction");
       string_abstraction(
         goto_model,
         get_message_handler());
@@ -795,9 +996,11 @@ bool cbmc_parse_optionst::process_goto_program(
 
     // add failed symbols
     // needs to be done before pointer analysis
+    phase.next("add_failed_symbols");
     add_failed_symbols(goto_model.symbol_table);
 
     // recalculate numbers, etc.
+    phase.next("update");
     goto_model.goto_functions.update();
 
     // add loop ids
@@ -807,16 +1010,19 @@ bool cbmc_parse_optionst::process_goto_program(
     {
       // Entry point will have been set before and function pointers removed
       status() << "Removing unused functions" << eom;
+      phase.next("remove_unused_functions");
       remove_unused_functions(goto_model, get_message_handler());
     }
 
     // remove skips such that trivial GOTOs are deleted and not considered
     // for coverage annotation:
+    phase.next("remove_skip");
     remove_skip(goto_model);
 
     // instrument cover goals
     if(cmdline.isset("cover"))
     {
+      phase.next("instrument_cover_goals");
       if(instrument_cover_goals(options, goto_model, get_message_handler()))
         return true;
     }
@@ -826,12 +1032,14 @@ bool cbmc_parse_optionst::process_goto_program(
     // before using the argument of the "property" option.
     // Do not re-label after using the property slicer because
     // this would cause the property identifiers to change.
+    phase.next("label_properties");
     label_properties(goto_model);
 
     // full slice?
     if(cmdline.isset("full-slice"))
     {
       status() << "Performing a full slice" << eom;
+      phase.next("full_slicer");
       if(cmdline.isset("property"))
         property_slicer(goto_model, cmdline.get_values("property"));
       else
@@ -839,6 +1047,7 @@ bool cbmc_parse_optionst::process_goto_program(
     }
 
     // remove any skips introduced since coverage instrumentation
+    phase.next("remove_skip");
     remove_skip(goto_model);
   }
 
@@ -928,6 +1137,7 @@ void cbmc_parse_optionst::help()
     " --property id                only check one specific property\n"
     " --stop-on-fail               stop analysis once a failed property is detected\n" // NOLINT(*)
     " --trace                      give a counterexample trace for failed properties\n" //NOLINT(*)
+    " --jobs n                     check the properties using n worker processes\n" // NOLINT(*)
     "\n"
     "C/C++ frontend options:\n"
     " -I path                      set include path (C/C++)\n"
@@ -994,17 +1204,34 @@ void cbmc_parse_optionst::help()
     " --unwind nr                  unwind nr times\n"
     " --unwindset L:B,...          unwind loop L with a bound of B\n"
     "                              (use --show-loops to get the loop IDs)\n"
+    " --incremental                check with increasing unwinding depths,\n"
+    "                              reusing the solver across depths\n"
+    " --unwind-min nr              start incremental unwinding at depth nr\n"
+    " --unwind-max nr              stop incremental unwinding at depth nr\n"
+    " --paths strategy             check one path at a time, stopping at the\n"
+    "                              first violation; the strategy (dfs, bfs or\n"
+    "                              random) picks the path to continue next\n"
+    " --stream-ssa                 convert the SSA to the solver while it is\n"
+    "                              generated, which saves memory, but does\n"
+    "                              not slice the SSA\n"
     " --show-vcc                   show the verification conditions\n"
     " --slice-formula              remove assignments unrelated to property\n"
+    " --preprocess-ssa             substitute definitions, fold constants and\n"
+    "                              narrow variables in the SSA; the trace\n"
+    "                              omits the assignments that are inlined\n"
     " --unwinding-assertions       generate unwinding assertions\n"
     " --partial-loops              permit paths with partial loops\n"
     " --no-pretty-names            do not simplify identifiers\n"
+    " --hash-consing               share all structurally equal expressions\n"
     " --graphml-witness filename   write the witness in GraphML format to filename\n" // NOLINT(*)
     "\n"
     "Backend options:\n"
     " --object-bits n              number of bits used for object addresses\n"
     " --dimacs                     generate CNF in DIMACS format\n"
+    " --portfolio                  run all built-in SAT solvers, take the first answer\n" // NOLINT(*)
     " --beautify                   beautify the counterexample (greedy heuristic)\n" // NOLINT(*)
+    " --aig                        optimise the formula as an and-inverter graph\n" // NOLINT(*)
+    " --polarity-aware             encode connectives only in the polarities they are used in\n" // NOLINT(*)
     " --localize-faults            localize faults (experimental)\n"
     " --smt1                       use default SMT1 solver (obsolete)\n"
     " --smt2                       use default SMT2 solver (Z3)\n"
@@ -1013,6 +1240,9 @@ void cbmc_parse_optionst::help()
     " --cvc4                       use CVC4\n"
     " --yices                      use Yices\n"
     " --z3                         use Z3\n"
+    " --smt2-interactive           keep one SMT2 solver process and solve\n"
+    "                              incrementally (Boolector, CVC4, MathSAT,\n"
+    "                              Yices or Z3)\n"
     " --refine                     use refinement procedure (experimental)\n"
     " --refine-strings             use string refinement (experimental)\n"
     " --string-printable           add constraint that strings are printable (experimental)\n" // NOLINT(*)
@@ -1024,6 +1254,7 @@ void cbmc_parse_optionst::help()
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
+    " --profile-json file          write time and memory used per phase to file\n" // NOLINT(*)
     " --xml-ui                     use XML-formatted output\n"
     " --xml-interface              bi-directional XML interface\n"
     " --json-ui                    use JSON-formatted output\n"
@@ -31,6 +31,8 @@ class optionst;
   "(program-only)(preprocess)(slice-by-trace):" \
   OPT_FUNCTIONS \
   "(no-simplify)(unwind):(unwindset):(slice-formula)(full-slice)" \
+  "(preprocess-ssa)" \
+  "(incremental)(unwind-min):(unwind-max):(paths):(stream-ssa)" \
   "(debug-level):(no-propagation)(no-simplify-if)" \
   "(document-subgoals)(outfile):(test-preprocessor)" \
   "D:I:(c89)(c99)(c11)(cpp98)(cpp03)(cpp11)" \
@@ -41,24 +43,26 @@ class optionst;
   "(no-built-in-assertions)" \
   "(xml-ui)(xml-interface)(json-ui)" \
   "(smt1)(smt2)(fpa)(cvc3)(cvc4)(boolector)(yices)(z3)(opensmt)(mathsat)" \
-  "(no-sat-preprocessor)" \
+  "(smt2-interactive)" \
+  "(no-sat-preprocessor)(portfolio)" \
   "(no-pretty-names)(beautify)" \
   "(dimacs)(refine)(max-node-refinement):(refine-arrays)(refine-arithmetic)"\
   "(refine-strings)" \
   "(string-printable)" \
   "(string-max-length):" \
   "(string-max-input-length):" \
-  "(aig)(16)(32)(64)(LP64)(ILP64)(LLP64)(ILP32)(LP32)" \
+  "(aig)(polarity-aware)(16)(32)(64)(LP64)(ILP64)(LLP64)(ILP32)(LP32)" \
   "(little-endian)(big-endian)" \
   OPT_SHOW_GOTO_FUNCTIONS \
   "(show-loops)" \
   "(show-symbol-table)(show-parse-tree)(show-vcc)" \
+  "(hash-consing)" \
   "(show-claims)(claim):(show-properties)" \
   "(drop-unused-functions)" \
-  "(property):(stop-on-fail)(trace)" \
+  "(property):(stop-on-fail)(trace)(jobs):" \
   "(error-label):(verbosity):(no-library)" \
   "(nondet-static)" \
-  "(version)" \
+  "(version)(profile-json):" \
   "(cover):(symex-coverage-report):" \
   "(mm):" \
   "(i386-linux)(i386-macos)(i386-win32)(win32)(winx64)(gcc)" \
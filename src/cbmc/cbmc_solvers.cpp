@@ -19,10 +19,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/make_unique.h>
 
 #include <solvers/sat/satcheck.h>
+#include <solvers/sat/satcheck_portfolio.h>
 #include <solvers/refinement/bv_refinement.h>
 #include <solvers/refinement/string_refinement.h>
 #include <solvers/smt1/smt1_dec.h>
 #include <solvers/smt2/smt2_dec.h>
+#include <solvers/smt2/smt2_interactive_dec.h>
 #include <solvers/cvc/cvc_dec.h>
 #include <solvers/prop/aig_prop.h>
 #include <solvers/sat/dimacs_cnf.h>
@@ -91,18 +93,65 @@ smt2_dect::solvert cbmc_solverst::get_smt2_solver_type() const
 std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_default()
 {
   auto solver=util_make_unique<solvert>();
+  std::unique_ptr<propt> sat;
 
   if(options.get_bool_option("beautify") ||
+     options.get_bool_option("incremental") ||
      !options.get_bool_option("sat-preprocessor")) // no simplifier
   {
-    // simplifier won't work with beautification
-    solver->set_prop(util_make_unique<satcheck_no_simplifiert>());
+    // simplifier won't work with beautification, and would eliminate
+    // variables needed by later depths of incremental BMC
+    sat=util_make_unique<satcheck_no_simplifiert>();
   }
   else // with simplifier
   {
-    solver->set_prop(util_make_unique<satcheckt>());
+    sat=util_make_unique<satcheckt>();
   }
 
+  // optimise the formula as an and-inverter graph before it reaches the
+  // SAT solver
+  if(options.get_bool_option("aig"))
+    solver->set_prop(util_make_unique<aig_prop_solvert>(std::move(sat)));
+  else
+    solver->set_prop(std::move(sat));
+
+  solver->prop().set_message_handler(get_message_handler());
+
+  auto bv_cbmc=util_make_unique<bv_cbmct>(ns, solver->prop());
+
+  if(options.get_option("arrays-uf")=="never")
+    bv_cbmc->unbounded_array=bv_cbmct::unbounded_arrayt::U_NONE;
+  else if(options.get_option("arrays-uf")=="always")
+    bv_cbmc->unbounded_array=bv_cbmct::unbounded_arrayt::U_ALL;
+
+  bv_cbmc->polarity_aware=options.get_bool_option("polarity-aware");
+
+  solver->set_prop_conv(std::move(bv_cbmc));
+
+  return solver;
+}
+
+/// Races all built-in SAT solvers on the CNF obtained from a single
+/// conversion of the equation; the first answer is taken.
+std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_portfolio()
+{
+  auto solver=util_make_unique<solvert>();
+
+  // simplifier won't work with beautification
+  const bool simplifier=
+    !options.get_bool_option("beautify") &&
+    options.get_bool_option("sat-preprocessor");
+
+  std::unique_ptr<satcheck_portfoliot> portfolio=
+    new_satcheck_portfolio(simplifier);
+
+  if(portfolio->size()==0)
+  {
+    error() << "no SAT solvers available for the portfolio" << eom;
+    throw 0;
+  }
+
+  solver->set_prop(std::move(portfolio));
   solver->prop().set_message_handler(get_message_handler());
 
   auto bv_cbmc=util_make_unique<bv_cbmct>(ns, solver->prop());
@@ -112,6 +161,8 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_default()
   else if(options.get_option("arrays-uf")=="always")
     bv_cbmc->unbounded_array=bv_cbmct::unbounded_arrayt::U_ALL;
 
+  bv_cbmc->polarity_aware=options.get_bool_option("polarity-aware");
+
   solver->set_prop_conv(std::move(bv_cbmc));
 
   return solver;
@@ -274,17 +325,40 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_smt2(
       throw 0;
     }
 
-    auto smt2_dec=
-      util_make_unique<smt2_dect>(
-        ns,
-        "cbmc",
-        "Generated by CBMC " CBMC_VERSION,
-        "QF_AUFBV",
-        solver);
+    std::unique_ptr<smt2_dect> smt2_dec;
+
+    if(options.get_bool_option("smt2-interactive"))
+    {
+      if(!smt2_interactive_dect::is_supported(solver))
+      {
+        error() << "the SMT2 solver cannot be run interactively" << eom;
+        throw 0;
+      }
+
+      smt2_dec=
+        util_make_unique<smt2_interactive_dect>(
+          ns,
+          "cbmc",
+          "Generated by CBMC " CBMC_VERSION,
+          "QF_AUFBV",
+          solver);
+    }
+    else
+    {
+      smt2_dec=
+        util_make_unique<smt2_dect>(
+          ns,
+          "cbmc",
+          "Generated by CBMC " CBMC_VERSION,
+          "QF_AUFBV",
+          solver);
+    }
 
     if(options.get_bool_option("fpa"))
       smt2_dec->use_FPA_theory=true;
 
+    smt2_dec->set_message_handler(get_message_handler());
+
     return util_make_unique<solvert>(std::move(smt2_dec));
   }
   else if(filename=="-")
@@ -350,6 +424,7 @@ void cbmc_solverst::no_incremental_check()
 {
   if(options.get_bool_option("all-properties") ||
      options.get_option("cover")!="" ||
+     options.get_bool_option("incremental") ||
      options.get_option("incremental-check")!="")
   {
     error() << "sorry, this solver does not support incremental solving" << eom;
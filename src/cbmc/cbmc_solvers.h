@@ -116,6 +116,8 @@ public:
       return get_smt1(get_smt1_solver_type());
     if(options.get_bool_option("smt2"))
       return get_smt2(get_smt2_solver_type());
+    if(options.get_bool_option("portfolio"))
+      return get_portfolio();
     return get_default();
   }
 
@@ -134,6 +136,7 @@ protected:
   ui_message_handlert::uit ui;
 
   std::unique_ptr<solvert> get_default();
+  std::unique_ptr<solvert> get_portfolio();
   std::unique_ptr<solvert> get_dimacs();
   std::unique_ptr<solvert> get_bv_refinement();
   std::unique_ptr<solvert> get_string_refinement();
@@ -231,6 +231,14 @@ xmlt fault_localizationt::report_xml(irep_idt goal_id)
 
 safety_checkert::resultt fault_localizationt::operator()()
 {
+  // the candidate fault locations are checked under assumptions
+  if(!bmc.prop_conv.has_set_assumptions())
+  {
+    error() << "fault localization requires a solver that supports "
+            << "assumptions" << eom;
+    return safety_checkert::resultt::ERROR;
+  }
+
   if(options.get_bool_option("stop-on-fail"))
     return stop_on_fail();
   else
@@ -248,7 +256,7 @@ fault_localizationt::run_decision_procedure(prop_convt &prop_conv)
   // stop the time
   absolute_timet sat_start=current_time();
 
-  bmc.do_conversion();
+  bmc.do_conversion(prop_conv);
 
   freeze_guards();
 
@@ -282,7 +290,7 @@ safety_checkert::resultt fault_localizationt::stop_on_fail()
         counterexample_beautificationt()(
           dynamic_cast<bv_cbmct &>(bmc.prop_conv), bmc.equation, bmc.ns);
 
-      bmc.error_trace();
+      bmc.error_trace(bmc.prop_conv);
     }
 
     // localize faults
@@ -350,15 +358,14 @@ void fault_localizationt::goal_covered(
   }
 }
 
-void fault_localizationt::report(
-  const cover_goalst &cover_goals)
+void fault_localizationt::report(unsigned iterations)
 {
-  bmc_all_propertiest::report(cover_goals);
+  bmc_all_propertiest::report(iterations);
 
   switch(bmc.ui)
   {
   case ui_message_handlert::uit::PLAIN:
-    if(cover_goals.number_covered()>0)
+    if(number_failed()>0)
     {
       status() << "\n** Most likely fault location:" << eom;
       for(auto &goal_pair : goal_map)
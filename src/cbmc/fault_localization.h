@@ -92,7 +92,7 @@ protected:
   xmlt report_xml(irep_idt goal_id);
 
   // override bmc_all_propertiest
-  virtual void report(const cover_goalst &cover_goals);
+  virtual void report(unsigned iterations);
 
   // override bmc_all_propertiest
   virtual void do_before_solving()
@@ -13,8 +13,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <limits>
 
+#include <util/make_unique.h>
 #include <util/source_location.h>
 #include <util/simplify_expr.h>
+#include <util/std_expr.h>
 
 symex_bmct::symex_bmct(
   message_handlert &mh,
@@ -25,6 +27,8 @@ symex_bmct::symex_bmct(
     record_coverage(false),
     max_unwind(0),
     max_unwind_is_set(false),
+    incremental(false),
+    incremental_started(false),
     symex_coverage(_ns)
 {
 }
@@ -66,6 +70,8 @@ void symex_bmct::symex_step(
   goto_symext::symex_step(goto_functions, state);
 
   if(record_coverage &&
+     // the path ended at a branch without leaving the goto
+     branch_successors.empty() &&
      // avoid an invalid iterator in state.source.pc
      (!cur_pc->is_end_function() ||
       cur_pc->function!=goto_functions.entry_point()))
@@ -165,7 +171,7 @@ bool symex_bmct::get_unwind_recursion(
     l_it=loop_limits.find(id);
     if(l_it!=loop_limits.end())
       this_loop_limit=l_it->second;
-    else if(max_unwind_is_set)
+    else if(max_unwind_is_set && !incremental)
       this_loop_limit=max_unwind;
   }
 
@@ -195,3 +201,244 @@ void symex_bmct::no_body(const irep_idt &identifier)
                   << log.eom;
   }
 }
+
+/// \return true if the loop has a limit of its own, i.e., one that is not
+///   raised by incremental unwinding
+bool symex_bmct::has_loop_limit(const symex_targett::sourcet &source)
+{
+  const irep_idt id=goto_programt::loop_id(*source.pc);
+
+  const loop_limitst &this_thread_limits=
+    thread_loop_limits[source.thread_nr];
+
+  return this_thread_limits.find(id)!=this_thread_limits.end() ||
+         loop_limits.find(id)!=loop_limits.end();
+}
+
+void symex_bmct::loop_bound_exceeded(
+  statet &state,
+  const exprt &guard)
+{
+  if(!incremental || has_loop_limit(state.source))
+  {
+    goto_symext::loop_bound_exceeded(state, guard);
+    return;
+  }
+
+  if(state.threads.size()>1)
+    throw "incremental unwinding does not support threads";
+
+  // keep the path that stays in the loop for later
+  paused_states.emplace_back();
+  statet &paused=paused_states.back();
+  paused.copy_path_from(state);
+  paused.guard.add(guard);
+
+  // the pending merges belong to other paths, which this state continues
+  for(auto &frame : paused.call_stack())
+    frame.goto_state_map.clear();
+
+  exprt negated_cond;
+
+  if(guard.is_true())
+    negated_cond=false_exprt();
+  else
+    negated_cond=not_exprt(guard);
+
+  state.guard.add(negated_cond);
+}
+
+void symex_bmct::symex_end_of_function(statet &state)
+{
+  // pop_frame forgets the L2 counters of the locals
+  if(incremental)
+    record_level2_counts(state);
+
+  goto_symext::symex_end_of_function(state);
+}
+
+void symex_bmct::record_level2_counts(const statet &state)
+{
+  statet::level2t::current_namest::viewt view;
+  state.level2.current_names.get_view(view);
+
+  for(const auto &entry : view)
+  {
+    auto result=as_const(&max_level2)->find(entry.first);
+    if(!result.second)
+      max_level2.insert(entry.first, entry.second, tvt(false));
+    else if(result.first.second<entry.second.second)
+      max_level2.find(entry.first, tvt(true)).first.second=
+        entry.second.second;
+  }
+}
+
+/// Makes sure that a paused state does not reuse any SSA name that was
+/// introduced by paths that were executed after it had been paused.
+void symex_bmct::rename_apart(statet &state)
+{
+  state.l1_history.insert(l1_history.begin(), l1_history.end());
+
+  statet::framet::local_objectst local_objects;
+  for(const auto &frame : state.call_stack())
+    local_objects.insert(
+      frame.local_objects.begin(), frame.local_objects.end());
+
+  statet::level2t::current_namest::viewt max_view;
+  max_level2.get_view(max_view);
+
+  for(const auto &max_entry : max_view)
+  {
+    const ssa_exprt &ssa=max_entry.second.first;
+    const unsigned max_count=max_entry.second.second;
+
+    if(!state.level2.current_names.has_key(max_entry.first))
+    {
+      // not yet known to this path, but possibly declared later on
+      if(ssa.get_level_1().empty() ||
+         local_objects.find(ssa.get_l1_object_identifier())!=
+           local_objects.end())
+        state.level2.current_names.insert(
+          max_entry.first, max_entry.second, tvt(false));
+      continue;
+    }
+
+    const unsigned count=state.level2.current_count(max_entry.first);
+
+    if(count>=max_count)
+      continue;
+
+    std::pair<ssa_exprt, unsigned> &entry=
+      state.level2.current_names.find(max_entry.first, tvt(true)).first;
+
+    // guards are never read after the fact, and propagated
+    // constants are not read from the L2 instance
+    if(ssa.get_object_name()==guard_identifier ||
+       state.propagation.values.has_key(max_entry.first))
+    {
+      entry.second=max_count;
+      continue;
+    }
+
+    ssa_exprt rhs=entry.first;
+    rhs.set_level_2(count);
+
+    entry.second=max_count+1;
+
+    ssa_exprt lhs=entry.first;
+    lhs.set_level_2(max_count+1);
+
+    target.assignment(
+      true_exprt(),
+      lhs, lhs, lhs.get_original_expr(),
+      rhs,
+      state.source,
+      symex_targett::assignment_typet::PHI);
+  }
+}
+
+void symex_bmct::run_incrementally(
+  statet &state,
+  const goto_functionst &goto_functions)
+{
+  if(!dirty)
+    dirty=util_make_unique<dirtyt>(goto_functions);
+  state.dirty=std::move(dirty);
+
+  while(!state.call_stack().empty())
+    symex_threaded_step(state, goto_functions);
+
+  dirty=std::move(state.dirty);
+
+  record_level2_counts(state);
+  l1_history.insert(state.l1_history.begin(), state.l1_history.end());
+}
+
+void symex_bmct::unwind_incrementally(const goto_functionst &goto_functions)
+{
+  PRECONDITION(incremental);
+
+  if(!incremental_started)
+  {
+    incremental_started=true;
+
+    goto_functionst::function_mapt::const_iterator it=
+      goto_functions.function_map.find(goto_functionst::entry_point());
+
+    if(it==goto_functions.function_map.end())
+      throw "the program has no entry point";
+
+    const goto_programt &body=it->second.body;
+    PRECONDITION(!body.instructions.empty());
+
+    statet state;
+    symex_entry_point(
+      state,
+      goto_functions,
+      body.instructions.begin(),
+      prev(body.instructions.end()));
+    dirty=std::move(state.dirty);
+
+    run_incrementally(state, goto_functions);
+    return;
+  }
+
+  std::list<statet> states;
+  states.swap(paused_states);
+
+  for(auto &state : states)
+  {
+    rename_apart(state);
+
+    // take the backwards edge that was not taken before
+    symex_transition(state, state.source.pc->get_target(), true);
+
+    run_incrementally(state, goto_functions);
+  }
+}
+
+exprt symex_bmct::paused_paths() const
+{
+  exprt::operandst guards;
+
+  for(const auto &state : paused_states)
+    guards.push_back(state.guard.as_expr());
+
+  return disjunction(guards);
+}
+
+void symex_bmct::assert_paused_paths()
+{
+  for(const auto &state : paused_states)
+  {
+    exprt cond=false_exprt();
+    state.guard.guard_expr(cond);
+
+    total_vccs++;
+    remaining_vccs++;
+    target.assertion(
+      state.guard.as_expr(),
+      cond,
+      "unwinding assertion loop "+
+        std::to_string(state.source.pc->loop_number),
+      state.source);
+  }
+}
+
+void symex_bmct::resume_path(
+  statet &state,
+  const goto_functionst &goto_functions)
+{
+  PRECONDITION(path_exploration);
+  PRECONDITION(branch_successors.empty());
+
+  if(!dirty)
+    dirty=util_make_unique<dirtyt>(goto_functions);
+  state.dirty=std::move(dirty);
+  state.symex_target=&target;
+
+  while(!state.call_stack().empty() && branch_successors.empty())
+    symex_threaded_step(state, goto_functions);
+
+  dirty=std::move(state.dirty);
+}
@@ -12,8 +12,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_CBMC_SYMEX_BMC_H
 #define CPROVER_CBMC_SYMEX_BMC_H
 
+#include <list>
+#include <memory>
+
 #include <util/message.h>
 
+#include <analyses/dirty.h>
+
 #include <goto-symex/goto_symex.h>
 
 #include "symex_coverage.h"
@@ -62,6 +67,44 @@ public:
 
   bool record_coverage;
 
+  // Incremental unwinding.
+
+  /// Paths that reach the global unwinding limit in a loop are paused
+  /// instead of being cut off, such that unwind_incrementally() can
+  /// continue them once the limit has been raised.
+  void set_incremental(bool value)
+  {
+    incremental=value;
+  }
+
+  /// Symbolically executes the program from the entry point up to the
+  /// current unwinding limit on the first call, and continues all paused
+  /// paths up to the current limit on any later call.
+  void unwind_incrementally(const goto_functionst &goto_functions);
+
+  /// \return the disjunction of the guards of the paths paused at the
+  ///   current unwinding limit, or false if there are none
+  exprt paused_paths() const;
+
+  /// Adds an unwinding assertion for each path paused at the current
+  /// unwinding limit, as symbolic execution without incremental unwinding
+  /// would have at this limit
+  void assert_paused_paths();
+
+  // Path exploration.
+
+  /// Makes symbolic execution end the current path at any branch, saving
+  /// the states at the successors in branch_successors instead of merging
+  /// them later on.
+  void set_path_exploration(bool value)
+  {
+    path_exploration=value;
+  }
+
+  /// Continues a path that was saved at a branch, up to the end of the
+  /// program or the next branch.
+  void resume_path(statet &state, const goto_functionst &goto_functions);
+
 protected:
   // We have
   // 1) a global limit (max_unwind)
@@ -103,6 +146,28 @@ protected:
 
   std::unordered_set<irep_idt, irep_id_hash> body_warnings;
 
+  virtual void loop_bound_exceeded(statet &state, const exprt &guard);
+
+  virtual void symex_end_of_function(statet &state);
+
+  bool has_loop_limit(const symex_targett::sourcet &source);
+  void run_incrementally(statet &state, const goto_functionst &goto_functions);
+  void record_level2_counts(const statet &state);
+  void rename_apart(statet &state);
+
+  bool incremental;
+  bool incremental_started;
+
+  // the paths paused at the current unwinding limit
+  std::list<statet> paused_states;
+
+  // the highest L2 counters and all L1 names used by any path so far,
+  // such that continued paths do not reuse any SSA names
+  statet::level2t::current_namest max_level2;
+  statet::l1_historyt l1_history;
+
+  std::unique_ptr<const dirtyt> dirty;
+
   symex_coveraget symex_coverage;
 };
 
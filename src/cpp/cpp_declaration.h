@@ -23,7 +23,7 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 class cpp_declarationt:public exprt
 {
 public:
-  typedef std::vector<cpp_declaratort> declaratorst;
+  typedef irep_sub_vectort<cpp_declaratort> declaratorst;
 
   cpp_declarationt():exprt(ID_cpp_declaration)
   {
@@ -19,7 +19,7 @@ public:
   {
   }
 
-  typedef std::vector<class cpp_itemt> itemst;
+  typedef irep_sub_vectort<class cpp_itemt> itemst;
 
   const itemst &items() const
   {
@@ -24,7 +24,7 @@ public:
     add("alias").make_nil();
   }
 
-  typedef std::vector<class cpp_itemt> itemst;
+  typedef irep_sub_vectort<class cpp_itemt> itemst;
 
   const itemst &items() const
   {
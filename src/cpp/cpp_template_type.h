@@ -22,7 +22,7 @@ public:
   {
   }
 
-  typedef std::vector<template_parametert> template_parameterst;
+  typedef irep_sub_vectort<template_parametert> template_parameterst;
 
   template_parameterst &template_parameters()
   {
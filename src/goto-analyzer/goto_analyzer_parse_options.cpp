@@ -39,17 +39,21 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/link_to_library.h>
 #include <goto-programs/remove_java_new.h>
 
+#include <analyses/ai_cache.h>
 #include <analyses/is_threaded.h>
 #include <analyses/goto_check.h>
 #include <analyses/local_may_alias.h>
 #include <analyses/constant_propagator.h>
 #include <analyses/dependence_graph.h>
 #include <analyses/interval_domain.h>
+#include <analyses/summary_ai.h>
 
 #include <langapi/mode.h>
 
 #include <util/language.h>
+#include <util/make_unique.h>
 #include <util/options.h>
+#include <util/profiler.h>
 #include <util/config.h>
 #include <util/string2int.h>
 #include <util/unicode.h>
@@ -258,6 +262,14 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("location-sensitive", true);
     else if(cmdline.isset("concurrent"))
       options.set_option("concurrent", true);
+    else if(cmdline.isset("summaries"))
+    {
+      options.set_option("summaries", true);
+      options.set_option(
+        "max-summaries",
+        cmdline.isset("max-summaries")?
+          cmdline.get_value("max-summaries"):"8");
+    }
     else
     {
       // Silently default to location-sensitive as it's the "default"
@@ -265,6 +277,14 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("location-sensitive", true);
     }
 
+    if(cmdline.isset("cache"))
+    {
+      if(options.get_bool_option("summaries"))
+        options.set_option("cache", cmdline.get_value("cache"));
+      else
+        warning() << "--cache requires --summaries, ignoring it" << eom;
+    }
+
     // Domain choice
     if(cmdline.isset("constants"))
     {
@@ -341,6 +361,20 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
     }
 #endif
   }
+  else if(options.get_bool_option("summaries"))
+  {
+    const std::size_t max_summaries=
+      options.get_unsigned_int_option("max-summaries");
+
+    if(options.get_bool_option("constants"))
+    {
+      domain=new summary_ait<constant_propagator_domaint>(max_summaries);
+    }
+    else if(options.get_bool_option("intervals"))
+    {
+      domain=new summary_ait<interval_domaint>(max_summaries);
+    }
+  }
   else if(options.get_bool_option("concurrent"))
   {
 #if 0
@@ -631,10 +665,53 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
     }
 
 
+    // The summaries of the previous run, for the same domain
+    const std::string cache_file=options.get_option("cache");
+    std::unique_ptr<ai_cachet> cache;
+
+    if(!cache_file.empty())
+    {
+      std::string tag=
+        "max-summaries "+options.get_option("max-summaries");
+      for(const char *option : { "constants", "dependence-graph",
+                                 "intervals", "non-null" })
+        if(options.get_bool_option(option))
+          tag+=std::string(" ")+option;
+
+      cache=util_make_unique<ai_cachet>(tag);
+      cache->set_functions(goto_model.goto_functions);
+
+      std::ifstream in(cache_file, std::ios::binary);
+      if(in && cache->read(in))
+        warning() << "ignoring the cache in `" << cache_file
+                  << "', which is for a different analysis" << eom;
+
+      if(analyzer->set_cache(*cache))
+      {
+        warning() << "the analysis does not compute summaries, "
+                  << "ignoring --cache" << eom;
+        cache.reset();
+      }
+    }
+
     // Run
     status() << "Computing abstract states" << eom;
     (*analyzer)(goto_model);
 
+    if(cache)
+    {
+      statistics() << "Reused " << cache->hits << " of "
+                   << cache->hits+cache->misses << " function summaries"
+                   << eom;
+
+      std::ofstream cache_out(cache_file, std::ios::binary);
+      cache->write(cache_out);
+
+      if(!cache_out)
+        warning() << "failed to write the cache to `" << cache_file << "'"
+                  << eom;
+    }
+
     // Perform the task
     status() << "Performing task" << eom;
     bool result = true;
@@ -745,27 +822,36 @@ bool goto_analyzer_parse_optionst::process_goto_program(
     link_to_library(goto_model, ui_message_handler);
     #endif
 
+    profile_phaset phase("remove_java_new");
     remove_java_new(goto_model, get_message_handler());
 
     // remove function pointers
     status() << "Removing function pointers and virtual functions" << eom;
+    phase.next("remove_function_pointers");
     remove_function_pointers(
       get_message_handler(), goto_model, cmdline.isset("pointer-check"));
     // Java virtual functions -> explicit dispatch tables:
+    phase.next("remove_virtual_functions");
     remove_virtual_functions(goto_model);
     // remove Java throw and catch
     // This introduces instanceof, so order is important:
+    phase.next("remove_exceptions");
     remove_exceptions(goto_model);
     // remove rtti
+    phase.next("remove_instanceof");
     remove_instanceof(goto_model);
 
     // do partial inlining
     status() << "Partial Inlining" << eom;
+    phase.next("goto_partial_inline");
     goto_partial_inline(goto_model, ui_message_handler);
 
     // remove returns, gcc vectors, complex
+    phase.next("remove_returns");
     remove_returns(goto_model);
+    phase.next("remove_vector");
     remove_vector(goto_model);
+    phase.next("remove_complex");
     remove_complex(goto_model);
 
     #if 0
@@ -775,6 +861,7 @@ bool goto_analyzer_parse_optionst::process_goto_program(
     #endif
 
     // recalculate numbers, etc.
+    phase.next("update");
     goto_model.goto_functions.update();
 
     // add loop ids
@@ -843,6 +930,17 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --location-sensitive         use location-sensitive abstract interpreter\n"
     " --concurrent                 use concurrency-aware abstract interpreter\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --summaries                  analyse each function once for each state it\n"
+    "                              is called in, and reuse the result\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --max-summaries n            join the states of further calls of a function\n"
+    "                              with n summaries (default: 8)\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --cache file_name            with --summaries, reuse the summaries of\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    "                              unchanged functions in file_name, which is\n"
+    "                              created or updated\n"
     "\n"
     "Domain options:\n"
     " --constants                  constant domain\n"
@@ -909,5 +1007,6 @@ void goto_analyzer_parse_optionst::help()
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
+    " --profile-json file          write time and memory used per phase to file\n" // NOLINT(*)
     "\n";
 }
@@ -128,7 +128,7 @@ class optionst;
   "(show-loops)" \
   "(show-symbol-table)(show-parse-tree)" \
   "(show-properties)(show-reachable-properties)(property):" \
-  "(verbosity):(version)" \
+  "(verbosity):(version)(profile-json):" \
   "(gcc)(arch):" \
   "(taint):(show-taint)" \
   "(show-local-may-alias)" \
@@ -141,7 +141,8 @@ class optionst;
   "(constants)" \
   "(dependence-graph)" \
   "(show)(verify)(simplify):" \
-  "(location-sensitive)(concurrent)" \
+  "(location-sensitive)(concurrent)(summaries)(max-summaries):" \
+  "(cache):" \
   "(no-simplify-slicing)" \
   JAVA_BYTECODE_LANGUAGE_OPTIONS
 
@@ -345,6 +345,10 @@ bool compilet::link()
   statistics() << "Compiling functions" << eom;
   convert_symbols(compiled_functions);
 
+  // link groups of object files in parallel first
+  if(jobs>1 && object_files.size()>jobs && link_in_jobs())
+    return true;
+
   // parse object files
   while(!object_files.empty())
   {
@@ -387,60 +391,90 @@ bool compilet::link()
 /// \return true on error, false otherwise
 bool compilet::compile()
 {
+  if(jobs>1 &&
+     source_files.size()>1 &&
+     mode!=PREPROCESS_ONLY &&
+     std::find(source_files.begin(), source_files.end(), "-")==
+       source_files.end())
+    return compile_in_jobs();
+
   while(!source_files.empty())
   {
     std::string file_name=source_files.front();
     source_files.pop_front();
 
-    // Visual Studio always prints the name of the file it's doing
-    if(echo_file_name)
-      status() << file_name << eom;
-
-    bool r=parse_source(file_name); // don't break the program!
-
-    if(r)
-    {
-      const std::string &debug_outfile=
-        cmdline.get_value("print-rejected-preprocessed-source");
-      if(!debug_outfile.empty())
-      {
-        std::ifstream in(file_name, std::ios::binary);
-        std::ofstream out(debug_outfile, std::ios::binary);
-        out << in.rdbuf();
-        warning() << "Failed sources in " << debug_outfile << eom;
-      }
-
+    if(compile_source(file_name))
       return true; // parser/typecheck error
-    }
 
     if(mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY)
     {
       // output an object file for every source file
+      if(write_source_object_file(object_file_name(file_name)))
+        return true;
+    }
+  }
 
-      // "compile" functions
-      convert_symbols(compiled_functions);
-
-      std::string cfn;
-
-      if(output_file_object=="")
-        cfn=get_base_name(file_name, true)+"."+object_file_extension;
-      else
-        cfn=output_file_object;
+  return false;
+}
 
-      if(write_object_file(cfn, symbol_table, compiled_functions))
-        return true;
+/// parses and typechecks a source file into the symbol table
+/// \return true on error, false otherwise
+bool compilet::compile_source(const std::string &file_name)
+{
+  // Visual Studio always prints the name of the file it's doing
+  if(echo_file_name)
+    status() << file_name << eom;
 
-      if(add_written_cprover_symbols(symbol_table))
-        return true;
+  bool r=parse_source(file_name); // don't break the program!
 
-      symbol_table.clear(); // clean symbol table for next source file.
-      compiled_functions.clear();
+  if(r)
+  {
+    const std::string &debug_outfile=
+      cmdline.get_value("print-rejected-preprocessed-source");
+    if(!debug_outfile.empty())
+    {
+      std::ifstream in(file_name, std::ios::binary);
+      std::ofstream out(debug_outfile, std::ios::binary);
+      out << in.rdbuf();
+      warning() << "Failed sources in " << debug_outfile << eom;
     }
+
+    return true; // parser/typecheck error
   }
 
   return false;
 }
 
+/// \return the name of the object file for the given source file when
+///   compiling only
+std::string compilet::object_file_name(const std::string &file_name) const
+{
+  if(output_file_object=="")
+    return get_base_name(file_name, true)+"."+object_file_extension;
+  else
+    return output_file_object;
+}
+
+/// converts the functions in the symbol table, writes them to the given
+/// object file and clears the symbol table for the next source file
+/// \return true on error, false otherwise
+bool compilet::write_source_object_file(const std::string &file_name)
+{
+  // "compile" functions
+  convert_symbols(compiled_functions);
+
+  if(write_object_file(file_name, symbol_table, compiled_functions))
+    return true;
+
+  if(add_written_cprover_symbols(symbol_table))
+    return true;
+
+  symbol_table.clear(); // clean symbol table for next source file.
+  compiled_functions.clear();
+
+  return false;
+}
+
 /// parses a source file (low-level parsing)
 /// \return true on error, false otherwise
 bool compilet::parse(const std::string &file_name)
@@ -603,7 +637,8 @@ bool compilet::write_bin_object_file(
     return true;
   }
 
-  if(write_goto_binary(outfile, lsymbol_table, functions))
+  if(write_goto_binary(
+       outfile, lsymbol_table, functions, goto_binary_version))
     return true;
 
   unsigned cnt=function_body_count(functions);
@@ -647,6 +682,8 @@ compilet::compilet(cmdlinet &_cmdline, ui_message_handlert &mh, bool Werror):
 {
   mode=COMPILE_LINK_EXECUTABLE;
   echo_file_name=false;
+  jobs=1;
+  goto_binary_version=GOTO_BINARY_VERSION;
   wrote_object=false;
   working_directory=get_current_working_directory();
 }
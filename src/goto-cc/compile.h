@@ -16,6 +16,7 @@ Date: June 2006
 
 #include <util/symbol.h>
 #include <util/rename_symbol.h>
+#include <util/tempfile.h>
 
 #include <langapi/language_ui.h>
 #include <goto-programs/goto_model.h>
@@ -26,6 +27,11 @@ public:
   namespacet ns;
   goto_functionst compiled_functions;
   bool echo_file_name;
+  /// The number of worker processes for compiling source files and for
+  /// linking object files
+  unsigned jobs;
+  /// The format version of the goto binaries that are written
+  int goto_binary_version;
   std::string working_directory;
   std::string override_language;
 
@@ -62,6 +68,7 @@ public:
   bool link();
 
   bool parse_source(const std::string &);
+  bool compile_source(const std::string &);
 
   bool write_object_file(
     const std::string &,
@@ -100,6 +107,15 @@ protected:
 
   void convert_symbols(goto_functionst &dest);
 
+  std::string object_file_name(const std::string &source_file) const;
+  bool write_source_object_file(const std::string &);
+
+  bool compile_in_jobs();
+  bool link_in_jobs();
+
+  /// Object files written by the workers, which are removed on destruction
+  std::list<temporary_filet> tmp_object_files;
+
   bool add_written_cprover_symbols(const symbol_tablet &symbol_table);
   std::map<irep_idt, symbolt> written_macros;
 
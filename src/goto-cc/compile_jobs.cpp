@@ -0,0 +1,280 @@
+/*******************************************************************\
+
+Module: Compile and link source and object files.
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Compiling source files and linking object files in worker processes
+
+#include "compile.h"
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <cerrno>
+#include <sys/wait.h>
+#include <sys/types.h>
+#endif
+
+#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/write_goto_binary.h>
+
+/// Runs task(0), ..., task(n-1), each in a worker process of its own, with
+/// at most `jobs` of them at a time. Worker processes are used instead of
+/// threads as neither the reference counts of irept nor the front-ends'
+/// parsers are safe for concurrent use. The tasks thus communicate their
+/// results through files only. No new tasks are started once one has
+/// failed. On Windows, the tasks are run one after the other in this
+/// process.
+/// \return true if any of the tasks failed
+static bool run_in_jobs(
+  std::size_t n,
+  unsigned jobs,
+  const std::function<bool(std::size_t)> &task,
+  messaget &message)
+{
+  #ifdef _WIN32
+  for(std::size_t i=0; i<n; i++)
+    if(task(i))
+      return true;
+
+  return false;
+  #else
+  std::map<pid_t, std::size_t> running;
+  std::size_t next=0;
+  bool failed=false;
+
+  while((next<n && !failed) || !running.empty())
+  {
+    if(next<n && !failed && running.size()<jobs)
+    {
+      // make sure no buffered output is duplicated into the worker
+      std::cout.flush();
+      std::cerr.flush();
+
+      pid_t pid=fork();
+
+      if(pid==0)
+      {
+        int exit_status=1;
+
+        try
+        {
+          exit_status=task(next)?1:0;
+        }
+
+        catch(const char *e)
+        {
+          message.error() << e << messaget::eom;
+        }
+
+        catch(const std::string &e)
+        {
+          message.error() << e << messaget::eom;
+        }
+
+        catch(...)
+        {
+        }
+
+        // exit without running any destructors of the parent's state
+        std::cout.flush();
+        std::cerr.flush();
+        _exit(exit_status);
+      }
+      else if(pid<0)
+      {
+        message.error() << "failed to start job " << next << messaget::eom;
+        failed=true;
+      }
+      else
+        running[pid]=next;
+
+      next++;
+      continue;
+    }
+
+    int exit_status=0;
+    pid_t pid=waitpid(-1, &exit_status, 0);
+
+    if(pid==-1)
+    {
+      if(errno==EINTR)
+        continue;
+
+      message.error() << "failed to wait for jobs" << messaget::eom;
+      return true;
+    }
+
+    std::map<pid_t, std::size_t>::iterator it=running.find(pid);
+    if(it==running.end())
+      continue;
+
+    if(WIFSIGNALED(exit_status))
+      message.error() << "job " << it->second << " was terminated by signal "
+                      << WTERMSIG(exit_status) << messaget::eom;
+
+    if(!WIFEXITED(exit_status) || WEXITSTATUS(exit_status)!=0)
+      failed=true;
+
+    running.erase(it);
+  }
+
+  return failed;
+  #endif
+}
+
+/// Compiles each source file in a worker process. When compiling only, each
+/// worker writes the object file for its source file, as compile would.
+/// Otherwise, each worker writes a temporary object file, and these are
+/// linked ahead of the given object files, in the order of the source files.
+/// \return true on error, false otherwise
+bool compilet::compile_in_jobs()
+{
+  const std::vector<std::string> files(
+    source_files.begin(), source_files.end());
+  source_files.clear();
+
+  const bool compile_only=mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY;
+
+  statistics() << "Compiling " << files.size() << " source files using "
+               << jobs << " jobs" << eom;
+
+  // the object files, and, when compiling only, the files through which the
+  // workers report the __CPROVER macros they wrote
+  std::vector<std::string> outputs, macro_files;
+  std::list<temporary_filet> macro_tmp_files;
+
+  for(const auto &file_name : files)
+  {
+    if(compile_only)
+    {
+      outputs.push_back(object_file_name(file_name));
+      macro_tmp_files.emplace_back("goto-cc_macros_", ".gb");
+      macro_files.push_back(macro_tmp_files.back()());
+    }
+    else
+    {
+      tmp_object_files.emplace_back(
+        "goto-cc_", "."+object_file_extension);
+      outputs.push_back(tmp_object_files.back()());
+    }
+  }
+
+  const bool failed=run_in_jobs(
+    files.size(),
+    jobs,
+    [&](std::size_t i) -> bool
+    {
+      if(compile_source(files[i]))
+        return true;
+
+      if(!compile_only)
+      {
+        convert_symbols(compiled_functions);
+
+        if(write_object_file(outputs[i], symbol_table, compiled_functions))
+          return true;
+
+        symbol_table.clear();
+        compiled_functions.clear();
+        return false;
+      }
+
+      written_macros.clear();
+
+      if(write_source_object_file(outputs[i]))
+        return true;
+
+      symbol_tablet macros;
+      for(const auto &pair : written_macros)
+        macros.add(pair.second);
+
+      std::ofstream out(macro_files[i], std::ios::binary);
+      return write_goto_binary(out, macros, goto_functionst()) || !out;
+    },
+    *this);
+
+  if(failed)
+    return true;
+
+  if(compile_only)
+  {
+    for(const auto &file_name : macro_files)
+    {
+      symbol_tablet macros;
+      goto_functionst functions;
+
+      if(read_goto_binary(
+           file_name, macros, functions, get_message_handler()) ||
+         add_written_cprover_symbols(macros))
+        return true;
+    }
+
+    wrote_object=true;
+  }
+  else
+    object_files.insert(object_files.begin(), outputs.begin(), outputs.end());
+
+  return false;
+}
+
+/// Splits the object files into as many contiguous groups as there are jobs
+/// and links each group into a temporary object file in a worker process,
+/// which then replace the object files. As the declarations that the object
+/// files share are merged in the workers, the final, sequential linking step
+/// has much less to read and to merge. The groups are contiguous and are
+/// kept in order, hence the result does not depend on the timing of the
+/// workers.
+/// \return true on error, false otherwise
+bool compilet::link_in_jobs()
+{
+  const std::vector<std::string> files(
+    object_files.begin(), object_files.end());
+
+  std::vector<std::string> outputs;
+  std::vector<std::size_t> group_begin;
+
+  for(std::size_t j=0; j<jobs; j++)
+  {
+    group_begin.push_back(j*files.size()/jobs);
+    tmp_object_files.emplace_back("goto-cc_", "."+object_file_extension);
+    outputs.push_back(tmp_object_files.back()());
+  }
+
+  group_begin.push_back(files.size());
+
+  statistics() << "Linking " << files.size() << " object files in "
+               << jobs << " groups" << eom;
+
+  const bool failed=run_in_jobs(
+    jobs,
+    jobs,
+    [&](std::size_t j) -> bool
+    {
+      goto_modelt goto_model;
+
+      for(std::size_t i=group_begin[j]; i<group_begin[j+1]; i++)
+        if(read_object_and_link(files[i], goto_model, get_message_handler()))
+          return true;
+
+      std::ofstream out(outputs[j], std::ios::binary);
+      return write_goto_binary(out, goto_model) || !out;
+    },
+    *this);
+
+  if(failed)
+    return true;
+
+  object_files.assign(outputs.begin(), outputs.end());
+
+  return false;
+}
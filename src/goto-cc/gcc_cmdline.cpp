@@ -29,6 +29,8 @@ const char *goto_cc_options_with_separated_argument[]=
   "--native-compiler",
   "--native-linker",
   "--print-rejected-preprocessed-source",
+  "--jobs",
+  "--goto-binary-version",
   nullptr
 };
 
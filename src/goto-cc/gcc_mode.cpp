@@ -411,6 +411,22 @@ int gcc_modet::doit()
       debug() << "GCC mode" << eom;
   }
 
+  if(cmdline.isset("jobs"))
+    compiler.jobs=std::max(
+      1u, unsafe_string2unsigned(cmdline.get_value("jobs")));
+
+  if(cmdline.isset("goto-binary-version"))
+  {
+    compiler.goto_binary_version=
+      unsafe_string2int(cmdline.get_value("goto-binary-version"));
+
+    if(compiler.goto_binary_version!=3 && compiler.goto_binary_version!=4)
+    {
+      error() << "goto binary version must be 3 or 4" << eom;
+      return EX_USAGE;
+    }
+  }
+
   // determine actions to be undertaken
   if(act_as_ld)
     compiler.mode=compilet::LINK_LIBRARY;
@@ -64,6 +64,9 @@ void goto_cc_modet::help()
   " --native-assembler cmd      command to invoke as assembler (goto-as only)\n"
   " --print-rejected-preprocessed-source file\n"
   "                             copy failing (preprocessed) source to file\n"
+  " --jobs n                    compile and link using n worker processes\n"
+  " --goto-binary-version n     write goto binaries of format version n;\n"
+  "                             version 4 can be loaded lazily by cbmc\n"
   "\n";
 }
 
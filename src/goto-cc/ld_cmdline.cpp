@@ -24,6 +24,8 @@ const char *goto_ld_options_with_argument[]=
   "--verbosity",
   "--native-compiler",
   "--native-linker",
+  "--jobs",
+  "--goto-binary-version",
   nullptr
 };
 
@@ -18,6 +18,7 @@ Date: December 2012
 
 #include <util/prefix.h>
 #include <util/file_util.h>
+#include <util/irep_memory_statistics.h>
 
 #include <goto-programs/cfg.h>
 
@@ -141,3 +142,23 @@ void print_path_lengths(const goto_modelt &goto_model)
       ++n_reachable;
   std::cout << "Reachable instructions: " << n_reachable << "\n";
 }
+
+void print_irep_memory(const goto_modelt &goto_model)
+{
+  irep_memory_statisticst irep_memory_statistics;
+
+  for(const auto &symbol_pair : goto_model.symbol_table.symbols)
+  {
+    irep_memory_statistics(symbol_pair.second.type);
+    irep_memory_statistics(symbol_pair.second.value);
+  }
+
+  forall_goto_functions(f_it, goto_model.goto_functions)
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      irep_memory_statistics(i_it->code);
+      irep_memory_statistics(i_it->guard);
+    }
+
+  irep_memory_statistics.output(std::cout);
+}
@@ -19,5 +19,6 @@ Date: December 2012
 void count_eloc(const goto_modelt &);
 void list_eloc(const goto_modelt &);
 void print_path_lengths(const goto_modelt &);
+void print_irep_memory(const goto_modelt &);
 
 #endif // CPROVER_GOTO_INSTRUMENT_COUNT_ELOC_H
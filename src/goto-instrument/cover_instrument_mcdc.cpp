@@ -18,13 +18,13 @@ Author: Daniel Kroening
 /// To recursively collect controlling exprs for for mcdc coverage.
 void collect_mcdc_controlling_rec(
   const exprt &src,
-  const std::vector<exprt> &conditions,
+  const exprt::operandst &conditions,
   std::set<exprt> &result)
 {
   // src is conjunction (ID_and) or disjunction (ID_or)
   if(src.id() == ID_and || src.id() == ID_or)
   {
-    std::vector<exprt> operands;
+    exprt::operandst operands;
     collect_operands(src, operands);
 
     if(operands.size() == 1)
@@ -42,7 +42,7 @@ void collect_mcdc_controlling_rec(
         {
           if(src.id() == ID_or)
           {
-            std::vector<exprt> others1, others2;
+            exprt::operandst others1, others2;
             if(!conditions.empty())
             {
               others1.push_back(conjunction(conditions));
@@ -63,10 +63,10 @@ void collect_mcdc_controlling_rec(
             continue;
           }
 
-          std::vector<exprt> o = operands;
+          exprt::operandst o = operands;
 
           // 'o[i]' needs to be true and false
-          std::vector<exprt> new_conditions = conditions;
+          exprt::operandst new_conditions = conditions;
           new_conditions.push_back(conjunction(o));
           result.insert(conjunction(new_conditions));
 
@@ -76,7 +76,7 @@ void collect_mcdc_controlling_rec(
         }
         else
         {
-          std::vector<exprt> others;
+          exprt::operandst others;
           others.reserve(operands.size() - 1);
 
           for(std::size_t j = 0; j < operands.size(); j++)
@@ -89,7 +89,7 @@ void collect_mcdc_controlling_rec(
             }
 
           exprt c = conjunction(others);
-          std::vector<exprt> new_conditions = conditions;
+          exprt::operandst new_conditions = conditions;
           new_conditions.push_back(c);
 
           collect_mcdc_controlling_rec(op, new_conditions, result);
@@ -105,12 +105,12 @@ void collect_mcdc_controlling_rec(
     else
     {
       // to store a copy of ''src''
-      std::vector<exprt> new_conditions1 = conditions;
+      exprt::operandst new_conditions1 = conditions;
       new_conditions1.push_back(src);
       result.insert(conjunction(new_conditions1));
 
       // to store a copy of its negation, i.e., ''e''
-      std::vector<exprt> new_conditions2 = conditions;
+      exprt::operandst new_conditions2 = conditions;
       new_conditions2.push_back(e);
       result.insert(conjunction(new_conditions2));
     }
@@ -139,13 +139,13 @@ std::set<exprt> collect_mcdc_controlling(const std::set<exprt> &decisions)
 /// ''replacement_exprs''.
 std::set<exprt> replacement_conjunction(
   const std::set<exprt> &replacement_exprs,
-  const std::vector<exprt> &operands,
+  const exprt::operandst &operands,
   const std::size_t i)
 {
   std::set<exprt> result;
   for(auto &y : replacement_exprs)
   {
-    std::vector<exprt> others;
+    exprt::operandst others;
     for(std::size_t j = 0; j < operands.size(); j++)
       if(i != j)
         others.push_back(operands[j]);
@@ -195,7 +195,7 @@ collect_mcdc_controlling_nested(const std::set<exprt> &decisions)
         }
         // otherwise, we apply the ''nested'' method to
         // each of its operands
-        std::vector<exprt> operands;
+        exprt::operandst operands;
         collect_operands(x, operands);
 
         for(std::size_t i = 0; i < operands.size(); i++)
@@ -281,7 +281,7 @@ std::set<signed> sign_of_expr(const exprt &e, const exprt &E)
   /**
    * In the general case, we analyze each operand of ''E''.
    **/
-  std::vector<exprt> ops;
+  exprt::operandst ops;
   collect_operands(E, ops);
   for(auto &x : ops)
   {
@@ -401,7 +401,7 @@ void remove_repetition(std::set<exprt> &exprs)
 /// To evaluate the value of expr ''src'', according to the atomic expr values
 bool eval_expr(const std::map<exprt, signed> &atomic_exprs, const exprt &src)
 {
-  std::vector<exprt> operands;
+  exprt::operandst operands;
   collect_operands(src, operands);
   // src is AND
   if(src.id() == ID_and)
@@ -66,7 +66,7 @@ std::set<exprt> collect_conditions(const goto_programt::const_targett t)
   return std::set<exprt>();
 }
 
-void collect_operands(const exprt &src, std::vector<exprt> &dest)
+void collect_operands(const exprt &src, exprt::operandst &dest)
 {
   for(const exprt &op : src.operands())
   {
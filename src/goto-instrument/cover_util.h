@@ -22,7 +22,7 @@ std::set<exprt> collect_conditions(const exprt &src);
 
 std::set<exprt> collect_conditions(const goto_programt::const_targett t);
 
-void collect_operands(const exprt &src, std::vector<exprt> &dest);
+void collect_operands(const exprt &src, exprt::operandst &dest);
 
 void collect_decisions_rec(const exprt &src, std::set<exprt> &dest);
 
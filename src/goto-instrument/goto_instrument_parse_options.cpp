@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/string2int.h>
 #include <util/unicode.h>
 #include <util/json.h>
+#include <util/profiler.h>
 #include <util/exit_codes.h>
 
 #include <goto-programs/class_hierarchy.h>
@@ -135,9 +136,15 @@ int goto_instrument_parse_optionst::doit()
   {
     register_languages();
 
-    get_goto_program();
+    {
+      profile_phaset phase("reading goto binary");
+      get_goto_program();
+    }
 
-    instrument_goto_program();
+    {
+      profile_phaset phase("instrumentation");
+      instrument_goto_program();
+    }
 
     {
       bool unwind=cmdline.isset("unwind");
@@ -509,6 +516,12 @@ int goto_instrument_parse_optionst::doit()
       return CPROVER_EXIT_SUCCESS;
     }
 
+    if(cmdline.isset("print-irep-memory"))
+    {
+      print_irep_memory(goto_model);
+      return CPROVER_EXIT_SUCCESS;
+    }
+
     if(cmdline.isset("list-symbols"))
     {
       show_symbol_table_brief(goto_model, get_ui());
@@ -1489,6 +1502,8 @@ void goto_instrument_parse_optionst::help()
     " --list-calls-args            list all function calls with their arguments\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --print-path-lengths         print statistics about control-flow graph paths\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --print-irep-memory          print statistics about the memory used by ireps\n"
     " --call-graph                 show graph of function calls\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --reachable-call-graph       show graph of function calls potentially reachable from main function\n"
@@ -1566,6 +1581,7 @@ void goto_instrument_parse_optionst::help()
     " --use-all-headers            with --dump-c/--dump-cpp: generate C source with all includes\n" // NOLINT(*)
     " --harness                    with --dump-c/--dump-cpp: include input generator in output\n" // NOLINT(*)
     " --version                    show version and exit\n"
+    " --profile-json file          write time and memory used per phase to file\n" // NOLINT(*)
     " --xml-ui                     use XML-formatted output\n"
     " --json-ui                    use JSON-formatted output\n"
     "\n";
@@ -69,6 +69,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(show-natural-loops)(accelerate)(havoc-loops)" \
   "(error-label):(string-abstraction)" \
   "(verbosity):(version)(xml-ui)(json-ui)(show-loops)" \
+  "(profile-json):" \
   "(accelerate)(constant-propagator)" \
   "(k-induction):(step-case)(base-case)" \
   "(show-call-sequences)(check-call-sequence)" \
@@ -77,6 +78,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(z3)(add-library)(show-dependence-graph)" \
   "(horn)(skip-loops):(apply-code-contracts)(model-argc-argv):" \
   "(show-threaded)(list-calls-args)(print-path-lengths)" \
+  "(print-irep-memory)" \
   "(undefined-function-is-assume-false)" \
   "(remove-function-body):"\
   "(splice-call):" \
@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/language.h>
 #include <util/config.h>
+#include <util/profiler.h>
 #include <util/unicode.h>
 
 #include <langapi/mode.h>
@@ -57,6 +58,8 @@ goto_modelt initialize_goto_model(
 
   if(!sources.empty())
   {
+    profile_phaset phase("parsing");
+
     for(const auto &filename : sources)
     {
       #ifdef _MSC_VER
@@ -99,6 +102,8 @@ goto_modelt initialize_goto_model(
       lf.get_modules();
     }
 
+    phase.next("typecheck");
+
     msg.status() << "Converting" << messaget::eom;
 
     if(language_files.typecheck(goto_model.symbol_table))
@@ -110,6 +115,8 @@ goto_modelt initialize_goto_model(
 
   for(const auto &file : binaries)
   {
+    profile_phaset phase("reading goto binary");
+
     msg.status() << "Reading GOTO program from file" << messaget::eom;
 
     if(read_object_and_link(file, goto_model, message_handler))
@@ -162,10 +169,16 @@ goto_modelt initialize_goto_model(
 
   msg.status() << "Generating GOTO Program" << messaget::eom;
 
-  goto_convert(
-    goto_model.symbol_table,
-    goto_model.goto_functions,
-    message_handler);
+  {
+    profile_phaset phase("goto conversion");
+
+    goto_convert(
+      goto_model.symbol_table,
+      goto_model.goto_functions,
+      message_handler);
+
+    profile_count("functions", goto_model.goto_functions.function_map.size());
+  }
 
   // stupid hack
   config.set_object_bits_from_symbol_table(
@@ -50,6 +50,12 @@ public:
   typedef
   std::function<void(goto_functionst::goto_functiont &function)>
     post_process_functiont;
+  /// Fills in the body of the given function from some other source than
+  /// the language front-ends, e.g., a goto binary, and returns true, or
+  /// returns false if that source does not have a body for the function
+  typedef std::function<
+    bool(const irep_idt &name, goto_functionst::goto_functiont &function)>
+    read_function_bodyt;
 
 private:
   typedef std::map<key_type, goto_function_templatet<bodyt>> underlying_mapt;
@@ -66,6 +72,7 @@ private:
   // recreate it for each conversion, but it's easier just to store it mutable.
   mutable goto_convert_functionst convert_functions;
   const post_process_functiont post_process_function;
+  const read_function_bodyt read_function_body;
 
 public:
   /// Creates a lazy_goto_functions_mapt.
@@ -74,12 +81,14 @@ public:
     language_filest &language_files,
     symbol_tablet &symbol_table,
     post_process_functiont post_process_function,
+    read_function_bodyt read_function_body,
     message_handlert &message_handler)
   : goto_functions(goto_functions),
     language_files(language_files),
     symbol_table(symbol_table),
     convert_functions(symbol_table, message_handler),
-    post_process_function(std::move(post_process_function))
+    post_process_function(std::move(post_process_function)),
+    read_function_body(std::move(read_function_body))
   {
   }
 
@@ -130,11 +139,19 @@ private:
     typename underlying_mapt::iterator it=goto_functions.find(name);
     if(it!=goto_functions.end())
       return *it;
+    goto_functionst::goto_functiont function;
+    // Take the body from elsewhere if we can
+    const symbolt *symbol=symbol_table.lookup(name);
+    if(symbol!=nullptr && symbol->type.id()==ID_code)
+    {
+      function.type=to_code_type(symbol->type);
+      if(read_function_body(name, function))
+        return *goto_functions.emplace(name, std::move(function)).first;
+    }
     // Fill in symbol table entry body if not already done
     // If this returns false then it's a stub
     language_files.convert_lazy_method(name, symbol_table);
     // Create goto_functiont
-    goto_functionst::goto_functiont function;
     convert_functions.convert_function(name, function);
     // Add to map
     return *goto_functions.emplace(name, std::move(function)).first;
@@ -11,11 +11,15 @@
 
 #include <util/cmdline.h>
 #include <util/config.h>
+#include <util/find_symbols.h>
 #include <util/journalling_symbol_table.h>
 #include <util/language.h>
+#include <util/profiler.h>
+#include <util/std_code.h>
 #include <util/unicode.h>
 
 #include <fstream>
+#include <unordered_set>
 
 //! @cond Doxygen_suppress_Lambda_in_initializer_list
 lazy_goto_modelt::lazy_goto_modelt(
@@ -33,6 +37,13 @@ lazy_goto_modelt::lazy_goto_modelt(
         goto_model_functiont model_function(*goto_model, function);
         this->post_process_function(model_function);
       },
+      [this] (
+        const irep_idt &name,
+        goto_functionst::goto_functiont &function) -> bool
+      {
+        return goto_binary!=nullptr &&
+               !goto_binary->read_function_body(name, function);
+      },
       message_handler),
     post_process_function(std::move(post_process_function)),
     post_process_functions(std::move(post_process_functions)),
@@ -43,6 +54,7 @@ lazy_goto_modelt::lazy_goto_modelt(
 
 lazy_goto_modelt::lazy_goto_modelt(lazy_goto_modelt &&other)
   : goto_model(std::move(other.goto_model)),
+    goto_binary(std::move(other.goto_binary)),
     symbol_table(goto_model->symbol_table),
     goto_functions(
       goto_model->goto_functions.function_map,
@@ -53,6 +65,13 @@ lazy_goto_modelt::lazy_goto_modelt(lazy_goto_modelt &&other)
         goto_model_functiont model_function(*goto_model, function);
         this->post_process_function(model_function);
       },
+      [this] (
+        const irep_idt &name,
+        goto_functionst::goto_functiont &function) -> bool
+      {
+        return goto_binary!=nullptr &&
+               !goto_binary->read_function_body(name, function);
+      },
       other.message_handler),
     language_files(std::move(other.language_files)),
     post_process_function(std::move(other.post_process_function)),
@@ -87,6 +106,8 @@ void lazy_goto_modelt::initialize(const cmdlinet &cmdline)
 
   if(!sources.empty())
   {
+    profile_phaset phase("parsing");
+
     for(const auto &filename : sources)
     {
 #ifdef _MSC_VER
@@ -129,6 +150,8 @@ void lazy_goto_modelt::initialize(const cmdlinet &cmdline)
       lf.get_modules();
     }
 
+    phase.next("typecheck");
+
     msg.status() << "Converting" << messaget::eom;
 
     if(language_files.typecheck(symbol_table))
@@ -138,12 +161,36 @@ void lazy_goto_modelt::initialize(const cmdlinet &cmdline)
     }
   }
 
-  for(const std::string &file : binaries)
+  if(sources.empty() &&
+     binaries.size()==1 &&
+     mapped_goto_binaryt::has_index(binaries.front()))
   {
+    // There is nothing to link with, hence we read the symbols now
+    // and the function bodies when they are first requested.
+    profile_phaset phase("reading goto binary");
+
     msg.status() << "Reading GOTO program from file" << messaget::eom;
 
-    if(read_object_and_link(file, *goto_model, message_handler))
+    goto_binary=std::unique_ptr<mapped_goto_binaryt>(
+      new mapped_goto_binaryt());
+
+    if(goto_binary->open(binaries.front(), message_handler))
       throw 0;
+
+    goto_binary->read_symbols(symbol_table);
+    config.set_from_symbol_table(symbol_table);
+  }
+  else
+  {
+    for(const std::string &file : binaries)
+    {
+      profile_phaset phase("reading goto binary");
+
+      msg.status() << "Reading GOTO program from file" << messaget::eom;
+
+      if(read_object_and_link(file, *goto_model, message_handler))
+        throw 0;
+    }
   }
 
   bool binaries_provided_start =
@@ -189,6 +236,9 @@ void lazy_goto_modelt::initialize(const cmdlinet &cmdline)
 /// Eagerly loads all functions from the symbol table.
 void lazy_goto_modelt::load_all_functions() const
 {
+  // this includes the transformations done per function
+  profile_phaset phase("goto conversion");
+
   symbol_tablet::symbolst::size_type table_size;
   symbol_tablet::symbolst::size_type new_table_size=symbol_table.symbols.size();
   do
@@ -213,6 +263,93 @@ void lazy_goto_modelt::load_all_functions() const
   } while(new_table_size!=table_size);
 
   goto_model->goto_functions.compute_location_numbers();
+
+  profile_count("functions", goto_model->goto_functions.function_map.size());
+}
+
+/// Loads the entry point and, transitively, every function that is referred
+/// to by a loaded function or by the value of a symbol. The latter covers
+/// the functions whose address is stored in the initial value of a variable.
+/// A call with a component name, i.e., a virtual call, may reach a method of
+/// that name in any class; hence all of them are loaded. The functions that
+/// are not reached are not loaded, which saves reading their bodies when the
+/// program is a goto binary with an index.
+void lazy_goto_modelt::load_reachable_functions() const
+{
+  profile_phaset phase("goto conversion");
+
+  std::vector<irep_idt> worklist;
+  find_symbols_sett seen;
+  std::unordered_set<irep_idt, irep_id_hash> component_names;
+
+  auto reach=[this, &worklist, &seen](const find_symbols_sett &identifiers)
+  {
+    for(const irep_idt &identifier : identifiers)
+    {
+      const symbolt *symbol=symbol_table.lookup(identifier);
+      if(symbol!=nullptr &&
+         symbol->is_function() &&
+         seen.insert(identifier).second)
+        worklist.push_back(identifier);
+    }
+  };
+
+  reach({ goto_functionst::entry_point() });
+
+  for(const auto &named_symbol : symbol_table.symbols)
+  {
+    if(!named_symbol.second.is_function())
+    {
+      find_symbols_sett identifiers;
+      find_symbols(named_symbol.second.value, identifiers);
+      reach(identifiers);
+    }
+  }
+
+  while(!worklist.empty())
+  {
+    const irep_idt name=worklist.back();
+    worklist.pop_back();
+
+    find_symbols_sett identifiers;
+    bool new_component_name=false;
+
+    for(const auto &instruction : goto_functions.at(name).body.instructions)
+    {
+      find_symbols(instruction.code, identifiers);
+      find_symbols(instruction.guard, identifiers);
+
+      if(instruction.is_function_call())
+      {
+        const irep_idt &component_name=
+          to_code_function_call(instruction.code).function().get(
+            ID_component_name);
+
+        if(!component_name.empty() &&
+           component_names.insert(component_name).second)
+          new_component_name=true;
+      }
+    }
+
+    if(new_component_name)
+    {
+      for(const auto &named_symbol : symbol_table.symbols)
+      {
+        const std::string &identifier=id2string(named_symbol.first);
+        const std::size_t dot=identifier.rfind('.');
+
+        if(dot!=std::string::npos &&
+           component_names.count(identifier.substr(dot+1))!=0)
+          identifiers.insert(named_symbol.first);
+      }
+    }
+
+    reach(identifiers);
+  }
+
+  goto_model->goto_functions.compute_location_numbers();
+
+  profile_count("functions", goto_model->goto_functions.function_map.size());
 }
 
 bool lazy_goto_modelt::finalize()
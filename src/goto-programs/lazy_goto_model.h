@@ -11,6 +11,7 @@
 #include "goto_model.h"
 #include "lazy_goto_functions_map.h"
 #include "goto_convert_functions.h"
+#include "mapped_goto_binary.h"
 
 class cmdlinet;
 class optionst;
@@ -33,6 +34,7 @@ public:
   lazy_goto_modelt &operator=(lazy_goto_modelt &&other)
   {
     goto_model = std::move(other.goto_model);
+    goto_binary = std::move(other.goto_binary);
     language_files = std::move(other.language_files);
     return *this;
   }
@@ -67,6 +69,9 @@ public:
   /// Eagerly loads all functions from the symbol table.
   void load_all_functions() const;
 
+  /// Loads the entry point and the functions that it may reach.
+  void load_reachable_functions() const;
+
   void unload(const irep_idt &name) const { goto_functions.unload(name); }
 
   language_filet &add_language_file(const std::string &filename)
@@ -90,6 +95,9 @@ public:
 
 private:
   std::unique_ptr<goto_modelt> goto_model;
+  /// The goto binary whose function bodies are read on demand, if the
+  /// program is given as a single goto binary with an index
+  std::unique_ptr<mapped_goto_binaryt> goto_binary;
 
 public:
   /// Reference to symbol_table in the internal goto_model
@@ -0,0 +1,250 @@
+/*******************************************************************\
+
+Module: Read goto binaries with an index on demand
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Read goto binaries with an index on demand
+
+#include "mapped_goto_binary.h"
+
+#if defined(__linux__) || \
+    defined(__FreeBSD_kernel__) || \
+    defined(__GNU__) || \
+    defined(__unix__) || \
+    defined(__CYGWIN__) || \
+    defined(__MACH__)
+#define HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <fstream>
+#include <initializer_list>
+#include <istream>
+#include <iterator>
+#include <streambuf>
+
+#include <util/irep_serialization.h>
+#include <util/message.h>
+#include <util/symbol_table.h>
+#include <util/unicode.h>
+
+/// An input stream buffer on memory that is owned by someone else
+class memory_streambuft:public std::streambuf
+{
+public:
+  memory_streambuft(const char *begin, std::size_t size)
+  {
+    char *b=const_cast<char *>(begin);
+    setg(b, b, b+size);
+  }
+
+  std::size_t position() const
+  {
+    return gptr()-eback();
+  }
+};
+
+/// \return the version of the goto binary in the given stream, or 0 if the
+///   stream does not start with the header of a goto binary
+static std::size_t read_version(std::istream &in)
+{
+  char hdr[4];
+  in.read(hdr, sizeof(hdr));
+
+  if(!in || hdr[0]!=0x7f || hdr[1]!='G' || hdr[2]!='B' || hdr[3]!='F')
+    return 0;
+
+  return irep_serializationt::read_gb_word(in);
+}
+
+bool mapped_goto_binaryt::has_index(const std::string &filename)
+{
+  #ifdef _MSC_VER
+  std::ifstream in(widen(filename), std::ios::binary);
+  #else
+  std::ifstream in(filename, std::ios::binary);
+  #endif
+
+  return in && read_version(in)==4;
+}
+
+bool mapped_goto_binaryt::map_file(const std::string &filename)
+{
+  #ifdef HAVE_MMAP
+  int fd=::open(filename.c_str(), O_RDONLY);
+
+  if(fd>=0)
+  {
+    struct stat st;
+    void *p=MAP_FAILED;
+
+    if(fstat(fd, &st)==0 && st.st_size>0)
+      p=mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    ::close(fd);
+
+    if(p!=MAP_FAILED)
+    {
+      data=static_cast<const char *>(p);
+      size=st.st_size;
+      mapped=true;
+      return false;
+    }
+  }
+  #endif
+
+  // fall back to reading the file
+  #ifdef _MSC_VER
+  std::ifstream in(widen(filename), std::ios::binary);
+  #else
+  std::ifstream in(filename, std::ios::binary);
+  #endif
+
+  if(!in)
+    return true;
+
+  buffer.assign(
+    std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  data=buffer.data();
+  size=buffer.size();
+
+  return false;
+}
+
+void mapped_goto_binaryt::close()
+{
+  #ifdef HAVE_MMAP
+  if(mapped)
+    munmap(const_cast<char *>(data), size);
+  #endif
+
+  data=nullptr;
+  size=0;
+  mapped=false;
+  buffer.clear();
+  symbol_index.clear();
+  symbol_lookup.clear();
+  function_index.clear();
+}
+
+bool mapped_goto_binaryt::open(
+  const std::string &filename,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  close();
+
+  if(map_file(filename))
+  {
+    message.error() << "Failed to open `" << filename << "'"
+                    << messaget::eom;
+    return true;
+  }
+
+  memory_streambuft streambuf(data, size);
+  std::istream in(&streambuf);
+
+  if(read_version(in)!=4)
+  {
+    message.error() << "`" << filename
+                    << "' is not a goto binary with an index"
+                    << messaget::eom;
+    return true;
+  }
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+  std::vector<goto_binary_index_entryt> function_entries;
+
+  read_bin_goto_index(in, irepconverter, symbol_index);
+  read_bin_goto_index(in, irepconverter, function_entries);
+
+  data_start=streambuf.position();
+
+  bool corrupt=!in;
+
+  for(const auto index : { &symbol_index, &function_entries })
+    for(const auto &entry : *index)
+      if(entry.offset>size-data_start ||
+         entry.size>size-data_start-entry.offset)
+        corrupt=true;
+
+  if(corrupt)
+  {
+    message.error() << "`" << filename << "' has a corrupt index"
+                    << messaget::eom;
+    return true;
+  }
+
+  for(const auto &entry : symbol_index)
+    symbol_lookup.insert(std::make_pair(entry.name, entry));
+
+  for(const auto &entry : function_entries)
+    function_index.insert(std::make_pair(entry.name, entry));
+
+  return false;
+}
+
+const char *mapped_goto_binaryt::record(
+  const goto_binary_index_entryt &entry) const
+{
+  return data+data_start+entry.offset;
+}
+
+void mapped_goto_binaryt::read_symbols(symbol_tablet &symbol_table) const
+{
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  for(const auto &entry : symbol_index)
+  {
+    memory_streambuft streambuf(record(entry), entry.size);
+    std::istream in(&streambuf);
+    irepconverter.clear();
+    symbol_table.add(read_bin_goto_symbol(in, irepconverter));
+  }
+}
+
+bool mapped_goto_binaryt::read_symbol(
+  const irep_idt &name,
+  symbolt &symbol) const
+{
+  indext::const_iterator entry=symbol_lookup.find(name);
+
+  if(entry==symbol_lookup.end())
+    return true;
+
+  memory_streambuft streambuf(record(entry->second), entry->second.size);
+  std::istream in(&streambuf);
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+  symbol=read_bin_goto_symbol(in, irepconverter);
+
+  return false;
+}
+
+bool mapped_goto_binaryt::read_function_body(
+  const irep_idt &name,
+  goto_functionst::goto_functiont &function) const
+{
+  indext::const_iterator entry=function_index.find(name);
+
+  if(entry==function_index.end())
+    return true;
+
+  memory_streambuft streambuf(record(entry->second), entry->second.size);
+  std::istream in(&streambuf);
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+  read_bin_goto_function_body(in, irepconverter, function);
+
+  return false;
+}
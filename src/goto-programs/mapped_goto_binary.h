@@ -0,0 +1,96 @@
+/*******************************************************************\
+
+Module: Read goto binaries with an index on demand
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Read goto binaries with an index on demand
+
+#ifndef CPROVER_GOTO_PROGRAMS_MAPPED_GOTO_BINARY_H
+#define CPROVER_GOTO_PROGRAMS_MAPPED_GOTO_BINARY_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "goto_functions.h"
+#include "read_bin_goto_object.h"
+
+class message_handlert;
+class symbol_tablet;
+
+/// Gives access to the symbols and function bodies of a goto binary of
+/// format version 4 without deserializing all of them up front. The file is
+/// mapped into memory where the platform permits this, and read into memory
+/// otherwise. Only the indices are decoded when the file is opened; each
+/// symbol and function body is decoded from its own record when requested.
+class mapped_goto_binaryt
+{
+public:
+  mapped_goto_binaryt():
+    data(nullptr),
+    size(0),
+    mapped(false),
+    data_start(0)
+  {
+  }
+
+  ~mapped_goto_binaryt()
+  {
+    close();
+  }
+
+  mapped_goto_binaryt(const mapped_goto_binaryt &)=delete;
+  mapped_goto_binaryt &operator=(const mapped_goto_binaryt &)=delete;
+
+  /// \return true if the given file is a goto binary of a format version
+  ///   that has an index, as opposed to, e.g., an ELF file with a goto-cc
+  ///   section or a goto binary of an older version
+  static bool has_index(const std::string &filename);
+
+  /// Maps the given file and reads its indices
+  /// \return true on error
+  bool open(const std::string &filename, message_handlert &);
+
+  void close();
+
+  /// Adds all symbols of the binary to the given symbol table
+  void read_symbols(symbol_tablet &) const;
+
+  /// Decodes the given symbol
+  /// \return true if the binary does not have the symbol
+  bool read_symbol(const irep_idt &name, symbolt &) const;
+
+  bool has_function_body(const irep_idt &name) const
+  {
+    return function_index.find(name)!=function_index.end();
+  }
+
+  /// Decodes the body of the given function into the empty body of the
+  /// given function, whose type is expected to be set already
+  /// \return true if the binary does not have a body for the function
+  bool read_function_body(
+    const irep_idt &name,
+    goto_functionst::goto_functiont &) const;
+
+protected:
+  const char *data;
+  std::size_t size;
+  bool mapped;
+  std::vector<char> buffer;
+  std::size_t data_start;
+
+  typedef std::unordered_map<irep_idt, goto_binary_index_entryt, irep_id_hash>
+    indext;
+  std::vector<goto_binary_index_entryt> symbol_index;
+  indext symbol_lookup;
+  indext function_index;
+
+  bool map_file(const std::string &filename);
+  const char *record(const goto_binary_index_entryt &) const;
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_MAPPED_GOTO_BINARY_H
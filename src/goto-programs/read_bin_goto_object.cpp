@@ -18,7 +18,163 @@ Date: June 2006
 #include <util/symbol_table.h>
 #include <util/irep_serialization.h>
 
-#include "goto_functions.h"
+
+/// Reads a symbol, in the format of goto binary versions 3 and 4
+symbolt read_bin_goto_symbol(
+  std::istream &in,
+  irep_serializationt &irepconverter)
+{
+  symbolt sym;
+
+  irepconverter.reference_convert(in, sym.type);
+  irepconverter.reference_convert(in, sym.value);
+  irepconverter.reference_convert(in, sym.location);
+
+  sym.name = irepconverter.read_string_ref(in);
+  sym.module = irepconverter.read_string_ref(in);
+  sym.base_name = irepconverter.read_string_ref(in);
+  sym.mode = irepconverter.read_string_ref(in);
+  sym.pretty_name = irepconverter.read_string_ref(in);
+
+  // obsolete: symordering
+  irepconverter.read_gb_word(in);
+
+  std::size_t flags=irepconverter.read_gb_word(in);
+
+  sym.is_weak = (flags &(1 << 16))!=0;
+  sym.is_type = (flags &(1 << 15))!=0;
+  sym.is_property = (flags &(1 << 14))!=0;
+  sym.is_macro = (flags &(1 << 13))!=0;
+  sym.is_exported = (flags &(1 << 12))!=0;
+  sym.is_input = (flags &(1 << 11))!=0;
+  sym.is_output = (flags &(1 << 10))!=0;
+  sym.is_state_var = (flags &(1 << 9))!=0;
+  sym.is_parameter = (flags &(1 << 8))!=0;
+  sym.is_auxiliary = (flags &(1 << 7))!=0;
+  // sym.binding = (flags &(1 << 6))!=0;
+  sym.is_lvalue = (flags &(1 << 5))!=0;
+  sym.is_static_lifetime = (flags &(1 << 4))!=0;
+  sym.is_thread_local = (flags &(1 << 3))!=0;
+  sym.is_file_local = (flags &(1 << 2))!=0;
+  sym.is_extern = (flags &(1 << 1))!=0;
+  sym.is_volatile = (flags &1)!=0;
+
+  return sym;
+}
+
+/// Reads the instructions of a function body, in the format of goto binary
+/// versions 3 and 4, into the (empty) body of the given function
+void read_bin_goto_function_body(
+  std::istream &in,
+  irep_serializationt &irepconverter,
+  goto_functionst::goto_functiont &f)
+{
+  typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
+  target_mapt target_map;
+  typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
+  rev_target_mapt rev_target_map;
+
+  bool hidden=false;
+
+  std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
+  for(std::size_t i=0; i<ins_count; i++)
+  {
+    goto_programt::targett itarget = f.body.add_instruction();
+    goto_programt::instructiont &instruction=*itarget;
+
+    irepconverter.reference_convert(in, instruction.code);
+    instruction.function = irepconverter.read_string_ref(in);
+    irepconverter.reference_convert(in, instruction.source_location);
+    instruction.type = (goto_program_instruction_typet)
+                            irepconverter.read_gb_word(in);
+    instruction.guard.make_nil();
+    irepconverter.reference_convert(in, instruction.guard);
+    irepconverter.read_string_ref(in); // former event
+    instruction.target_number = irepconverter.read_gb_word(in);
+    if(instruction.is_target() &&
+       rev_target_map.insert(
+         rev_target_map.end(),
+         std::make_pair(instruction.target_number, itarget))->second!=itarget)
+      UNREACHABLE;
+
+    std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
+    for(std::size_t i=0; i<t_count; i++)
+      // just save the target numbers
+      target_map[itarget].push_back(irepconverter.read_gb_word(in));
+
+    std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
+
+    for(std::size_t i=0; i<l_count; i++)
+    {
+      irep_idt label=irepconverter.read_string_ref(in);
+      instruction.labels.push_back(label);
+      if(label=="__CPROVER_HIDE")
+        hidden=true;
+      // The above info is normally in the type of the goto_functiont object,
+      // which should likely be stored in the binary.
+    }
+  }
+
+  // Resolve targets
+  for(target_mapt::iterator tit = target_map.begin();
+      tit!=target_map.end();
+      tit++)
+  {
+    goto_programt::targett ins = tit->first;
+
+    for(std::list<unsigned>::iterator nit = tit->second.begin();
+        nit!=tit->second.end();
+        nit++)
+    {
+      unsigned n=*nit;
+      rev_target_mapt::const_iterator entry=rev_target_map.find(n);
+      assert(entry!=rev_target_map.end());
+      ins->targets.push_back(entry->second);
+    }
+  }
+
+  f.body.update();
+
+  if(hidden)
+    f.make_hidden();
+}
+
+/// Reads one of the two indices of goto binary format v4, which give the
+/// name, offset and size of each symbol or function body
+void read_bin_goto_index(
+  std::istream &in,
+  irep_serializationt &irepconverter,
+  std::vector<goto_binary_index_entryt> &index)
+{
+  std::size_t count=irepconverter.read_gb_word(in);
+  index.reserve(count);
+
+  for(std::size_t i=0; i<count && in; i++)
+  {
+    goto_binary_index_entryt entry;
+    entry.name=irepconverter.read_gb_string(in);
+    entry.offset=irepconverter.read_gb_word(in);
+    entry.size=irepconverter.read_gb_word(in);
+    index.push_back(entry);
+  }
+}
+
+/// Adds a symbol read from a goto binary to the symbol table
+static void add_symbol(
+  const symbolt &sym,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions)
+{
+  if(!sym.is_type && sym.type.id()==ID_code)
+  {
+    // makes sure there is an empty function
+    // for every function symbol and fixes
+    // the function types.
+    functions.function_map[sym.name].type=to_code_type(sym.type);
+  }
+
+  symbol_table.add(sym);
+}
 
 /// read goto binary format v3
 /// \par parameters: input stream, symbol_table, functions
@@ -34,128 +190,58 @@ bool read_bin_goto_object_v3(
   std::size_t count = irepconverter.read_gb_word(in); // # of symbols
 
   for(std::size_t i=0; i<count; i++)
-  {
-    symbolt sym;
-
-    irepconverter.reference_convert(in, sym.type);
-    irepconverter.reference_convert(in, sym.value);
-    irepconverter.reference_convert(in, sym.location);
-
-    sym.name = irepconverter.read_string_ref(in);
-    sym.module = irepconverter.read_string_ref(in);
-    sym.base_name = irepconverter.read_string_ref(in);
-    sym.mode = irepconverter.read_string_ref(in);
-    sym.pretty_name = irepconverter.read_string_ref(in);
-
-    // obsolete: symordering
-    irepconverter.read_gb_word(in);
-
-    std::size_t flags=irepconverter.read_gb_word(in);
-
-    sym.is_weak = (flags &(1 << 16))!=0;
-    sym.is_type = (flags &(1 << 15))!=0;
-    sym.is_property = (flags &(1 << 14))!=0;
-    sym.is_macro = (flags &(1 << 13))!=0;
-    sym.is_exported = (flags &(1 << 12))!=0;
-    sym.is_input = (flags &(1 << 11))!=0;
-    sym.is_output = (flags &(1 << 10))!=0;
-    sym.is_state_var = (flags &(1 << 9))!=0;
-    sym.is_parameter = (flags &(1 << 8))!=0;
-    sym.is_auxiliary = (flags &(1 << 7))!=0;
-    // sym.binding = (flags &(1 << 6))!=0;
-    sym.is_lvalue = (flags &(1 << 5))!=0;
-    sym.is_static_lifetime = (flags &(1 << 4))!=0;
-    sym.is_thread_local = (flags &(1 << 3))!=0;
-    sym.is_file_local = (flags &(1 << 2))!=0;
-    sym.is_extern = (flags &(1 << 1))!=0;
-    sym.is_volatile = (flags &1)!=0;
-
-    if(!sym.is_type && sym.type.id()==ID_code)
-    {
-      // makes sure there is an empty function
-      // for every function symbol and fixes
-      // the function types.
-      functions.function_map[sym.name].type=to_code_type(sym.type);
-    }
-
-    symbol_table.add(sym);
-  }
+    add_symbol(
+      read_bin_goto_symbol(in, irepconverter), symbol_table, functions);
 
   count=irepconverter.read_gb_word(in); // # of functions
 
   for(std::size_t i=0; i<count; i++)
   {
     irep_idt fname=irepconverter.read_gb_string(in);
-    goto_functionst::goto_functiont &f = functions.function_map[fname];
-
-    typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
-    target_mapt target_map;
-    typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
-    rev_target_mapt rev_target_map;
+    read_bin_goto_function_body(
+      in, irepconverter, functions.function_map[fname]);
+  }
 
-    bool hidden=false;
+  functions.compute_location_numbers();
 
-    std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
-    for(std::size_t i=0; i<ins_count; i++)
-    {
-      goto_programt::targett itarget = f.body.add_instruction();
-      goto_programt::instructiont &instruction=*itarget;
-
-      irepconverter.reference_convert(in, instruction.code);
-      instruction.function = irepconverter.read_string_ref(in);
-      irepconverter.reference_convert(in, instruction.source_location);
-      instruction.type = (goto_program_instruction_typet)
-                              irepconverter.read_gb_word(in);
-      instruction.guard.make_nil();
-      irepconverter.reference_convert(in, instruction.guard);
-      irepconverter.read_string_ref(in); // former event
-      instruction.target_number = irepconverter.read_gb_word(in);
-      if(instruction.is_target() &&
-         rev_target_map.insert(
-           rev_target_map.end(),
-           std::make_pair(instruction.target_number, itarget))->second!=itarget)
-        UNREACHABLE;
-
-      std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
-      for(std::size_t i=0; i<t_count; i++)
-        // just save the target numbers
-        target_map[itarget].push_back(irepconverter.read_gb_word(in));
-
-      std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
-
-      for(std::size_t i=0; i<l_count; i++)
-      {
-        irep_idt label=irepconverter.read_string_ref(in);
-        instruction.labels.push_back(label);
-        if(label=="__CPROVER_HIDE")
-          hidden=true;
-        // The above info is normally in the type of the goto_functiont object,
-        // which should likely be stored in the binary.
-      }
-    }
+  return false;
+}
 
-    // Resolve targets
-    for(target_mapt::iterator tit = target_map.begin();
-        tit!=target_map.end();
-        tit++)
-    {
-      goto_programt::targett ins = tit->first;
+/// read goto binary format v4; the records follow the indices in the order
+/// given by them, hence we can read all of them without seeking
+/// \par parameters: input stream, symbol_table, functions
+/// \return true on error, false otherwise
+bool read_bin_goto_object_v4(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  irep_serializationt &irepconverter)
+{
+  std::vector<goto_binary_index_entryt> symbols, bodies;
+  read_bin_goto_index(in, irepconverter, symbols);
+  read_bin_goto_index(in, irepconverter, bodies);
 
-      for(std::list<unsigned>::iterator nit = tit->second.begin();
-          nit!=tit->second.end();
-          nit++)
-      {
-        unsigned n=*nit;
-        rev_target_mapt::const_iterator entry=rev_target_map.find(n);
-        assert(entry!=rev_target_map.end());
-        ins->targets.push_back(entry->second);
-      }
-    }
+  for(std::size_t i=0; i<symbols.size(); i++)
+  {
+    irepconverter.clear();
+    add_symbol(
+      read_bin_goto_symbol(in, irepconverter), symbol_table, functions);
+  }
 
-    f.body.update();
+  for(const auto &entry : bodies)
+  {
+    irepconverter.clear();
+    read_bin_goto_function_body(
+      in, irepconverter, functions.function_map[entry.name]);
+  }
 
-    if(hidden)
-      f.make_hidden();
+  if(!in)
+  {
+    messaget(message_handler).error()
+      << "`" << filename << "' is truncated" << messaget::eom;
+    return true;
   }
 
   functions.compute_location_numbers();
@@ -235,6 +321,13 @@ bool read_bin_goto_object(
                                      irepconverter);
       break;
 
+    case 4:
+      return read_bin_goto_object_v4(in, filename,
+                                     symbol_table, functions,
+                                     message_handler,
+                                     irepconverter);
+      break;
+
     default:
       message.error() <<
           "The input was compiled with an unsupported version of "
@@ -16,10 +16,25 @@ Date: May 2007
 
 #include <iosfwd>
 #include <string>
+#include <vector>
+
+#include <util/irep.h>
+
+#include "goto_functions.h"
 
 class symbol_tablet;
-class goto_functionst;
+class symbolt;
 class message_handlert;
+class irep_serializationt;
+
+/// An entry of the symbol or function index of goto binary format v4. The
+/// offset is relative to the end of the indices.
+struct goto_binary_index_entryt
+{
+  irep_idt name;
+  std::size_t offset;
+  std::size_t size;
+};
 
 bool read_bin_goto_object(
   std::istream &in,
@@ -28,4 +43,16 @@ bool read_bin_goto_object(
   goto_functionst &goto_functions,
   message_handlert &message_handler);
 
+symbolt read_bin_goto_symbol(std::istream &, irep_serializationt &);
+
+void read_bin_goto_function_body(
+  std::istream &,
+  irep_serializationt &,
+  goto_functionst::goto_functiont &);
+
+void read_bin_goto_index(
+  std::istream &,
+  irep_serializationt &,
+  std::vector<goto_binary_index_entryt> &);
+
 #endif // CPROVER_GOTO_PROGRAMS_READ_BIN_GOTO_OBJECT_H
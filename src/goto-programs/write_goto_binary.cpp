@@ -12,6 +12,9 @@ Author: CM Wintersteiger
 #include "write_goto_binary.h"
 
 #include <fstream>
+#include <initializer_list>
+#include <streambuf>
+#include <vector>
 
 #include <util/message.h>
 #include <util/irep_serialization.h>
@@ -19,7 +22,86 @@ Author: CM Wintersteiger
 
 #include <goto-programs/goto_model.h>
 
-/// Writes a goto program to disc, using goto binary format ver 2
+/// Writes a symbol, using the format of goto binary versions 3 and 4
+static void write_symbol(
+  std::ostream &out,
+  const symbolt &sym,
+  irep_serializationt &irepconverter)
+{
+  // Since version 2, symbols are not converted to ireps,
+  // instead they are saved in a custom binary format
+
+  irepconverter.reference_convert(sym.type, out);
+  irepconverter.reference_convert(sym.value, out);
+  irepconverter.reference_convert(sym.location, out);
+
+  irepconverter.write_string_ref(out, sym.name);
+  irepconverter.write_string_ref(out, sym.module);
+  irepconverter.write_string_ref(out, sym.base_name);
+  irepconverter.write_string_ref(out, sym.mode);
+  irepconverter.write_string_ref(out, sym.pretty_name);
+
+  write_gb_word(out, 0); // old: sym.ordering
+
+  unsigned flags=0;
+  flags = (flags << 1) | static_cast<int>(sym.is_weak);
+  flags = (flags << 1) | static_cast<int>(sym.is_type);
+  flags = (flags << 1) | static_cast<int>(sym.is_property);
+  flags = (flags << 1) | static_cast<int>(sym.is_macro);
+  flags = (flags << 1) | static_cast<int>(sym.is_exported);
+  flags = (flags << 1) | static_cast<int>(sym.is_input);
+  flags = (flags << 1) | static_cast<int>(sym.is_output);
+  flags = (flags << 1) | static_cast<int>(sym.is_state_var);
+  flags = (flags << 1) | static_cast<int>(sym.is_parameter);
+  flags = (flags << 1) | static_cast<int>(sym.is_auxiliary);
+  flags = (flags << 1) | static_cast<int>(false); // sym.binding;
+  flags = (flags << 1) | static_cast<int>(sym.is_lvalue);
+  flags = (flags << 1) | static_cast<int>(sym.is_static_lifetime);
+  flags = (flags << 1) | static_cast<int>(sym.is_thread_local);
+  flags = (flags << 1) | static_cast<int>(sym.is_file_local);
+  flags = (flags << 1) | static_cast<int>(sym.is_extern);
+  flags = (flags << 1) | static_cast<int>(sym.is_volatile);
+
+  write_gb_word(out, flags);
+}
+
+/// Writes the instructions of a function body, using the format of goto
+/// binary versions 3 and 4
+static void write_function_body(
+  std::ostream &out,
+  const goto_programt &body,
+  irep_serializationt &irepconverter)
+{
+  // Since version 2, goto functions are not converted to ireps,
+  // instead they are saved in a custom binary format
+
+  write_gb_word(out, body.instructions.size()); // # instructions
+
+  forall_goto_program_instructions(i_it, body)
+  {
+    const goto_programt::instructiont &instruction = *i_it;
+
+    irepconverter.reference_convert(instruction.code, out);
+    irepconverter.write_string_ref(out, instruction.function);
+    irepconverter.reference_convert(instruction.source_location, out);
+    write_gb_word(out, (long)instruction.type);
+    irepconverter.reference_convert(instruction.guard, out);
+    irepconverter.write_string_ref(out, irep_idt()); // former event
+    write_gb_word(out, instruction.target_number);
+
+    write_gb_word(out, instruction.targets.size());
+
+    for(const auto &t_it : instruction.targets)
+      write_gb_word(out, t_it->target_number);
+
+    write_gb_word(out, instruction.labels.size());
+
+    for(const auto &l_it : instruction.labels)
+      irepconverter.write_string_ref(out, l_it);
+  }
+}
+
+/// Writes a goto program to disc, using goto binary format ver 3
 bool write_goto_binary_v3(
   std::ostream &out,
   const symbol_tablet &symbol_table,
@@ -31,45 +113,7 @@ bool write_goto_binary_v3(
   write_gb_word(out, symbol_table.symbols.size());
 
   forall_symbols(it, symbol_table.symbols)
-  {
-    // Since version 2, symbols are not converted to ireps,
-    // instead they are saved in a custom binary format
-
-    const symbolt &sym = it->second;
-
-    irepconverter.reference_convert(sym.type, out);
-    irepconverter.reference_convert(sym.value, out);
-    irepconverter.reference_convert(sym.location, out);
-
-    irepconverter.write_string_ref(out, sym.name);
-    irepconverter.write_string_ref(out, sym.module);
-    irepconverter.write_string_ref(out, sym.base_name);
-    irepconverter.write_string_ref(out, sym.mode);
-    irepconverter.write_string_ref(out, sym.pretty_name);
-
-    write_gb_word(out, 0); // old: sym.ordering
-
-    unsigned flags=0;
-    flags = (flags << 1) | static_cast<int>(sym.is_weak);
-    flags = (flags << 1) | static_cast<int>(sym.is_type);
-    flags = (flags << 1) | static_cast<int>(sym.is_property);
-    flags = (flags << 1) | static_cast<int>(sym.is_macro);
-    flags = (flags << 1) | static_cast<int>(sym.is_exported);
-    flags = (flags << 1) | static_cast<int>(sym.is_input);
-    flags = (flags << 1) | static_cast<int>(sym.is_output);
-    flags = (flags << 1) | static_cast<int>(sym.is_state_var);
-    flags = (flags << 1) | static_cast<int>(sym.is_parameter);
-    flags = (flags << 1) | static_cast<int>(sym.is_auxiliary);
-    flags = (flags << 1) | static_cast<int>(false); // sym.binding;
-    flags = (flags << 1) | static_cast<int>(sym.is_lvalue);
-    flags = (flags << 1) | static_cast<int>(sym.is_static_lifetime);
-    flags = (flags << 1) | static_cast<int>(sym.is_thread_local);
-    flags = (flags << 1) | static_cast<int>(sym.is_file_local);
-    flags = (flags << 1) | static_cast<int>(sym.is_extern);
-    flags = (flags << 1) | static_cast<int>(sym.is_volatile);
-
-    write_gb_word(out, flags);
-  }
+    write_symbol(out, it->second, irepconverter);
 
   // now write functions, but only those with body
 
@@ -84,39 +128,122 @@ bool write_goto_binary_v3(
   {
     if(fct.second.body_available())
     {
-      // Since version 2, goto functions are not converted to ireps,
-      // instead they are saved in a custom binary format
-
       write_gb_string(out, id2string(fct.first)); // name
-      write_gb_word(out, fct.second.body.instructions.size()); // # instructions
+      write_function_body(out, fct.second.body, irepconverter);
+    }
+  }
+
+  // irepconverter.output_map(f);
+  // irepconverter.output_string_map(f);
+
+  return false;
+}
+
+/// Counts the characters written to it, which it discards
+class counting_streambuft:public std::streambuf
+{
+public:
+  counting_streambuft():count(0)
+  {
+  }
+
+  std::size_t count;
 
-      forall_goto_program_instructions(i_it, fct.second.body)
-      {
-        const goto_programt::instructiont &instruction = *i_it;
+protected:
+  int_type overflow(int_type c) override
+  {
+    if(!traits_type::eq_int_type(c, traits_type::eof()))
+      count++;
+    return traits_type::not_eof(c);
+  }
 
-        irepconverter.reference_convert(instruction.code, out);
-        irepconverter.write_string_ref(out, instruction.function);
-        irepconverter.reference_convert(instruction.source_location, out);
-        write_gb_word(out, (long)instruction.type);
-        irepconverter.reference_convert(instruction.guard, out);
-        irepconverter.write_string_ref(out, irep_idt()); // former event
-        write_gb_word(out, instruction.target_number);
+  std::streamsize xsputn(const char *, std::streamsize n) override
+  {
+    count+=n;
+    return n;
+  }
+};
+
+/// Writes a goto program to disc, using goto binary format ver 4. Unlike
+/// version 3, the symbols and function bodies are preceded by an index that
+/// gives the name, offset and size of each of them, and each of them is
+/// serialized with sharing of ireps and strings within itself only. This
+/// permits reading any one of them without reading what precedes it, see
+/// mapped_goto_binaryt. The offsets are relative to the end of the index.
+/// As nothing is shared across records, the binary is larger and slower to
+/// read in full than one of version 3, hence version 4 is not the default.
+///
+/// The words of the index take a number of bytes that depends on their
+/// value. Thus, the records are serialized twice: once to measure them
+/// for the index, and once to write them after it. This avoids holding
+/// the whole binary in memory.
+bool write_goto_binary_v4(
+  std::ostream &out,
+  const symbol_tablet &symbol_table,
+  const goto_functionst &goto_functions)
+{
+  struct entryt
+  {
+    irep_idt name;
+    std::size_t offset, size;
+  };
 
-        write_gb_word(out, instruction.targets.size());
+  std::vector<entryt> symbols, functions;
+  symbols.reserve(symbol_table.symbols.size());
 
-        for(const auto &t_it : instruction.targets)
-          write_gb_word(out, t_it->target_number);
+  counting_streambuft counter;
+  std::ostream measure(&counter);
 
-        write_gb_word(out, instruction.labels.size());
+  forall_symbols(it, symbol_table.symbols)
+  {
+    const std::size_t offset=counter.count;
+    irep_serializationt::ireps_containert irepc;
+    irep_serializationt irepconverter(irepc);
+    write_symbol(measure, it->second, irepconverter);
+    symbols.push_back({it->first, offset, counter.count-offset});
+  }
 
-        for(const auto &l_it : instruction.labels)
-          irepconverter.write_string_ref(out, l_it);
-      }
+  for(const auto &fct : goto_functions.function_map)
+  {
+    if(fct.second.body_available())
+    {
+      const std::size_t offset=counter.count;
+      irep_serializationt::ireps_containert irepc;
+      irep_serializationt irepconverter(irepc);
+      write_function_body(measure, fct.second.body, irepconverter);
+      functions.push_back({fct.first, offset, counter.count-offset});
     }
   }
 
-  // irepconverter.output_map(f);
-  // irepconverter.output_string_map(f);
+  for(const auto index : { &symbols, &functions })
+  {
+    write_gb_word(out, index->size());
+
+    for(const auto &entry : *index)
+    {
+      write_gb_string(out, id2string(entry.name));
+      write_gb_word(out, entry.offset);
+      write_gb_word(out, entry.size);
+    }
+  }
+
+  // in the same order as above
+  forall_symbols(it, symbol_table.symbols)
+  {
+    irep_serializationt::ireps_containert irepc;
+    irep_serializationt irepconverter(irepc);
+    write_symbol(out, it->second, irepconverter);
+  }
+
+  for(const auto &fct : goto_functions.function_map)
+  {
+    if(fct.second.body_available())
+    {
+      irep_serializationt::ireps_containert irepc;
+      irep_serializationt irepconverter(irepc);
+      write_function_body(out, fct.second.body, irepconverter);
+    }
+  }
 
   return false;
 }
@@ -160,6 +287,9 @@ bool write_goto_binary(
     return write_goto_binary_v3(
       out, symbol_table, goto_functions, irepconverter);
 
+  case 4:
+    return write_goto_binary_v4(out, symbol_table, goto_functions);
+
   default:
     throw "unknown goto binary version";
   }
@@ -171,7 +301,8 @@ bool write_goto_binary(
 bool write_goto_binary(
   const std::string &filename,
   const goto_modelt &goto_model,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  int version)
 {
   std::ofstream out(filename, std::ios::binary);
 
@@ -183,5 +314,5 @@ bool write_goto_binary(
     return true;
   }
 
-  return write_goto_binary(out, goto_model);
+  return write_goto_binary(out, goto_model, version);
 }
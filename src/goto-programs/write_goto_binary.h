@@ -36,6 +36,7 @@ bool write_goto_binary(
 bool write_goto_binary(
   const std::string &filename,
   const goto_modelt &,
-  message_handlert &);
+  message_handlert &,
+  int version=GOTO_BINARY_VERSION);
 
 #endif // CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
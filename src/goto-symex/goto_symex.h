@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 #define CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 
+#include <list>
+
 #include <util/options.h>
 #include <util/message.h>
 #include <util/byte_operators.h>
@@ -50,6 +52,7 @@ public:
     : total_vccs(0),
       remaining_vccs(0),
       constant_propagation(true),
+      path_exploration(false),
       new_symbol_table(_new_symbol_table),
       language_mode(),
       ns(_ns),
@@ -130,6 +133,13 @@ public:
 
   bool constant_propagation;
 
+  /// In path exploration, the successors of a branch are not merged later
+  /// on. Instead, the current path ends at any branch where both successors
+  /// may be reachable, and the states at the successors are saved in
+  /// branch_successors, such that they can be continued separately.
+  bool path_exploration;
+  std::list<statet> branch_successors;
+
   optionst options;
   symbol_tablet &new_symbol_table;
 
@@ -222,6 +232,11 @@ protected:
   virtual void symex_assume(statet &state, const exprt &cond);
 
   // gotos
+  exprt branch_guard(
+    statet &state,
+    const exprt &new_guard,
+    const symex_targett::sourcet &source);
+
   void merge_gotos(statet &state);
 
   virtual void merge_goto(
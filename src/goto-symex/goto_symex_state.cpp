@@ -34,6 +34,26 @@ goto_symex_statet::goto_symex_statet():
 
 goto_symex_statet::~goto_symex_statet()=default;
 
+void goto_symex_statet::copy_path_from(const goto_symex_statet &other)
+{
+  depth=other.depth;
+  guard=other.guard;
+  source=other.source;
+  symex_target=other.symex_target;
+  l1_history=other.l1_history;
+  l1_types=other.l1_types;
+  value_set=other.value_set;
+  level0=other.level0;
+  level1=other.level1;
+  level2=other.level2;
+  propagation=other.propagation;
+  atomic_section_id=other.atomic_section_id;
+  read_in_atomic_section=other.read_in_atomic_section;
+  written_in_atomic_section=other.written_in_atomic_section;
+  threads=other.threads;
+  record_events=other.record_events;
+}
+
 void goto_symex_statet::level0t::operator()(
   ssa_exprt &ssa_expr,
   const namespacet &ns,
@@ -74,12 +94,13 @@ void goto_symex_statet::level1t::operator()(ssa_exprt &ssa_expr)
 
   const irep_idt l0_name=ssa_expr.get_l1_object_identifier();
 
-  current_namest::const_iterator it=current_names.find(l0_name);
-  if(it==current_names.end())
+  current_namest::const_find_type entry=
+    as_const(&current_names)->find(l0_name);
+  if(!entry.second)
     return;
 
   // rename!
-  ssa_expr.set_level_1(it->second.second);
+  ssa_expr.set_level_1(entry.first.second);
 }
 
 /// This function determines what expressions are to be propagated as
@@ -334,8 +355,7 @@ void goto_symex_statet::assignment(
   #endif
 
   // do the l2 renaming
-  if(level2.current_names.find(l1_identifier)==level2.current_names.end())
-    level2.current_names[l1_identifier]=std::make_pair(lhs, 0);
+  level2.current_names.insert(l1_identifier, std::make_pair(lhs, 0));
   level2.increase_counter(l1_identifier);
   set_ssa_indices(lhs, ns, L2);
 
@@ -378,10 +398,10 @@ void goto_symex_statet::propagationt::operator()(exprt &expr)
 {
   if(expr.id()==ID_symbol)
   {
-    valuest::const_iterator it=
-      values.find(expr.get(ID_identifier));
-    if(it!=values.end())
-      expr=it->second;
+    valuest::const_find_type entry=
+      as_const(&values)->find(expr.get(ID_identifier));
+    if(entry.second)
+      expr=entry.first;
   }
   else if(expr.id()==ID_address_of)
   {
@@ -464,11 +484,11 @@ void goto_symex_statet::rename(
       {
         // We also consider propagation if we go up to L2.
         // L1 identifiers are used for propagation!
-        propagationt::valuest::const_iterator p_it=
-          propagation.values.find(ssa.get_identifier());
+        propagationt::valuest::const_find_type p_it=
+          as_const(&propagation.values)->find(ssa.get_identifier());
 
-        if(p_it!=propagation.values.end())
-          expr=p_it->second; // already L2
+        if(p_it.second)
+          expr=p_it.first; // already L2
         else
           set_ssa_indices(ssa, ns, L2);
       }
@@ -599,8 +619,7 @@ bool goto_symex_statet::l2_thread_read_encoding(
 
     if(a_s_read.second.empty())
     {
-      if(level2.current_names.find(l1_identifier)==level2.current_names.end())
-        level2.current_names[l1_identifier]=std::make_pair(ssa_l1, 0);
+      level2.current_names.insert(l1_identifier, std::make_pair(ssa_l1, 0));
       level2.increase_counter(l1_identifier);
       a_s_read.first=level2.current_count(l1_identifier);
     }
@@ -637,8 +656,7 @@ bool goto_symex_statet::l2_thread_read_encoding(
     return true;
   }
 
-  if(level2.current_names.find(l1_identifier)==level2.current_names.end())
-    level2.current_names[l1_identifier]=std::make_pair(ssa_l1, 0);
+  level2.current_names.insert(l1_identifier, std::make_pair(ssa_l1, 0));
 
   // No event and no fresh index, but avoid constant propagation
   if(!record_events)
@@ -20,6 +20,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/std_expr.h>
 #include <util/ssa_expr.h>
 #include <util/make_unique.h>
+#include <util/sharing_map.h>
 
 #include <pointer-analysis/value_set.h>
 #include <goto-programs/goto_functions.h>
@@ -35,6 +36,10 @@ public:
   goto_symex_statet();
   ~goto_symex_statet();
 
+  /// Copies all but the dependency information, which is not owned by
+  /// a single path
+  void copy_path_from(const goto_symex_statet &other);
+
   // distance from entry
   unsigned depth;
 
@@ -54,28 +59,30 @@ public:
   {
     virtual ~renaming_levelt() { }
 
-    typedef std::map<irep_idt, std::pair<ssa_exprt, unsigned> > current_namest;
+    // shared copy-on-write, such that states are cheap to copy at branches
+    typedef sharing_mapt<
+      irep_idt, std::pair<ssa_exprt, unsigned>, irep_id_hash> current_namest;
     current_namest current_names;
 
     unsigned current_count(const irep_idt &identifier) const
     {
-      current_namest::const_iterator it=
-        current_names.find(identifier);
-      return it==current_names.end()?0:it->second.second;
+      current_namest::const_find_type entry=current_names.find(identifier);
+      return entry.second?entry.first.second:0;
     }
 
     void increase_counter(const irep_idt &identifier)
     {
-      assert(current_names.find(identifier)!=current_names.end());
-      ++current_names[identifier].second;
+      current_namest::find_type entry=current_names.find(identifier);
+      assert(entry.second);
+      ++entry.first.second;
     }
 
     void get_variables(std::unordered_set<ssa_exprt, irep_hash> &vars) const
     {
-      for(current_namest::const_iterator it=current_names.begin();
-          it!=current_names.end();
-          it++)
-        vars.insert(it->second.first);
+      current_namest::viewt view;
+      current_names.get_view(view);
+      for(const auto &item : view)
+        vars.insert(item.second.first);
     }
   };
 
@@ -101,23 +108,11 @@ public:
 
     void restore_from(const current_namest &other)
     {
-      current_namest::iterator it=current_names.begin();
-      for(current_namest::const_iterator
-          ito=other.begin();
-          ito!=other.end();
-          ++ito)
-      {
-        while(it!=current_names.end() && it->first<ito->first)
-          ++it;
-        if(it==current_names.end() || ito->first<it->first)
-          current_names.insert(it, *ito);
-        else if(it!=current_names.end())
-        {
-          assert(it->first==ito->first);
-          it->second=ito->second;
-          ++it;
-        }
-      }
+      // only the entries that have been written since are visited
+      current_namest::delta_viewt delta_view;
+      other.get_delta_view(current_names, delta_view, false);
+      for(const auto &item : delta_view)
+        current_names[item.k]=item.m;
     }
 
     level1t() { }
@@ -136,7 +131,7 @@ public:
   class propagationt
   {
   public:
-    typedef std::map<irep_idt, exprt> valuest;
+    typedef sharing_mapt<irep_idt, exprt, irep_id_hash> valuest;
     valuest values;
     void operator()(exprt &expr);
 
@@ -212,18 +207,17 @@ public:
     void level2_get_variables(
       std::unordered_set<ssa_exprt, irep_hash> &vars) const
     {
-      for(level2t::current_namest::const_iterator
-          it=level2_current_names.begin();
-          it!=level2_current_names.end();
-          it++)
-        vars.insert(it->second.first);
+      level2t::current_namest::viewt view;
+      level2_current_names.get_view(view);
+      for(const auto &item : view)
+        vars.insert(item.second.first);
     }
 
     unsigned level2_current_count(const irep_idt &identifier) const
     {
-      level2t::current_namest::const_iterator it=
+      level2t::current_namest::const_find_type entry=
         level2_current_names.find(identifier);
-      return it==level2_current_names.end()?0:it->second.second;
+      return entry.second?entry.first.second:0;
     }
   };
 
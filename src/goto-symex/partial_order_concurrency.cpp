@@ -71,7 +71,9 @@ void partial_order_concurrencyt::add_init_writes(
     init_done.insert(a);
   }
 
-  equation.SSA_steps.splice(equation.SSA_steps.begin(), init_steps);
+  // prepend, keeping the order of the initialising writes
+  for(auto it=init_steps.rbegin(); it!=init_steps.rend(); it++)
+    equation.SSA_steps.push_front(std::move(*it));
 }
 
 void partial_order_concurrencyt::build_event_lists(
@@ -0,0 +1,70 @@
+/*******************************************************************\
+
+Module: Storage of symbolic execution paths
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Storage of symbolic execution paths
+
+#include "path_storage.h"
+
+#include <vector>
+
+#include <util/make_unique.h>
+
+path_storaget::segmentt::~segmentt()
+{
+  // Release the ancestors that are not shared with other paths one at a
+  // time, rather than recursively, which could exhaust the stack on long
+  // paths.
+  std::shared_ptr<const segmentt> ancestor=std::move(parent);
+  while(ancestor!=nullptr && ancestor.use_count()==1)
+  {
+    std::shared_ptr<const segmentt> next=
+      std::move(const_cast<segmentt &>(*ancestor).parent);
+    ancestor=std::move(next);
+  }
+}
+
+void path_storaget::push(
+  const segment_ptrt &prefix,
+  const goto_symex_statet &state)
+{
+  paths.emplace_back();
+  paths.back().prefix=prefix;
+  paths.back().state.copy_path_from(state);
+}
+
+void path_storaget::get_SSA_steps(
+  const segment_ptrt &prefix,
+  symex_target_equationt::SSA_stepst &dest)
+{
+  std::vector<const segmentt *> segments;
+  for(const segmentt *s=prefix.get(); s!=nullptr; s=s->parent.get())
+    segments.push_back(s);
+
+  for(auto it=segments.rbegin(); it!=segments.rend(); it++)
+    for(const auto &step : (*it)->SSA_steps)
+      dest.push_back(step);
+}
+
+std::list<path_storaget::patht>::iterator path_randomt::next()
+{
+  std::uniform_int_distribution<std::size_t> distribution(0, paths.size()-1);
+  return std::next(paths.begin(), distribution(generator));
+}
+
+std::unique_ptr<path_storaget> get_path_strategy(const std::string &strategy)
+{
+  if(strategy=="dfs")
+    return util_make_unique<path_lifot>();
+  else if(strategy=="bfs")
+    return util_make_unique<path_fifot>();
+  else if(strategy=="random")
+    return util_make_unique<path_randomt>();
+  else
+    return nullptr;
+}
@@ -0,0 +1,137 @@
+/*******************************************************************\
+
+Module: Storage of symbolic execution paths
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Storage of symbolic execution paths
+
+#ifndef CPROVER_GOTO_SYMEX_PATH_STORAGE_H
+#define CPROVER_GOTO_SYMEX_PATH_STORAGE_H
+
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <util/invariant.h>
+
+#include "goto_symex_state.h"
+#include "symex_target_equation.h"
+
+/// Storage for the paths that symbolic execution has saved at branches and
+/// has not continued yet. The strategy determines which of them is
+/// continued next.
+class path_storaget
+{
+public:
+  /// A segment of the SSA steps along a path: the steps that follow those
+  /// of the parent segment. Paths that are saved at the same branch share
+  /// the segments of their common prefix, such that no steps are copied
+  /// per path.
+  struct segmentt
+  {
+    std::shared_ptr<const segmentt> parent;
+    symex_target_equationt::SSA_stepst SSA_steps;
+
+    segmentt(
+      std::shared_ptr<const segmentt> _parent,
+      symex_target_equationt::SSA_stepst _SSA_steps):
+      parent(std::move(_parent)),
+      SSA_steps(std::move(_SSA_steps))
+    {
+    }
+
+    ~segmentt();
+  };
+
+  typedef std::shared_ptr<const segmentt> segment_ptrt;
+
+  /// A path that is yet to be continued: the last segment of the SSA steps
+  /// along it so far, and the state of symbolic execution at its end
+  struct patht
+  {
+    segment_ptrt prefix;
+    goto_symex_statet state;
+  };
+
+  virtual ~path_storaget()
+  {
+  }
+
+  /// Saves a path that continues the given prefix from a copy of the
+  /// given state
+  void push(const segment_ptrt &prefix, const goto_symex_statet &state);
+
+  /// Appends the SSA steps of all segments of the prefix, starting with
+  /// the first one
+  static void get_SSA_steps(
+    const segment_ptrt &prefix,
+    symex_target_equationt::SSA_stepst &dest);
+
+  /// Removes the path that is to be continued next
+  /// \param [out] dest: list the path is moved to the end of
+  void pop(std::list<patht> &dest)
+  {
+    PRECONDITION(!paths.empty());
+    dest.splice(dest.end(), paths, next());
+  }
+
+  bool empty() const
+  {
+    return paths.empty();
+  }
+
+  std::size_t size() const
+  {
+    return paths.size();
+  }
+
+protected:
+  std::list<patht> paths;
+
+  /// \return the path that is to be continued next
+  virtual std::list<patht>::iterator next()=0;
+};
+
+/// Continues the path saved last, i.e., explores depth-first
+class path_lifot:public path_storaget
+{
+protected:
+  std::list<patht>::iterator next() override
+  {
+    return std::prev(paths.end());
+  }
+};
+
+/// Continues the path saved first, i.e., explores breadth-first
+class path_fifot:public path_storaget
+{
+protected:
+  std::list<patht>::iterator next() override
+  {
+    return paths.begin();
+  }
+};
+
+/// Continues a path chosen uniformly at random. The generator is always
+/// seeded the same, such that runs can be reproduced.
+class path_randomt:public path_storaget
+{
+protected:
+  std::mt19937 generator;
+
+  std::list<patht>::iterator next() override;
+};
+
+/// \param strategy: one of "dfs", "bfs" or "random"
+/// \return storage for paths that implements the given strategy, or nullptr
+///   if there is no such strategy
+std::unique_ptr<path_storaget> get_path_strategy(const std::string &strategy);
+
+#endif // CPROVER_GOTO_SYMEX_PATH_STORAGE_H
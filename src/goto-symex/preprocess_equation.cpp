@@ -0,0 +1,439 @@
+/*******************************************************************\
+
+Module: Word-level Preprocessing of the SSA Equation
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Word-level preprocessing of the SSA equation, which shrinks the
+/// formula before it is converted into bits
+
+#include "preprocess_equation.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+#include <util/arith_tools.h>
+#include <util/simplify_expr.h>
+#include <util/std_expr.h>
+
+class preprocess_equationt
+{
+public:
+  preprocess_equationt(
+    symex_target_equationt &_equation,
+    const namespacet &_ns):
+    equation(_equation),
+    ns(_ns)
+  {
+  }
+
+  void operator()();
+
+  preprocess_equation_statisticst statistics;
+
+protected:
+  typedef symex_target_equationt::SSA_stept SSA_stept;
+  typedef std::unordered_map<irep_idt, exprt, irep_id_hash> substitutiont;
+
+  symex_target_equationt &equation;
+  const namespacet &ns;
+
+  substitutiont substitution;
+
+  struct boundt
+  {
+    bool non_negative=false;
+    bool bounded=false;
+    // exclusive
+    mp_integer upper;
+  };
+
+  std::unordered_map<irep_idt, boundt, irep_id_hash> bounds;
+  std::unordered_map<irep_idt, SSA_stept *, irep_id_hash> definitions;
+
+  bool substitute(const exprt &src, exprt &dest);
+  void substitute_step(SSA_stept &step);
+  void collect_facts(const exprt &cond);
+  void narrow();
+
+  typedef std::unordered_map<irep_idt, std::size_t, irep_id_hash> demandst;
+  void demand(
+    const exprt &expr,
+    demandst &demands,
+    bool whole,
+    const irep_idt &skip) const;
+  bool slice_bits();
+};
+
+static bool is_integer_bv(const typet &type)
+{
+  return type.id()==ID_unsignedbv || type.id()==ID_signedbv;
+}
+
+static std::size_t width(const typet &type)
+{
+  return to_bitvector_type(type).get_width();
+}
+
+/// Replaces the symbols in `substitution`, but not under address_of,
+/// whose symbols are objects rather than values. Nothing is copied unless
+/// a symbol is replaced.
+/// \return true if `dest` has been set to `src` with the symbols replaced
+bool preprocess_equationt::substitute(const exprt &src, exprt &dest)
+{
+  if(src.id()==ID_symbol)
+  {
+    substitutiont::const_iterator it=
+      substitution.find(to_symbol_expr(src).get_identifier());
+
+    if(it==substitution.end())
+      return false;
+
+    dest=it->second;
+    statistics.substitutions++;
+    return true;
+  }
+
+  if(src.id()==ID_address_of || !src.has_operands())
+    return false;
+
+  bool changed=false;
+  const exprt::operandst &operands=src.operands();
+
+  for(std::size_t i=0; i<operands.size(); i++)
+  {
+    exprt tmp;
+    if(substitute(operands[i], tmp))
+    {
+      if(!changed)
+      {
+        dest=src;
+        changed=true;
+      }
+
+      dest.operands()[i].swap(tmp);
+    }
+  }
+
+  return changed;
+}
+
+/// Substitutes into the expressions of `step` that are converted; the
+/// condition of an assignment is rebuilt from its right-hand side, as its
+/// left-hand side is defined rather than read
+void preprocess_equationt::substitute_step(SSA_stept &step)
+{
+  exprt &cond=step.is_assignment()?step.ssa_rhs:step.cond_expr;
+
+  for(exprt *expr : { &step.guard, &cond })
+  {
+    exprt tmp;
+    if(substitute(*expr, tmp))
+    {
+      simplify(tmp, ns);
+      if(tmp.is_constant())
+        statistics.constants++;
+      expr->swap(tmp);
+
+      if(expr==&step.ssa_rhs)
+        step.cond_expr=equal_exprt(step.ssa_lhs, step.ssa_rhs);
+    }
+  }
+}
+
+/// Collects the equalities with constants, and the bounds, that the
+/// conjuncts of `cond` impose on symbols
+void preprocess_equationt::collect_facts(const exprt &cond)
+{
+  if(cond.id()==ID_and)
+  {
+    forall_operands(it, cond)
+      collect_facts(*it);
+    return;
+  }
+
+  // the simplifier may have turned x<c into !(x>=c)
+  const bool negated=cond.id()==ID_not && cond.operands().size()==1;
+  const exprt &relation=negated?cond.op0():cond;
+
+  if(relation.operands().size()!=2)
+    return;
+
+  irep_idt id=relation.id();
+  exprt lhs=relation.op0(), rhs=relation.op1();
+
+  if(negated)
+  {
+    if(id==ID_lt)
+      id=ID_ge;
+    else if(id==ID_gt)
+      id=ID_le;
+    else if(id==ID_le)
+      id=ID_gt;
+    else if(id==ID_ge)
+      id=ID_lt;
+    else
+      return;
+  }
+
+  // put the symbol left
+
+  if(lhs.id()!=ID_symbol)
+  {
+    std::swap(lhs, rhs);
+
+    if(id==ID_lt)
+      id=ID_gt;
+    else if(id==ID_gt)
+      id=ID_lt;
+    else if(id==ID_le)
+      id=ID_ge;
+    else if(id==ID_ge)
+      id=ID_le;
+  }
+
+  if(lhs.id()!=ID_symbol || !rhs.is_constant() || lhs.type()!=rhs.type())
+    return;
+
+  const irep_idt &identifier=to_symbol_expr(lhs).get_identifier();
+
+  if(id==ID_equal)
+  {
+    substitution.insert(std::make_pair(identifier, rhs));
+    return;
+  }
+
+  mp_integer value;
+  if(!is_integer_bv(lhs.type()) || to_integer(rhs, value))
+    return;
+
+  boundt &bound=bounds[identifier];
+
+  // lower bounds
+  if((id==ID_ge && value>=0) || (id==ID_gt && value>=-1))
+    bound.non_negative=true;
+
+  // upper bounds, which we make exclusive
+  if(id==ID_le)
+    ++value;
+
+  if(id==ID_lt || id==ID_le)
+  {
+    if(!bound.bounded || value<bound.upper)
+      bound.upper=value;
+    bound.bounded=true;
+  }
+}
+
+/// Replaces each input whose range is bounded to [0, c) by the zero
+/// extension of an input with the bits for c-1
+void preprocess_equationt::narrow()
+{
+  for(const auto &b : bounds)
+  {
+    const boundt &bound=b.second;
+    const auto definition=definitions.find(b.first);
+
+    if(!bound.bounded || bound.upper<2 || definition==definitions.end())
+      continue;
+
+    SSA_stept &step=*definition->second;
+    const typet &type=step.ssa_lhs.type();
+
+    if(step.ssa_rhs.id()!=ID_nondet_symbol ||
+       (type.id()!=ID_unsignedbv && !bound.non_negative))
+      continue;
+
+    const std::size_t bits=integer2size_t(address_bits(bound.upper));
+
+    if(bits>=width(type))
+      continue;
+
+    statistics.narrowed_bits+=width(type)-bits;
+
+    const exprt &rhs=step.ssa_rhs;
+    const nondet_symbol_exprt input(
+      to_nondet_symbol_expr(rhs).get_identifier(),
+      unsignedbv_typet(bits));
+    step.ssa_rhs=typecast_exprt(input, type);
+    step.cond_expr=equal_exprt(step.ssa_lhs, step.ssa_rhs);
+  }
+}
+
+/// Records the number of low bits of each symbol that `expr` reads: all of
+/// them, unless the symbol is the operand of a narrowing type cast or a
+/// bit extraction
+/// \param whole: whether all bits of the symbols are read regardless
+/// \param skip: symbol that is not read
+void preprocess_equationt::demand(
+  const exprt &expr,
+  demandst &demands,
+  bool whole,
+  const irep_idt &skip) const
+{
+  if(expr.id()==ID_symbol)
+  {
+    const irep_idt &identifier=to_symbol_expr(expr).get_identifier();
+    if(identifier!=skip)
+      demands[identifier]=std::numeric_limits<std::size_t>::max();
+    return;
+  }
+
+  if(!whole && expr.operands().size()>=1 && expr.op0().id()==ID_symbol &&
+     is_integer_bv(expr.op0().type()))
+  {
+    std::size_t bits=0;
+    mp_integer index;
+
+    if(expr.id()==ID_typecast && is_integer_bv(expr.type()))
+      bits=width(expr.type());
+    else if(expr.id()==ID_extractbits && !to_integer(expr.op1(), index))
+      bits=integer2size_t(index)+1;
+    else if(expr.id()==ID_extractbit && !to_integer(expr.op1(), index))
+      bits=integer2size_t(index)+1;
+
+    if(bits>0 && bits<width(expr.op0().type()))
+    {
+      std::size_t &d=demands[to_symbol_expr(expr.op0()).get_identifier()];
+      d=std::max(d, bits);
+
+      for(std::size_t i=1; i<expr.operands().size(); i++)
+        demand(expr.operands()[i], demands, whole, skip);
+
+      return;
+    }
+  }
+
+  forall_operands(it, expr)
+    demand(*it, demands, whole, skip);
+}
+
+/// Inlines the definitions of arithmetic expressions whose value is only
+/// read in part, in the narrower type, which the simplifier then pushes
+/// into the operands
+/// \return true if any definition has been inlined
+bool preprocess_equationt::slice_bits()
+{
+  demandst demands;
+
+  for(const auto &step : equation.SSA_steps)
+  {
+    if(step.ignore)
+      continue;
+
+    demand(step.guard, demands, false, irep_idt());
+    demand(
+      step.is_assignment()?step.ssa_rhs:step.cond_expr,
+      demands,
+      false,
+      irep_idt());
+
+    // these are needed for the trace
+    demand(step.ssa_full_lhs, demands, true, step.ssa_lhs.get_identifier());
+    for(const auto &arg : step.io_args)
+      demand(arg, demands, true, irep_idt());
+  }
+
+  substitution.clear();
+
+  for(auto &step : equation.SSA_steps)
+  {
+    static const irep_idt arithmetic[]=
+    {
+      ID_plus, ID_minus, ID_mult, ID_unary_minus,
+      ID_bitand, ID_bitor, ID_bitxor, ID_bitnot
+    };
+
+    if(step.ignore ||
+       !step.is_assignment() ||
+       !is_integer_bv(step.ssa_lhs.type()) ||
+       std::find(
+         std::begin(arithmetic),
+         std::end(arithmetic),
+         step.ssa_rhs.id())==std::end(arithmetic))
+      continue;
+
+    const demandst::const_iterator d=
+      demands.find(step.ssa_lhs.get_identifier());
+    const typet &type=step.ssa_lhs.type();
+
+    if(d==demands.end() || d->second>=width(type))
+      continue;
+
+    typet narrow_type=type;
+    to_bitvector_type(narrow_type).set_width(d->second);
+
+    // the definition may read symbols inlined before
+    exprt value=typecast_exprt(step.ssa_rhs, narrow_type);
+    exprt tmp;
+    if(substitute(value, tmp))
+      value.swap(tmp);
+
+    substitution[step.ssa_lhs.get_identifier()]=value;
+
+    statistics.sliced_bits+=width(type)-d->second;
+    step.ignore=true;
+  }
+
+  if(substitution.empty())
+    return false;
+
+  for(auto &step : equation.SSA_steps)
+    if(!step.ignore)
+      substitute_step(step);
+
+  return true;
+}
+
+void preprocess_equationt::operator()()
+{
+  if(equation.has_threads())
+    return;
+
+  bool before_assertion=true;
+
+  for(auto &step : equation.SSA_steps)
+  {
+    if(step.ignore)
+      continue;
+
+    substitute_step(step);
+
+    if(step.is_assignment())
+    {
+      const irep_idt &identifier=step.ssa_lhs.get_identifier();
+      definitions[identifier]=&step;
+
+      // copy and constant propagation
+      if((step.ssa_rhs.is_constant() || step.ssa_rhs.id()==ID_symbol) &&
+         step.ssa_rhs.type()==step.ssa_lhs.type())
+        substitution.insert(std::make_pair(identifier, step.ssa_rhs));
+    }
+    else if(step.is_assert())
+      before_assertion=false;
+    else if((step.is_assume() || step.is_constraint()) &&
+            before_assertion &&
+            step.guard.is_true())
+      collect_facts(step.cond_expr);
+  }
+
+  narrow();
+
+  // each round may make further definitions narrow
+  for(unsigned round=0; round<4 && slice_bits(); round++)
+  {
+  }
+}
+
+preprocess_equation_statisticst preprocess_equation(
+  symex_target_equationt &equation,
+  const namespacet &ns)
+{
+  preprocess_equationt preprocess(equation, ns);
+  preprocess();
+  return preprocess.statistics;
+}
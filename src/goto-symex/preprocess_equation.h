@@ -0,0 +1,50 @@
+/*******************************************************************\
+
+Module: Word-level Preprocessing of the SSA Equation
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Word-level preprocessing of the SSA equation, which shrinks the
+/// formula before it is converted into bits
+
+#ifndef CPROVER_GOTO_SYMEX_PREPROCESS_EQUATION_H
+#define CPROVER_GOTO_SYMEX_PREPROCESS_EQUATION_H
+
+#include <cstddef>
+
+#include "symex_target_equation.h"
+
+class namespacet;
+
+struct preprocess_equation_statisticst
+{
+  // symbols replaced by a constant or another symbol
+  std::size_t substitutions=0;
+  // expressions that simplify to a constant after the substitution
+  std::size_t constants=0;
+  // bits of the inputs whose range the assumptions bound
+  std::size_t narrowed_bits=0;
+  // bits of definitions that are only read in part
+  std::size_t sliced_bits=0;
+};
+
+/// Preprocesses the steps of `equation` that are not ignored:
+/// - Symbols that are defined as a constant or another symbol, or that
+///   an unconditional assumption before the first assertion equates to a
+///   constant, are replaced by it in the later steps, and the expressions
+///   that change are simplified, which folds constants across steps.
+/// - Inputs of integer type whose range such an assumption bounds to
+///   [0, c) become the zero extension of an input with just enough bits
+///   for c-1.
+/// - Definitions of arithmetic expressions whose value is only read by
+///   narrowing type casts or bit extractions are inlined in the narrower
+///   type, and ignored like the steps that the slicer removes.
+/// Equations with threads are left alone.
+preprocess_equation_statisticst preprocess_equation(
+  symex_target_equationt &equation,
+  const namespacet &ns);
+
+#endif // CPROVER_GOTO_SYMEX_PREPROCESS_EQUATION_H
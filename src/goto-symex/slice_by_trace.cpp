@@ -298,7 +298,7 @@ void symex_slice_by_tracet::compute_ts_back(
           if(!sigma_vals[j].empty())
           {
             std::list<exprt> eq_conds;
-            std::list<exprt>::iterator pvi=i->io_args.begin();
+            auto pvi=i->io_args.begin();
             for(std::vector<irep_idt>::iterator k=sigma_vals[j].begin();
                  k!=sigma_vals[j].end(); k++)
             {
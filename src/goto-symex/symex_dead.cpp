@@ -60,7 +60,6 @@ void goto_symext::symex_dead(statet &state)
   state.propagation.remove(l1_identifier);
 
   // L2 renaming
-  if(state.level2.current_names.find(l1_identifier)!=
-     state.level2.current_names.end())
+  if(state.level2.current_names.has_key(l1_identifier))
     state.level2.increase_counter(l1_identifier);
 }
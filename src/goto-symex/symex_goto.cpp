@@ -113,7 +113,8 @@ void goto_symext::symex_goto(statet &state)
       while(state_pc!=goto_target && !state_pc->is_target())
         ++state_pc;
 
-    if(state_pc==goto_target)
+    if(state_pc==goto_target ||
+       (path_exploration && new_guard.is_true()))
     {
       symex_transition(state, goto_target);
       return; // nothing else to do
@@ -126,6 +127,29 @@ void goto_symext::symex_goto(statet &state)
     state_pc=goto_target;
   }
 
+  if(path_exploration)
+  {
+    // the current path ends here; the paths along both successors
+    // are continued separately
+    exprt guard_expr=branch_guard(state, new_guard, original_source);
+
+    branch_successors.emplace_back();
+    statet &taken=branch_successors.back();
+    taken.copy_path_from(state);
+    taken.guard.add(guard_expr);
+    symex_transition(taken, goto_target, !forward);
+
+    guard_expr.make_not();
+
+    branch_successors.emplace_back();
+    statet &not_taken=branch_successors.back();
+    not_taken.copy_path_from(state);
+    not_taken.guard.add(guard_expr);
+    symex_transition(not_taken);
+
+    return;
+  }
+
   // put into state-queue
   statet::goto_state_listt &goto_state_list=
     state.top().goto_state_map[new_state_pc];
@@ -142,38 +166,7 @@ void goto_symext::symex_goto(statet &state)
   }
   else
   {
-    // produce new guard symbol
-    exprt guard_expr;
-
-    if(new_guard.id()==ID_symbol ||
-       (new_guard.id()==ID_not &&
-        new_guard.operands().size()==1 &&
-        new_guard.op0().id()==ID_symbol))
-      guard_expr=new_guard;
-    else
-    {
-      symbol_exprt guard_symbol_expr=
-        symbol_exprt(guard_identifier, bool_typet());
-      exprt new_rhs=new_guard;
-      new_rhs.make_not();
-
-      ssa_exprt new_lhs(guard_symbol_expr);
-      state.rename(new_lhs, ns, goto_symex_statet::L1);
-      state.assignment(new_lhs, new_rhs, ns, true, false);
-
-      guardt guard;
-
-      target.assignment(
-        guard.as_expr(),
-        new_lhs, new_lhs, guard_symbol_expr,
-        new_rhs,
-        original_source,
-        symex_targett::assignment_typet::GUARD);
-
-      guard_expr=guard_symbol_expr;
-      guard_expr.make_not();
-      state.rename(guard_expr, ns);
-    }
+    exprt guard_expr=branch_guard(state, new_guard, original_source);
 
     if(forward)
     {
@@ -190,6 +183,47 @@ void goto_symext::symex_goto(statet &state)
   }
 }
 
+/// \param new_guard: the renamed condition of a goto instruction
+/// \param source: the goto instruction
+/// \return an expression that holds iff the goto is taken and that is
+///   cheap to copy into guards: the condition itself if it is a possibly
+///   negated symbol, or a fresh guard symbol that is assigned the condition
+exprt goto_symext::branch_guard(
+  statet &state,
+  const exprt &new_guard,
+  const symex_targett::sourcet &source)
+{
+  if(new_guard.id()==ID_symbol ||
+     (new_guard.id()==ID_not &&
+      new_guard.operands().size()==1 &&
+      new_guard.op0().id()==ID_symbol))
+    return new_guard;
+
+  symbol_exprt guard_symbol_expr=
+    symbol_exprt(guard_identifier, bool_typet());
+  exprt new_rhs=new_guard;
+  new_rhs.make_not();
+
+  ssa_exprt new_lhs(guard_symbol_expr);
+  state.rename(new_lhs, ns, goto_symex_statet::L1);
+  state.assignment(new_lhs, new_rhs, ns, true, false);
+
+  guardt guard;
+
+  target.assignment(
+    guard.as_expr(),
+    new_lhs, new_lhs, guard_symbol_expr,
+    new_rhs,
+    source,
+    symex_targett::assignment_typet::GUARD);
+
+  exprt guard_expr=guard_symbol_expr;
+  guard_expr.make_not();
+  state.rename(guard_expr, ns);
+
+  return guard_expr;
+}
+
 void goto_symext::symex_step_goto(statet &state, bool taken)
 {
   const goto_programt::instructiont &instruction=*state.source.pc;
@@ -268,11 +302,28 @@ void goto_symext::phi_function(
   const statet::goto_statet &goto_state,
   statet &dest_state)
 {
-  // go over all variables to see what changed
+  // go over the variables that may have changed, i.e., the ones whose
+  // entries are not shared between the states
   std::unordered_set<ssa_exprt, irep_hash> variables;
 
-  goto_state.level2_get_variables(variables);
-  dest_state.level2.get_variables(variables);
+  {
+    statet::level2t::current_namest::delta_viewt delta_view;
+    goto_state.level2_current_names.get_delta_view(
+      dest_state.level2.current_names, delta_view, false);
+
+    for(const auto &item : delta_view)
+      variables.insert(item.m.first);
+  }
+
+  {
+    statet::level2t::current_namest::delta_viewt delta_view;
+    dest_state.level2.current_names.get_delta_view(
+      goto_state.level2_current_names, delta_view, false);
+
+    for(const auto &item : delta_view)
+      if(!item.in_both)
+        variables.insert(item.m.first);
+  }
 
   guardt diff_guard;
 
@@ -322,22 +373,22 @@ void goto_symext::phi_function(
     exprt goto_state_rhs=*it, dest_state_rhs=*it;
 
     {
-      goto_symex_statet::propagationt::valuest::const_iterator p_it=
+      goto_symex_statet::propagationt::valuest::const_find_type p_it=
         goto_state.propagation.values.find(l1_identifier);
 
-      if(p_it!=goto_state.propagation.values.end())
-        goto_state_rhs=p_it->second;
+      if(p_it.second)
+        goto_state_rhs=p_it.first;
       else
         to_ssa_expr(goto_state_rhs).set_level_2(
           goto_state.level2_current_count(l1_identifier));
     }
 
     {
-      goto_symex_statet::propagationt::valuest::const_iterator p_it=
-        dest_state.propagation.values.find(l1_identifier);
+      goto_symex_statet::propagationt::valuest::const_find_type p_it=
+        as_const(&dest_state.propagation.values)->find(l1_identifier);
 
-      if(p_it!=dest_state.propagation.values.end())
-        dest_state_rhs=p_it->second;
+      if(p_it.second)
+        dest_state_rhs=p_it.first;
       else
         to_ssa_expr(dest_state_rhs).set_level_2(
           dest_state.level2.current_count(l1_identifier));
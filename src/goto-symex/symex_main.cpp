@@ -173,7 +173,8 @@ void goto_symext::operator()(
     prev(goto_program.instructions.end()));
   PRECONDITION(state.top().end_of_function->is_end_function());
 
-  while(!state.call_stack().empty())
+  // in path exploration, the path may end at a branch
+  while(!state.call_stack().empty() && branch_successors.empty())
     symex_threaded_step(state, goto_functions);
 
   state.dirty=nullptr;
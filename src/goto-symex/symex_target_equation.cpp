@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "symex_target_equation.h"
 
 #include <cassert>
+#include <iterator>
 
 #include <util/std_expr.h>
 
@@ -23,7 +24,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "goto_symex_state.h"
 
 symex_target_equationt::symex_target_equationt(
-  const namespacet &_ns):ns(_ns)
+  const namespacet &_ns):
+  ns(_ns),
+  converted_steps(0),
+  converted_io_args(0),
+  assumptions_literal(const_literal(true)),
+  stream_prop_conv(nullptr),
+  hash_consing(false)
 {
 }
 
@@ -48,6 +55,7 @@ void symex_target_equationt::shared_read(
   SSA_step.source=source;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// write to a sharedvariable
@@ -67,6 +75,7 @@ void symex_target_equationt::shared_write(
   SSA_step.source=source;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// spawn a new thread
@@ -74,6 +83,10 @@ void symex_target_equationt::spawn(
   const exprt &guard,
   const sourcet &source)
 {
+  // the memory model needs the guards of all the steps of all threads
+  if(is_streaming())
+    throw "streaming SSA conversion does not support threads";
+
   SSA_steps.push_back(SSA_stept());
   SSA_stept &SSA_step=SSA_steps.back();
   SSA_step.guard=guard;
@@ -81,6 +94,7 @@ void symex_target_equationt::spawn(
   SSA_step.source=source;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 void symex_target_equationt::memory_barrier(
@@ -94,6 +108,7 @@ void symex_target_equationt::memory_barrier(
   SSA_step.source=source;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// start an atomic section
@@ -110,6 +125,7 @@ void symex_target_equationt::atomic_begin(
   SSA_step.source=source;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// end an atomic section
@@ -126,6 +142,7 @@ void symex_target_equationt::atomic_end(
   SSA_step.source=source;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// write to a variable
@@ -157,6 +174,7 @@ void symex_target_equationt::assignment(
   SSA_step.source=source;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// declare a fresh variable
@@ -184,6 +202,7 @@ void symex_target_equationt::decl(
   SSA_step.cond_expr=equal_exprt(SSA_step.ssa_lhs, SSA_step.ssa_lhs);
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// declare a fresh variable
@@ -208,6 +227,7 @@ void symex_target_equationt::location(
   SSA_step.source=source;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// just record a location
@@ -225,6 +245,7 @@ void symex_target_equationt::function_call(
   SSA_step.identifier=identifier;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// just record a location
@@ -242,6 +263,7 @@ void symex_target_equationt::function_return(
   SSA_step.identifier=identifier;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// just record output
@@ -261,6 +283,7 @@ void symex_target_equationt::output(
   SSA_step.io_id=output_id;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// just record formatted output
@@ -283,6 +306,7 @@ void symex_target_equationt::output_fmt(
   SSA_step.format_string=fmt;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// just record input
@@ -302,6 +326,7 @@ void symex_target_equationt::input(
   SSA_step.io_id=input_id;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// record an assumption
@@ -319,6 +344,7 @@ void symex_target_equationt::assumption(
   SSA_step.source=source;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// record an assertion
@@ -338,6 +364,7 @@ void symex_target_equationt::assertion(
   SSA_step.comment=msg;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// record a goto instruction
@@ -355,6 +382,7 @@ void symex_target_equationt::goto_instruction(
   SSA_step.source=source;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 /// record a constraint
@@ -374,11 +402,23 @@ void symex_target_equationt::constraint(
   SSA_step.comment=msg;
 
   merge_ireps(SSA_step);
+  stream_step(SSA_step);
 }
 
 void symex_target_equationt::convert(
   prop_convt &prop_conv)
 {
+  if(is_streaming())
+  {
+    // all the steps have been converted as they were recorded
+    PRECONDITION(&prop_conv==stream_prop_conv);
+
+    if(!stream_failures.empty())
+      prop_conv.set_to_true(disjunction(stream_failures));
+
+    return;
+  }
+
   convert_guards(prop_conv);
   convert_assignments(prop_conv);
   convert_decls(prop_conv);
@@ -574,7 +614,7 @@ void symex_target_equationt::convert_io(
           symbol.set_identifier("symex::io::"+std::to_string(io_count++));
 
           equal_exprt eq(arg, symbol);
-          merge_irep(eq);
+          merge_expr(eq);
 
           dec_proc.set_to(eq, true);
           step.converted_io_args.push_back(symbol);
@@ -583,20 +623,175 @@ void symex_target_equationt::convert_io(
     }
 }
 
+literalt symex_target_equationt::convert_incremental(prop_convt &prop_conv)
+{
+  exprt::operandst failures;
+
+  for(auto it=std::next(SSA_steps.begin(), converted_steps);
+      it!=SSA_steps.end();
+      it++, converted_steps++)
+    convert_step(prop_conv, *it, failures);
+
+  return prop_conv.convert(disjunction(failures));
+}
+
+void symex_target_equationt::stream_to(prop_convt &prop_conv)
+{
+  PRECONDITION(SSA_steps.empty());
+  stream_prop_conv=&prop_conv;
+}
+
+/// Converts a single step, after all the steps before it. Only the
+/// assumptions converted so far constrain an assertion.
+/// \param prop_conv: the solver to convert to
+/// \param step: the step to convert
+/// \param [out] failures: a literal that is true iff the step is an
+///   assertion that fails is added to this
+void symex_target_equationt::convert_step(
+  prop_convt &prop_conv,
+  SSA_stept &step,
+  exprt::operandst &failures)
+{
+  if(step.ignore)
+  {
+    step.guard_literal=const_literal(false);
+    if(step.is_assume() || step.is_goto())
+      step.cond_literal=const_literal(true);
+    return;
+  }
+
+  step.guard_literal=prop_conv.convert(step.guard);
+
+  if(step.is_assignment() || step.is_constraint())
+    prop_conv.set_to_true(step.cond_expr);
+  else if(step.is_decl())
+    prop_conv.convert(step.cond_expr);
+  else if(step.is_goto())
+    step.cond_literal=prop_conv.convert(step.cond_expr);
+  else if(step.is_assume())
+  {
+    step.cond_literal=prop_conv.convert(step.cond_expr);
+    assumptions_literal=prop_conv.convert(
+      and_exprt(
+        literal_exprt(assumptions_literal),
+        literal_exprt(step.cond_literal)));
+  }
+  else if(step.is_assert())
+  {
+    // as in convert_assertions, only the assumptions so far count
+    implies_exprt implication(
+      literal_exprt(assumptions_literal),
+      step.cond_expr);
+    step.cond_literal=prop_conv.convert(implication);
+    failures.push_back(literal_exprt(!step.cond_literal));
+  }
+
+  for(const auto &arg : step.io_args)
+  {
+    if(arg.is_constant() ||
+       arg.id()==ID_string_constant)
+      step.converted_io_args.push_back(arg);
+    else
+    {
+      symbol_exprt symbol;
+      symbol.type()=arg.type();
+      symbol.set_identifier(
+        "symex::io::"+std::to_string(converted_io_args++));
 
+      equal_exprt eq(arg, symbol);
+      merge_expr(eq);
+
+      prop_conv.set_to(eq, true);
+      step.converted_io_args.push_back(symbol);
+    }
+  }
+}
+
+/// \return a symbol of a dynamically allocated object in `expr`, or nil
+///   if there is none
+static const exprt &find_dynamic_object(
+  const exprt &expr,
+  const namespacet &ns)
+{
+  if(expr.id()==ID_symbol)
+  {
+    const symbolt *symbol;
+    if(!ns.lookup(to_ssa_expr(expr).get_original_name(), symbol) &&
+       symbol->type.get_bool("#dynamic"))
+      return expr;
+  }
+  else
+  {
+    forall_operands(it, expr)
+    {
+      const exprt &result=find_dynamic_object(*it, ns);
+      if(result.is_not_nil())
+        return result;
+    }
+  }
+
+  return static_cast<const exprt &>(get_nil_irep());
+}
+
+/// In streaming mode, converts the step just recorded and then drops the
+/// expressions that only the conversion needed. What build_goto_trace
+/// reads is kept: the left-hand sides, the conditions of assertions,
+/// assumptions and gotos, and the literals. Of the right-hand side, only
+/// a dynamically allocated object it refers to is kept, which marks the
+/// step as internal in the trace.
+void symex_target_equationt::stream_step(SSA_stept &SSA_step)
+{
+  if(!is_streaming())
+    return;
+
+  convert_step(*stream_prop_conv, SSA_step, stream_failures);
+  converted_steps++;
+
+  SSA_step.guard.make_nil();
+  SSA_step.ssa_rhs=find_dynamic_object(SSA_step.ssa_rhs, ns);
+  SSA_step.io_args.clear();
+
+  if(SSA_step.is_assignment() ||
+     SSA_step.is_decl() ||
+     SSA_step.is_constraint())
+    SSA_step.cond_expr.make_nil();
+
+  // the solver would otherwise keep what was just dropped
+  stream_prop_conv->prune_cache();
+}
+
+void symex_target_equationt::merge_expr(exprt &expr)
+{
+  // hash consing subsumes merging
+  if(hash_consing)
+    hash_cons_table(expr);
+  else
+    merge_irep(expr);
+}
+
+/// Merges the expressions of the step with those of the steps before. In
+/// streaming mode, only those that stream_step keeps are merged, as the
+/// merge table would otherwise keep the dropped ones alive.
 void symex_target_equationt::merge_ireps(SSA_stept &SSA_step)
 {
-  merge_irep(SSA_step.guard);
+  merge_expr(SSA_step.ssa_lhs);
+  merge_expr(SSA_step.ssa_full_lhs);
+  merge_expr(SSA_step.original_full_lhs);
+
+  if(!is_streaming() ||
+     !(SSA_step.is_assignment() ||
+       SSA_step.is_decl() ||
+       SSA_step.is_constraint()))
+    merge_expr(SSA_step.cond_expr);
 
-  merge_irep(SSA_step.ssa_lhs);
-  merge_irep(SSA_step.ssa_full_lhs);
-  merge_irep(SSA_step.original_full_lhs);
-  merge_irep(SSA_step.ssa_rhs);
+  if(is_streaming())
+    return;
 
-  merge_irep(SSA_step.cond_expr);
+  merge_expr(SSA_step.guard);
+  merge_expr(SSA_step.ssa_rhs);
 
   for(auto &step : SSA_step.io_args)
-    merge_irep(step);
+    merge_expr(step);
 
   // converted_io_args is merged in convert_io
 }
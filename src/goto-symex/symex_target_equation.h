@@ -14,7 +14,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <list>
 #include <iosfwd>
+#include <iterator>
+#include <memory>
 
+#include <util/chunked_vector.h>
+#include <util/hash_cons.h>
 #include <util/merge_irep.h>
 
 #include <goto-programs/goto_program.h>
@@ -165,8 +169,119 @@ public:
   void convert_guards(prop_convt &prop_conv);
   void convert_io(decision_proceduret &decision_procedure);
 
+  /// Converts the steps added since the previous call, such that a growing
+  /// equation can be passed to the same solver repeatedly. Unlike
+  /// convert(), this does not constrain the assertions to fail.
+  /// \return literal that is true iff one of the newly converted
+  ///   assertions fails
+  literalt convert_incremental(prop_convt &prop_conv);
+
+  /// Converts each step to `prop_conv` as soon as it is recorded, and
+  /// then releases the expressions that are no longer needed to build a
+  /// trace, such that the equation does not hold the program expression in
+  /// full. convert() then only adds the assertions. The steps cannot be
+  /// sliced, shown or used for a witness of correctness afterwards, and
+  /// threads are not supported. Must be called before any step is recorded.
+  void stream_to(prop_convt &prop_conv);
+
+  bool is_streaming() const
+  {
+    return stream_prop_conv!=nullptr;
+  }
+
+  /// \return literal that is true iff all the assumptions converted by
+  ///   convert_incremental hold
+  literalt get_assumptions_literal() const
+  {
+    return assumptions_literal;
+  }
+
   exprt make_expression() const;
 
+  /// A list of expressions that is kept out of line, as only the steps
+  /// for input and output have any: an empty list takes a single pointer
+  /// in the step.
+  class io_argst
+  {
+  public:
+    typedef std::list<exprt> listt;
+    // NOLINTNEXTLINE(readability/identifiers)
+    typedef listt::iterator iterator;
+    // NOLINTNEXTLINE(readability/identifiers)
+    typedef listt::const_iterator const_iterator;
+
+    io_argst()=default;
+    io_argst(io_argst &&)=default;
+    io_argst &operator=(io_argst &&)=default;
+
+    io_argst(const io_argst &other)
+    {
+      *this=other.get();
+    }
+
+    io_argst &operator=(const io_argst &other)
+    {
+      if(this!=&other)
+        *this=other.get();
+      return *this;
+    }
+
+    io_argst &operator=(const listt &other)
+    {
+      if(other.empty())
+        list.reset();
+      else
+        list=std::unique_ptr<listt>(new listt(other));
+      return *this;
+    }
+
+    bool empty() const { return list==nullptr || list->empty(); }
+    std::size_t size() const { return list==nullptr?0:list->size(); }
+
+    const_iterator begin() const { return get().begin(); }
+    const_iterator end() const { return get().end(); }
+    // iterating does not allocate: a step without a list yields the
+    // (empty) range of a shared list that is never modified
+    iterator begin()
+    {
+      return list==nullptr?empty_list().begin():list->begin();
+    }
+
+    iterator end()
+    {
+      return list==nullptr?empty_list().end():list->end();
+    }
+
+    const exprt &front() const { return get().front(); }
+    const exprt &back() const { return get().back(); }
+    exprt &front() { return get_writable().front(); }
+    exprt &back() { return get_writable().back(); }
+
+    void push_back(const exprt &expr) { get_writable().push_back(expr); }
+    void clear() { list.reset(); }
+
+    const listt &get() const
+    {
+      return list==nullptr?empty_list():*list;
+    }
+
+  protected:
+    std::unique_ptr<listt> list;
+
+    static listt &empty_list()
+    {
+      static listt empty;
+      return empty;
+    }
+
+    listt &get_writable()
+    {
+      if(list==nullptr)
+        list=std::unique_ptr<listt>(new listt());
+      return *list;
+    }
+  };
+
   class SSA_stept
   {
   public:
@@ -226,8 +341,8 @@ public:
     // for INPUT/OUTPUT
     irep_idt format_string, io_id;
     bool formatted=false;
-    std::list<exprt> io_args;
-    std::list<exprt> converted_io_args;
+    io_argst io_args;
+    io_argst converted_io_args;
 
     // for function call/return
     irep_idt identifier;
@@ -283,18 +398,15 @@ public:
     return i;
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  // The steps are stored in chunks rather than in a node each, and only
+  // ever added at either end, which keeps iterators to them valid.
+  typedef chunked_vectort<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
   SSA_stepst::iterator get_SSA_step(std::size_t s)
   {
-    SSA_stepst::iterator it=SSA_steps.begin();
-    for(; s!=0; s--)
-    {
-      assert(it!=SSA_steps.end());
-      it++;
-    }
-    return it;
+    assert(s<=SSA_steps.size());
+    return std::next(SSA_steps.begin(), s);
   }
 
   void output(std::ostream &out) const;
@@ -304,6 +416,26 @@ public:
     SSA_steps.clear();
   }
 
+  /// Share all structurally equal expressions of the steps recorded from
+  /// now on via a table of this equation, rather than merging the
+  /// expressions of each step
+  void set_hash_consing(bool enabled)
+  {
+    hash_consing=enabled;
+  }
+
+  const hash_cons_tablet &get_hash_cons_table() const
+  {
+    return hash_cons_table;
+  }
+
+  /// Releases the nodes held by the table, e.g., once symbolic execution
+  /// is done. The steps recorded so far keep sharing them.
+  void clear_hash_cons_table()
+  {
+    hash_cons_table.clear();
+  }
+
   bool has_threads() const
   {
     for(SSA_stepst::const_iterator it=SSA_steps.begin();
@@ -318,18 +450,29 @@ public:
 protected:
   const namespacet &ns;
 
+  // progress of convert_incremental
+  std::size_t converted_steps;
+  std::size_t converted_io_args;
+  literalt assumptions_literal;
+
+  // the solver that the steps are converted to as they are recorded
+  prop_convt *stream_prop_conv;
+  exprt::operandst stream_failures;
+
+  void convert_step(
+    prop_convt &prop_conv,
+    SSA_stept &step,
+    exprt::operandst &failures);
+  void stream_step(SSA_stept &SSA_step);
+
   // for enforcing sharing in the expressions stored
   merge_irept merge_irep;
+  bool hash_consing;
+  hash_cons_tablet hash_cons_table;
+  void merge_expr(exprt &expr);
   void merge_ireps(SSA_stept &SSA_step);
 };
 
-inline bool operator<(
-  const symex_target_equationt::SSA_stepst::const_iterator a,
-  const symex_target_equationt::SSA_stepst::const_iterator b)
-{
-  return &(*a)<&(*b);
-}
-
 std::ostream &operator<<(
   std::ostream &out,
   const symex_target_equationt::SSA_stept &step);
@@ -532,7 +532,8 @@ bool java_bytecode_convert_class(
 ///   parameter identifier)
 static void find_and_replace_parameter(
   java_generic_parametert &parameter,
-  const std::vector<java_generic_parametert> &replacement_parameters)
+  const java_implicitly_generic_class_typet::implicit_generic_typest
+    &replacement_parameters)
 {
   // get the name of the parameter, e.g., `T` from `java::Class::T`
   const std::string &parameter_full_name =
@@ -581,7 +582,8 @@ static void find_and_replace_parameter(
 /// \param replacement_parameters
 static void find_and_replace_parameters(
   typet &type,
-  const std::vector<java_generic_parametert> &replacement_parameters)
+  const java_implicitly_generic_class_typet::implicit_generic_typest
+    &replacement_parameters)
 {
   if(is_java_generic_parameter(type))
   {
@@ -591,7 +593,7 @@ static void find_and_replace_parameters(
   else if(is_java_generic_type(type))
   {
     java_generic_typet &generic_type = to_java_generic_type(type);
-    std::vector<reference_typet> &arguments =
+    java_generic_typet::generic_type_argumentst &arguments =
       generic_type.generic_type_arguments();
     for(auto &argument : arguments)
     {
@@ -632,7 +634,8 @@ void mark_java_implicitly_generic_class_type(
 
   // create a vector of all generic type parameters of all outer classes, in
   // the order from the outer-most inwards
-  std::vector<java_generic_parametert> implicit_generic_type_parameters;
+  java_implicitly_generic_class_typet::implicit_generic_typest
+    implicit_generic_type_parameters;
   std::string::size_type outer_class_delimiter =
     qualified_class_name.rfind("$");
   while(outer_class_delimiter != std::string::npos)
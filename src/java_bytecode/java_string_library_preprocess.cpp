@@ -1455,7 +1455,7 @@ codet java_string_library_preprocesst::make_string_format_code(
 
   // We will process arguments so that each is converted to a `struct_exprt`
   // containing each possible type used in format specifiers.
-  std::vector<exprt> processed_args;
+  exprt::operandst processed_args;
   processed_args.push_back(args[0]);
   for(std::size_t i=0; i<MAX_FORMAT_ARGS; ++i)
     processed_args.push_back(make_argument_for_format(
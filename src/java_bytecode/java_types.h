@@ -128,7 +128,7 @@ public:
   }
 
 private:
-  typedef std::vector<type_variablet> type_variablest;
+  typedef irep_sub_vectort<type_variablet> type_variablest;
   const type_variablest &type_variables() const
   {
     return (const type_variablest &)(find(ID_type_variables).get_sub());
@@ -184,7 +184,7 @@ inline java_generic_parametert &to_java_generic_parameter(typet &type)
 class java_generic_typet:public reference_typet
 {
 public:
-  typedef std::vector<reference_typet> generic_type_argumentst;
+  typedef irep_sub_vectort<reference_typet> generic_type_argumentst;
 
   explicit java_generic_typet(const typet &_type):
     reference_typet(java_reference_type(_type))
@@ -241,7 +241,7 @@ inline java_generic_typet &to_java_generic_type(typet &type)
 class java_generic_class_typet:public java_class_typet
 {
  public:
-  typedef std::vector<java_generic_parametert> generic_typest;
+  typedef irep_sub_vectort<java_generic_parametert> generic_typest;
 
   java_generic_class_typet()
   {
@@ -292,7 +292,7 @@ inline const typet &java_generic_get_inst_type(
   size_t index,
   const java_generic_typet &type)
 {
-  const std::vector<reference_typet> &type_arguments =
+  const java_generic_typet::generic_type_argumentst &type_arguments =
     type.generic_type_arguments();
   PRECONDITION(index<type_arguments.size());
   return type_arguments[index];
@@ -305,7 +305,8 @@ inline const typet &java_generic_get_inst_type(
 inline const irep_idt &
 java_generic_class_type_var(size_t index, const java_generic_class_typet &type)
 {
-  const std::vector<java_generic_parametert> &gen_types=type.generic_types();
+  const java_generic_class_typet::generic_typest &gen_types=
+    type.generic_types();
 
   PRECONDITION(index<gen_types.size());
   const java_generic_parametert &gen_type=gen_types[index];
@@ -322,7 +323,8 @@ inline const typet &java_generic_class_type_bound(size_t index, const typet &t)
   PRECONDITION(is_java_generic_class_type(t));
   const java_generic_class_typet &type =
     to_java_generic_class_type(to_java_class_type(t));
-  const std::vector<java_generic_parametert> &gen_types=type.generic_types();
+  const java_generic_class_typet::generic_typest &gen_types=
+    type.generic_types();
 
   PRECONDITION(index<gen_types.size());
   const java_generic_parametert &gen_type=gen_types[index];
@@ -336,7 +338,7 @@ inline const typet &java_generic_class_type_bound(size_t index, const typet &t)
 class java_implicitly_generic_class_typet : public java_class_typet
 {
 public:
-  typedef std::vector<java_generic_parametert> implicit_generic_typest;
+  typedef irep_sub_vectort<java_generic_parametert> implicit_generic_typest;
 
   explicit java_implicitly_generic_class_typet(
     const java_class_typet &class_type,
@@ -421,7 +423,7 @@ inline typet java_type_from_string_with_exception(
 /// \param identifier The string identifier of the type of the component.
 /// \return Optional with the size if the identifier was found.
 inline const optionalt<size_t> java_generics_get_index_for_subtype(
-  const std::vector<java_generic_parametert> &gen_types,
+  const java_generic_class_typet::generic_typest &gen_types,
   const irep_idt &identifier)
 {
   const auto iter = std::find_if(
@@ -450,7 +452,7 @@ void get_dependencies_from_generic_parameters(
 class java_specialized_generic_class_typet : public java_class_typet
 {
 public:
-  typedef std::vector<reference_typet> generic_type_argumentst;
+  typedef irep_sub_vectort<reference_typet> generic_type_argumentst;
 
   /// Build the specialised version of the specific class, with the specified
   /// parameters and name.
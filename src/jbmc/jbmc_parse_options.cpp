@@ -926,6 +926,7 @@ void jbmc_parse_optionst::help()
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
+    " --profile-json file          write time and memory used per phase to file\n" // NOLINT(*)
     " --xml-ui                     use XML-formatted output\n"
     " --json-ui                    use JSON-formatted output\n"
     HELP_GOTO_TRACE
@@ -56,7 +56,7 @@ class optionst;
   "(drop-unused-functions)" \
   "(property):(stop-on-fail)(trace)" \
   "(verbosity):" \
-  "(version)" \
+  "(version)(profile-json):" \
   "(cover):(symex-coverage-report):" \
   "(i386-linux)(i386-macos)(i386-win32)(win32)(winx64)" \
   "(ppc-macos)" \
@@ -173,7 +173,7 @@ jsil_union_typet jsil_union_typet::union_with(
   jsil_union_typet result;
   auto &elements=result.components();
   elements.resize(elements1.size()+elements2.size());
-  std::vector<union_typet::componentt>::iterator it=std::set_union(
+  union_typet::componentst::iterator it=std::set_union(
     elements1.begin(), elements1.end(),
     elements2.begin(), elements2.end(),
     elements.begin(), compare_components);
@@ -190,7 +190,7 @@ jsil_union_typet jsil_union_typet::intersect_with(
   jsil_union_typet result;
   auto &elements=result.components();
   elements.resize(std::min(elements1.size(), elements2.size()));
-  std::vector<union_typet::componentt>::iterator it=std::set_intersection(
+  union_typet::componentst::iterator it=std::set_intersection(
     elements1.begin(), elements1.end(),
     elements2.begin(), elements2.end(),
     elements.begin(), compare_components);
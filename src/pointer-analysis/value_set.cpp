@@ -11,8 +11,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "value_set.h"
 
+#include <algorithm>
 #include <cassert>
+#include <list>
 #include <ostream>
+#include <vector>
 
 #include <util/symbol_table.h>
 #include <util/simplify_expr.h>
@@ -66,10 +69,7 @@ value_sett::entryt &value_sett::get_entry(
   else
     index=e.identifier;
 
-  std::pair<valuest::iterator, bool> r=
-    values.insert(std::pair<idt, entryt>(index, e));
-
-  return r.first->second;
+  return values.place(index, e).first;
 }
 
 bool value_sett::insert(
@@ -96,18 +96,37 @@ bool value_sett::insert(
   }
 }
 
+std::vector<const value_sett::valuest::view_itemt *>
+value_sett::sort_view(const valuest::viewt &view)
+{
+  std::vector<const valuest::view_itemt *> sorted;
+  sorted.reserve(view.size());
+  for(const auto &item : view)
+    sorted.push_back(&item);
+
+  std::sort(
+    sorted.begin(),
+    sorted.end(),
+    [](const valuest::view_itemt *a, const valuest::view_itemt *b)
+    {
+      return a->first<b->first;
+    });
+
+  return sorted;
+}
+
 void value_sett::output(
   const namespacet &ns,
   std::ostream &out) const
 {
-  for(valuest::const_iterator
-      v_it=values.begin();
-      v_it!=values.end();
-      v_it++)
+  valuest::viewt view;
+  values.get_view(view);
+
+  for(const auto item : sort_view(view))
   {
     irep_idt identifier, display_name;
 
-    const entryt &e=v_it->second;
+    const entryt &e=item->second;
 
     if(has_prefix(id2string(e.identifier), "value_set::dynamic_object"))
     {
@@ -210,36 +229,24 @@ bool value_sett::make_union(const value_sett::valuest &new_values)
 {
   bool result=false;
 
-  valuest::iterator v_it=values.begin();
+  // entries that are shared with new_values are unchanged
+  valuest::delta_viewt delta_view;
+  new_values.get_delta_view(values, delta_view, false);
 
-  for(valuest::const_iterator
-      it=new_values.begin();
-      it!=new_values.end();
-      ) // no it++
+  for(const auto &item : delta_view)
   {
-    if(v_it==values.end() || it->first<v_it->first)
+    if(!item.in_both)
     {
-      values.insert(v_it, *it);
+      values.insert(item.k, item.m, tvt(false));
       result=true;
-      it++;
-      continue;
-    }
-    else if(v_it->first<it->first)
-    {
-      v_it++;
       continue;
     }
 
-    assert(v_it->first==it->first);
-
-    entryt &e=v_it->second;
-    const entryt &new_e=it->second;
+    entryt &e=values.find(item.k, tvt(true)).first;
+    const entryt &new_e=item.m;
 
     if(make_union(e.object_map, new_e.object_map))
       result=true;
-
-    v_it++;
-    it++;
   }
 
   return result;
@@ -408,11 +415,10 @@ void value_sett::get_value_set_rec(
        expr_type.id()==ID_array)
     {
       // look it up
-      valuest::const_iterator v_it=
-        values.find(id2string(identifier)+suffix);
+      const entryt *v_it=find_entry(id2string(identifier)+suffix);
 
       // try first component name as suffix if not yet found
-      if(v_it==values.end() &&
+      if(v_it==nullptr &&
           (expr_type.id()==ID_struct ||
            expr_type.id()==ID_union))
       {
@@ -422,16 +428,16 @@ void value_sett::get_value_set_rec(
         const std::string first_component_name=
           struct_union_type.components().front().get_string(ID_name);
 
-        v_it=values.find(
+        v_it=find_entry(
             id2string(identifier)+"."+first_component_name+suffix);
       }
 
       // not found? try without suffix
-      if(v_it==values.end())
-        v_it=values.find(identifier);
+      if(v_it==nullptr)
+        v_it=find_entry(identifier);
 
-      if(v_it!=values.end())
-        make_union(dest, v_it->second.object_map);
+      if(v_it!=nullptr)
+        make_union(dest, v_it->object_map);
       else
         insert(dest, exprt(ID_unknown, original_type));
     }
@@ -794,16 +800,16 @@ void value_sett::get_value_set_rec(
     const std::string full_name=prefix+suffix;
 
     // look it up
-    valuest::const_iterator v_it=values.find(full_name);
+    const entryt *v_it=find_entry(full_name);
 
     // not found? try without suffix
-    if(v_it==values.end())
-      v_it=values.find(prefix);
+    if(v_it==nullptr)
+      v_it=find_entry(prefix);
 
-    if(v_it==values.end())
+    if(v_it==nullptr)
       insert(dest, exprt(ID_unknown, original_type));
     else
-      make_union(dest, v_it->second.object_map);
+      make_union(dest, v_it->object_map);
   }
   else if(expr.id()==ID_byte_extract_little_endian ||
           expr.id()==ID_byte_extract_big_endian)
@@ -1251,15 +1257,18 @@ void value_sett::do_free(
   }
 
   // mark these as 'may be invalid'
-  // this, unfortunately, destroys the sharing
-  for(valuest::iterator v_it=values.begin();
-      v_it!=values.end();
-      v_it++)
+  // only the entries that change are written, to keep the others shared
+  valuest::viewt view;
+  values.get_view(view);
+
+  std::list<std::pair<idt, object_mapt>> new_object_maps;
+
+  for(const auto &item : view)
   {
     object_mapt new_object_map;
 
     const object_map_dt &old_object_map=
-      v_it->second.object_map.read();
+      item.second.object_map.read();
 
     bool changed=false;
 
@@ -1292,8 +1301,11 @@ void value_sett::do_free(
     }
 
     if(changed)
-      v_it->second.object_map=new_object_map;
+      new_object_maps.push_back(std::make_pair(item.first, new_object_map));
   }
+
+  for(const auto &entry : new_object_maps)
+    values.find(entry.first, tvt(true)).first.object_map=entry.second;
 }
 
 void value_sett::assign_rec(
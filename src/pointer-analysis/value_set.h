@@ -13,9 +13,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_POINTER_ANALYSIS_VALUE_SET_H
 
 #include <set>
+#include <vector>
 
 #include <util/mp_arith.h>
 #include <util/reference_counting.h>
+#include <util/sharing_map.h>
 
 #include "object_numbering.h"
 #include "value_sets.h"
@@ -283,10 +285,14 @@ public:
   ///
   /// The components of the ID are thus duplicated in the `valuest` key and in
   /// `entryt` fields.
+  ///
+  /// The map is shared copy-on-write: copies, as made at every branch by
+  /// symbolic execution, are constant-time, and merges only visit the
+  /// entries that are not shared.
   #ifdef USE_DSTRING
-  typedef std::map<idt, entryt> valuest;
+  typedef sharing_mapt<idt, entryt, irep_id_hash> valuest;
   #else
-  typedef std::unordered_map<idt, entryt, string_hash> valuest;
+  typedef sharing_mapt<idt, entryt, string_hash> valuest;
   #endif
 
   /// Gets values pointed to by `expr`, including following dereference
@@ -329,6 +335,15 @@ public:
     const entryt &e, const typet &type,
     const namespacet &ns);
 
+  /// Finds an entry in this value-set without inserting one.
+  /// \param id: the key of the entry, i.e., identifier and suffix
+  /// \return the entry, or nullptr if there is none
+  const entryt *find_entry(const idt &id) const
+  {
+    valuest::const_find_type entry=values.find(id);
+    return entry.second?&entry.first:nullptr;
+  }
+
   /// Pretty-print this value-set
   /// \param ns: global namespace
   /// \param [out] out: stream to write to
@@ -340,6 +355,11 @@ public:
   /// for more detail.
   valuest values;
 
+  /// \return the entries of the view, which is in no particular order,
+  ///   sorted by their keys
+  static std::vector<const valuest::view_itemt *>
+  sort_view(const valuest::viewt &view);
+
   /// Merges two RHS expression sets
   /// \param [in, out] dest: set to merge into
   /// \param src: set to merge in
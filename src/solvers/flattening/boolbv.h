@@ -115,6 +115,17 @@ protected:
   typedef std::unordered_map<const exprt, bvt, irep_hash> bv_cachet;
   bv_cachet bv_cache;
 
+  std::size_t cache_size() const override
+  {
+    return SUB::cache_size()+bv_cache.size();
+  }
+
+  bool erase_unshared_cache_entries() override
+  {
+    bool erased=erase_unshared(bv_cache);
+    return SUB::erase_unshared_cache_entries() || erased;
+  }
+
   bool type_conversion(
     const typet &src_type, const bvt &src,
     const typet &dest_type, bvt &dest);
@@ -12,7 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 bvt boolbvt::convert_case(const exprt &expr)
 {
-  const std::vector<exprt> &operands=expr.operands();
+  const exprt::operandst &operands=expr.operands();
 
   std::size_t width=boolbv_width(expr.type());
 
@@ -180,7 +180,7 @@ bool instantiate_quantifier(exprt &expr,
     return false;
 
   bool res=true;
-  std::vector<exprt> expr_insts;
+  exprt::operandst expr_insts;
   for(mp_integer i=lb; i<=ub; ++i)
   {
     exprt constraint_expr=body_expr;
@@ -0,0 +1,708 @@
+/*******************************************************************\
+
+Module: Optimisation of And-Inverter Graphs
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Optimisation of And-Inverter Graphs: structural hashing, two-level
+/// rewriting, balancing, and merging of functionally equivalent nodes
+
+#include "aig_optimize.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <random>
+
+#include <util/invariant.h>
+
+aig_buildert::aig_buildert(aigt &_dest):dest(_dest)
+{
+  // reserve node 0
+  if(dest.nodes.empty())
+    dest.new_var_node();
+
+  levels.resize(dest.nodes.size(), 0);
+  for(std::size_t n=0; n<dest.nodes.size(); n++)
+  {
+    const aigt::nodet &node=dest.nodes[n];
+
+    if(node.is_and())
+    {
+      levels[n]=1+std::max(level(node.a), level(node.b));
+      table[(std::uint64_t(node.a.get())<<32)|node.b.get()]=n;
+    }
+  }
+}
+
+literalt aig_buildert::new_var()
+{
+  levels.push_back(0);
+  return dest.new_var_node();
+}
+
+literalt aig_buildert::new_and(literalt a, literalt b)
+{
+  // the inputs are ordered, such that the key does not depend on the order
+  if(b<a)
+    std::swap(a, b);
+
+  const std::uint64_t key=(std::uint64_t(a.get())<<32)|b.get();
+
+  const auto entry=table.find(key);
+  if(entry!=table.end())
+    return literalt(entry->second, false);
+
+  const literalt l=dest.new_and_node(a, b);
+  levels.push_back(1+std::max(level(a), level(b)));
+  table[key]=l.var_no();
+
+  return l;
+}
+
+literalt aig_buildert::land(literalt a, literalt b)
+{
+  // one level: constants, idempotence and contradiction
+  if(a.is_false() || b.is_false())
+    return const_literal(false);
+  if(a.is_true())
+    return b;
+  if(b.is_true())
+    return a;
+  if(a==b)
+    return a;
+  if(a==!b)
+    return const_literal(false);
+
+  // two levels, for either order of the inputs
+  for(unsigned order=0; order<2; order++)
+  {
+    const literalt x=order==0?a:b;
+    const literalt y=order==0?b:a;
+
+    if(!is_and(x))
+      continue;
+
+    const aigt::nodet &x_node=dest.nodes[x.var_no()];
+    const literalt x0=x_node.a, x1=x_node.b;
+
+    if(!x.sign())
+    {
+      // contradiction: (x0 & x1) & !x0 = 0
+      if(y==!x0 || y==!x1)
+        return const_literal(false);
+
+      // idempotence: (x0 & x1) & x0 = x0 & x1
+      if(y==x0 || y==x1)
+        return x;
+
+      if(is_and(y) && !y.sign())
+      {
+        const aigt::nodet &y_node=dest.nodes[y.var_no()];
+        const literalt y0=y_node.a, y1=y_node.b;
+
+        // contradiction: (x0 & x1) & (!x0 & y1) = 0
+        if(x0==!y0 || x0==!y1 || x1==!y0 || x1==!y1)
+          return const_literal(false);
+
+        // idempotence: (x0 & x1) & (x0 & y1) = (x0 & x1) & y1
+        if(x0==y0 || x1==y0)
+          return land(x, y1);
+        if(x0==y1 || x1==y1)
+          return land(x, y0);
+      }
+    }
+    else
+    {
+      // subsumption: !(x0 & x1) & !x0 = !x0
+      if(y==!x0 || y==!x1)
+        return y;
+
+      // substitution: !(x0 & x1) & x0 = x0 & !x1
+      if(y==x0)
+        return land(y, !x1);
+      if(y==x1)
+        return land(y, !x0);
+
+      if(is_and(y) && y.sign())
+      {
+        const aigt::nodet &y_node=dest.nodes[y.var_no()];
+        const literalt y0=y_node.a, y1=y_node.b;
+
+        // resolution: !(x0 & x1) & !(x0 & !x1) = !x0
+        if((x0==y0 && x1==!y1) || (x0==y1 && x1==!y0))
+          return !x0;
+        if((x1==y0 && x0==!y1) || (x1==y1 && x0==!y0))
+          return !x1;
+      }
+
+      if(is_and(y) && !y.sign())
+      {
+        const aigt::nodet &y_node=dest.nodes[y.var_no()];
+        const literalt y0=y_node.a, y1=y_node.b;
+
+        // subsumption: !(x0 & x1) & (!x0 & y1) = !x0 & y1
+        if(y0==!x0 || y0==!x1 || y1==!x0 || y1==!x1)
+          return y;
+
+        // substitution: !(x0 & x1) & (x0 & y1) = !x1 & (x0 & y1)
+        if(y0==x0 || y1==x0)
+          return land(!x1, y);
+        if(y0==x1 || y1==x1)
+          return land(!x0, y);
+      }
+    }
+  }
+
+  return new_and(a, b);
+}
+
+void aig_rebuild(
+  const aigt &src,
+  aig_buildert &dest,
+  std::vector<literalt> &map)
+{
+  map.assign(src.nodes.size(), unmapped_literal());
+
+  for(std::size_t n=0; n<src.nodes.size(); n++)
+  {
+    const aigt::nodet &node=src.nodes[n];
+
+    if(n==0)
+      map[n]=literalt(0, false);
+    else if(node.is_var())
+      map[n]=dest.new_var();
+    else
+      map[n]=dest.land(map_literal(map, node.a), map_literal(map, node.b));
+  }
+}
+
+/// Marks the nodes in the cone of influence of `roots`
+static void mark_cone(
+  const aigt &aig,
+  const bvt &roots,
+  std::vector<bool> &in_cone)
+{
+  in_cone.assign(aig.nodes.size(), false);
+
+  std::vector<literalt::var_not> stack;
+
+  for(const auto &r : roots)
+    if(!r.is_constant())
+      stack.push_back(r.var_no());
+
+  while(!stack.empty())
+  {
+    const literalt::var_not n=stack.back();
+    stack.pop_back();
+
+    if(in_cone[n])
+      continue;
+
+    in_cone[n]=true;
+
+    const aigt::nodet &node=aig.nodes[n];
+
+    if(node.is_and())
+    {
+      if(!node.a.is_constant())
+        stack.push_back(node.a.var_no());
+      if(!node.b.is_constant())
+        stack.push_back(node.b.var_no());
+    }
+  }
+}
+
+std::size_t aig_cone_size(const aigt &aig, const bvt &roots)
+{
+  std::vector<bool> in_cone;
+  mark_cone(aig, roots, in_cone);
+
+  std::size_t count=0;
+
+  for(std::size_t n=0; n<aig.nodes.size(); n++)
+    if(in_cone[n] && aig.nodes[n].is_and())
+      count++;
+
+  return count;
+}
+
+void aig_balance(
+  const aigt &src,
+  const bvt &roots,
+  aig_buildert &dest,
+  std::vector<literalt> &map)
+{
+  const std::size_t size=src.nodes.size();
+
+  std::vector<bool> in_cone;
+  mark_cone(src, roots, in_cone);
+
+  // the uses of the nodes within the cone
+  std::vector<unsigned> uses(size, 0);
+  std::vector<bool> negated_use(size, false);
+
+  for(std::size_t n=0; n<size; n++)
+  {
+    const aigt::nodet &node=src.nodes[n];
+
+    if(!in_cone[n] || !node.is_and())
+      continue;
+
+    for(const literalt &input : { node.a, node.b })
+    {
+      if(input.is_constant())
+        continue;
+
+      uses[input.var_no()]++;
+      if(input.sign())
+        negated_use[input.var_no()]=true;
+    }
+  }
+
+  for(const auto &r : roots)
+    if(!r.is_constant())
+      negated_use[r.var_no()]=true; // never inside a tree
+
+  // an input that is an inner node of the tree of its single user
+  auto is_inner=[&](literalt l)
+  {
+    return !l.is_constant() &&
+           !l.sign() &&
+           src.nodes[l.var_no()].is_and() &&
+           uses[l.var_no()]==1 &&
+           !negated_use[l.var_no()];
+  };
+
+  map.assign(size, unmapped_literal());
+
+  bvt leaves;
+  std::vector<literalt> stack;
+
+  for(std::size_t n=0; n<size; n++)
+  {
+    const aigt::nodet &node=src.nodes[n];
+
+    if(n==0)
+    {
+      map[n]=literalt(0, false);
+      continue;
+    }
+    else if(node.is_var())
+    {
+      map[n]=dest.new_var();
+      continue;
+    }
+    else if(!in_cone[n] || is_inner(literalt(n, false)))
+      continue;
+
+    // collect the leaves of the tree rooted here
+    leaves.clear();
+    stack.assign({ node.a, node.b });
+
+    while(!stack.empty())
+    {
+      const literalt l=stack.back();
+      stack.pop_back();
+
+      if(is_inner(l))
+      {
+        const aigt::nodet &inner=src.nodes[l.var_no()];
+        stack.push_back(inner.a);
+        stack.push_back(inner.b);
+      }
+      else
+        leaves.push_back(map_literal(map, l));
+    }
+
+    std::sort(leaves.begin(), leaves.end());
+    leaves.erase(std::unique(leaves.begin(), leaves.end()), leaves.end());
+
+    // a literal and its negation are adjacent once sorted
+    bool contradiction=false;
+    for(std::size_t i=1; i<leaves.size(); i++)
+      contradiction|=leaves[i-1]==!leaves[i];
+
+    if(contradiction)
+    {
+      map[n]=const_literal(false);
+      continue;
+    }
+
+    // combine the two leaves of least depth first
+    auto deeper=[&](literalt a, literalt b)
+    {
+      return dest.level(a)>dest.level(b);
+    };
+
+    std::make_heap(leaves.begin(), leaves.end(), deeper);
+
+    while(leaves.size()>1)
+    {
+      std::pop_heap(leaves.begin(), leaves.end(), deeper);
+      const literalt a=leaves.back();
+      leaves.pop_back();
+
+      std::pop_heap(leaves.begin(), leaves.end(), deeper);
+      const literalt b=leaves.back();
+      leaves.pop_back();
+
+      leaves.push_back(dest.land(a, b));
+      std::push_heap(leaves.begin(), leaves.end(), deeper);
+    }
+
+    map[n]=leaves.front();
+  }
+}
+
+namespace
+{
+/// A cut of at most four leaves, with the truth table of the node over
+/// the leaves. Leaf i is the i-th variable of the truth table, and the
+/// table does not depend on the variables beyond the leaves.
+struct cutt
+{
+  unsigned size;
+  std::array<literalt::var_not, 4> leaves;
+  std::uint16_t truth_table;
+
+  bool operator==(const cutt &other) const
+  {
+    return size==other.size &&
+           truth_table==other.truth_table &&
+           std::equal(leaves.begin(), leaves.begin()+size,
+                      other.leaves.begin());
+  }
+};
+
+struct cut_hasht
+{
+  std::size_t operator()(const cutt &cut) const
+  {
+    std::size_t result=cut.truth_table;
+    for(unsigned i=0; i<cut.size; i++)
+      result=result*31+cut.leaves[i];
+    return result;
+  }
+};
+
+// the truth tables of the variables
+const std::uint16_t variable_table[]={ 0xAAAA, 0xCCCC, 0xF0F0, 0xFF00 };
+const std::uint16_t low_half[]={ 0x5555, 0x3333, 0x0F0F, 0x00FF };
+
+bool depends_on(std::uint16_t table, unsigned i)
+{
+  return ((table^(table>>(1u<<i)))&low_half[i])!=0;
+}
+
+/// Removes variable i, on which `table` does not depend
+std::uint16_t remove_variable(std::uint16_t table, unsigned i)
+{
+  std::uint16_t result=0;
+
+  for(unsigned m=0; m<16; m++)
+  {
+    // the new variables 0..2 are the old ones without i
+    const unsigned low=m&7;
+    const unsigned old_m=(low&((1u<<i)-1))|((low>>i)<<(i+1));
+    result|=((table>>old_m)&1u)<<m;
+  }
+
+  return result;
+}
+
+/// Re-expresses `table` over the leaves of `from` as a table over the
+/// leaves of `to`, which must include them
+std::uint16_t expand(std::uint16_t table, const cutt &from, const cutt &to)
+{
+  unsigned position[4];
+  for(unsigned j=0; j<from.size; j++)
+    position[j]=std::find(
+      to.leaves.begin(), to.leaves.begin()+to.size, from.leaves[j])-
+      to.leaves.begin();
+
+  std::uint16_t result=0;
+
+  for(unsigned m=0; m<16; m++)
+  {
+    unsigned old_m=0;
+    for(unsigned j=0; j<from.size; j++)
+      old_m|=((m>>position[j])&1u)<<j;
+    result|=((table>>old_m)&1u)<<m;
+  }
+
+  return result;
+}
+
+/// Drops the leaves that the truth table does not depend on
+void shrink(cutt &cut)
+{
+  for(unsigned i=cut.size; i-->0;)
+  {
+    if(depends_on(cut.truth_table, i))
+      continue;
+
+    cut.truth_table=remove_variable(cut.truth_table, i);
+    for(unsigned j=i; j+1<cut.size; j++)
+      cut.leaves[j]=cut.leaves[j+1];
+    cut.size--;
+  }
+}
+
+cutt trivial_cut(literalt::var_not n)
+{
+  cutt cut;
+  cut.size=1;
+  cut.leaves[0]=n;
+  cut.truth_table=variable_table[0];
+  return cut;
+}
+
+/// \return whether the union of the leaves fits into a cut
+bool merge_leaves(const cutt &a, const cutt &b, cutt &result)
+{
+  result.size=0;
+  unsigned i=0, j=0;
+
+  while(i<a.size || j<b.size)
+  {
+    literalt::var_not next;
+
+    if(j==b.size || (i<a.size && a.leaves[i]<b.leaves[j]))
+      next=a.leaves[i++];
+    else if(i==a.size || b.leaves[j]<a.leaves[i])
+      next=b.leaves[j++];
+    else
+    {
+      next=a.leaves[i++];
+      j++;
+    }
+
+    if(result.size==4)
+      return false;
+
+    result.leaves[result.size++]=next;
+  }
+
+  return true;
+}
+} // namespace
+
+std::size_t aig_merge_equivalent(
+  const aigt &src,
+  aig_buildert &dest,
+  std::vector<literalt> &map)
+{
+  const std::size_t size=src.nodes.size();
+  const std::size_t words=4;
+  const std::size_t max_cuts=8;
+
+  // random simulation, with a fixed seed for reproducible results
+  std::vector<std::uint64_t> simulation(size*words);
+  std::mt19937_64 generator(0);
+
+  for(std::size_t n=0; n<size; n++)
+  {
+    const aigt::nodet &node=src.nodes[n];
+    std::uint64_t *values=&simulation[n*words];
+
+    for(std::size_t w=0; w<words; w++)
+    {
+      if(node.is_var())
+        values[w]=generator();
+      else
+      {
+        auto input=[&](literalt l)
+        {
+          if(l.is_constant())
+            return l.is_true()?~std::uint64_t(0):0;
+          const std::uint64_t v=simulation[l.var_no()*words+w];
+          return l.sign()?~v:v;
+        };
+
+        values[w]=input(node.a)&input(node.b);
+      }
+    }
+  }
+
+  // the candidates for merging are the nodes whose simulated values equal
+  // those of another node or its negation, or are constant
+  std::vector<bool> candidate(size, false);
+
+  {
+    auto normalized=[&](std::size_t n, std::size_t w)
+    {
+      const std::uint64_t *values=&simulation[n*words];
+      return (values[0]&1)?~values[w]:values[w];
+    };
+
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> classes;
+
+    for(std::size_t n=1; n<size; n++)
+    {
+      std::uint64_t hash=0;
+      bool constant=true;
+
+      for(std::size_t w=0; w<words; w++)
+      {
+        hash=hash*0x9E3779B97F4A7C15ull+normalized(n, w);
+        constant&=normalized(n, w)==0;
+      }
+
+      if(constant)
+        candidate[n]=true;
+
+      classes[hash].push_back(n);
+    }
+
+    for(const auto &c : classes)
+      if(c.second.size()>1)
+        for(const auto n : c.second)
+          candidate[n]=true;
+  }
+
+  // the remaining users of each node, to free the cuts once done
+  std::vector<unsigned> users(size, 0);
+  for(std::size_t n=0; n<size; n++)
+  {
+    const aigt::nodet &node=src.nodes[n];
+    if(node.is_and())
+    {
+      if(!node.a.is_constant())
+        users[node.a.var_no()]++;
+      if(!node.b.is_constant())
+        users[node.b.var_no()]++;
+    }
+  }
+
+  std::vector<std::vector<cutt>> cuts(size);
+
+  // maps a cut, with the truth table normalised to map all zeros to
+  // zero, to the node and whether the node is the negation of the table
+  std::unordered_map<cutt, std::pair<std::size_t, bool>, cut_hasht>
+    functions;
+
+  std::vector<literalt> replacement(size, unmapped_literal());
+  std::size_t merged=0;
+
+  for(std::size_t n=1; n<size; n++)
+  {
+    const aigt::nodet &node=src.nodes[n];
+
+    if(node.is_and())
+    {
+      std::vector<cutt> &node_cuts=cuts[n];
+
+      auto input_cuts=[&](literalt l)
+      {
+        std::vector<cutt> result=cuts[l.var_no()];
+        result.push_back(trivial_cut(l.var_no()));
+        if(l.sign())
+          for(auto &cut : result)
+            cut.truth_table=~cut.truth_table&0xFFFF;
+        return result;
+      };
+
+      // aig_buildert folds constant inputs, so these nodes are rare
+      if(!node.a.is_constant() && !node.b.is_constant())
+      {
+        const std::vector<cutt> a_cuts=input_cuts(node.a);
+        const std::vector<cutt> b_cuts=input_cuts(node.b);
+
+        for(const auto &a_cut : a_cuts)
+        {
+          for(const auto &b_cut : b_cuts)
+          {
+            cutt cut;
+            if(!merge_leaves(a_cut, b_cut, cut))
+              continue;
+
+            cut.truth_table=
+              expand(a_cut.truth_table, a_cut, cut)&
+              expand(b_cut.truth_table, b_cut, cut);
+            shrink(cut);
+
+            if(std::find(node_cuts.begin(), node_cuts.end(), cut)==
+               node_cuts.end())
+              node_cuts.push_back(cut);
+
+            if(node_cuts.size()==max_cuts)
+              break;
+          }
+
+          if(node_cuts.size()==max_cuts)
+            break;
+        }
+      }
+
+      for(const literalt &input : { node.a, node.b })
+        if(!input.is_constant() && --users[input.var_no()]==0)
+          std::vector<cutt>().swap(cuts[input.var_no()]);
+    }
+
+    if(!candidate[n])
+      continue;
+
+    // look for an equivalent node that came before
+    for(const auto &cut : cuts[n])
+    {
+      if(cut.size==0)
+      {
+        replacement[n]=const_literal(cut.truth_table!=0);
+        break;
+      }
+
+      cutt key=cut;
+      const bool negated=(key.truth_table&1)!=0;
+      if(negated)
+        key.truth_table=~key.truth_table&0xFFFF;
+
+      const auto entry=functions.find(key);
+      if(entry!=functions.end())
+      {
+        replacement[n]=
+          literalt(entry->second.first, false)^
+          (entry->second.second!=negated);
+        break;
+      }
+    }
+
+    if(replacement[n]!=unmapped_literal())
+    {
+      merged++;
+      continue;
+    }
+
+    functions.insert({ trivial_cut(n), { n, false } });
+
+    for(const auto &cut : cuts[n])
+    {
+      cutt key=cut;
+      const bool negated=(key.truth_table&1)!=0;
+      if(negated)
+        key.truth_table=~key.truth_table&0xFFFF;
+      functions.insert({ key, { n, negated } });
+    }
+  }
+
+  map.assign(size, unmapped_literal());
+
+  for(std::size_t n=0; n<size; n++)
+  {
+    const aigt::nodet &node=src.nodes[n];
+
+    if(n==0)
+      map[n]=literalt(0, false);
+    else if(node.is_var())
+      map[n]=dest.new_var();
+    else if(replacement[n]!=unmapped_literal())
+      map[n]=map_literal(map, replacement[n]);
+    else
+      map[n]=dest.land(map_literal(map, node.a), map_literal(map, node.b));
+  }
+
+  return merged;
+}
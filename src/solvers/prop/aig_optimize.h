@@ -0,0 +1,111 @@
+/*******************************************************************\
+
+Module: Optimisation of And-Inverter Graphs
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Optimisation of And-Inverter Graphs: structural hashing, two-level
+/// rewriting, balancing, and merging of functionally equivalent nodes
+
+#ifndef CPROVER_SOLVERS_PROP_AIG_OPTIMIZE_H
+#define CPROVER_SOLVERS_PROP_AIG_OPTIMIZE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "aig.h"
+
+/// Builds the nodes of an AIG with structural hashing, such that no two
+/// AND nodes have the same inputs, and simplifies each new AND node with
+/// the two-level rewriting rules of Brummayer and Biere ("Local Two-Level
+/// And-Inverter Graph Minimization without Blowup", MEMICS 2006), which
+/// look at the inputs of the inputs of the node. Node 0 is reserved, as
+/// variable 0 is not a valid variable of the SAT solvers.
+class aig_buildert
+{
+public:
+  explicit aig_buildert(aigt &_dest);
+
+  literalt new_var();
+  literalt land(literalt a, literalt b);
+
+  /// \return the number of AND nodes on the longest path from a
+  ///   variable to the node
+  unsigned level(literalt l) const
+  {
+    return l.is_constant()?0:levels[l.var_no()];
+  }
+
+  bool is_and(literalt l) const
+  {
+    return !l.is_constant() && dest.nodes[l.var_no()].is_and();
+  }
+
+  aigt &dest;
+
+protected:
+  // maps the pair of inputs of each AND node to the node
+  std::unordered_map<std::uint64_t, literalt::var_not> table;
+  std::vector<unsigned> levels;
+
+  literalt new_and(literalt a, literalt b);
+};
+
+/// Sentinel for the nodes that a pass did not map
+inline literalt unmapped_literal()
+{
+  return literalt();
+}
+
+/// \return the literal that `map` gives for `l`, with the sign of `l`
+inline literalt map_literal(const std::vector<literalt> &map, literalt l)
+{
+  if(l.is_constant())
+    return l;
+
+  const literalt m=map[l.var_no()];
+  return m==unmapped_literal()?m:m^l.sign();
+}
+
+/// Copies `src` into `dest`, rewriting and hashing each AND node.
+/// \param [out] map: gives the literal in `dest` for each node of `src`
+void aig_rebuild(
+  const aigt &src,
+  aig_buildert &dest,
+  std::vector<literalt> &map);
+
+/// Copies the cone of influence of `roots` into `dest`, rebuilding each
+/// maximal tree of AND nodes whose inner nodes have a single, positive
+/// use as a tree of minimal depth. The inputs of lower depth are combined
+/// first, which also gives the rewriting more opportunities.
+/// \param [out] map: gives the literal in `dest` for the roots, the
+///   variables and the roots of the trees, and unmapped_literal() for all
+///   other nodes
+void aig_balance(
+  const aigt &src,
+  const bvt &roots,
+  aig_buildert &dest,
+  std::vector<literalt> &map);
+
+/// Copies `src` into `dest`, merging the nodes that compute the same
+/// function, or its negation. Random simulation picks the candidates for
+/// merging, which are the nodes with the same simulated values up to
+/// negation. Each candidate is then compared with the others by its
+/// k-feasible cuts: nodes with a cut with the same leaves and the same
+/// truth table over the leaves are equivalent. Only such equivalences are
+/// merged, hence the merge does not need a SAT solver.
+/// \param [out] map: gives the literal in `dest` for each node of `src`
+/// \return the number of nodes merged
+std::size_t aig_merge_equivalent(
+  const aigt &src,
+  aig_buildert &dest,
+  std::vector<literalt> &map);
+
+/// \return the number of AND nodes in the cone of influence of `roots`
+std::size_t aig_cone_size(const aigt &aig, const bvt &roots);
+
+#endif // CPROVER_SOLVERS_PROP_AIG_OPTIMIZE_H
@@ -8,23 +8,18 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "aig_prop.h"
 
-#include <set>
-#include <stack>
+#include <algorithm>
 
 // Tries to compact AIGs corresponding to xor and equality
 // Needed to match the performance of the native CNF back-end.
 #define USE_AIG_COMPACT
 
-// Use the Plaisted-Greenbaum encoding, again, needed to match the
-// native CNF back-end.
-#define USE_PG
-
 literalt aig_prop_baset::land(const bvt &bv)
 {
   literalt literal=const_literal(true);
 
   // Introduces N-1 extra nodes for N bits
-  // See convert_node for where this overhead is removed
+  // See aig_balance and convert_node for where this overhead is removed
   forall_literals(it, bv)
     literal=land(*it, literal);
 
@@ -36,7 +31,7 @@ literalt aig_prop_baset::lor(const bvt &bv)
   literalt literal=const_literal(true);
 
   // Introduces N-1 extra nodes for N bits
-  // See convert_node for where this overhead is removed
+  // See aig_balance and convert_node for where this overhead is removed
   forall_literals(it, bv)
     literal=land(neg(*it), literal);
 
@@ -144,455 +139,410 @@ void aig_prop_baset::set_equal(literalt a, literalt b)
 #endif
 }
 
+aig_prop_solvert::aig_prop_solvert(propt &_solver):
+  aig_prop_constraintt(aig),
+  solver(_solver),
+  builder(optimized),
+  optimized_once(false),
+  converted_constraints(0),
+  clauses(0),
+  freeze_all(false),
+  frozen_variables(1),
+  values_valid(false)
+{
+  // reserve node 0, as variable 0 is not a valid variable of the SAT
+  // solvers
+  aig.new_node();
+}
+
+aig_prop_solvert::aig_prop_solvert(std::unique_ptr<propt> _solver):
+  aig_prop_solvert(*_solver)
+{
+  solver_ptr=std::move(_solver);
+}
+
+/// The value of a node is computed from the values of the variables, as
+/// the nodes that the optimisation merged or that the conversion inlined
+/// are not constrained in the solver.
 tvt aig_prop_solvert::l_get(literalt a) const
 {
-  return solver.l_get(a);
+  if(a.is_constant())
+    return tvt(a.is_true());
+
+  if(!values_valid || values.size()!=aig.nodes.size())
+  {
+    values.resize(aig.nodes.size());
+
+    for(std::size_t n=0; n<aig.nodes.size(); n++)
+    {
+      const aigt::nodet &node=aig.nodes[n];
+
+      if(node.is_var())
+      {
+        // node 0 is reserved, and the variables that are not mapped do
+        // not occur in the constraints
+        const literalt l=
+          n>0 && n<node_map.size()?node_map[n]:unmapped_literal();
+        values[n]=l==unmapped_literal()?tvt(false):solver.l_get(l);
+      }
+      else
+      {
+        auto input=[this](literalt l)
+        {
+          if(l.is_constant())
+            return tvt(l.is_true());
+          return l.sign()?!values[l.var_no()]:values[l.var_no()];
+        };
+
+        values[n]=input(node.a) && input(node.b);
+      }
+    }
+
+    values_valid=true;
+  }
+
+  if(a.var_no()>=values.size())
+    return tvt::unknown();
+
+  const tvt value=values[a.var_no()];
+  return a.sign()?!value:value;
 }
 
 propt::resultt aig_prop_solvert::prop_solve()
 {
-  status() << "converting AIG, "
-           << aig.nodes.size() << " nodes" << eom;
+  values_valid=false;
+
   convert_aig();
 
   return solver.prop_solve();
 }
 
-/// Compute the phase information needed for Plaisted-Greenbaum encoding
-/// \par parameters: Two vectors of bools of size aig.nodes.size()
-/// \return These vectors filled in with per node phase information
-void aig_prop_solvert::compute_phase(
-  std::vector<bool> &n_pos,
-  std::vector<bool> &n_neg)
+/// Maps a literal of `aig` into `optimized`, adding the nodes that the
+/// optimisation did not map, and those added to `aig` since
+/// \return the literal in `optimized`
+literalt aig_prop_solvert::map_node(literalt l)
 {
-  std::stack<literalt> queue;
+  if(l.is_constant())
+    return l;
 
-  // Get phases of constraints
-  for(aig_plus_constraintst::constraintst::const_iterator
-      c_it=aig.constraints.begin();
-      c_it!=aig.constraints.end();
-      c_it++)
-    queue.push(*c_it);
+  if(node_map.size()<aig.nodes.size())
+    node_map.resize(aig.nodes.size(), unmapped_literal());
 
-  while(!queue.empty())
+  std::vector<literalt::var_not> stack(1, l.var_no());
+
+  while(!stack.empty())
   {
-    literalt l=queue.top();
-    queue.pop();
+    const literalt::var_not n=stack.back();
 
-    if(l.is_constant())
+    if(node_map[n]!=unmapped_literal())
+    {
+      stack.pop_back();
       continue;
+    }
 
-    bool sign=l.sign();
-    unsigned var_no=l.var_no();
-
-    // already set?
-    if(sign?n_neg[var_no]:n_pos[var_no])
-      continue; // done already
+    const aigt::nodet &node=aig.nodes[n];
 
-    // set
-    sign?n_neg[var_no]=1:n_pos[var_no]=1;
+    if(node.is_var())
+    {
+      node_map[n]=builder.new_var();
+      stack.pop_back();
+      continue;
+    }
 
-    const aigt::nodet &node=aig.nodes[var_no];
+    bool ready=true;
 
-    if(node.is_and())
+    for(const literalt &input : { node.a, node.b })
     {
-      queue.push(node.a^sign);
-      queue.push(node.b^sign);
+      if(!input.is_constant() && node_map[input.var_no()]==unmapped_literal())
+      {
+        stack.push_back(input.var_no());
+        ready=false;
+      }
     }
-  }
 
-  // Count
-  unsigned pos_only=0, neg_only=0, mixed=0;
-
-  for(unsigned n=0; n<aig.nodes.size(); n++)
-  {
-    if(aig.nodes[n].is_and())
+    if(ready)
     {
-      if(n_neg[n] && n_pos[n])
-        mixed++;
-      else if(n_pos[n])
-        pos_only++;
-      else if(n_neg[n])
-        neg_only++;
+      node_map[n]=builder.land(
+        map_literal(node_map, node.a), map_literal(node_map, node.b));
+      stack.pop_back();
     }
   }
 
-  statistics() << "Pos only: " << pos_only << "\n"
-               << "Neg only: " << neg_only << "\n"
-               << "Mixed: " << mixed << eom;
+  return map_literal(node_map, l);
 }
 
-
-/// Compact encoding for single usage variable
-/// \par parameters: Two vectors of unsigned of size aig.nodes.size()
-/// \return These vectors filled in with per node usage information
-void aig_prop_solvert::usage_count(
-  std::vector<unsigned> &p_usage_count,
-  std::vector<unsigned> &n_usage_count)
+/// Optimises the AIG built so far, and maps it into `optimized`: the
+/// nodes are hashed and rewritten, the trees of AND nodes are balanced,
+/// and equivalent nodes are merged
+void aig_prop_solvert::optimize()
 {
-  for(aig_plus_constraintst::constraintst::const_iterator
-      c_it=aig.constraints.begin();
-      c_it!=aig.constraints.end();
-      c_it++)
+  std::vector<literalt> rebuilt_map, balanced_map, merged_map;
+
+  aigt rebuilt;
+  aig_buildert rebuilt_builder(rebuilt);
+  aig_rebuild(aig, rebuilt_builder, rebuilt_map);
+
+  bvt roots;
+  for(const auto &c : aig.constraints)
+    roots.push_back(map_literal(rebuilt_map, c));
+
+  aigt balanced;
+  aig_buildert balanced_builder(balanced);
+  aig_balance(rebuilt, roots, balanced_builder, balanced_map);
+
   {
-    if(!((*c_it).is_constant()))
-    {
-      if((*c_it).sign())
-      {
-        ++n_usage_count[(*c_it).var_no()];
-      }
-      else
-      {
-        ++p_usage_count[(*c_it).var_no()];
-      }
-    }
+    aigt tmp;
+    rebuilt.swap(tmp);
   }
 
-  for(unsigned n=0; n<aig.nodes.size(); n++)
-  {
-    const aigt::nodet &node=aig.nodes[n];
+  const std::size_t merged=
+    aig_merge_equivalent(balanced, builder, merged_map);
 
-    if(node.is_and())
-    {
-      if(node.a.sign())
-      {
-        ++n_usage_count[node.a.var_no()];
-      }
-      else
-      {
-        ++p_usage_count[node.a.var_no()];
-      }
+  statistics() << "AIG optimisation merged " << merged
+               << " equivalent nodes" << eom;
 
-      if(node.b.sign())
-      {
-        ++n_usage_count[node.b.var_no()];
-      }
-      else
-      {
-        ++p_usage_count[node.b.var_no()];
-      }
-    }
+  // compose the maps; the balancing does not map the inner nodes of the
+  // trees it rebuilds, which map_node adds on demand
+  node_map.assign(aig.nodes.size(), unmapped_literal());
+
+  for(std::size_t n=0; n<aig.nodes.size(); n++)
+  {
+    const literalt l=map_literal(balanced_map, rebuilt_map[n]);
+    if(l!=unmapped_literal())
+      node_map[n]=map_literal(merged_map, l);
   }
+}
 
+/// Emits the clauses for the given literal of `optimized`: with the
+/// Plaisted-Greenbaum encoding, when the literal is true in the solver, so
+/// is the function of its node, but not necessarily vice versa. This
+/// suffices for the literals that are only constrained to be true.
+/// Positive inputs with no other use are inlined into a single
+/// conjunction, and the patterns of AND nodes that multiplexers,
+/// exclusive-ors and carries produce get clauses of their own.
+/// \param l: the literal, whose node must be an AND node
+/// \param [out] queue: the inputs whose clauses are needed in turn
+void aig_prop_solvert::convert_node(literalt l, bvt &queue)
+{
+  const literalt o(l.var_no(), false);
+  const bool negative=l.sign();
 
-  #if 1
-  // Compute stats
-  unsigned unused=0;
-  unsigned usedOncePositive=0;
-  unsigned usedOnceNegative=0;
-  unsigned usedTwicePositive=0;
-  unsigned usedTwiceNegative=0;
-  unsigned usedTwiceMixed=0;
-  unsigned usedThreeTimes=0;
-  unsigned usedMore=0;
+  auto is_single_use_and=[this](literalt x)
+  {
+    return builder.is_and(x) && fanout[x.var_no()]==1;
+  };
+
+  bvt body;
+  bvt stack={ optimized.nodes[o.var_no()].a, optimized.nodes[o.var_no()].b };
 
-  for(unsigned n=0; n<aig.nodes.size(); n++)
+  while(!stack.empty())
   {
-    switch(p_usage_count[n] + n_usage_count[n])
-    {
-    case 0: ++unused; break;
-    case 1:
-      if(p_usage_count[n]==1)
-        ++usedOncePositive;
-      else
-        ++usedOnceNegative;
-      break;
+    const literalt x=stack.back();
+    stack.pop_back();
 
-    case 2 :
-      if(p_usage_count[n]>=2)
-      {
-        ++usedTwicePositive;
-      }
-      else if(n_usage_count[n]>=2)
-      {
-        ++usedTwiceNegative;
-      }
-      else
-      {
-        assert(p_usage_count[n]==1 && n_usage_count[n]==1);
-        ++usedTwiceMixed;
-      }
-      break;
-    case 3: ++usedThreeTimes; break;
-    default: ++usedMore; break;
+    if(!x.sign() && is_single_use_and(x))
+    {
+      stack.push_back(optimized.nodes[x.var_no()].a);
+      stack.push_back(optimized.nodes[x.var_no()].b);
     }
+    else
+      body.push_back(x);
   }
 
-  statistics() << "Unused: " << unused << " "
-               << "Used once: " << usedOncePositive + usedOnceNegative
-               << " (P: " << usedOncePositive
-               << ", N: " << usedOnceNegative << ") "
-               << "Used twice: "
-               << usedTwicePositive + usedTwiceNegative + usedTwiceMixed
-               << " (P: " << usedTwicePositive
-               << ", N: " << usedTwiceNegative
-               << ", M: " << usedTwiceMixed << ") "
-               << "Used three times: " << usedThreeTimes << " "
-               << "Used more: " << usedMore
-               << eom;
-  #endif
-}
-
-/// Convert one AIG node, including special handling of a couple of cases
-/// \par parameters: The node to convert, the phases required and the usage
-///   counts.
-/// \return The node converted to CNF in the solver object.
-void aig_prop_solvert::convert_node(
-  unsigned n,
-  const aigt::nodet &node,
-  bool n_pos, bool n_neg,
-  std::vector<unsigned> &p_usage_count,
-  std::vector<unsigned> &n_usage_count)
-{
-  if(p_usage_count[n]>0 || n_usage_count[n]>0)
+  // multiplexer: o = !(s & p) & !(!s & q), i.e., !o = s ? p : q
+  if(body.size()==2 &&
+     body[0].sign() && is_single_use_and(body[0]) &&
+     body[1].sign() && is_single_use_and(body[1]))
   {
-    literalt o=literalt(n, false);
-    bvt body(2);
-    body[0]=node.a;
-    body[1]=node.b;
-
-#ifdef USE_AIG_COMPACT
-    // Inline positive literals
-    // This should remove the overhead introduced by land and lor for bvt
+    const aigt::nodet &left=optimized.nodes[body[0].var_no()];
+    const aigt::nodet &right=optimized.nodes[body[1].var_no()];
 
-    for(bvt::size_type i=0; i < body.size(); i++)
+    for(unsigned i=0; i<4; i++)
     {
-      literalt l=body[i];
+      const literalt s=(i&1)?left.b:left.a;
+      const literalt p=(i&1)?left.a:left.b;
+      const literalt not_s=(i&2)?right.b:right.a;
+      const literalt q=(i&2)?right.a:right.b;
+
+      if(s!=!not_s)
+        continue;
 
-      if(!l.sign() &&                      // Used positively...
-         aig.nodes[l.var_no()].is_and() && // ... is a gate ...
-         p_usage_count[l.var_no()] == 1 && // ... only used here.
-         n_usage_count[l.var_no()] == 0)
+      if(!negative)
       {
-        const aigt::nodet &rep=aig.nodes[l.var_no()];
-        body[i]=rep.a;
-        body.push_back(rep.b);
-        --i;                         // Repeat the process
-        --p_usage_count[l.var_no()]; // Supress generation of inlined node
+        emit({ !o, !s, !p });
+        emit({ !o, s, !q });
+        queue.insert(queue.end(), { !p, !q, s, !s });
       }
+      else
+      {
+        emit({ o, !s, p });
+        emit({ o, s, q });
+        queue.insert(queue.end(), { p, q, s, !s });
+      }
+
+      return;
     }
+  }
 
-    // TODO : Could check the array for duplicates / complementary literals
-    // but this should be found by the SAT preprocessor.
-    // TODO : Likewise could find things that are constrained, esp the output
-    // and backwards constant propagate.  Again may not be worth it.
-
-    // lxor and lselect et al. are difficult to express in AIGs.
-    // Doing so introduces quite a bit of overhead.
-    // This should recognise the AIGs they produce and
-    // handle them in a more efficient way.
-
-    // Recognise something of the form:
-    //
-    //  neg(o)=lor(land(a,b), land(neg(a),c))
-    //      o =land(lneg(land(a,b)), lneg(land(neg(a),c)))
-    //
-    // Note that lxor and lselect generate the negation of this
-    // but will still be recognised because the negation is
-    // recorded where it is used
-
-    if(body.size() == 2 && body[0].sign() && body[1].sign())
+  // carry: o = !(x & y) & !(x & z) & !(y & z), i.e., at most one holds
+  if(body.size()==3 &&
+     body[0].sign() && is_single_use_and(body[0]) &&
+     body[1].sign() && is_single_use_and(body[1]) &&
+     body[2].sign() && is_single_use_and(body[2]))
+  {
+    bvt inputs;
+    for(const auto &b : body)
     {
-      const aigt::nodet &left=aig.nodes[body[0].var_no()];
-      const aigt::nodet &right=aig.nodes[body[1].var_no()];
-
-      if(left.is_and() && right.is_and())
-      {
-        if(left.a==neg(right.a))
-        {
-          if(p_usage_count[body[0].var_no()]==0 &&
-             n_usage_count[body[0].var_no()]==1 &&
-             p_usage_count[body[1].var_no()]==0 &&
-             n_usage_count[body[1].var_no()]==1)
-          {
-            bvt lits(3);
-
-            if(n_neg)
-            {
-              lits[0]=left.a;
-              lits[1]=right.b;
-              lits[2]=o;
-              solver.lcnf(lits);
-
-              lits[0]=neg(left.a);
-              lits[1]=left.b;
-              lits[2]=o;
-              solver.lcnf(lits);
-            }
-
-            if(n_pos)
-            {
-              lits[0]=left.a;
-              lits[1]=neg(right.b);
-              lits[2]=neg(o);
-              solver.lcnf(lits);
-
-              lits[0]=neg(left.a);
-              lits[1]=neg(left.b);
-              lits[2]=neg(o);
-              solver.lcnf(lits);
-            }
-
-            // Supress generation
-            --n_usage_count[body[0].var_no()];
-            --n_usage_count[body[1].var_no()];
-
-            return;
-          }
-        }
-      }
+      inputs.push_back(optimized.nodes[b.var_no()].a);
+      inputs.push_back(optimized.nodes[b.var_no()].b);
     }
 
+    bvt distinct=inputs;
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(
+      std::unique(distinct.begin(), distinct.end()), distinct.end());
 
-    // Likewise, carry has an improved encoding which is generated
-    // by the CNF encoding
-    if(body.size() == 3 && body[0].sign() && body[1].sign() && body[2].sign())
+    // each pair of three distinct literals occurs once
+    if(distinct.size()==3 &&
+       inputs[0]!=inputs[1] && inputs[2]!=inputs[3] && inputs[4]!=inputs[5] &&
+       std::count(inputs.begin(), inputs.end(), distinct[0])==2 &&
+       std::count(inputs.begin(), inputs.end(), distinct[1])==2)
     {
-      const aigt::nodet &left=aig.nodes[body[0].var_no()];
-      const aigt::nodet &mid=aig.nodes[body[1].var_no()];
-      const aigt::nodet &right=aig.nodes[body[2].var_no()];
-
-      if(left.is_and() && mid.is_and() && right.is_and())
+      for(std::size_t i=0; i<3; i++)
       {
-        if(p_usage_count[body[0].var_no()]==0 &&
-           n_usage_count[body[0].var_no()]==1 &&
-           p_usage_count[body[1].var_no()]==0 &&
-           n_usage_count[body[1].var_no()]==1 &&
-           p_usage_count[body[2].var_no()]==0 &&
-           n_usage_count[body[2].var_no()]==1)
+        for(std::size_t j=i+1; j<3; j++)
         {
-          literalt a=left.a;
-          literalt b=left.b;
-          literalt c=mid.a;
-
-          if(a==right.b && b==mid.b && c==right.a)
-          {
-            // A (negative) carry -- 1 if at most one input is 1
-            bvt lits(3);
-
-            if(n_neg)
-            {
-              lits[0]=a;
-              lits[1]=b;
-              lits[2]=o;
-              solver.lcnf(lits);
-
-              lits[0]=a;
-              lits[1]=c;
-              lits[2]=o;
-              solver.lcnf(lits);
-
-              lits[0]=b;
-              lits[1]=c;
-              lits[2]=o;
-              solver.lcnf(lits);
-            }
-
-            if(n_pos)
-            {
-              lits[0]=neg(a);
-              lits[1]=neg(b);
-              lits[2]=neg(o);
-              solver.lcnf(lits);
-
-              lits[0]=neg(a);
-              lits[1]=neg(c);
-              lits[2]=neg(o);
-              solver.lcnf(lits);
-
-              lits[0]=neg(b);
-              lits[1]=neg(c);
-              lits[2]=neg(o);
-              solver.lcnf(lits);
-            }
-
-            // Supress generation
-            --n_usage_count[body[0].var_no()];
-            --n_usage_count[body[1].var_no()];
-            --n_usage_count[body[2].var_no()];
-
-            return;
-          }
+          if(!negative)
+            emit({ !o, !distinct[i], !distinct[j] });
+          else
+            emit({ o, distinct[i], distinct[j] });
         }
+
+        queue.push_back(distinct[i]^!negative);
       }
-    }
 
-    // TODO : these special cases are fragile and could be improved.
-    // They don't handle cases where the construction is partially constant
-    // folded.  Also the usage constraints are sufficient for improvement
-    // but reductions may still be possible with looser restrictions.
-#endif
+      return;
+    }
+  }
 
-    if(n_pos)
+  if(!negative)
+  {
+    for(const auto &b : body)
     {
-      bvt lits(2);
-      lits[1]=neg(o);
-
-      forall_literals(it, body)
-      {
-        lits[0]=pos(*it);
-        solver.lcnf(lits);
-      }
+      emit({ !o, b });
+      queue.push_back(b);
     }
+  }
+  else
+  {
+    bvt clause;
+    clause.reserve(body.size()+1);
 
-    if(n_neg)
+    for(const auto &b : body)
     {
-      bvt lits;
-
-      forall_literals(it, body)
-        lits.push_back(neg(*it));
-
-      lits.push_back(pos(o));
-      solver.lcnf(lits);
+      clause.push_back(!b);
+      queue.push_back(!b);
     }
+
+    clause.push_back(o);
+    emit(clause);
   }
 }
 
+void aig_prop_solvert::emit(const bvt &clause)
+{
+  solver.lcnf(clause);
+  clauses++;
+}
+
 void aig_prop_solvert::convert_aig()
 {
-  // 1. Do variables
-  while(solver.no_variables()<=aig.nodes.size())
-    solver.new_variable();
+  const bool first=!optimized_once;
+  const std::size_t nodes_before=
+    first?aig_cone_size(aig, aig.constraints):0;
 
-  // Usage count for inlining
+  if(first)
+  {
+    optimize();
+    optimized_once=true;
+  }
 
-  std::vector<unsigned> p_usage_count;
-  std::vector<unsigned> n_usage_count;
-  p_usage_count.resize(aig.nodes.size(), 0);
-  n_usage_count.resize(aig.nodes.size(), 0);
+  // map the new constraints
+  const std::size_t first_new=optimized.constraints.size();
+  bvt queue;
 
-  this->usage_count(p_usage_count, n_usage_count);
+  for(std::size_t i=converted_constraints; i<aig.constraints.size(); i++)
+  {
+    const literalt l=map_node(aig.constraints[i]);
+    optimized.constraints.push_back(l);
+    queue.push_back(l);
+  }
 
+  converted_constraints=aig.constraints.size();
 
-  #ifdef USE_PG
-  // Get phases
-  std::vector<bool> n_pos, n_neg;
-  n_pos.resize(aig.nodes.size(), false);
-  n_neg.resize(aig.nodes.size(), false);
+  while(solver.no_variables()<=optimized.nodes.size())
+    solver.new_variable();
 
-  this->compute_phase(n_pos, n_neg);
-  #endif
+  if(freeze_all)
+  {
+    for(; frozen_variables<optimized.nodes.size(); frozen_variables++)
+      solver.set_frozen(literalt(frozen_variables, false));
+  }
 
-  // 2. Do nodes
-  for(std::size_t n=aig.nodes.size() - 1; n!=0; n--)
+  // the uses of the new nodes count towards the fanout
+  for(std::size_t n=fanout.size(); n<optimized.nodes.size(); n++)
   {
-    if(aig.nodes[n].is_and())
+    fanout.push_back(0);
+
+    const aigt::nodet &node=optimized.nodes[n];
+    if(node.is_and())
     {
-#ifdef USE_PG
-      convert_node(
-        n, aig.nodes[n], n_pos[n], n_neg[n], p_usage_count, n_usage_count);
-#else
-      convert_node(n, aig.nodes[n], true, true, p_usage_count, n_usage_count);
-#endif
+      if(!node.a.is_constant())
+        fanout[node.a.var_no()]++;
+      if(!node.b.is_constant())
+        fanout[node.b.var_no()]++;
     }
   }
-  // Skip zero as it is not used or a valid literal
 
+  for(const auto &l : queue)
+    if(!l.is_constant())
+      fanout[l.var_no()]++;
+
+  positive_done.resize(optimized.nodes.size(), false);
+  negative_done.resize(optimized.nodes.size(), false);
+
+  const std::size_t clauses_before=clauses;
+
+  while(!queue.empty())
+  {
+    const literalt l=queue.back();
+    queue.pop_back();
+
+    if(!builder.is_and(l))
+      continue;
 
-  // 3. Do constraints
-  for(const auto &c_it : aig.constraints)
-    solver.l_set_to(c_it, true);
+    std::vector<bool> &done=l.sign()?negative_done:positive_done;
+    if(done[l.var_no()])
+      continue;
 
-  // HACK!
-  aig.nodes.clear();
+    done[l.var_no()]=true;
+    convert_node(l, queue);
+  }
+
+  for(std::size_t i=first_new; i<optimized.constraints.size(); i++)
+    emit({ optimized.constraints[i] });
+
+  if(first)
+  {
+    // an estimate, not a measurement: the Tseitin encoding of the
+    // unoptimised cone gives three clauses per AND node, plus one per
+    // constraint
+    const std::size_t constraints=optimized.constraints.size();
+
+    status() << "AIG: " << nodes_before << " AND nodes optimised to "
+             << aig_cone_size(optimized, optimized.constraints)
+             << ", an estimated " << 3*nodes_before+constraints
+             << " clauses with a plain encoding, " << clauses-clauses_before
+             << " emitted" << eom;
+  }
 }
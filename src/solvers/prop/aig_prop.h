@@ -11,11 +11,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_PROP_AIG_PROP_H
 
 #include <cassert>
+#include <memory>
 
 #include <util/threeval.h>
 #include <solvers/prop/prop.h>
 
 #include "aig.h"
+#include "aig_optimize.h"
 
 class aig_prop_baset:public propt
 {
@@ -87,14 +89,16 @@ public:
   }
 };
 
+/// Builds an AIG, which is optimised with the passes in aig_optimize.h
+/// before the first call of prop_solve(), and then converted into the
+/// clauses of `solver` with the Plaisted-Greenbaum encoding. Literals and
+/// constraints added later are hashed and rewritten, but not optimised
+/// further.
 class aig_prop_solvert:public aig_prop_constraintt
 {
 public:
-  explicit aig_prop_solvert(propt &_solver):
-    aig_prop_constraintt(aig),
-    solver(_solver)
-  {
-  }
+  explicit aig_prop_solvert(propt &_solver);
+  explicit aig_prop_solvert(std::unique_ptr<propt> _solver);
 
   aig_plus_constraintst aig;
 
@@ -108,6 +112,12 @@ public:
   tvt l_get(literalt a) const override;
   resultt prop_solve() override;
 
+  /// Later literals and constraints are hashed onto any node converted
+  /// before, and the clauses of a node may be emitted in the other
+  /// polarity later on. Freezing a literal hence freezes every variable
+  /// of `solver` that is converted, now and later.
+  void set_frozen(literalt a) override { freeze_all=true; }
+
   void set_message_handler(message_handlert &m) override
   {
     aig_prop_constraintt::set_message_handler(m);
@@ -116,18 +126,37 @@ public:
 
 protected:
   propt &solver;
-
+  std::unique_ptr<propt> solver_ptr;
+
+  // the optimised AIG, whose node n is variable n of `solver`
+  aig_plus_constraintst optimized;
+  aig_buildert builder;
+  bool optimized_once;
+
+  // the literal in `optimized` for each node of `aig`
+  std::vector<literalt> node_map;
+  std::size_t converted_constraints;
+
+  // the uses of each node of `optimized`, and the polarities of the nodes
+  // whose clauses have been emitted
+  std::vector<unsigned> fanout;
+  std::vector<bool> positive_done, negative_done;
+  std::size_t clauses;
+
+  // whether to freeze the variables of `solver`, and the number of
+  // variables frozen so far
+  bool freeze_all;
+  std::size_t frozen_variables;
+
+  // the values of the nodes of `aig`, computed by l_get
+  mutable std::vector<tvt> values;
+  mutable bool values_valid;
+
+  void optimize();
+  literalt map_node(literalt l);
   void convert_aig();
-  void usage_count(
-    std::vector<unsigned> &p_usage_count, std::vector<unsigned> &n_usage_count);
-  void compute_phase(std::vector<bool> &n_pos, std::vector<bool> &n_neg);
-  void convert_node(
-    unsigned n,
-    const aigt::nodet &node,
-    bool n_pos,
-    bool n_neg,
-    std::vector<unsigned> &p_usage_count,
-    std::vector<unsigned> &n_usage_count);
+  void convert_node(literalt l, bvt &queue);
+  void emit(const bvt &clause);
 };
 
 #endif // CPROVER_SOLVERS_PROP_AIG_PROP_H
@@ -91,6 +91,9 @@ public:
   virtual size_t no_variables() const=0;
   bvt new_variables(std::size_t width);
 
+  // clauses, for the solvers that have them
+  virtual size_t no_clauses() const { return 0; }
+
   // solving
   virtual const std::string solver_text()=0;
   enum class resultt { P_SATISFIABLE, P_UNSATISFIABLE, P_ERROR };
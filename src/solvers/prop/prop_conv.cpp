@@ -8,10 +8,12 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "prop_conv.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <map>
 
+#include <util/profiler.h>
 #include <util/std_expr.h>
 #include <util/symbol.h>
 #include <util/threeval.h>
@@ -43,6 +45,41 @@ void prop_convt::set_frozen(const bvt &bv)
       set_frozen(bv[i]);
 }
 
+/// Represents the connectives AND, OR, NAND, NOR and IMPLIES as a
+/// conjunction whose inputs and output may be negated
+/// \param expr: Boolean expression
+/// \param [out] output_negated: whether the expression is the negation of
+///   the conjunction
+/// \return true if `expr` is one of the connectives
+static bool is_conjunction(const exprt &expr, bool &output_negated)
+{
+  const irep_idt &id=expr.id();
+
+  if(id==ID_and || id==ID_nor)
+    output_negated=false;
+  else if(id==ID_or || id==ID_nand)
+    output_negated=true;
+  else if(id==ID_implies && expr.operands().size()==2)
+    output_negated=true;
+  else
+    return false;
+
+  return !expr.operands().empty();
+}
+
+/// \return whether operand `i` of the connective `expr` is negated in
+///   the conjunction that represents it
+static bool is_input_negated(const exprt &expr, std::size_t i)
+{
+  const irep_idt &id=expr.id();
+  return id==ID_or || id==ID_nor || (id==ID_implies && i==1);
+}
+
+static unsigned flip(unsigned polarity)
+{
+  return ((polarity&1)<<1) | ((polarity&2)>>1);
+}
+
 bool prop_conv_solvert::literal(const exprt &expr, literalt &dest) const
 {
   assert(expr.type().id()==ID_bool);
@@ -162,6 +199,21 @@ bool prop_conv_solvert::get_bool(const exprt &expr, tvt &value) const
     }
   }
 
+  // the literals of the connectives are exact if they are used in both
+  // polarities
+
+  polarity_cachet::const_iterator polarity_result=
+    polarity_cache.find(expr);
+  bool output_negated;
+
+  if(polarity_result!=polarity_cache.end() &&
+     polarity_result->second.done==BOTH &&
+     is_conjunction(expr, output_negated))
+  {
+    value=prop.l_get(polarity_result->second.literal^output_negated);
+    return false;
+  }
+
   // check cache
 
   cachet::const_iterator cache_result=cache.find(expr);
@@ -174,6 +226,10 @@ bool prop_conv_solvert::get_bool(const exprt &expr, tvt &value) const
 
 literalt prop_conv_solvert::convert(const exprt &expr)
 {
+  bool output_negated;
+  if(polarity_aware && use_cache && is_conjunction(expr, output_negated))
+    return convert_polarity(expr, BOTH);
+
   if(!use_cache ||
      expr.id()==ID_symbol ||
      expr.id()==ID_constant)
@@ -206,6 +262,100 @@ literalt prop_conv_solvert::convert(const exprt &expr)
   return literal;
 }
 
+literalt prop_conv_solvert::convert_polarity(
+  const exprt &expr,
+  unsigned polarity)
+{
+  if(!polarity_aware || !use_cache)
+    return convert(expr);
+
+  const exprt::operandst &op=expr.operands();
+
+  if(expr.id()==ID_not && op.size()==1)
+    return !convert_polarity(op.front(), flip(polarity));
+
+  bool output_negated;
+  if(!is_conjunction(expr, output_negated))
+    return convert(expr);
+
+  // the polarity of the conjunction
+  if(output_negated)
+    polarity=flip(polarity);
+
+  // references into the unordered_map remain valid as it grows
+  polarity_entryt &entry=polarity_cache[expr];
+
+  const unsigned missing=polarity & ~entry.done;
+  entry.done|=polarity;
+
+  if(missing==0)
+    return entry.literal^output_negated;
+
+  // the inputs are needed in the polarities of the conjunction
+  bvt inputs;
+  inputs.reserve(op.size());
+
+  for(std::size_t i=0; i<op.size(); i++)
+  {
+    const bool negated=is_input_negated(expr, i);
+    inputs.push_back(
+      convert_polarity(op[i], negated?flip(missing):missing)^negated);
+  }
+
+  std::sort(inputs.begin(), inputs.end());
+  inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+
+  bvt conjuncts;
+  conjuncts.reserve(inputs.size());
+  bool is_false=false;
+
+  for(const auto &l : inputs)
+  {
+    if(l.is_false() || (!conjuncts.empty() && conjuncts.back()==!l))
+      is_false=true;
+    else if(!l.is_true())
+      conjuncts.push_back(l);
+  }
+
+  if(is_false)
+    entry.literal=const_literal(false);
+  else if(conjuncts.empty())
+    entry.literal=const_literal(true);
+  else if(conjuncts.size()==1)
+    entry.literal=conjuncts.front();
+  else
+  {
+    if(entry.literal.var_no()==literalt::unused_var_no())
+    {
+      entry.literal=prop.new_variable();
+      if(freeze_all)
+        prop.set_frozen(entry.literal);
+    }
+
+    const literalt output=entry.literal;
+
+    // output implies the conjunction
+    if(missing&POSITIVE)
+    {
+      for(const auto &l : conjuncts)
+        prop.lcnf(!output, l);
+    }
+
+    // the conjunction implies output
+    if(missing&NEGATIVE)
+    {
+      bvt clause;
+      clause.reserve(conjuncts.size()+1);
+      for(const auto &l : conjuncts)
+        clause.push_back(!l);
+      clause.push_back(output);
+      prop.lcnf(clause);
+    }
+  }
+
+  return entry.literal^output_negated;
+}
+
 literalt prop_conv_solvert::convert_bool(const exprt &expr)
 {
   if(expr.type().id()!=ID_bool)
@@ -421,7 +571,7 @@ void prop_conv_solvert::set_to(const exprt &expr, bool value)
             bv.reserve(expr.operands().size());
 
             forall_operands(it, expr)
-              bv.push_back(convert(*it));
+              bv.push_back(convert_polarity(*it, POSITIVE));
 
             prop.lcnf(bv);
             return;
@@ -431,8 +581,8 @@ void prop_conv_solvert::set_to(const exprt &expr, bool value)
         {
           if(expr.operands().size()==2)
           {
-            literalt l0=convert(expr.op0());
-            literalt l1=convert(expr.op1());
+            literalt l0=convert_polarity(expr.op0(), NEGATIVE);
+            literalt l1=convert_polarity(expr.op1(), POSITIVE);
             prop.lcnf(!l0, l1);
             return;
           }
@@ -464,7 +614,21 @@ void prop_conv_solvert::set_to(const exprt &expr, bool value)
   }
 
   // fall back to convert
-  prop.l_set_to(convert(expr), value);
+  prop.l_set_to(convert_polarity(expr, value?POSITIVE:NEGATIVE), value);
+}
+
+void prop_conv_solvert::prune_cache()
+{
+  if(cache_size()<2*pruned_cache_size)
+    return;
+
+  // the expression of an erased entry may have been the last one that
+  // shared the expression of another entry
+  while(erase_unshared_cache_entries())
+  {
+  }
+
+  pruned_cache_size=std::max(cache_size(), pruned_cache_size);
 }
 
 void prop_conv_solvert::ignoring(const exprt &expr)
@@ -490,6 +654,10 @@ decision_proceduret::resultt prop_conv_solvert::dec_solve()
 
   statistics() << "Solving with " << prop.solver_text() << eom;
 
+  profile_phaset phase("prop_solve");
+  profile_count("variables", prop.no_variables());
+  profile_count("clauses", prop.no_clauses());
+
   propt::resultt result=prop.prop_solve();
 
   switch(result)
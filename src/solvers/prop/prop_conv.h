@@ -58,6 +58,11 @@ public:
 
   // Resource limits:
   virtual void set_time_limit_seconds(uint32_t) {}
+
+  /// Drops the conversions of expressions that nothing but the caches
+  /// refers to, once the caches have doubled in size since this was last
+  /// done. An equal expression that is converted later is converted again.
+  virtual void prune_cache() {}
 };
 
 //
@@ -74,8 +79,10 @@ public:
     prop_convt(_ns),
     use_cache(true),
     equality_propagation(true),
+    polarity_aware(false),
     freeze_all(false),
     post_processing_done(false),
+    pruned_cache_size(1024),
     prop(_prop) { }
 
   virtual ~prop_conv_solvert() { }
@@ -108,9 +115,16 @@ public:
 
   bool use_cache;
   bool equality_propagation;
+  bool polarity_aware; // Plaisted-Greenbaum encoding of the connectives
   bool freeze_all; // freezing variables (for incremental solving)
 
-  virtual void clear_cache() { cache.clear();}
+  virtual void clear_cache()
+  {
+    cache.clear();
+    polarity_cache.clear();
+  }
+
+  void prune_cache() override;
 
   typedef std::map<irep_idt, literalt> symbolst;
   typedef std::unordered_map<exprt, literalt, irep_hash> cachet;
@@ -144,8 +158,70 @@ protected:
   // cache
   cachet cache;
 
+  /// The polarities in which a literal is used. A literal that is only
+  /// used positively only needs to imply its expression, and one that is
+  /// only used negatively only needs to be implied by it.
+  enum polarityt : unsigned { POSITIVE=1, NEGATIVE=2, BOTH=3 };
+
+  /// Converts the connectives AND, OR, NAND, NOR and IMPLIES with the
+  /// Plaisted-Greenbaum encoding when polarity_aware is set, and any other
+  /// expression with convert()
+  /// \param expr: Boolean expression
+  /// \param polarity: a combination of polarityt
+  literalt convert_polarity(const exprt &expr, unsigned polarity);
+
+  struct polarity_entryt
+  {
+    literalt literal;
+    // the polarities of the conjunction whose clauses have been added
+    unsigned done=0;
+  };
+
+  typedef std::unordered_map<exprt, polarity_entryt, irep_hash>
+    polarity_cachet;
+
+  // the connectives converted by convert_polarity, each of which is
+  // represented as a (possibly negated) conjunction
+  polarity_cachet polarity_cache;
+
   virtual void ignoring(const exprt &expr);
 
+  // the size of the caches after they were last pruned
+  std::size_t pruned_cache_size;
+
+  virtual std::size_t cache_size() const
+  {
+    return cache.size()+polarity_cache.size();
+  }
+
+  /// Erases the entries of the caches whose expression nothing else
+  /// refers to
+  /// \return true if any entry was erased
+  virtual bool erase_unshared_cache_entries()
+  {
+    bool erased=erase_unshared(cache);
+    return erase_unshared(polarity_cache) || erased;
+  }
+
+  template<typename cachet>
+  static bool erase_unshared(cachet &cache)
+  {
+    bool erased=false;
+
+    for(auto it=cache.begin(); it!=cache.end();)
+    {
+      if(it->first.is_unshared())
+      {
+        it=cache.erase(it);
+        erased=true;
+      }
+      else
+        ++it;
+    }
+
+    return erased;
+  }
+
   // deliberately protected now to protect lower-level API
   propt &prop;
 };
@@ -12,6 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_REFINEMENT_BV_REFINEMENT_H
 #define CPROVER_SOLVERS_REFINEMENT_BV_REFINEMENT_H
 
+#include <map>
+#include <tuple>
+
 #include <util/ui_message.h>
 
 #include <solvers/flattening/bv_pointers.h>
@@ -69,6 +72,7 @@ private:
       no_operands(0),
       under_state(0),
       over_state(0),
+      exact_bits(0),
       id_nr(_id_nr)
     {
     }
@@ -85,6 +89,10 @@ private:
     // the kind of under- or over-approximation
     unsigned under_state, over_state;
 
+    // the number of least-significant bits of an integer product
+    // that are encoded exactly
+    std::size_t exact_bits;
+
     std::string as_string() const;
 
     void add_over_assumption(literalt l);
@@ -95,6 +103,22 @@ private:
 
   resultt prop_solve();
   approximationt &add_approximation(const exprt &expr, bvt &bv);
+  approximationt &add_approximation(
+    const exprt &expr,
+    const bvt &op0_bv,
+    const bvt &op1_bv);
+  void encode_product(approximationt &approximation, std::size_t bits);
+  void lazy_divider(
+    const bvt &op0,
+    const bvt &op1,
+    bvt &res,
+    bvt &rem,
+    bv_utilst::representationt rep);
+  void lazy_unsigned_divider(
+    const bvt &op0,
+    const bvt &op1,
+    bvt &res,
+    bvt &rem);
   bool conflicts_with(approximationt &approximation);
   void check_SAT(approximationt &approximation);
   void check_UNSAT(approximationt &approximation);
@@ -109,6 +133,12 @@ private:
 
   bool progress;
   std::list<approximationt> approximations;
+
+  // quotient and remainder of the integer divisions
+  typedef std::map<
+    std::tuple<bvt, bvt, bv_utilst::representationt>,
+    std::pair<bvt, bvt>> divider_cachet;
+  divider_cachet divider_cache;
   bvt parent_assumptions;
 protected:
   // use gui format
@@ -8,6 +8,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "bv_refinement.h"
 
+#include <algorithm>
+
 #include <util/bv_arithmetic.h>
 #include <util/ieee_float.h>
 #include <util/expr_util.h>
@@ -19,9 +21,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <solvers/floatbv/float_utils.h>
 
 // Parameters
-#define MAX_INTEGER_UNDERAPPROX 3
 #define MAX_FLOAT_UNDERAPPROX 10
 
+static bv_utilst::representationt representation(const typet &type)
+{
+  return type.id()==ID_signedbv?bv_utilst::representationt::SIGNED:
+                                bv_utilst::representationt::UNSIGNED;
+}
+
 void bv_refinementt::approximationt::add_over_assumption(literalt l)
 {
   // if it's a constant already, give up
@@ -111,9 +118,16 @@ bvt bv_refinementt::convert_div(const div_exprt &expr)
   if(expr.op1().is_constant())
     return SUB::convert_div(expr);
 
-  bvt bv;
-  add_approximation(expr, bv);
-  return bv;
+  const std::size_t width=boolbv_width(expr.type());
+  const bvt op0=convert_bv(expr.op0());
+  const bvt op1=convert_bv(expr.op1());
+
+  if(op0.size()!=width || op1.size()!=width)
+    return SUB::convert_div(expr);
+
+  bvt res, rem;
+  lazy_divider(op0, op1, res, rem, representation(expr.type()));
+  return res;
 }
 
 bvt bv_refinementt::convert_mod(const mod_exprt &expr)
@@ -129,14 +143,105 @@ bvt bv_refinementt::convert_mod(const mod_exprt &expr)
   if(expr.op1().is_constant())
     return SUB::convert_mod(expr);
 
-  bvt bv;
-  add_approximation(expr, bv);
-  return bv;
+  const std::size_t width=boolbv_width(expr.type());
+  const bvt op0=convert_bv(expr.op0());
+  const bvt op1=convert_bv(expr.op1());
+
+  if(op0.size()!=width || op1.size()!=width)
+    return SUB::convert_mod(expr);
+
+  bvt res, rem;
+  lazy_divider(op0, op1, res, rem, representation(expr.type()));
+  return rem;
+}
+
+/// Divides like bv_utilst::divider, but defines the quotient and the
+/// remainder through a product that is refined lazily. Divisions of the
+/// same operands share the quotient and the remainder.
+void bv_refinementt::lazy_divider(
+  const bvt &op0,
+  const bvt &op1,
+  bvt &res,
+  bvt &rem,
+  bv_utilst::representationt rep)
+{
+  const auto entry=
+    divider_cache.insert({ std::make_tuple(op0, op1, rep), { } });
+
+  if(!entry.second)
+  {
+    res=entry.first->second.first;
+    rem=entry.first->second.second;
+    return;
+  }
+
+  if(rep==bv_utilst::representationt::UNSIGNED)
+    lazy_unsigned_divider(op0, op1, res, rem);
+  else
+  {
+    // divide the absolute values, as bv_utilst::signed_divider does
+    const literalt sign0=op0.back();
+    const literalt sign1=op1.back();
+
+    lazy_unsigned_divider(
+      bv_utils.cond_negate(op0, sign0),
+      bv_utils.cond_negate(op1, sign1),
+      res,
+      rem);
+
+    res=bv_utils.cond_negate(res, prop.lxor(sign0, sign1));
+    rem=bv_utils.cond_negate(rem, sign0);
+  }
+
+  entry.first->second=std::make_pair(res, rem);
+}
+
+/// The quotient and the remainder are fresh variables with
+/// op1!=0 => res*op1+rem==op0 && rem<op1, where the product is computed
+/// in twice the width, and hence without overflow. Its partial products
+/// are added only once a model violates them.
+void bv_refinementt::lazy_unsigned_divider(
+  const bvt &op0,
+  const bvt &op1,
+  bvt &res,
+  bvt &rem)
+{
+  const std::size_t width=op0.size();
+  const literalt is_not_zero=prop.lor(op1);
+
+  res=prop.new_variables(width);
+  rem=prop.new_variables(width);
+
+  approximationt &a=add_approximation(
+    exprt(ID_mult, unsignedbv_typet(2*width)),
+    bv_utils.zero_extension(res, 2*width),
+    bv_utils.zero_extension(op1, 2*width));
+
+  const bvt sum=
+    bv_utils.add(a.result_bv, bv_utils.zero_extension(rem, 2*width));
+
+  prop.l_set_to_true(
+    prop.limplies(
+      is_not_zero,
+      bv_utils.equal(sum, bv_utils.zero_extension(op0, 2*width))));
+
+  prop.l_set_to_true(
+    prop.limplies(
+      is_not_zero,
+      bv_utils.lt_or_le(
+        false, rem, op1, bv_utilst::representationt::UNSIGNED)));
+
+  // not implied before the product is exact, but cheap
+  prop.l_set_to_true(
+    prop.limplies(
+      is_not_zero,
+      bv_utils.lt_or_le(
+        true, res, op0, bv_utilst::representationt::UNSIGNED)));
 }
 
 void bv_refinementt::get_values(approximationt &a)
 {
-  std::size_t o=a.expr.operands().size();
+  std::size_t o=a.no_operands;
 
   if(o==1)
     a.op0_value=get_value(a.op0_bv);
@@ -282,73 +387,44 @@ void bv_refinementt::check_SAT(approximationt &a)
   else if(type.id()==ID_signedbv ||
           type.id()==ID_unsignedbv)
   {
-    // these are all binary
+    // these are all binary products, as divisions and remainders
+    // are defined through a product
     INVARIANT(
-      a.expr.operands().size()==2,
-      string_refinement_invariantt("all (un)signedbv typed exprs are binary"));
+      a.no_operands==2 && a.expr.id()==ID_mult,
+      string_refinement_invariantt("all (un)signedbv typed exprs are "
+        "binary products"));
+
+    const std::size_t width=a.result_bv.size();
 
     // already full interpretation?
-    if(a.over_state>0)
+    if(a.exact_bits==width)
       return;
 
+    // the bits of the product do not depend on the signedness
     bv_spect spec(type);
     bv_arithmetict o0(spec), o1(spec);
     o0.unpack(a.op0_value);
     o1.unpack(a.op1_value);
+    o0*=o1;
 
-    // division by zero is never spurious
+    const std::string product=integer2binary(o0.pack(), width);
+    const std::string result=integer2binary(a.result_value, width);
 
-    if((a.expr.id()==ID_div || a.expr.id()==ID_mod) &&
-       o1==0)
+    if(product==result) // ok
       return;
 
-    if(a.expr.id()==ID_mult)
-      o0*=o1;
-    else if(a.expr.id()==ID_div)
-      o0/=o1;
-    else if(a.expr.id()==ID_mod)
-      o0%=o1;
-    else
-      UNREACHABLE;
+    // the least-significant bit that is wrong depends on the
+    // partial products of the bits up to it
+    std::size_t bit=0;
+    while(product[width-bit-1]==result[width-bit-1])
+      bit++;
 
-    if(o0.pack()==a.result_value) // ok
-      return;
+    // at least double the exact bits, and give up eventually
+    std::size_t bits=std::max(bit+1, 2*a.exact_bits);
+    if(a.over_state+1>=config_.max_node_refinement)
+      bits=width;
 
-    if(a.over_state==0)
-    {
-      // we give up right away and add the full interpretation
-      bvt r;
-      if(a.expr.id()==ID_mult)
-      {
-        r=bv_utils.multiplier(
-          a.op0_bv, a.op1_bv,
-          a.expr.type().id()==ID_signedbv?
-            bv_utilst::representationt::SIGNED:
-            bv_utilst::representationt::UNSIGNED);
-      }
-      else if(a.expr.id()==ID_div)
-      {
-        r=bv_utils.divider(
-          a.op0_bv, a.op1_bv,
-          a.expr.type().id()==ID_signedbv?
-            bv_utilst::representationt::SIGNED:
-            bv_utilst::representationt::UNSIGNED);
-      }
-      else if(a.expr.id()==ID_mod)
-      {
-        r=bv_utils.remainder(
-          a.op0_bv, a.op1_bv,
-          a.expr.type().id()==ID_signedbv?
-            bv_utilst::representationt::SIGNED:
-            bv_utilst::representationt::UNSIGNED);
-      }
-      else
-        UNREACHABLE;
-
-      bv_utils.set_equal(r, a.result_bv);
-    }
-    else
-      UNREACHABLE;
+    encode_product(a, std::min(bits, width));
   }
   else if(type.id()==ID_fixedbv)
   {
@@ -434,9 +510,10 @@ void bv_refinementt::check_UNSAT(approximationt &a)
   }
   else
   {
-    unsigned x=a.under_state+1;
+    // the free bits double in each step
+    std::size_t x=std::size_t(1)<<std::min(a.under_state, 16u);
 
-    if(x>=MAX_INTEGER_UNDERAPPROX && x>=a.result_bv.size())
+    if(x>=a.result_bv.size())
     {
       // make it free altogether, this guarantees progress
     }
@@ -467,6 +544,19 @@ bool bv_refinementt::conflicts_with(approximationt &a)
   return false;
 }
 
+/// Encodes the `bits` least-significant bits of an integer product
+/// exactly, with the partial products of the operand bits below them
+void bv_refinementt::encode_product(approximationt &a, std::size_t bits)
+{
+  const bvt product=
+    bv_utils.unsigned_multiplier(
+      bv_utilst::extract_lsb(a.op0_bv, bits),
+      bv_utilst::extract_lsb(a.op1_bv, bits));
+
+  bv_utils.set_equal(product, bv_utilst::extract_lsb(a.result_bv, bits));
+  a.exact_bits=bits;
+}
+
 void bv_refinementt::initialize(approximationt &a)
 {
   a.over_state=a.under_state=0;
@@ -528,6 +618,32 @@ bv_refinementt::add_approximation(
   return a;
 }
 
+/// Adds an approximation of a binary operation whose operands are
+/// already converted, with no under-approximation
+bv_refinementt::approximationt &
+bv_refinementt::add_approximation(
+  const exprt &expr,
+  const bvt &op0_bv,
+  const bvt &op1_bv)
+{
+  approximations.push_back(approximationt(approximations.size()));
+  approximationt &a=approximations.back();
+
+  std::size_t width=boolbv_width(expr.type());
+  PRECONDITION(width!=0);
+
+  a.expr=expr;
+  a.result_bv=prop.new_variables(width);
+  a.no_operands=2;
+  a.op0_bv=op0_bv;
+  a.op1_bv=op1_bv;
+  set_frozen(a.result_bv);
+  set_frozen(a.op0_bv);
+  set_frozen(a.op1_bv);
+
+  return a;
+}
+
 std::string bv_refinementt::approximationt::as_string() const
 {
   #if 0
@@ -132,10 +132,10 @@ static optionalt<exprt> get_array(
 /// \param index_value: map containing values of specific vector cells
 /// \return Vector containing values as described in the map
 template <typename T>
-static std::vector<T> fill_in_map_as_vector(
+static irep_sub_vectort<T> fill_in_map_as_vector(
   const std::map<std::size_t, T> &index_value)
 {
-  std::vector<T> result;
+  irep_sub_vectort<T> result;
   if(!index_value.empty())
   {
     result.resize(index_value.rbegin()->first+1);
@@ -1453,7 +1453,7 @@ static exprt negation_of_not_contains_constraint(
 
   // The negated existential becomes an universal, and this is the unrolling of
   // that universal quantifier.
-  std::vector<exprt> conjuncts;
+  exprt::operandst conjuncts;
   for(mp_integer i=lbe; i<ube; ++i)
   {
     const constant_exprt i_exprt=from_integer(i, univ_var.type());
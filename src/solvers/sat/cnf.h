@@ -37,7 +37,7 @@ public:
   virtual literalt new_variable() override;
   virtual size_t no_variables() const override { return _no_variables; }
   virtual void set_no_variables(size_t no) { _no_variables=no; }
-  virtual size_t no_clauses() const=0;
+  virtual size_t no_clauses() const override=0;
 
   void gate_and(literalt a, literalt b, literalt o);
   void gate_or(literalt a, literalt b, literalt o);
@@ -76,7 +76,9 @@ public:
   }
 
 protected:
-  enum class statust { INIT, SAT, UNSAT, ERROR };
+  // INTERRUPTED: the last query has been stopped by interrupt(), the
+  // solver can be used again
+  enum class statust { INIT, SAT, UNSAT, ERROR, INTERRUPTED };
   statust status;
   size_t clause_counter;
 };
@@ -131,6 +131,20 @@ void satcheck_glucose_baset<T>::lcnf(const bvt &bv)
   }
 }
 
+template<typename T>
+void satcheck_glucose_baset<T>::interrupt()
+{
+  interrupted=true;
+  solver->interrupt();
+}
+
+template<typename T>
+void satcheck_glucose_baset<T>::clear_interrupt()
+{
+  interrupted=false;
+  solver->clearInterrupt();
+}
+
 template<typename T>
 propt::resultt satcheck_glucose_baset<T>::prop_solve()
 {
@@ -171,16 +185,35 @@ propt::resultt satcheck_glucose_baset<T>::prop_solve()
         Glucose::vec<Glucose::Lit> solver_assumptions;
         convert(assumptions, solver_assumptions);
 
-        if(solver->solve(solver_assumptions))
+        using Glucose::lbool;
+
+        lbool solver_result=solver->solveLimited(solver_assumptions);
+
+        if(solver_result==l_True)
         {
           messaget::status() << "SAT checker: instance is SATISFIABLE" << eom;
           status = statust::SAT;
           return resultt::P_SATISFIABLE;
         }
-        else
+        else if(solver_result==l_False)
         {
           messaget::status() << "SAT checker: instance is UNSATISFIABLE" << eom;
         }
+        else
+        {
+          if(interrupted)
+          {
+            // interrupt() has been called, e.g., by a portfolio; the
+            // solver remains usable once the interrupt has been cleared
+            messaget::status() << "SAT checker: interrupted" << eom;
+            status = statust::INTERRUPTED;
+            return resultt::P_ERROR;
+          }
+
+          messaget::status() << "SAT checker: timed out or other error" << eom;
+          status = statust::ERROR;
+          return resultt::P_ERROR;
+        }
       }
     }
 
@@ -220,7 +253,7 @@ void satcheck_glucose_baset<T>::set_assignment(literalt a, bool value)
 
 template<typename T>
 satcheck_glucose_baset<T>::satcheck_glucose_baset(T *_solver):
-  solver(_solver)
+  solver(_solver), interrupted(false)
 {
 }
 
@@ -291,3 +324,6 @@ bool satcheck_glucose_simplifiert::is_eliminated(literalt a) const
 
   return solver->isEliminated(a.var_no());
 }
+
+template class satcheck_glucose_baset<Glucose::Solver>;
+template class satcheck_glucose_baset<Glucose::SimpSolver>;
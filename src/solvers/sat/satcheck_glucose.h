@@ -10,6 +10,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_SAT_SATCHECK_GLUCOSE_H
 #define CPROVER_SOLVERS_SAT_SATCHECK_GLUCOSE_H
 
+#include <atomic>
+
 #include "cnf.h"
 
 // Select one: basic solver or with simplification.
@@ -42,12 +44,20 @@ public:
   // extra MiniSat feature: default branching decision
   void set_polarity(literalt a, bool value);
 
+  // extra MiniSat feature: interrupt running SAT query
+  void interrupt();
+
+  // extra MiniSat feature: permit previously interrupted SAT query to continue
+  void clear_interrupt();
+
   virtual bool is_in_conflict(literalt a) const;
   virtual bool has_set_assumptions() const { return true; }
   virtual bool has_is_in_conflict() const { return true; }
 
 protected:
   T *solver;
+  // set by interrupt(), which is called from another thread
+  std::atomic<bool> interrupted;
 
   void add_variables();
   bvt assumptions;
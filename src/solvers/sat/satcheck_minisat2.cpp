@@ -84,12 +84,14 @@ void satcheck_minisat2_baset<T>::set_polarity(literalt a, bool value)
 template<typename T>
 void satcheck_minisat2_baset<T>::interrupt()
 {
+  interrupted=true;
   solver->interrupt();
 }
 
 template<typename T>
 void satcheck_minisat2_baset<T>::clear_interrupt()
 {
+  interrupted=false;
   solver->clearInterrupt();
 }
 
@@ -250,6 +252,15 @@ propt::resultt satcheck_minisat2_baset<T>::prop_solve()
         }
         else
         {
+          if(interrupted)
+          {
+            // interrupt() has been called, e.g., by a portfolio; the
+            // solver remains usable once the interrupt has been cleared
+            messaget::status() << "SAT checker: interrupted" << eom;
+            status=statust::INTERRUPTED;
+            return resultt::P_ERROR;
+          }
+
           messaget::status() <<
             "SAT checker: timed out or other error" << eom;
           status=statust::ERROR;
@@ -295,7 +306,7 @@ void satcheck_minisat2_baset<T>::set_assignment(literalt a, bool value)
 
 template<typename T>
 satcheck_minisat2_baset<T>::satcheck_minisat2_baset(T *_solver):
-  solver(_solver), time_limit_seconds(0)
+  solver(_solver), interrupted(false), time_limit_seconds(0)
 {
 }
 
@@ -370,3 +381,6 @@ bool satcheck_minisat_simplifiert::is_eliminated(literalt a) const
 
   return solver->isEliminated(a.var_no());
 }
+
+template class satcheck_minisat2_baset<Minisat::Solver>;
+template class satcheck_minisat2_baset<Minisat::SimpSolver>;
@@ -10,6 +10,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_SAT_SATCHECK_MINISAT2_H
 #define CPROVER_SOLVERS_SAT_SATCHECK_MINISAT2_H
 
+#include <atomic>
+
 #include "cnf.h"
 
 // Select one: basic solver or with simplification.
@@ -59,6 +61,8 @@ public:
 
 protected:
   T *solver;
+  // set by interrupt(), which is called from another thread
+  std::atomic<bool> interrupted;
   uint32_t time_limit_seconds;
 
   void add_variables();
@@ -0,0 +1,217 @@
+/*******************************************************************\
+
+Module: Portfolio of SAT Solvers
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Portfolio of SAT Solvers
+
+#include "satcheck_portfolio.h"
+
+#include <mutex>
+#include <thread>
+
+#include <util/invariant.h>
+#include <util/make_unique.h>
+
+#ifdef HAVE_MINISAT2
+#include "satcheck_minisat2.h"
+#endif
+
+#ifdef HAVE_GLUCOSE
+#include "satcheck_glucose.h"
+#endif
+
+const std::string satcheck_portfoliot::solver_text()
+{
+  std::string result="portfolio of";
+
+  for(std::size_t i=0; i<solvers.size(); i++)
+    result+=(i==0?" ":", ")+solvers[i].solver->solver_text();
+
+  return result;
+}
+
+void satcheck_portfoliot::add_variables()
+{
+  for(auto &s : solvers)
+    s.solver->set_no_variables(no_variables());
+}
+
+void satcheck_portfoliot::lcnf(const bvt &bv)
+{
+  bvt new_bv;
+
+  if(process_clause(bv, new_bv))
+    return;
+
+  add_variables();
+
+  for(auto &s : solvers)
+    s.solver->lcnf(new_bv);
+
+  clause_counter++;
+}
+
+void satcheck_portfoliot::set_frozen(literalt a)
+{
+  add_variables();
+
+  for(auto &s : solvers)
+    s.solver->set_frozen(a);
+}
+
+void satcheck_portfoliot::set_assumptions(const bvt &_assumptions)
+{
+  add_variables();
+
+  for(auto &s : solvers)
+    s.solver->set_assumptions(_assumptions);
+}
+
+bool satcheck_portfoliot::has_set_assumptions() const
+{
+  for(const auto &s : solvers)
+    if(!s.solver->has_set_assumptions())
+      return false;
+
+  return true;
+}
+
+bool satcheck_portfoliot::has_is_in_conflict() const
+{
+  for(const auto &s : solvers)
+    if(!s.solver->has_is_in_conflict())
+      return false;
+
+  return true;
+}
+
+propt::resultt satcheck_portfoliot::prop_solve()
+{
+  PRECONDITION(!solvers.empty());
+  PRECONDITION(status!=statust::ERROR);
+
+  add_variables();
+
+  // We start counting at 1, thus there is one variable fewer.
+  messaget::status() << (no_variables()-1) << " variables, "
+                     << no_clauses() << " clauses, "
+                     << solvers.size() << " solvers" << eom;
+
+  winner=no_winner;
+  std::vector<resultt> results(solvers.size(), resultt::P_ERROR);
+  std::mutex winner_mutex;
+
+  for(auto &s : solvers)
+    s.clear_interrupt();
+
+  std::vector<std::thread> threads;
+  threads.reserve(solvers.size());
+
+  for(std::size_t i=0; i<solvers.size(); i++)
+  {
+    threads.emplace_back(
+      [this, i, &results, &winner_mutex]()
+      {
+        resultt result;
+
+        try
+        {
+          result=solvers[i].solver->prop_solve();
+        }
+        catch(...)
+        {
+          result=resultt::P_ERROR;
+        }
+
+        results[i]=result;
+
+        if(result==resultt::P_ERROR)
+          return;
+
+        std::lock_guard<std::mutex> lock(winner_mutex);
+
+        if(winner==no_winner)
+        {
+          winner=i;
+
+          for(std::size_t j=0; j<solvers.size(); j++)
+            if(j!=i)
+              solvers[j].interrupt();
+        }
+      });
+  }
+
+  for(auto &t : threads)
+    t.join();
+
+  if(winner==no_winner)
+  {
+    messaget::error() << "all solvers in the portfolio have failed" << eom;
+    status=statust::ERROR;
+    return resultt::P_ERROR;
+  }
+
+  messaget::status() << "SAT checker "
+                     << solvers[winner].solver->solver_text()
+                     << " answered first: instance is "
+                     << (results[winner]==resultt::P_SATISFIABLE?
+                         "SATISFIABLE":"UNSATISFIABLE") << eom;
+
+  if(results[winner]==resultt::P_SATISFIABLE)
+  {
+    status=statust::SAT;
+    return resultt::P_SATISFIABLE;
+  }
+
+  status=statust::UNSAT;
+  return resultt::P_UNSATISFIABLE;
+}
+
+tvt satcheck_portfoliot::l_get(literalt a) const
+{
+  if(a.is_true())
+    return tvt(true);
+  else if(a.is_false())
+    return tvt(false);
+
+  if(winner==no_winner)
+    return tvt::unknown();
+
+  return solvers[winner].solver->l_get(a);
+}
+
+void satcheck_portfoliot::set_assignment(literalt a, bool value)
+{
+  PRECONDITION(winner!=no_winner);
+  solvers[winner].solver->set_assignment(a, value);
+}
+
+bool satcheck_portfoliot::is_in_conflict(literalt a) const
+{
+  PRECONDITION(winner!=no_winner);
+  return solvers[winner].solver->is_in_conflict(a);
+}
+
+std::unique_ptr<satcheck_portfoliot> new_satcheck_portfolio(bool simplifier)
+{
+  auto portfolio=util_make_unique<satcheck_portfoliot>();
+
+  #ifdef HAVE_MINISAT2
+  portfolio->add_solver(util_make_unique<satcheck_minisat_no_simplifiert>());
+  if(simplifier)
+    portfolio->add_solver(util_make_unique<satcheck_minisat_simplifiert>());
+  #endif
+
+  #ifdef HAVE_GLUCOSE
+  portfolio->add_solver(util_make_unique<satcheck_glucose_no_simplifiert>());
+  if(simplifier)
+    portfolio->add_solver(util_make_unique<satcheck_glucose_simplifiert>());
+  #endif
+
+  return portfolio;
+}
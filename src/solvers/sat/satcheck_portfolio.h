@@ -0,0 +1,88 @@
+/*******************************************************************\
+
+Module: Portfolio of SAT Solvers
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Portfolio of SAT Solvers
+
+#ifndef CPROVER_SOLVERS_SAT_SATCHECK_PORTFOLIO_H
+#define CPROVER_SOLVERS_SAT_SATCHECK_PORTFOLIO_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "cnf.h"
+
+/// Passes every clause to a number of SAT solvers, and runs these
+/// concurrently on each call to prop_solve(). The first solver to
+/// come back with an answer wins, the others are interrupted.
+/// The satisfying assignment is then taken from the winner.
+/// Interrupted solvers retain their clauses and take part in
+/// subsequent incremental calls.
+class satcheck_portfoliot:public cnf_solvert
+{
+public:
+  satcheck_portfoliot():winner(no_winner)
+  {
+  }
+
+  /// Add a solver to the portfolio. The solver type must offer
+  /// interrupt() and clear_interrupt().
+  template<typename T>
+  void add_solver(std::unique_ptr<T> solver)
+  {
+    T *s=solver.get();
+    solverst::value_type entry;
+    entry.interrupt=[s]() { s->interrupt(); };
+    entry.clear_interrupt=[s]() { s->clear_interrupt(); };
+    entry.solver=std::move(solver);
+    solvers.push_back(std::move(entry));
+  }
+
+  std::size_t size() const
+  {
+    return solvers.size();
+  }
+
+  virtual const std::string solver_text() override;
+  virtual resultt prop_solve() override;
+  virtual tvt l_get(literalt a) const override;
+
+  virtual void lcnf(const bvt &bv) override;
+  virtual void set_assignment(literalt a, bool value) override;
+  virtual void set_frozen(literalt a) override;
+
+  virtual void set_assumptions(const bvt &_assumptions) override;
+  virtual bool has_set_assumptions() const override;
+  virtual bool is_in_conflict(literalt a) const override;
+  virtual bool has_is_in_conflict() const override;
+
+protected:
+  struct solvert
+  {
+    std::unique_ptr<cnf_solvert> solver;
+    std::function<void()> interrupt;
+    std::function<void()> clear_interrupt;
+  };
+
+  typedef std::vector<solvert> solverst;
+  solverst solvers;
+
+  static const std::size_t no_winner=-1;
+
+  // the index of the solver that answered the last query first
+  std::size_t winner;
+
+  void add_variables();
+};
+
+/// Set up a portfolio with all SAT solvers built in
+/// \param simplifier: whether to also add variants with a preprocessor
+std::unique_ptr<satcheck_portfoliot> new_satcheck_portfolio(bool simplifier);
+
+#endif // CPROVER_SOLVERS_SAT_SATCHECK_PORTFOLIO_H
@@ -11,7 +11,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "smt2_conv.h"
 
+#include <algorithm>
 #include <cassert>
+#include <unordered_set>
 
 #include <util/arith_tools.h>
 #include <util/base_type.h>
@@ -707,10 +709,12 @@ literalt smt2_convt::convert(const exprt &expr)
 
   out << "\n";
 
+  define_shared_subterms(expr);
   find_symbols(expr);
 
   literalt l(no_boolean_variables, false);
   no_boolean_variables++;
+  smt2_identifiers.insert("B"+std::to_string(l.var_no()));
 
   out << "; convert\n";
   out << "(define-fun ";
@@ -737,40 +741,46 @@ void smt2_convt::convert_literal(const literalt l)
 
     if(l.sign())
       out << ")";
-
-    smt2_identifiers.insert("B"+std::to_string(l.var_no()));
   }
 }
 
-std::string smt2_convt::convert_identifier(const irep_idt &identifier)
+/// Writes the identifier as it goes between the bars of a quoted symbol,
+/// without building a string first
+static void write_identifier(std::ostream &out, const std::string &identifier)
 {
   // Backslashes are disallowed in quoted symbols just for simplicity.
   // Otherwise, for Common Lisp compatibility they would have to be treated
   // as escaping symbols.
 
-  std::string result;
-
-  for(std::size_t i=0; i<identifier.size(); i++)
+  // the common case: nothing to escape
+  if(identifier.find_first_of("|\\&")==std::string::npos)
   {
-    char ch=identifier[i];
+    out.write(identifier.data(), identifier.size());
+    return;
+  }
 
+  for(const char ch : identifier)
+  {
     switch(ch)
     {
     case '|':
     case '\\':
     case '&': // we use the & for escaping
-      result+='&';
-      result+=std::to_string(ch);
-      result+=';';
+      out << '&' << std::to_string(ch) << ';';
       break;
 
     case '$': // $ _is_ allowed
     default:
-      result+=ch;
+      out << ch;
     }
   }
+}
 
-  return result;
+std::string smt2_convt::convert_identifier(const irep_idt &identifier)
+{
+  std::ostringstream result;
+  write_identifier(result, id2string(identifier));
+  return result.str();
 }
 
 std::string smt2_convt::type2id(const typet &type) const
@@ -820,7 +830,9 @@ void smt2_convt::convert_floatbv(const exprt &expr)
   if(expr.id()==ID_symbol)
   {
     irep_idt id=to_symbol_expr(expr).get_identifier();
-    out << '|' << convert_identifier(id) << '|';
+    out << '|';
+    write_identifier(out, id2string(id));
+    out << '|';
     return;
   }
 
@@ -848,18 +860,25 @@ void smt2_convt::convert_floatbv(const exprt &expr)
 
 void smt2_convt::convert_expr(const exprt &expr)
 {
+  if(convert_shared(expr))
+    return;
+
   // huge monster case split over expression id
   if(expr.id()==ID_symbol)
   {
     irep_idt id=to_symbol_expr(expr).get_identifier();
     DATA_INVARIANT(!id.empty(), "symbol must have identifier");
-    out << '|' << convert_identifier(id) << '|';
+    out << '|';
+    write_identifier(out, id2string(id));
+    out << '|';
   }
   else if(expr.id()==ID_nondet_symbol)
   {
     irep_idt id=to_nondet_symbol_expr(expr).get_identifier();
     DATA_INVARIANT(!id.empty(), "symbol must have identifier");
-    out << '|' << convert_identifier("nondet_"+id2string(id)) << '|';
+    out << "|nondet_";
+    write_identifier(out, id2string(id));
+    out << '|';
   }
   else if(expr.id()==ID_smt2_symbol)
   {
@@ -1735,7 +1754,9 @@ void smt2_convt::convert_expr(const exprt &expr)
     convert_type(bound.type());
     out << ")) ";
 
+    binder_depth++;
     convert_expr(expr.op1());
+    binder_depth--;
 
     out << ")";
   }
@@ -1782,7 +1803,9 @@ void smt2_convt::convert_expr(const exprt &expr)
     out << ' ';
     convert_expr(let_expr.value());
     out << ")) ";
+    binder_depth++;
     convert_expr(let_expr.where());
+    binder_depth--;
     out << ')'; // let
   }
   else if(expr.id()==ID_constraint_select_one)
@@ -4006,6 +4029,7 @@ void smt2_convt::set_to(const exprt &expr, bool value)
 
         id.type=equal_expr.lhs().type();
         find_symbols(id.type);
+        define_shared_subterms(equal_expr.rhs());
         find_symbols(equal_expr.rhs());
 
         std::string smt2_identifier=convert_identifier(identifier);
@@ -4024,6 +4048,7 @@ void smt2_convt::set_to(const exprt &expr, bool value)
     }
   }
 
+  define_shared_subterms(expr);
   find_symbols(expr);
 
   #if 0
@@ -4050,6 +4075,15 @@ void smt2_convt::set_to(const exprt &expr, bool value)
 
 void smt2_convt::find_symbols(const exprt &expr)
 {
+  // the symbols of a shared subterm are found when it is defined
+  if(expr.has_operands())
+  {
+    const shared_subtermst::const_iterator it=
+      shared_subterms.find(&expr.read());
+    if(it!=shared_subterms.end())
+      return;
+  }
+
   // recursive call on type
   find_symbols(expr.type());
 
@@ -4234,7 +4268,9 @@ void smt2_convt::find_symbols(const exprt &expr)
       tmp2=letify(tmp2);
 
       assert(!tmp2.is_nil());
+      binder_depth++;
       convert_expr(tmp2);
+      binder_depth--;
 
       out << ")\n"; // define-fun
     }
@@ -4615,6 +4651,163 @@ void smt2_convt::find_symbols_rec(
   }
 }
 
+/// \return whether expressions of the given type can be defined with
+///   define-fun
+bool smt2_convt::is_shareable_type(const typet &type)
+{
+  return type.id()==ID_bool ||
+         type.id()==ID_signedbv ||
+         type.id()==ID_unsignedbv ||
+         type.id()==ID_bv ||
+         type.id()==ID_fixedbv ||
+         type.id()==ID_floatbv ||
+         type.id()==ID_pointer;
+}
+
+/// Defines the subterms of `expr` that are referenced more than once, by
+/// node identity, in `expr` and the formulas converted before, ahead of
+/// converting `expr`. A subterm that an earlier formula wrote out is
+/// defined when it occurs again. With hash consing, this finds all
+/// repeated subterms; otherwise, those that are shared in memory, which
+/// are the ones that make the output grow exponentially.
+void smt2_convt::define_shared_subterms(const exprt &expr)
+{
+  // the identity of the nodes is only meaningful with sharing
+  #ifdef SHARING
+  std::unordered_map<const void *, unsigned> references;
+  std::unordered_set<const void *> written_before;
+
+  struct itemt
+  {
+    const exprt *expr;
+    bool operands_pushed;
+    // whether an enclosing subterm has been written out before
+    bool in_written;
+  };
+
+  // the subterms in post-order, which defines the operands first
+  std::vector<const exprt *> subterms;
+  std::vector<itemt> stack;
+  stack.push_back(itemt{&expr, false, false});
+
+  while(!stack.empty())
+  {
+    const itemt item=stack.back();
+    const exprt &e=*item.expr;
+    stack.pop_back();
+
+    if(item.operands_pushed)
+    {
+      subterms.push_back(&e);
+      continue;
+    }
+
+    // not below binders, nor objects whose address is taken
+    if(!e.has_operands() ||
+       e.id()==ID_forall ||
+       e.id()==ID_exists ||
+       e.id()==ID_let ||
+       e.id()==ID_address_of)
+      continue;
+
+    const shared_subtermst::const_iterator s_it=
+      shared_subterms.find(&e.read());
+    const bool written=s_it!=shared_subterms.end();
+
+    // defined before, and referred to by name
+    if(written && !s_it->second.second.empty())
+      continue;
+
+    const auto r=references.insert(std::make_pair(&e.read(), 0));
+    unsigned &count=r.first->second;
+
+    // written out by an earlier formula; within a subterm that is written
+    // out before as well, it is written out again only with the definition
+    // of that subterm
+    if(written && !item.in_written && written_before.insert(&e.read()).second)
+      count++;
+
+    count++;
+
+    if(!r.second)
+      continue;
+
+    stack.push_back(itemt{&e, true, item.in_written});
+
+    forall_operands(it, e)
+      stack.push_back(itemt{&*it, false, item.in_written || written});
+  }
+
+  for(const exprt *e : subterms)
+  {
+    if(!is_shareable_type(e->type()))
+      continue;
+
+    // remembered without a name, in case a later formula reads it again
+    if(references[&e->read()]<2)
+    {
+      shared_subterms.insert(
+        std::make_pair(&e->read(), std::make_pair(*e, irep_idt())));
+      continue;
+    }
+
+    find_symbols(*e);
+
+    const irep_idt id="share."+std::to_string(no_shared_definitions++);
+
+    out << "(define-fun " << id << " () ";
+    convert_type(e->type());
+    out << ' ';
+    convert_expr(*e);
+    out << ")\n";
+
+    // not before, as the definition would refer to itself; the copy
+    // keeps the node, and thus the key, alive
+    shared_subterms[&e->read()]=std::make_pair(*e, id);
+  }
+
+  if(shared_subterms.size()>=2*pruned_shared_subterms)
+  {
+    // a subterm that nothing but the table refers to can't occur again;
+    // erasing one may leave its operands unshared
+    for(bool erased=true; erased;)
+    {
+      erased=false;
+
+      for(auto it=shared_subterms.begin(); it!=shared_subterms.end();)
+      {
+        if(it->second.first.is_unshared())
+        {
+          it=shared_subterms.erase(it);
+          erased=true;
+        }
+        else
+          ++it;
+      }
+    }
+
+    pruned_shared_subterms=
+      std::max(shared_subterms.size(), pruned_shared_subterms);
+  }
+  #endif
+}
+
+/// Writes the name of `expr` if it has been defined as a shared subterm
+/// \return true if the name has been written
+bool smt2_convt::convert_shared(const exprt &expr)
+{
+  if(binder_depth!=0 || !expr.has_operands())
+    return false;
+
+  shared_subtermst::const_iterator it=shared_subterms.find(&expr.read());
+
+  if(it==shared_subterms.end() || it->second.second.empty())
+    return false;
+
+  out << it->second.second;
+  return true;
+}
+
 exprt smt2_convt::letify(exprt &expr)
 {
   seen_expressionst map;
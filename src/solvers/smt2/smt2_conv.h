@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <sstream>
 #include <set>
+#include <unordered_map>
 
 #include <util/std_expr.h>
 #include <util/byte_operators.h>
@@ -59,6 +60,9 @@ public:
     solver(_solver),
     boolbv_width(_ns),
     let_id_count(0),
+    no_shared_definitions(0),
+    pruned_shared_subterms(1024),
+    binder_depth(0),
     pointer_logic(_ns),
     no_boolean_variables(0)
   {
@@ -214,6 +218,26 @@ protected:
     exprt &expr,
     const seen_expressionst &map);
 
+  // Subterms that are shared, by node identity, are defined once with
+  // define-fun and referred to by name. The subterms that have been
+  // written out once are remembered without a name, as later formulas
+  // may read them again. The expression keeps its node, and thus the
+  // key, alive, until nothing but the table refers to it.
+  typedef std::unordered_map<const void *, std::pair<exprt, irep_idt>>
+    shared_subtermst;
+  shared_subtermst shared_subterms;
+  std::size_t no_shared_definitions;
+  // the size of shared_subterms after it was last pruned
+  std::size_t pruned_shared_subterms;
+
+  // inside a quantifier or let, as the symbols of a definition may be
+  // bound there
+  unsigned binder_depth;
+
+  void define_shared_subterms(const exprt &expr);
+  bool convert_shared(const exprt &expr);
+  static bool is_shareable_type(const typet &type);
+
   // Parsing solver responses
   constant_exprt parse_literal(const irept &, const typet &type);
   exprt parse_struct(const irept &s, const struct_typet &type);
@@ -63,13 +63,37 @@ smt2_temp_filet::~smt2_temp_filet()
     unlink(temp_result_filename.c_str());
 }
 
+std::list<std::string> smt2_dect::mathsat_options()
+{
+  // The options below were recommended by Alberto Griggio
+  // on 10 July 2013
+  return
+  {
+    "-input=smt2",
+    "-preprocessor.toplevel_propagation=true",
+    "-preprocessor.simplification=7",
+    "-dpll.branching_random_frequency=0.01",
+    "-dpll.branching_random_invalidate_phase_cache=true",
+    "-dpll.restart_strategy=3",
+    "-dpll.glucose_var_activity=true",
+    "-dpll.glucose_learnt_minimization=true",
+    "-theory.bv.eager=true",
+    "-theory.bv.bit_blast_mode=1",
+    "-theory.bv.delay_propagated_eqs=true",
+    "-theory.fp.mode=1",
+    "-theory.fp.bit_blast_mode=2",
+    "-theory.arr.mode=1"
+  };
+}
+
 decision_proceduret::resultt smt2_dect::dec_solve()
 {
   // we write the problem into a file
   smt2_temp_filet smt2_temp_file;
 
-  // copy from string buffer into file
-  smt2_temp_file.temp_out << stringstream.str();
+  // copy from string buffer into file, without a copy of the buffer
+  stringstream.seekg(0);
+  smt2_temp_file.temp_out << stringstream.rdbuf();
 
   // this finishes up and closes the SMT2 file
   write_footer(smt2_temp_file.temp_out);
@@ -106,24 +130,11 @@ decision_proceduret::resultt smt2_dect::dec_solve()
     break;
 
   case solvert::MATHSAT:
-    // The options below were recommended by Alberto Griggio
-    // on 10 July 2013
-    command = "mathsat -input=smt2"
-              " -preprocessor.toplevel_propagation=true"
-              " -preprocessor.simplification=7"
-              " -dpll.branching_random_frequency=0.01"
-              " -dpll.branching_random_invalidate_phase_cache=true"
-              " -dpll.restart_strategy=3"
-              " -dpll.glucose_var_activity=true"
-              " -dpll.glucose_learnt_minimization=true"
-              " -theory.bv.eager=true"
-              " -theory.bv.bit_blast_mode=1"
-              " -theory.bv.delay_propagated_eqs=true"
-              " -theory.fp.mode=1"
-              " -theory.fp.bit_blast_mode=2"
-              " -theory.arr.mode=1"
-              " < "+smt2_temp_file.temp_out_filename
-            + " > "+smt2_temp_file.temp_result_filename;
+    command = "mathsat";
+    for(const auto &option : mathsat_options())
+      command+=" "+option;
+    command+=" < "+smt2_temp_file.temp_out_filename
+           + " > "+smt2_temp_file.temp_result_filename;
     break;
 
   case solvert::OPENSMT:
@@ -174,10 +185,6 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
   std::string line;
   decision_proceduret::resultt res=resultt::D_ERROR;
 
-  boolean_assignment.clear();
-  boolean_assignment.resize(no_boolean_variables, false);
-
-  typedef std::unordered_map<irep_idt, irept, irep_id_hash> valuest;
   valuest values;
 
   while(in)
@@ -216,6 +223,18 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
     }
   }
 
+  set_assignment(values);
+
+  return res;
+}
+
+/// Sets the values of the identifiers and of the Boolean variables
+/// \param values: the values that the solver gives to the SMT2 identifiers
+void smt2_dect::set_assignment(valuest &values)
+{
+  boolean_assignment.clear();
+  boolean_assignment.resize(no_boolean_variables, false);
+
   for(identifier_mapt::iterator
       it=identifier_map.begin();
       it!=identifier_map.end();
@@ -232,6 +251,4 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
     const irept &value=values["B"+std::to_string(v)];
     boolean_assignment[v]=(value.id()==ID_true);
   }
-
-  return res;
 }
@@ -11,6 +11,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_SMT2_SMT2_DEC_H
 
 #include <fstream>
+#include <list>
+#include <unordered_map>
 
 #include "smt2_conv.h"
 
@@ -52,7 +54,11 @@ public:
   virtual bool has_set_assumptions() const { return true; }
 
 protected:
+  typedef std::unordered_map<irep_idt, irept, irep_id_hash> valuest;
+
   resultt read_result(std::istream &in);
+  void set_assignment(valuest &values);
+  static std::list<std::string> mathsat_options();
 };
 
 #endif // CPROVER_SOLVERS_SMT2_SMT2_DEC_H
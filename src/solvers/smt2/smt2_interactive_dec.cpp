@@ -0,0 +1,268 @@
+/*******************************************************************\
+
+Module: Interactive SMT2 Decision Procedure
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Interactive SMT2 Decision Procedure
+
+#include "smt2_interactive_dec.h"
+
+#ifndef _WIN32
+#include <csignal>
+#endif
+
+#include <util/make_unique.h>
+
+#include "smt2irep.h"
+
+smt2_interactive_dect::smt2_interactive_dect(
+  const namespacet &_ns,
+  const std::string &_benchmark,
+  const std::string &_notes,
+  const std::string &_logic,
+  solvert _solver):
+  smt2_dect(_ns, _benchmark, _notes, _logic, _solver),
+  use_check_sat_assuming(
+    _solver==solvert::Z3 || _solver==solvert::CVC4),
+  defined_objects(0),
+  defined_object_sizes(0)
+{
+}
+
+smt2_interactive_dect::~smt2_interactive_dect()
+{
+  if(process && *process)
+  {
+    *process << "(exit)\n" << std::flush;
+    process->wait();
+  }
+}
+
+std::string smt2_interactive_dect::decision_procedure_text() const
+{
+  return smt2_dect::decision_procedure_text()+", interactive";
+}
+
+/// \return true if the solver can be run interactively
+bool smt2_interactive_dect::is_supported(solvert solver)
+{
+  return solver==solvert::BOOLECTOR ||
+         solver==solvert::CVC4 ||
+         solver==solvert::MATHSAT ||
+         solver==solvert::YICES ||
+         solver==solvert::Z3;
+}
+
+/// Starts the solver process
+/// \return true on success
+bool smt2_interactive_dect::start()
+{
+  std::string executable;
+  std::list<std::string> arguments;
+
+  switch(solver)
+  {
+  case solvert::BOOLECTOR:
+    executable="boolector";
+    arguments={ "--smt2", "--incremental" };
+    break;
+
+  case solvert::CVC4:
+    executable="cvc4";
+    arguments={ "--lang", "smt2", "--incremental" };
+    break;
+
+  case solvert::MATHSAT:
+    executable="mathsat";
+    arguments=mathsat_options();
+    break;
+
+  case solvert::YICES:
+    executable="yices-smt2";
+    arguments={ "--incremental" };
+    break;
+
+  case solvert::Z3:
+    executable="z3";
+    arguments={ "-in", "-smt2" };
+    break;
+
+  default:
+    error() << "the SMT2 solver cannot be run interactively" << eom;
+    return false;
+  }
+
+  #ifndef _WIN32
+  // a solver that terminates must not terminate us
+  signal(SIGPIPE, SIG_IGN);
+  #endif
+
+  process=util_make_unique<pipe_streamt>(executable, arguments);
+
+  if(process->run()<0)
+  {
+    error() << "error running SMT2 solver" << eom;
+    process.reset();
+    return false;
+  }
+
+  return true;
+}
+
+/// Sends the commands that have been converted since the last call
+void smt2_interactive_dect::send()
+{
+  *process << stringstream.str() << std::flush;
+  stringstream.str("");
+}
+
+decision_proceduret::resultt smt2_interactive_dect::dec_solve()
+{
+  if(!process && !start())
+    return resultt::D_ERROR;
+
+  if(!*process)
+  {
+    error() << "SMT2 solver is not running" << eom;
+    return resultt::D_ERROR;
+  }
+
+  // fix up the sizes of the objects, if there are new ones
+  if(pointer_logic.objects.size()!=defined_objects ||
+     object_sizes.size()!=defined_object_sizes)
+  {
+    for(const auto &object : object_sizes)
+      define_object_size(object.second, object.first);
+
+    defined_objects=pointer_logic.objects.size();
+    defined_object_sizes=object_sizes.size();
+  }
+
+  bvt literals;
+
+  for(const auto &l : assumptions)
+  {
+    if(l.is_false())
+      return resultt::D_UNSATISFIABLE;
+    else if(!l.is_true())
+      literals.push_back(l);
+  }
+
+  out << "\n";
+
+  if(use_check_sat_assuming && !literals.empty())
+  {
+    out << "(check-sat-assuming (";
+    for(const auto &l : literals)
+    {
+      out << ' ';
+      convert_literal(l);
+    }
+    out << "))\n";
+  }
+  else
+  {
+    if(!literals.empty())
+    {
+      out << "(push 1)\n";
+      for(const auto &l : literals)
+      {
+        out << "(assert ";
+        convert_literal(l);
+        out << ")\n";
+      }
+    }
+
+    out << "(check-sat)\n";
+  }
+
+  send();
+
+  resultt result=read_check_sat();
+
+  if(result==resultt::D_SATISFIABLE && !read_values())
+    result=resultt::D_ERROR;
+
+  // this is sent along with the next commands
+  if(!use_check_sat_assuming && !literals.empty())
+    out << "(pop 1)\n";
+
+  return result;
+}
+
+/// Reads the responses of the solver up to the one to check-sat
+decision_proceduret::resultt smt2_interactive_dect::read_check_sat()
+{
+  bool failed=false;
+
+  while(*process)
+  {
+    const irept parsed=smt2irep(*process);
+
+    if(parsed.id()=="sat")
+      return failed?resultt::D_ERROR:resultt::D_SATISFIABLE;
+    else if(parsed.id()=="unsat")
+      return failed?resultt::D_ERROR:resultt::D_UNSATISFIABLE;
+    else if(parsed.id()=="unknown")
+    {
+      error() << "SMT2 solver returned unknown" << eom;
+      return resultt::D_ERROR;
+    }
+    else if(parsed.id()=="" &&
+            parsed.get_sub().size()==2 &&
+            parsed.get_sub().front().id()=="error")
+    {
+      // keep reading, to stay in sync with the solver
+      error() << "SMT2 solver returned error message:\n"
+              << "\t\"" << parsed.get_sub()[1].id() << "\"" << eom;
+      failed=true;
+    }
+  }
+
+  error() << "SMT2 solver terminated unexpectedly" << eom;
+  return resultt::D_ERROR;
+}
+
+/// Asks for the values of all identifiers with a single get-value
+/// command, and parses the response as it arrives
+/// \return true on success
+bool smt2_interactive_dect::read_values()
+{
+  valuest values;
+
+  if(!smt2_identifiers.empty())
+  {
+    out << "(get-value (";
+    for(const auto &id : smt2_identifiers)
+      out << " |" << id << "|";
+    out << "))\n";
+
+    send();
+
+    // Example:
+    // ( (B0 true) (|__CPROVER_pipe_count#1| (_ bv0 32)) )
+    const irept parsed=smt2irep(*process);
+
+    if(parsed.get_sub().size()==2 &&
+       parsed.get_sub().front().id()=="error")
+    {
+      error() << "SMT2 solver returned error message:\n"
+              << "\t\"" << parsed.get_sub()[1].id() << "\"" << eom;
+      return false;
+    }
+
+    for(const auto &binding : parsed.get_sub())
+    {
+      if(binding.get_sub().size()==2)
+        values[binding.get_sub()[0].id()]=binding.get_sub()[1];
+    }
+  }
+
+  set_assignment(values);
+
+  return true;
+}
@@ -0,0 +1,58 @@
+/*******************************************************************\
+
+Module: Interactive SMT2 Decision Procedure
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Interactive SMT2 Decision Procedure
+
+#ifndef CPROVER_SOLVERS_SMT2_SMT2_INTERACTIVE_DEC_H
+#define CPROVER_SOLVERS_SMT2_SMT2_INTERACTIVE_DEC_H
+
+#include <memory>
+
+#include <util/pipe_stream.h>
+
+#include "smt2_dec.h"
+
+/*! \brief Decision procedure interface for SMT 2.x solvers that keeps
+    one solver process, and sends it only the commands that are new
+    since the last call to dec_solve
+*/
+class smt2_interactive_dect:public smt2_dect
+{
+public:
+  smt2_interactive_dect(
+    const namespacet &_ns,
+    const std::string &_benchmark,
+    const std::string &_notes,
+    const std::string &_logic,
+    solvert _solver);
+
+  ~smt2_interactive_dect();
+
+  resultt dec_solve() override;
+  std::string decision_procedure_text() const override;
+
+  static bool is_supported(solvert solver);
+
+protected:
+  std::unique_ptr<pipe_streamt> process;
+
+  // check-sat-assuming is used if the solver is known to support it,
+  // and otherwise the assumptions are asserted between push and pop
+  bool use_check_sat_assuming;
+
+  // the objects and object sizes at the time of the last call
+  std::size_t defined_objects, defined_object_sizes;
+
+  bool start();
+  void send();
+  resultt read_check_sat();
+  bool read_values();
+};
+
+#endif // CPROVER_SOLVERS_SMT2_SMT2_INTERACTIVE_DEC_H
@@ -0,0 +1,354 @@
+/*******************************************************************\
+
+Module: Sequence stored in fixed-size chunks
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Sequence stored in fixed-size chunks
+
+#ifndef CPROVER_UTIL_CHUNKED_VECTOR_H
+#define CPROVER_UTIL_CHUNKED_VECTOR_H
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "invariant.h"
+
+/// Random-access iterator over the elements of a chunked_vectort. The
+/// iterator holds the position of the element rather than its address,
+/// and remains valid when elements are added at either end.
+template<typename containert, typename T>
+class chunked_vector_iteratort
+{
+public:
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::random_access_iterator_tag iterator_category;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef typename std::remove_const<T>::type value_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::ptrdiff_t difference_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T *pointer;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T &reference;
+
+  chunked_vector_iteratort():container(nullptr), position(0)
+  {
+  }
+
+  chunked_vector_iteratort(containert *_container, std::ptrdiff_t _position):
+    container(_container), position(_position)
+  {
+  }
+
+  // iterator to const_iterator
+  template<
+    typename C,
+    typename U,
+    typename=typename std::enable_if<
+      std::is_same<const C, containert>::value &&
+      std::is_same<const U, T>::value>::type>
+  // NOLINTNEXTLINE(runtime/explicit)
+  chunked_vector_iteratort(const chunked_vector_iteratort<C, U> &other):
+    container(other.get_container()), position(other.get_position())
+  {
+  }
+
+  containert *get_container() const { return container; }
+  std::ptrdiff_t get_position() const { return position; }
+
+  T &operator*() const { return container->at_position(position); }
+  T *operator->() const { return &container->at_position(position); }
+
+  T &operator[](difference_type n) const
+  {
+    return container->at_position(position+n);
+  }
+
+  chunked_vector_iteratort &operator++()
+  {
+    ++position;
+    return *this;
+  }
+
+  chunked_vector_iteratort operator++(int)
+  {
+    return chunked_vector_iteratort(container, position++);
+  }
+
+  chunked_vector_iteratort &operator--()
+  {
+    --position;
+    return *this;
+  }
+
+  chunked_vector_iteratort operator--(int)
+  {
+    return chunked_vector_iteratort(container, position--);
+  }
+
+  chunked_vector_iteratort &operator+=(difference_type n)
+  {
+    position+=n;
+    return *this;
+  }
+
+  chunked_vector_iteratort &operator-=(difference_type n)
+  {
+    position-=n;
+    return *this;
+  }
+
+  chunked_vector_iteratort operator+(difference_type n) const
+  {
+    return chunked_vector_iteratort(container, position+n);
+  }
+
+  chunked_vector_iteratort operator-(difference_type n) const
+  {
+    return chunked_vector_iteratort(container, position-n);
+  }
+
+  difference_type operator-(const chunked_vector_iteratort &other) const
+  {
+    return position-other.position;
+  }
+
+  // NOLINTNEXTLINE(whitespace/line_length)
+  bool operator==(const chunked_vector_iteratort &other) const { return position==other.position; }
+  // NOLINTNEXTLINE(whitespace/line_length)
+  bool operator!=(const chunked_vector_iteratort &other) const { return position!=other.position; }
+  // NOLINTNEXTLINE(whitespace/line_length)
+  bool operator<(const chunked_vector_iteratort &other) const { return position<other.position; }
+  // NOLINTNEXTLINE(whitespace/line_length)
+  bool operator>(const chunked_vector_iteratort &other) const { return position>other.position; }
+  // NOLINTNEXTLINE(whitespace/line_length)
+  bool operator<=(const chunked_vector_iteratort &other) const { return position<=other.position; }
+  // NOLINTNEXTLINE(whitespace/line_length)
+  bool operator>=(const chunked_vector_iteratort &other) const { return position>=other.position; }
+
+protected:
+  containert *container;
+  std::ptrdiff_t position;
+};
+
+template<typename containert, typename T>
+chunked_vector_iteratort<containert, T> operator+(
+  std::ptrdiff_t n,
+  const chunked_vector_iteratort<containert, T> &it)
+{
+  return it+n;
+}
+
+/// A sequence that stores its elements in chunks of `chunk_size` elements
+/// each. Unlike a std::list, there is no allocation per element, and
+/// consecutive elements are adjacent in memory. Unlike a std::vector,
+/// elements are never moved: elements can be added at either end without
+/// invalidating any reference to or iterator over the other elements, as
+/// iterators hold the position of the element. An iterator equal to end()
+/// refers to the element added by a subsequent push_back(), however.
+///
+/// Elements can only be added or removed at the ends, and there is no
+/// insertion in the middle.
+///
+/// As an iterator refers to its container object, swap() and move
+/// assignment do not carry iterators over to the other container, unlike
+/// for a std::list: after `a.swap(b)`, an iterator obtained from `a`
+/// refers to the elements that are now in `a`, and iterators have to be
+/// obtained afresh from `b`. References to elements do remain valid.
+template<typename T, std::size_t chunk_size=64>
+class chunked_vectort
+{
+public:
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T value_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::size_t size_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::ptrdiff_t difference_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T &reference;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef const T &const_reference;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef chunked_vector_iteratort<chunked_vectort, T> iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef chunked_vector_iteratort<const chunked_vectort, const T>
+    const_iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  static_assert(chunk_size>0, "chunks must not be empty");
+
+  chunked_vectort():origin(0), first(0), last(0)
+  {
+  }
+
+  chunked_vectort(const chunked_vectort &other):chunked_vectort()
+  {
+    for(const auto &element : other)
+      push_back(element);
+  }
+
+  chunked_vectort(chunked_vectort &&other):chunked_vectort()
+  {
+    swap(other);
+  }
+
+  chunked_vectort &operator=(const chunked_vectort &other)
+  {
+    if(this!=&other)
+    {
+      chunked_vectort tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  chunked_vectort &operator=(chunked_vectort &&other)
+  {
+    if(this!=&other)
+    {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  ~chunked_vectort()
+  {
+    clear();
+  }
+
+  void swap(chunked_vectort &other)
+  {
+    chunks.swap(other.chunks);
+    std::swap(origin, other.origin);
+    std::swap(first, other.first);
+    std::swap(last, other.last);
+  }
+
+  iterator begin() { return iterator(this, first); }
+  iterator end() { return iterator(this, last); }
+  const_iterator begin() const { return const_iterator(this, first); }
+  const_iterator end() const { return const_iterator(this, last); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const { return last-first; }
+  bool empty() const { return first==last; }
+
+  T &operator[](size_type i) { return at_position(first+i); }
+  const T &operator[](size_type i) const { return at_position(first+i); }
+
+  T &front() { return at_position(first); }
+  const T &front() const { return at_position(first); }
+  T &back() { return at_position(last-1); }
+  const T &back() const { return at_position(last-1); }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  void push_front(const T &value) { emplace_front(value); }
+  void push_front(T &&value) { emplace_front(std::move(value)); }
+
+  template<typename... argst>
+  T &emplace_back(argst &&... args)
+  {
+    if(last==origin+static_cast<difference_type>(chunks.size()*chunk_size))
+      chunks.emplace_back(new storaget[chunk_size]);
+
+    T *element=new(slot(last)) T(std::forward<argst>(args)...);
+    last++;
+    return *element;
+  }
+
+  template<typename... argst>
+  T &emplace_front(argst &&... args)
+  {
+    if(first==origin)
+    {
+      chunks.emplace_front(new storaget[chunk_size]);
+      origin-=chunk_size;
+    }
+
+    T *element=new(slot(first-1)) T(std::forward<argst>(args)...);
+    first--;
+    return *element;
+  }
+
+  void pop_back()
+  {
+    PRECONDITION(!empty());
+    last--;
+    at_position(last).~T();
+  }
+
+  /// Destroys all elements and releases all chunks
+  void clear()
+  {
+    for(difference_type p=first; p<last; p++)
+      at_position(p).~T();
+
+    chunks.clear();
+    origin=first=last=0;
+  }
+
+  /// \return the number of bytes allocated for the chunks, not counting
+  ///   any memory that the elements own
+  std::size_t heap_size() const
+  {
+    return chunks.size()*chunk_size*sizeof(T);
+  }
+
+  T &at_position(difference_type p)
+  {
+    return *reinterpret_cast<T *>(slot(p));
+  }
+
+  const T &at_position(difference_type p) const
+  {
+    return *reinterpret_cast<const T *>(
+      const_cast<chunked_vectort *>(this)->slot(p));
+  }
+
+protected:
+  typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type
+    storaget;
+
+  std::deque<std::unique_ptr<storaget[]>> chunks;
+
+  // the position of the first slot of the first chunk, and the range of
+  // positions of the elements, which begin() and end() point to
+  difference_type origin, first, last;
+
+  storaget *slot(difference_type p)
+  {
+    const std::size_t offset=p-origin;
+    return &chunks[offset/chunk_size][offset%chunk_size];
+  }
+};
+
+#endif // CPROVER_UTIL_CHUNKED_VECTOR_H
@@ -50,7 +50,7 @@ class const_unique_depth_iteratort;
 class exprt:public irept
 {
 public:
-  typedef std::vector<exprt> operandst;
+  typedef irep_sub_vectort<exprt> operandst;
 
   // constructors
   exprt() { }
@@ -0,0 +1,155 @@
+/*******************************************************************\
+
+Module: Hash Consing of Ireps
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Hash Consing of Ireps
+
+#include "hash_cons.h"
+
+#include "irep_hash.h"
+
+static std::size_t hash_node(const irept &irep)
+{
+  return reinterpret_cast<std::size_t>(&irep.read());
+}
+
+static std::size_t hash_named_sub(
+  std::size_t result,
+  const irept::named_subt &named_sub)
+{
+  forall_named_irep(it, named_sub)
+  {
+    result=hash_combine(result, hash_string(it->first));
+    result=hash_combine(result, hash_node(it->second));
+  }
+
+  return result;
+}
+
+std::size_t hash_cons_tablet::shallow_hash::operator()(
+  const irept &irep) const
+{
+  const irept::subt &sub=irep.get_sub();
+  const irept::named_subt &named_sub=irep.get_named_sub();
+  const irept::named_subt &comments=irep.get_comments();
+
+  std::size_t result=hash_string(irep.id());
+
+  forall_irep(it, sub)
+    result=hash_combine(result, hash_node(*it));
+
+  result=hash_named_sub(result, named_sub);
+  result=hash_named_sub(result, comments);
+
+  return hash_finalize(
+    result,
+    sub.size()+named_sub.size()+comments.size());
+}
+
+static bool equal_named_sub(
+  const irept::named_subt &n1,
+  const irept::named_subt &n2)
+{
+  if(n1.size()!=n2.size())
+    return false;
+
+  irept::named_subt::const_iterator it1=n1.begin();
+  irept::named_subt::const_iterator it2=n2.begin();
+
+  for(; it1!=n1.end(); it1++, it2++)
+    if(it1->first!=it2->first ||
+       &it1->second.read()!=&it2->second.read())
+      return false;
+
+  return true;
+}
+
+bool hash_cons_tablet::shallow_eq::operator()(
+  const irept &i1,
+  const irept &i2) const
+{
+  if(i1.id()!=i2.id())
+    return false;
+
+  const irept::subt &sub1=i1.get_sub();
+  const irept::subt &sub2=i2.get_sub();
+
+  if(sub1.size()!=sub2.size())
+    return false;
+
+  for(std::size_t i=0; i<sub1.size(); i++)
+    if(&sub1[i].read()!=&sub2[i].read())
+      return false;
+
+  return equal_named_sub(i1.get_named_sub(), i2.get_named_sub()) &&
+         equal_named_sub(i1.get_comments(), i2.get_comments());
+}
+
+const irept &hash_cons_tablet::representative(const irept &irep)
+{
+  if(is_representative(irep))
+    return irep;
+
+  visitedt::const_iterator v_it=visited.find(&irep.read());
+  if(v_it!=visited.end())
+    return *v_it->second.second;
+
+  // build an irep whose children are representatives
+  irept new_irep(irep.id());
+
+  const irept::subt &src_sub=irep.get_sub();
+  irept::subt &dest_sub=new_irep.get_sub();
+  dest_sub.reserve(src_sub.size());
+
+  forall_irep(it, src_sub)
+    dest_sub.push_back(representative(*it)); // recursive call
+
+  const irept::named_subt &src_named_sub=irep.get_named_sub();
+  irept::named_subt &dest_named_sub=new_irep.get_named_sub();
+
+  forall_named_irep(it, src_named_sub)
+    #ifdef NAMED_SUB_IS_SORTED
+    dest_named_sub.push_back(
+      std::make_pair(it->first, representative(it->second))); // recursive
+    #else
+    dest_named_sub[it->first]=representative(it->second); // recursive call
+    #endif
+
+  const irept::named_subt &src_comments=irep.get_comments();
+  irept::named_subt &dest_comments=new_irep.get_comments();
+
+  forall_named_irep(it, src_comments)
+    #ifdef NAMED_SUB_IS_SORTED
+    dest_comments.push_back(
+      std::make_pair(it->first, representative(it->second))); // recursive
+    #else
+    dest_comments[it->first]=representative(it->second); // recursive call
+    #endif
+
+  // This copies new_irep into a fresh, shareable node.
+  std::pair<storet::const_iterator, bool> entry=store.insert(new_irep);
+
+  if(entry.second)
+  {
+    representatives.insert(&entry.first->read());
+
+    #ifdef HASH_CODE
+    // the node is never modified while in the table
+    entry.first->hash();
+    #endif
+  }
+
+  // A node that is not shareable is copied rather than shared, so it
+  // cannot be reached from elsewhere, and the copy would not keep it alive.
+  irept source=irep;
+  if(&source.read()==&irep.read())
+    visited.insert(
+      std::make_pair(&irep.read(), std::make_pair(source, &*entry.first)));
+
+  return *entry.first;
+}
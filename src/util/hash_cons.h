@@ -0,0 +1,93 @@
+/*******************************************************************\
+
+Module: Hash Consing of Ireps
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Hash Consing of Ireps
+
+#ifndef CPROVER_UTIL_HASH_CONS_H
+#define CPROVER_UTIL_HASH_CONS_H
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "irep.h"
+
+/// Maximal sharing of ireps: every irep passed through the table is
+/// replaced by a representative that shares its node with all structurally
+/// equal ireps passed through the same table, comments included.
+/// Equal representatives can thus be compared by address.
+///
+/// The children of a representative are representatives themselves, so
+/// the table hashes and compares a node by the addresses of its children,
+/// which takes time linear in the number of children rather than in the
+/// size of the tree. Each node that is not yet a representative is
+/// rebuilt once per table, however often it is shared: the table keeps
+/// shared nodes, and their representatives, until clear() is called.
+///
+/// A table is not safe to use from several threads; each thread needs a
+/// table of its own.
+class hash_cons_tablet
+{
+public:
+  void operator()(irept &irep)
+  {
+    // only useful if there is sharing
+    #ifdef SHARING
+    irep=representative(irep);
+    #endif
+  }
+
+  /// \return the representative of the given irep
+  const irept &representative(const irept &irep);
+
+  bool is_representative(const irept &irep) const
+  {
+    return representatives.find(&irep.read())!=representatives.end();
+  }
+
+  /// \return the number of distinct nodes in the table
+  std::size_t size() const
+  {
+    return store.size();
+  }
+
+  void clear()
+  {
+    visited.clear();
+    representatives.clear();
+    store.clear();
+  }
+
+protected:
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct shallow_hash
+  {
+    std::size_t operator()(const irept &irep) const;
+  };
+
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct shallow_eq
+  {
+    bool operator()(const irept &i1, const irept &i2) const;
+  };
+
+  typedef std::unordered_set<irept, shallow_hash, shallow_eq> storet;
+  storet store;
+
+  // the nodes of the ireps in store
+  std::unordered_set<const void *> representatives;
+
+  // The nodes that have been passed through the table, and their
+  // representatives. Keeping the irep keeps its node from being freed,
+  // and its address from being reused, while it is in the map.
+  typedef std::unordered_map<const void *, std::pair<irept, const irept *>>
+    visitedt;
+  visitedt visited;
+};
+
+#endif // CPROVER_UTIL_HASH_CONS_H
@@ -18,7 +18,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "string_hash.h"
 #include "irep_hash.h"
 
-#ifdef SUB_IS_LIST
+#ifdef NAMED_SUB_IS_SORTED
 #include <algorithm>
 #endif
 
@@ -26,7 +26,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 #endif
 
-#ifdef SUB_IS_LIST
+#ifdef NAMED_SUB_CHECK_REFERENCES
+#include <list>
+#endif
+
+#ifdef NAMED_SUB_IS_SORTED
 static inline bool named_subt_order(
   const std::pair<irep_namet, irept> &a,
   const irep_namet &b)
@@ -47,6 +51,49 @@ static inline irept::named_subt::iterator named_subt_lower_bound(
 }
 #endif
 
+#ifdef NAMED_SUB_CHECK_REFERENCES
+/// \return the irep that the stale copies refer to, which is never
+///   destroyed; its node is told apart by its address
+static const irept &stale_irep()
+{
+  static const irept *stale=new irept();
+  return *stale;
+}
+
+const irept::dt *irept::stale_node()
+{
+  return &stale_irep().data.read();
+}
+
+void irept::mark_stale(irept &irep)
+{
+  irep.data=stale_irep().data;
+}
+
+/// Moves the named subtrees in `s` to new storage before a name is added
+/// or removed, and makes the old copies stale, such that a reference into
+/// the old storage is detected when it is used
+static void relocate_named_sub(irept::named_subt &s)
+{
+  // the old storage is kept, as the references into it must not dangle
+  static std::list<irept::named_subt> old_storage;
+
+  if(s.empty())
+    return;
+
+  irept::named_subt tmp;
+  tmp.reserve(s.size()+1);
+  for(const auto &entry : s)
+    tmp.push_back(entry);
+
+  for(auto &entry : s)
+    irept::mark_stale(entry.second);
+
+  old_storage.push_back(std::move(s));
+  s=std::move(tmp);
+}
+#endif
+
 const irept &get_nil_irep()
 {
   static irept nil_rep_storage;
@@ -72,7 +119,7 @@ const irep_idt &irept::get(const irep_namet &name) const
   const named_subt &s=
     is_comment(name)?get_comments():get_named_sub();
 
-  #ifdef SUB_IS_LIST
+  #ifdef NAMED_SUB_IS_SORTED
   named_subt::const_iterator it=named_subt_lower_bound(s, name);
 
   if(it==s.end() ||
@@ -129,11 +176,17 @@ void irept::remove(const irep_namet &name)
   named_subt &s=
     is_comment(name)?get_comments():get_named_sub();
 
-  #ifdef SUB_IS_LIST
+  #ifdef NAMED_SUB_IS_SORTED
   named_subt::iterator it=named_subt_lower_bound(s, name);
 
   if(it!=s.end() && it->first==name)
+  {
+    #ifdef NAMED_SUB_CHECK_REFERENCES
+    relocate_named_sub(s);
+    it=named_subt_lower_bound(s, name);
+    #endif
     s.erase(it);
+  }
   #else
   s.erase(name);
   #endif
@@ -144,7 +197,7 @@ const irept &irept::find(const irep_namet &name) const
   const named_subt &s=
     is_comment(name)?get_comments():get_named_sub();
 
-  #ifdef SUB_IS_LIST
+  #ifdef NAMED_SUB_IS_SORTED
   named_subt::const_iterator it=named_subt_lower_bound(s, name);
 
   if(it==s.end() ||
@@ -165,12 +218,18 @@ irept &irept::add(const irep_namet &name)
   named_subt &s=
     is_comment(name)?get_comments():get_named_sub();
 
-  #ifdef SUB_IS_LIST
+  #ifdef NAMED_SUB_IS_SORTED
   named_subt::iterator it=named_subt_lower_bound(s, name);
 
   if(it==s.end() ||
      it->first!=name)
+  {
+    #ifdef NAMED_SUB_CHECK_REFERENCES
+    relocate_named_sub(s);
+    it=named_subt_lower_bound(s, name);
+    #endif
     it=s.insert(it, std::make_pair(name, irept()));
+  }
 
   return it->second;
   #else
@@ -183,12 +242,22 @@ irept &irept::add(const irep_namet &name, const irept &irep)
   named_subt &s=
     is_comment(name)?get_comments():get_named_sub();
 
-  #ifdef SUB_IS_LIST
+  #ifdef NAMED_SUB_IS_SORTED
   named_subt::iterator it=named_subt_lower_bound(s, name);
 
   if(it==s.end() ||
      it->first!=name)
+  {
+    #ifdef NAMED_SUB_CHECK_REFERENCES
+    // irep may be one of the subtrees that are relocated
+    const irept value(irep);
+    relocate_named_sub(s);
+    it=named_subt_lower_bound(s, name);
+    it=s.insert(it, std::make_pair(name, value));
+    #else
     it=s.insert(it, std::make_pair(name, irep));
+    #endif
+  }
   else
     it->second=irep;
 
@@ -219,6 +288,14 @@ bool irept::operator==(const irept &other) const
     return true;
   #endif
 
+  #ifdef HASH_CODE
+  // differing cached hash codes imply different ireps
+  if(read().hash_code!=0 &&
+     other.read().hash_code!=0 &&
+     read().hash_code!=other.read().hash_code)
+    return false;
+  #endif
+
   if(id()!=other.id() ||
      get_sub()!=other.get_sub() || // recursive call
      get_named_sub()!=other.get_named_sub()) // recursive call
@@ -20,14 +20,45 @@ Author: Daniel Kroening, kroening@kroening.com
 #define SHARING
 // #define HASH_CODE
 // #define SUB_IS_LIST
+// #define SUB_IS_SMALL_VECTOR
+// #define NAMED_SUB_IS_VECTOR
+// #define NAMED_SUB_CHECK_REFERENCES
+
+// The type of the reference count of shared ireps. With 32 bits, the
+// count and the id of a node share a single 8-byte word.
+#ifndef IREP_USE_COUNT_TYPE
+#define IREP_USE_COUNT_TYPE unsigned
+#endif
+
+#if defined(SUB_IS_LIST) && defined(NAMED_SUB_IS_VECTOR)
+#error "SUB_IS_LIST and NAMED_SUB_IS_VECTOR are mutually exclusive"
+#endif
+
+// With NAMED_SUB_CHECK_REFERENCES, adding or removing a name moves the
+// named subtrees of the node to new storage, and using a reference into
+// the old storage, as add() may have returned, fails an invariant. This
+// is meant for testing builds only, as the old storage is never freed.
+#if defined(NAMED_SUB_CHECK_REFERENCES) && \
+    (!defined(NAMED_SUB_IS_VECTOR) || !defined(SHARING))
+#error "NAMED_SUB_CHECK_REFERENCES requires NAMED_SUB_IS_VECTOR and SHARING"
+#endif
+
+// named_sub is kept sorted by name, and searched by binary search
+#if defined(SUB_IS_LIST) || defined(NAMED_SUB_IS_VECTOR)
+#define NAMED_SUB_IS_SORTED
+#endif
 
 #ifdef SHARING
 #include "cow.h"
 #endif
 
+#if defined(SUB_IS_SMALL_VECTOR) || defined(NAMED_SUB_IS_VECTOR)
+#include "small_vector.h"
+#endif
+
 #ifdef SUB_IS_LIST
 #include <list>
-#else
+#elif !defined(NAMED_SUB_IS_VECTOR)
 #include <map>
 #endif
 
@@ -82,6 +113,18 @@ inline const std::string &name2string(const irep_namet &n)
 #include <iostream>
 #endif
 
+/// The vector type used for the operands of an irept. Classes derived from
+/// irept that cast the result of get_sub(), e.g., exprt::operandst, must
+/// use this template to obtain the same layout.
+/// With SUB_IS_SMALL_VECTOR, up to three operands are stored inline.
+#ifdef SUB_IS_SMALL_VECTOR
+template<typename T>
+using irep_sub_vectort=small_vectort<T, 3>; // NOLINT template typedef
+#else
+template<typename T>
+using irep_sub_vectort=std::vector<T>; // NOLINT template typedef
+#endif
+
 class irept;
 const irept &get_nil_irep();
 
@@ -91,14 +134,19 @@ class irept
 {
 public:
   // These are not stable.
-  typedef std::vector<irept> subt;
+  typedef irep_sub_vectort<irept> subt;
 
   // named_subt has to provide stable references; with C++11 we could
   // use std::forward_list or std::vector< unique_ptr<T> > to save
   // memory and increase efficiency.
+  // NAMED_SUB_IS_VECTOR gives up on this for a single sorted array per
+  // node: a reference returned by add() is then only valid until the
+  // next name is added to or removed from the same irep.
 
   #ifdef SUB_IS_LIST
   typedef std::list<std::pair<irep_namet, irept> > named_subt;
+  #elif defined(NAMED_SUB_IS_VECTOR)
+  typedef small_vectort<std::pair<irep_namet, irept>, 0> named_subt;
   #else
   typedef std::map<irep_namet, irept> named_subt;
   #endif
@@ -106,6 +154,16 @@ public:
   bool is_nil() const { return id()==ID_nil; }
   bool is_not_nil() const { return id()!=ID_nil; }
 
+  /// \return true if no other irep refers to the node of this one
+  bool is_unshared() const
+  {
+#ifdef SHARING
+    return data.read().use_count()<=1;
+#else
+    return true;
+#endif
+  }
+
   irept() = default;
 
   explicit irept(const irep_idt &_id)
@@ -194,6 +252,12 @@ public:
 
   std::string pretty(unsigned indent=0, unsigned max_indent=0) const;
 
+  #ifdef NAMED_SUB_CHECK_REFERENCES
+  /// Makes `irep` refer to a node that fails the invariant in read() and
+  /// write(), for the old copy of a named subtree that has moved
+  static void mark_stale(irept &irep);
+  #endif
+
 protected:
   static bool is_comment(const irep_namet &name)
   { return !name.empty() && name[0]=='#'; }
@@ -201,7 +265,7 @@ protected:
 private:
   class dt
 #ifdef SHARING
-    : public copy_on_write_pointeet<unsigned>
+    : public copy_on_write_pointeet<IREP_USE_COUNT_TYPE>
 #endif
   {
   public:
@@ -234,18 +298,40 @@ private:
   dt data;
 #endif
 
+  #ifdef NAMED_SUB_CHECK_REFERENCES
+  static const dt *stale_node();
+
+  void check_not_stale() const
+  {
+    INVARIANT(
+      &data.read()!=stale_node(),
+      "reference into named_sub used after names were added or removed");
+  }
+  #endif
+
   dt &write(bool mark_shareable)
   {
+#ifdef NAMED_SUB_CHECK_REFERENCES
+    check_not_stale();
+#endif
 #ifdef SHARING
-    return data.write(mark_shareable);
+    dt &d=data.write(mark_shareable);
 #else
-    return data;
+    dt &d=data;
+#endif
+#ifdef HASH_CODE
+    // the caller may modify the node
+    d.hash_code=0;
 #endif
+    return d;
   }
 
 public:
   const dt &read() const
   {
+#ifdef NAMED_SUB_CHECK_REFERENCES
+    check_not_stale();
+#endif
 #ifdef SHARING
     return data.read();
 #else
@@ -30,6 +30,8 @@ public:
 
   void clear()
   {
+    // the numbers in the pointer cache refer to the numbering
+    ptr_hash.clear();
     numbering.clear();
   }
 
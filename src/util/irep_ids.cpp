@@ -43,10 +43,13 @@ const char *irep_ids_table[]=
 
 #include "irep_ids.def" // NOLINT(build/include)
 
-string_containert::string_containert()
+string_containert::string_containert():next_no(0)
 {
+  for(auto &segment : segments)
+    segment.store(nullptr);
+
   // pre-allocate empty string -- this gets index 0
-  get("");
+  get(string_ptrt(""));
 
   // allocate strings
   for(unsigned i=0; irep_ids_table[i]!=nullptr; i++)
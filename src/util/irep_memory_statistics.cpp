@@ -0,0 +1,85 @@
+/*******************************************************************\
+
+Module: Memory Usage of Ireps
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Memory Usage of Ireps
+
+#include "irep_memory_statistics.h"
+
+#include <ostream>
+#include <stack>
+
+#include "irep.h"
+
+static std::size_t sub_heap_size(const irept::subt &sub)
+{
+  #ifdef SUB_IS_SMALL_VECTOR
+  return sub.heap_size();
+  #else
+  return sub.capacity()*sizeof(irept);
+  #endif
+}
+
+static std::size_t named_sub_heap_size(const irept::named_subt &named_sub)
+{
+  #if defined(NAMED_SUB_IS_VECTOR)
+  return named_sub.heap_size();
+  #elif defined(SUB_IS_LIST)
+  // two links per list node
+  return named_sub.size()*
+    (sizeof(irept::named_subt::value_type)+2*sizeof(void *));
+  #else
+  // colour, parent, left and right per tree node
+  return named_sub.size()*
+    (sizeof(irept::named_subt::value_type)+4*sizeof(void *));
+  #endif
+}
+
+std::size_t irep_memory_statisticst::node_size()
+{
+  return sizeof(get_nil_irep().read());
+}
+
+void irep_memory_statisticst::operator()(const irept &irep)
+{
+  std::stack<const irept *> todo;
+  todo.push(&irep);
+
+  while(!todo.empty())
+  {
+    const irept &i=*todo.top();
+    todo.pop();
+
+    if(!seen.insert(&i.read()).second)
+      continue;
+
+    nodes++;
+    heap_bytes+=sub_heap_size(i.get_sub());
+    heap_bytes+=named_sub_heap_size(i.get_named_sub());
+    heap_bytes+=named_sub_heap_size(i.get_comments());
+
+    forall_irep(it, i.get_sub())
+      todo.push(&*it);
+    forall_named_irep(it, i.get_named_sub())
+      todo.push(&it->second);
+    forall_named_irep(it, i.get_comments())
+      todo.push(&it->second);
+  }
+}
+
+void irep_memory_statisticst::output(std::ostream &out) const
+{
+  out << "Irep nodes: " << nodes << '\n';
+  out << "Node size: " << node_size() << " bytes\n";
+  out << "Heap memory of containers: " << heap_bytes << " bytes\n";
+  out << "Total: " << total_bytes() << " bytes\n";
+
+  if(nodes!=0)
+    out << "Bytes per node: "
+        << static_cast<double>(total_bytes())/nodes << '\n';
+}
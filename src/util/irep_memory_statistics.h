@@ -0,0 +1,54 @@
+/*******************************************************************\
+
+Module: Memory Usage of Ireps
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Memory Usage of Ireps
+
+#ifndef CPROVER_UTIL_IREP_MEMORY_STATISTICS_H
+#define CPROVER_UTIL_IREP_MEMORY_STATISTICS_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <unordered_set>
+
+class irept;
+
+/// Collects the number of irep nodes and the bytes these occupy, to compare
+/// the node layouts that can be selected in irep.h. Shared nodes are counted
+/// once. The heap memory of the containers in each node is estimated from
+/// their capacity, without the overhead of the memory allocator.
+class irep_memory_statisticst
+{
+public:
+  irep_memory_statisticst():
+    nodes(0),
+    heap_bytes(0)
+  {
+  }
+
+  /// Account for all nodes of the given irep that have not been seen yet
+  void operator()(const irept &irep);
+
+  /// \return the size of a node without its containers' heap memory
+  static std::size_t node_size();
+
+  std::size_t total_bytes() const
+  {
+    return nodes*node_size()+heap_bytes;
+  }
+
+  void output(std::ostream &) const;
+
+  std::size_t nodes;
+  std::size_t heap_bytes;
+
+protected:
+  std::unordered_set<const void *> seen;
+};
+
+#endif // CPROVER_UTIL_IREP_MEMORY_STATISTICS_H
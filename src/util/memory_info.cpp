@@ -18,6 +18,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <malloc.h>
 #endif
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 #ifdef _WIN32
 #include <windows.h>
 #include <psapi.h>
@@ -69,3 +73,23 @@ void memory_info(std::ostream &out)
       << static_cast<double>(t.size_allocated)/1000000 << "m\n";
   #endif
 }
+
+std::size_t peak_resident_set_size()
+{
+  #ifdef _WIN32
+  return 0;
+  #else
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage)!=0)
+    return 0;
+
+  #ifdef __APPLE__
+  // bytes on macOS
+  return usage.ru_maxrss;
+  #else
+  // kilobytes elsewhere
+  return static_cast<std::size_t>(usage.ru_maxrss)*1024;
+  #endif
+  #endif
+}
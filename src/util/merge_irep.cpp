@@ -96,7 +96,7 @@ const merged_irept &merged_irepst::merged(const irept &irep)
   irept::named_subt &dest_named_sub=new_irep.get_named_sub();
 
   forall_named_irep(it, src_named_sub)
-    #ifdef SUB_IS_LIST
+    #ifdef NAMED_SUB_IS_SORTED
     dest_named_sub.push_back(
       std::make_pair(it->first, merged(it->second))); // recursive call
     #else
@@ -141,7 +141,7 @@ const irept &merge_irept::merged(const irept &irep)
   irept::named_subt &dest_named_sub=new_irep.get_named_sub();
 
   forall_named_irep(it, src_named_sub)
-    #ifdef SUB_IS_LIST
+    #ifdef NAMED_SUB_IS_SORTED
     dest_named_sub.push_back(
       std::make_pair(it->first, merged(it->second))); // recursive call
     #else
@@ -152,7 +152,7 @@ const irept &merge_irept::merged(const irept &irep)
   irept::named_subt &dest_comments=new_irep.get_comments();
 
   forall_named_irep(it, src_comments)
-    #ifdef SUB_IS_LIST
+    #ifdef NAMED_SUB_IS_SORTED
     dest_comments.push_back(
       std::make_pair(it->first, merged(it->second))); // recursive call
     #else
@@ -189,7 +189,7 @@ const irept &merge_full_irept::merged(const irept &irep)
   irept::named_subt &dest_named_sub=new_irep.get_named_sub();
 
   forall_named_irep(it, src_named_sub)
-    #ifdef SUB_IS_LIST
+    #ifdef NAMED_SUB_IS_SORTED
     dest_named_sub.push_back(
       std::make_pair(it->first, merged(it->second))); // recursive call
     #else
@@ -200,7 +200,7 @@ const irept &merge_full_irept::merged(const irept &irep)
   irept::named_subt &dest_comments=new_irep.get_comments();
 
   forall_named_irep(it, src_comments)
-    #ifdef SUB_IS_LIST
+    #ifdef NAMED_SUB_IS_SORTED
     dest_comments.push_back(
       std::make_pair(it->first, merged(it->second))); // recursive call
     #else
@@ -18,6 +18,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "string2int.h"
 #include "symbol_table.h"
 #include "prefix.h"
+#include "simplify_expr_cache.h"
 #include "std_types.h"
 
 unsigned get_max(
@@ -40,6 +41,21 @@ namespace_baset::~namespace_baset()
 {
 }
 
+void namespace_baset::enable_simplify_cache()
+{
+  if(!simplify_cache)
+    simplify_cache=std::make_shared<simplify_expr_cachet>();
+}
+
+simplify_expr_cachet *namespace_baset::get_simplify_cache() const
+{
+  if(!simplify_cache)
+    return nullptr;
+
+  simplify_cache->set_revision(get_revision());
+  return simplify_cache.get();
+}
+
 void namespace_baset::follow_symbol(irept &irep) const
 {
   while(irep.id()==ID_symbol)
@@ -136,6 +152,19 @@ unsigned namespacet::get_max(const std::string &prefix) const
   return m;
 }
 
+std::size_t namespacet::get_revision() const
+{
+  std::size_t revision=0;
+
+  if(symbol_table1!=nullptr)
+    revision+=symbol_table1->get_revision();
+
+  if(symbol_table2!=nullptr)
+    revision+=symbol_table2->get_revision();
+
+  return revision;
+}
+
 bool namespacet::lookup(
   const irep_idt &name,
   const symbolt *&symbol) const
@@ -180,6 +209,16 @@ unsigned multi_namespacet::get_max(const std::string &prefix) const
   return m;
 }
 
+std::size_t multi_namespacet::get_revision() const
+{
+  std::size_t revision=0;
+
+  for(const auto &symbol_table : symbol_table_list)
+    revision+=symbol_table->get_revision();
+
+  return revision;
+}
+
 bool multi_namespacet::lookup(
   const irep_idt &name,
   const symbolt *&symbol) const
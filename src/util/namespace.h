@@ -10,8 +10,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_NAMESPACE_H
 #define CPROVER_UTIL_NAMESPACE_H
 
+#include <memory>
+
 #include "irep.h"
 
+class simplify_expr_cachet;
 class symbol_tablet;
 class exprt;
 class symbolt;
@@ -66,6 +69,24 @@ public:
   /// \return False iff the requested symbol is found in at least one of the
   /// tables.
   virtual bool lookup(const irep_idt &name, const symbolt *&symbol) const=0;
+
+  /// Memoize the results of simplify_exprt for this namespace from now
+  /// on, in a cache that copies of the namespace made later share. The
+  /// cache is emptied when the symbol tables change via get_writeable()
+  /// or erase(), but changes via the references returned by insert() or
+  /// move() go unnoticed. Thus, enable it only once the symbols that are
+  /// there are complete, e.g., after type checking.
+  void enable_simplify_cache();
+
+  /// \return the cache for the results of simplify_exprt, or nullptr if
+  ///   the cache is not enabled
+  simplify_expr_cachet *get_simplify_cache() const;
+
+protected:
+  std::shared_ptr<simplify_expr_cachet> simplify_cache;
+
+  /// \return the sum of the revisions of the symbol tables
+  virtual std::size_t get_revision() const=0;
 };
 
 /*! \brief TO_BE_DOCUMENTED
@@ -109,6 +130,8 @@ public:
 
 protected:
   const symbol_tablet *symbol_table1, *symbol_table2;
+
+  virtual std::size_t get_revision() const override;
 };
 
 class multi_namespacet:public namespacet
@@ -134,11 +157,14 @@ public:
   void add(const symbol_tablet &symbol_table)
   {
     symbol_table_list.push_back(&symbol_table);
+    simplify_cache.reset();
   }
 
 protected:
   typedef std::vector<const symbol_tablet *> symbol_table_listt;
   symbol_table_listt symbol_table_list;
+
+  virtual std::size_t get_revision() const override;
 };
 
 #endif // CPROVER_UTIL_NAMESPACE_H
@@ -18,8 +18,32 @@ Author: Daniel Kroening, kroening@kroening.com
 #endif
 
 #include "cmdline.h"
+#include "profiler.h"
 #include "signal_catcher.h"
 
+/// Writes the profile for --profile-json when leaving the scope, which
+/// includes doit() throwing an exception
+class profile_writert
+{
+public:
+  explicit profile_writert(const std::string &_file_name):
+    file_name(_file_name)
+  {
+    if(!file_name.empty())
+      global_profiler().enable();
+  }
+
+  ~profile_writert()
+  {
+    if(!file_name.empty() &&
+       global_profiler().write_json(file_name))
+      std::cerr << "failed to write profile to " << file_name << "\n";
+  }
+
+protected:
+  const std::string file_name;
+};
+
 parse_options_baset::parse_options_baset(
   const std::string &_optstring, int argc, const char **argv)
 {
@@ -63,5 +87,9 @@ int parse_options_baset::main()
   // install signal catcher
   install_signal_catcher();
 
+  // for tools that offer --profile-json
+  profile_writert profile_writer(
+    cmdline.isset("profile-json")?cmdline.get_value("profile-json"):"");
+
   return doit();
 }
@@ -159,12 +159,11 @@ int pipe_streamt::run()
 
     _argv[args.size()+1]=nullptr;
 
-    int result=execvp(executable.c_str(), _argv.data());
+    execvp(executable.c_str(), _argv.data());
 
-    if(result==-1)
-      perror(nullptr);
-
-    return result;
+    // the child must not return into the caller
+    perror(executable.c_str());
+    _exit(1);
   }
   else if(pid==-1)
   {
@@ -291,17 +290,27 @@ std::streambuf::int_type filedescriptor_streambuft::underflow()
   if(gptr()<egptr())
     return traits_type::to_int_type(*gptr());
 
+  // keep the last character, such that it can be put back
+  char_type *start=eback();
+  if(gptr()>eback())
+  {
+    *eback()=*(gptr()-1);
+    start++;
+  }
+
+  const std::size_t size=READ_BUFFER_SIZE-(start-eback());
+
   #ifdef _WIN32
   DWORD len;
-  if(!ReadFile(proc_out, eback(), READ_BUFFER_SIZE, &len, NULL))
+  if(!ReadFile(proc_out, start, size, &len, NULL))
     return traits_type::eof();
   #else
-  ssize_t len=read(proc_out, eback(), READ_BUFFER_SIZE);
+  ssize_t len=read(proc_out, start, size);
   if(len==-1)
     return traits_type::eof();
   #endif
 
-  setg(eback(), eback(), eback()+(sizeof(char_type)*len));
+  setg(eback(), start, start+(sizeof(char_type)*len));
 
   if(len==0)
     return traits_type::eof();
@@ -0,0 +1,108 @@
+/*******************************************************************\
+
+Module: Profiling of Phases
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Profiling of Phases
+
+#include "profiler.h"
+
+#include <fstream>
+
+#include "invariant.h"
+#include "memory_info.h"
+
+void profilert::start(const std::string &name)
+{
+  std::list<phaset> &siblings=running.empty()?phases:running.back()->phases;
+
+  siblings.push_back(phaset());
+  phaset &phase=siblings.back();
+  phase.name=name;
+  phase.cpu_time=0;
+  phase.cumulative_peak_rss=0;
+  phase.cpu_start=std::clock();
+  phase.wall_time.start();
+
+  running.push_back(&phase);
+}
+
+void profilert::stop()
+{
+  PRECONDITION(!running.empty());
+
+  phaset &phase=*running.back();
+  phase.wall_time.stop();
+  phase.cpu_time=
+    static_cast<double>(std::clock()-phase.cpu_start)/CLOCKS_PER_SEC;
+  phase.cumulative_peak_rss=peak_resident_set_size();
+
+  running.pop_back();
+}
+
+void profilert::set_count(const std::string &what, std::size_t value)
+{
+  PRECONDITION(!running.empty());
+  running.back()->counts[what]=value;
+}
+
+jsont profilert::output_json(const std::list<phaset> &phases)
+{
+  json_arrayt json_phases;
+
+  for(const auto &phase : phases)
+  {
+    json_objectt &json_phase=json_phases.push_back().make_object();
+    json_phase["name"]=json_stringt(phase.name);
+    json_phase["wallTime"]=json_numbert(
+      std::to_string(
+        static_cast<double>(phase.wall_time.total_time().get_t())/1000));
+    json_phase["cpuTime"]=json_numbert(std::to_string(phase.cpu_time));
+    json_phase["cumulativePeakRSS"]=
+      json_numbert(std::to_string(phase.cumulative_peak_rss));
+
+    if(!phase.counts.empty())
+    {
+      json_objectt &json_counts=json_phase["counts"].make_object();
+      for(const auto &count : phase.counts)
+        json_counts[count.first]=json_numbert(std::to_string(count.second));
+    }
+
+    if(!phase.phases.empty())
+      json_phase["phases"]=output_json(phase.phases);
+  }
+
+  return json_phases;
+}
+
+json_objectt profilert::output_json() const
+{
+  json_objectt json;
+  json["phases"]=output_json(phases);
+  json["cpuTime"]=json_numbert(
+    std::to_string(static_cast<double>(std::clock())/CLOCKS_PER_SEC));
+  json["peakRSS"]=json_numbert(std::to_string(peak_resident_set_size()));
+  return json;
+}
+
+bool profilert::write_json(const std::string &file_name) const
+{
+  std::ofstream out(file_name);
+
+  if(!out)
+    return true;
+
+  out << output_json() << '\n';
+
+  return !out;
+}
+
+profilert &global_profiler()
+{
+  static profilert profiler;
+  return profiler;
+}
@@ -0,0 +1,132 @@
+/*******************************************************************\
+
+Module: Profiling of Phases
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Profiling of Phases
+
+#ifndef CPROVER_UTIL_PROFILER_H
+#define CPROVER_UTIL_PROFILER_H
+
+#include <ctime>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "json.h"
+#include "timer.h"
+
+/// Records the wall-clock time and CPU time of the phases of a run, such as
+/// parsing, symbolic execution or solving, along with counts such as the
+/// number of SSA steps. For the memory, the peak resident set size of the
+/// process up to the end of each phase is recorded, which includes the
+/// phases before; a phase that uses less than an earlier one shows the
+/// same value. Phases nest: a phase that
+/// is started while another one is running becomes part of it. Phases are
+/// meant to be started and stopped by the main thread only.
+class profilert
+{
+public:
+  profilert():enabled(false)
+  {
+  }
+
+  void enable()
+  {
+    enabled=true;
+  }
+
+  bool is_enabled() const
+  {
+    return enabled;
+  }
+
+  /// Start a phase, nested in the innermost running one
+  void start(const std::string &name);
+
+  /// Stop the innermost running phase
+  void stop();
+
+  /// Record a count, e.g., the number of SSA steps, for the innermost
+  /// running phase
+  void set_count(const std::string &what, std::size_t value);
+
+  /// \return the phases recorded so far, those still running included
+  json_objectt output_json() const;
+
+  /// Write the result of output_json to the given file
+  /// \return true on error
+  bool write_json(const std::string &file_name) const;
+
+protected:
+  struct phaset
+  {
+    std::string name;
+    timert wall_time;
+    std::clock_t cpu_start;
+    double cpu_time;
+    // of the process so far, not of the phase alone
+    std::size_t cumulative_peak_rss;
+    std::map<std::string, std::size_t> counts;
+    std::list<phaset> phases;
+  };
+
+  static jsont output_json(const std::list<phaset> &phases);
+
+  bool enabled;
+  std::list<phaset> phases;
+  std::vector<phaset *> running;
+};
+
+/// \return the profiler used by the tools for --profile-json
+profilert &global_profiler();
+
+/// Runs a phase of the global profiler, if enabled, for the lifetime of
+/// the object
+class profile_phaset
+{
+public:
+  explicit profile_phaset(const std::string &name):
+    running(global_profiler().is_enabled())
+  {
+    if(running)
+      global_profiler().start(name);
+  }
+
+  ~profile_phaset()
+  {
+    if(running)
+      global_profiler().stop();
+  }
+
+  /// Stop this phase and start the next one at the same level, for
+  /// sequences of transformations
+  void next(const std::string &name)
+  {
+    if(running)
+    {
+      global_profiler().stop();
+      global_profiler().start(name);
+    }
+  }
+
+  profile_phaset(const profile_phaset &)=delete;
+  profile_phaset &operator=(const profile_phaset &)=delete;
+
+protected:
+  const bool running;
+};
+
+/// Record a count for the innermost running phase of the global profiler
+inline void profile_count(const std::string &what, std::size_t value)
+{
+  if(global_profiler().is_enabled())
+    global_profiler().set_count(what, value);
+}
+
+#endif // CPROVER_UTIL_PROFILER_H
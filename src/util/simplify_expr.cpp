@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "c_types.h"
 #include "rational.h"
+#include "simplify_expr_cache.h"
 #include "simplify_expr_class.h"
 #include "mp_arith.h"
 #include "arith_tools.h"
@@ -42,30 +43,6 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 #endif
 
-// #define USE_CACHE
-
-#ifdef USE_CACHE
-struct simplify_expr_cachet
-{
-public:
-  #if 1
-  typedef std::unordered_map<
-    exprt, exprt, irep_full_hash, irep_full_eq> containert;
-  #else
-  typedef std::unordered_map<exprt, exprt, irep_hash> containert;
-  #endif
-
-  containert container_normal;
-
-  containert &container()
-  {
-    return container_normal;
-  }
-};
-
-simplify_expr_cachet simplify_expr_cache;
-#endif
-
 bool simplify_exprt::simplify_abs(exprt &expr)
 {
   if(expr.operands().size()!=1)
@@ -2356,25 +2333,6 @@ bool simplify_exprt::simplify_node(exprt &expr)
 /// \return returns true if expression unchanged; returns false if changed
 bool simplify_exprt::simplify_rec(exprt &expr)
 {
-  // look up in cache
-
-  #ifdef USE_CACHE
-  std::pair<simplify_expr_cachet::containert::iterator, bool>
-    cache_result=simplify_expr_cache.container().
-      insert(std::pair<exprt, exprt>(expr, exprt()));
-
-  if(!cache_result.second) // found!
-  {
-    const exprt &new_expr=cache_result.first->second;
-
-    if(new_expr.id().empty())
-      return true; // no change
-
-    expr=new_expr;
-    return false;
-  }
-  #endif
-
   // We work on a copy to prevent unnecessary destruction of sharing.
   exprt tmp=expr;
   bool result=true;
@@ -2403,11 +2361,6 @@ bool simplify_exprt::simplify_rec(exprt &expr)
   if(!result)
   {
     expr.swap(tmp);
-
-    #ifdef USE_CACHE
-    // save in cache
-    cache_result.first->second=expr;
-    #endif
   }
 
   return result;
@@ -2419,7 +2372,34 @@ bool simplify_exprt::simplify(exprt &expr)
   if(debug_on)
     std::cout << "TO-SIMP " << from_expr(ns, "", expr) << "\n";
 #endif
-  bool res=simplify_rec(expr);
+  // The results only depend on the namespace, unless there is a replace
+  // map or if-simplification is off.
+  simplify_expr_cachet *cache=
+    do_simplify_if && local_replace_map.empty()?
+    ns.get_simplify_cache():nullptr;
+
+  exprt result;
+
+  if(cache!=nullptr && cache->find(expr, result))
+  {
+    if(result.id().empty())
+      return true; // no change
+
+    expr=result;
+    return false;
+  }
+
+  bool res;
+
+  if(cache==nullptr)
+    res=simplify_rec(expr);
+  else
+  {
+    exprt original=expr;
+    res=simplify_rec(expr);
+    cache->insert(original, res?exprt():expr);
+  }
+
 #ifdef DEBUG_ON_DEMAND
   if(debug_on)
     std::cout << "FULLSIMP " << from_expr(ns, "", expr) << "\n";
@@ -0,0 +1,72 @@
+/*******************************************************************\
+
+Module: Memoization of Simplifier Results
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Memoization of Simplifier Results
+
+#include "simplify_expr_cache.h"
+
+void simplify_expr_cachet::set_revision(std::size_t _revision)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if(revision==_revision)
+    return;
+
+  index.clear();
+  entries.clear();
+  revision=_revision;
+}
+
+bool simplify_expr_cachet::find(const exprt &expr, exprt &result)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  indext::iterator it=index.find(expr);
+
+  if(it==index.end())
+  {
+    misses++;
+    return false;
+  }
+
+  hits++;
+
+  // move to the front
+  entries.splice(entries.begin(), entries, it->second);
+  result=it->second->second;
+
+  return true;
+}
+
+void simplify_expr_cachet::insert(const exprt &expr, const exprt &result)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if(capacity==0)
+    return;
+
+  indext::iterator it=index.find(expr);
+
+  if(it!=index.end())
+  {
+    it->second->second=result;
+    entries.splice(entries.begin(), entries, it->second);
+    return;
+  }
+
+  if(index.size()>=capacity)
+  {
+    // evict the least recently used entry
+    index.erase(entries.back().first);
+    entries.pop_back();
+  }
+
+  entries.push_front(std::make_pair(expr, result));
+  index.insert(std::make_pair(expr, entries.begin()));
+}
@@ -0,0 +1,99 @@
+/*******************************************************************\
+
+Module: Memoization of Simplifier Results
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Memoization of Simplifier Results
+
+#ifndef CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
+#define CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "expr.h"
+
+/// Remembers the results of simplify_exprt::simplify for a bounded number of
+/// expressions, evicting the least recently used one when full.
+///
+/// Expressions are hashed with irept::hash, which is cached in the
+/// expression with HASH_CODE, and compared including comments, which is
+/// immediate for expressions that share their node, e.g., after hash
+/// consing.
+///
+/// The results are only valid for one revision of the symbol tables, see
+/// set_revision(). The cache may be used from several threads.
+class simplify_expr_cachet
+{
+public:
+  static const std::size_t default_capacity=1u<<16;
+
+  explicit simplify_expr_cachet(std::size_t _capacity=default_capacity):
+    capacity(_capacity), revision(0), hits(0), misses(0)
+  {
+  }
+
+  /// Forget all results if the symbol tables the results have been
+  /// computed with have changed
+  /// \param _revision: the sum of the revisions of the symbol tables
+  void set_revision(std::size_t _revision);
+
+  /// Look up the simplified form of an expression
+  /// \param expr: the expression before simplification
+  /// \param [out] result: the simplified expression, or an expression
+  ///   with empty id if the simplifier leaves expr unchanged
+  /// \return true iff the expression is in the cache
+  bool find(const exprt &expr, exprt &result);
+
+  /// Remember the simplified form of an expression, with the conventions
+  /// of find()
+  void insert(const exprt &expr, const exprt &result);
+
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return index.size();
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+  }
+
+  std::size_t get_hits() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+  }
+
+  std::size_t get_misses() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+  }
+
+protected:
+  std::size_t capacity;
+  std::size_t revision;
+  std::size_t hits, misses;
+
+  // guards the members above and below
+  mutable std::mutex mutex;
+
+  // most recently used first
+  typedef std::list<std::pair<exprt, exprt>> entriest;
+  entriest entries;
+
+  typedef std::unordered_map<
+    exprt, entriest::iterator, irep_hash, irep_full_eq> indext;
+  indext index;
+};
+
+#endif // CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
@@ -0,0 +1,637 @@
+/*******************************************************************\
+
+Module: Vector with inline storage for a few elements
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Vector with inline storage for a few elements
+
+#ifndef CPROVER_UTIL_SMALL_VECTOR_H
+#define CPROVER_UTIL_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// Random-access iterator over the elements of a small_vectort. A class
+/// rather than a plain pointer, such that, as with std::vector, an
+/// iterator returned by a function can be incremented in place.
+template<typename T>
+class small_vector_iteratort
+{
+public:
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::random_access_iterator_tag iterator_category;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef typename std::remove_const<T>::type value_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::ptrdiff_t difference_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T *pointer;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T &reference;
+
+  small_vector_iteratort():p(nullptr)
+  {
+  }
+
+  explicit small_vector_iteratort(T *_p):p(_p)
+  {
+  }
+
+  // iterator to const_iterator
+  template<
+    typename U,
+    typename=typename std::enable_if<
+      std::is_same<const U, T>::value>::type>
+  // NOLINTNEXTLINE(runtime/explicit)
+  small_vector_iteratort(const small_vector_iteratort<U> &other):
+    p(other.base())
+  {
+  }
+
+  T *base() const { return p; }
+
+  T &operator*() const { return *p; }
+  T *operator->() const { return p; }
+  T &operator[](difference_type n) const { return p[n]; }
+
+  small_vector_iteratort &operator++()
+  {
+    ++p;
+    return *this;
+  }
+
+  small_vector_iteratort operator++(int)
+  {
+    return small_vector_iteratort(p++);
+  }
+
+  small_vector_iteratort &operator--()
+  {
+    --p;
+    return *this;
+  }
+
+  small_vector_iteratort operator--(int)
+  {
+    return small_vector_iteratort(p--);
+  }
+
+  small_vector_iteratort &operator+=(difference_type n)
+  {
+    p+=n;
+    return *this;
+  }
+
+  small_vector_iteratort &operator-=(difference_type n)
+  {
+    p-=n;
+    return *this;
+  }
+
+  small_vector_iteratort operator+(difference_type n) const
+  {
+    return small_vector_iteratort(p+n);
+  }
+
+  small_vector_iteratort operator-(difference_type n) const
+  {
+    return small_vector_iteratort(p-n);
+  }
+
+private:
+  T *p;
+};
+
+template<typename T>
+small_vector_iteratort<T> operator+(
+  std::ptrdiff_t n,
+  const small_vector_iteratort<T> &it)
+{
+  return it+n;
+}
+
+// The comparisons also apply to mixes of iterator and const_iterator.
+#define SMALL_VECTOR_ITERATOR_OPERATOR(op, result_type) \
+  template<typename T, typename U> \
+  result_type operator op( \
+    const small_vector_iteratort<T> &a, \
+    const small_vector_iteratort<U> &b) \
+  { \
+    return a.base() op b.base(); \
+  }
+
+SMALL_VECTOR_ITERATOR_OPERATOR(==, bool)
+SMALL_VECTOR_ITERATOR_OPERATOR(!=, bool)
+SMALL_VECTOR_ITERATOR_OPERATOR(<, bool)
+SMALL_VECTOR_ITERATOR_OPERATOR(>, bool)
+SMALL_VECTOR_ITERATOR_OPERATOR(<=, bool)
+SMALL_VECTOR_ITERATOR_OPERATOR(>=, bool)
+SMALL_VECTOR_ITERATOR_OPERATOR(-, std::ptrdiff_t)
+
+#undef SMALL_VECTOR_ITERATOR_OPERATOR
+
+/// A subset of the interface of std::vector that stores up to N elements
+/// without any heap allocation, and uses 32-bit size and capacity fields.
+/// The object occupies 8+N*sizeof(void *) bytes, or 16 bytes for N=0.
+///
+/// The inline buffer is sized in pointers rather than in elements of T,
+/// which has two consequences: T may be incomplete where the vector is
+/// declared (as is the case for irept::subt), and the layout does not
+/// depend on T, which permits the casts of irept::subt to the vectors of
+/// classes derived from irept, such as exprt::operandst. Element types
+/// kept inline must therefore be no larger than a pointer.
+///
+/// As with std::vector, iterators and references are invalidated by any
+/// operation that changes the size of the vector.
+/// Unlike std::vector, this is also the case for swap() and moves of
+/// vectors whose elements are stored inline.
+template<typename T, std::size_t N>
+class small_vectort
+{
+public:
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T value_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::size_t size_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::ptrdiff_t difference_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T &reference;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef const T &const_reference;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T *pointer;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef const T *const_pointer;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef small_vector_iteratort<T> iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef small_vector_iteratort<const T> const_iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  small_vectort():size_(0), capacity_(N)
+  {
+  }
+
+  explicit small_vectort(size_type n):small_vectort()
+  {
+    resize(n);
+  }
+
+  small_vectort(size_type n, const T &value):small_vectort()
+  {
+    assign(n, value);
+  }
+
+  template<
+    typename input_iteratort,
+    typename=typename std::enable_if<
+      !std::is_integral<input_iteratort>::value>::type>
+  small_vectort(input_iteratort first, input_iteratort last):small_vectort()
+  {
+    assign(first, last);
+  }
+
+  small_vectort(std::initializer_list<T> list):small_vectort()
+  {
+    assign(list.begin(), list.end());
+  }
+
+  small_vectort(const small_vectort &other):small_vectort()
+  {
+    assign(other.begin(), other.end());
+  }
+
+  small_vectort(small_vectort &&other):small_vectort()
+  {
+    take(other);
+  }
+
+  ~small_vectort()
+  {
+    clear();
+    release();
+  }
+
+  small_vectort &operator=(const small_vectort &other)
+  {
+    if(this!=&other)
+      assign(other.begin(), other.end());
+    return *this;
+  }
+
+  small_vectort &operator=(small_vectort &&other)
+  {
+    if(this!=&other)
+    {
+      clear();
+      release();
+      take(other);
+    }
+    return *this;
+  }
+
+  small_vectort &operator=(std::initializer_list<T> list)
+  {
+    assign(list.begin(), list.end());
+    return *this;
+  }
+
+  void assign(size_type n, const T &value)
+  {
+    T tmp(value); // value may be one of our elements
+    clear();
+    reserve(n);
+    for(size_type i=0; i<n; i++)
+      push_back(tmp);
+  }
+
+  template<
+    typename input_iteratort,
+    typename=typename std::enable_if<
+      !std::is_integral<input_iteratort>::value>::type>
+  void assign(input_iteratort first, input_iteratort last)
+  {
+    clear();
+    for(; first!=last; ++first)
+      emplace_back(*first);
+  }
+
+  iterator begin() { return iterator(data()); }
+  const_iterator begin() const { return const_iterator(data()); }
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end() { return iterator(data()+size_); }
+  const_iterator end() const { return const_iterator(data()+size_); }
+  const_iterator cend() const { return end(); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crend() const { return rend(); }
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_==0; }
+  size_type capacity() const { return capacity_; }
+
+  size_type max_size() const
+  {
+    return std::numeric_limits<std::uint32_t>::max();
+  }
+
+  /// \return whether the elements are kept in the inline buffer
+  bool is_inline() const { return capacity_<=N; }
+
+  /// \return the number of bytes allocated on the heap for the elements
+  std::size_t heap_size() const
+  {
+    return is_inline()?0:capacity_*sizeof(T);
+  }
+
+  T *data()
+  {
+    return is_inline()?inline_data():storage.heap;
+  }
+
+  const T *data() const
+  {
+    return is_inline()?inline_data():storage.heap;
+  }
+
+  T &operator[](size_type i) { return data()[i]; }
+  const T &operator[](size_type i) const { return data()[i]; }
+
+  T &at(size_type i)
+  {
+    if(i>=size_)
+      throw std::out_of_range("small_vectort::at");
+    return data()[i];
+  }
+
+  const T &at(size_type i) const
+  {
+    if(i>=size_)
+      throw std::out_of_range("small_vectort::at");
+    return data()[i];
+  }
+
+  T &front() { return data()[0]; }
+  const T &front() const { return data()[0]; }
+  T &back() { return data()[size_-1]; }
+  const T &back() const { return data()[size_-1]; }
+
+  void reserve(size_type n)
+  {
+    if(n>capacity_)
+      reallocate(n);
+  }
+
+  /// Move the elements back into the inline buffer if they fit,
+  /// or into a heap block of the exact size otherwise
+  void shrink_to_fit()
+  {
+    if(!is_inline() && size_<capacity_)
+      reallocate(size_);
+  }
+
+  void clear()
+  {
+    destroy(begin(), end());
+    size_=0;
+  }
+
+  void push_back(const T &value)
+  {
+    emplace_back(value);
+  }
+
+  void push_back(T &&value)
+  {
+    emplace_back(std::move(value));
+  }
+
+  template<typename... argst>
+  T &emplace_back(argst &&... args)
+  {
+    if(size_==capacity_)
+    {
+      // the arguments may refer to one of our elements
+      T tmp(std::forward<argst>(args)...);
+      reallocate(grown_capacity(size_+1));
+      new(data()+size_) T(std::move(tmp));
+    }
+    else
+      new(data()+size_) T(std::forward<argst>(args)...);
+
+    return data()[size_++];
+  }
+
+  void pop_back()
+  {
+    back().~T();
+    size_--;
+  }
+
+  void resize(size_type n)
+  {
+    if(n<size_)
+      erase(begin()+n, end());
+    else
+    {
+      reserve(n);
+      while(size_<n)
+        emplace_back();
+    }
+  }
+
+  void resize(size_type n, const T &value)
+  {
+    if(n<size_)
+      erase(begin()+n, end());
+    else if(n>size_)
+      insert(end(), n-size_, value);
+  }
+
+  template<typename... argst>
+  iterator emplace(const_iterator pos, argst &&... args)
+  {
+    const size_type index=pos-begin();
+    emplace_back(std::forward<argst>(args)...);
+    std::rotate(begin()+index, end()-1, end());
+    return begin()+index;
+  }
+
+  iterator insert(const_iterator pos, const T &value)
+  {
+    return emplace(pos, value);
+  }
+
+  iterator insert(const_iterator pos, T &&value)
+  {
+    return emplace(pos, std::move(value));
+  }
+
+  iterator insert(const_iterator pos, size_type n, const T &value)
+  {
+    const size_type index=pos-begin();
+    const size_type old_size=size_;
+    T tmp(value); // value may be one of our elements
+    reserve(size_+n);
+    for(size_type i=0; i<n; i++)
+      push_back(tmp);
+    std::rotate(begin()+index, begin()+old_size, end());
+    return begin()+index;
+  }
+
+  template<
+    typename input_iteratort,
+    typename=typename std::enable_if<
+      !std::is_integral<input_iteratort>::value>::type>
+  iterator insert(
+    const_iterator pos,
+    input_iteratort first,
+    input_iteratort last)
+  {
+    const size_type index=pos-begin();
+    const size_type old_size=size_;
+    for(; first!=last; ++first)
+      emplace_back(*first);
+    std::rotate(begin()+index, begin()+old_size, end());
+    return begin()+index;
+  }
+
+  iterator insert(const_iterator pos, std::initializer_list<T> list)
+  {
+    return insert(pos, list.begin(), list.end());
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    return erase(pos, pos+1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    iterator dest=begin()+(first-cbegin());
+    iterator src=begin()+(last-cbegin());
+
+    if(dest!=src)
+    {
+      iterator new_end=std::move(src, end(), dest);
+      destroy(new_end, end());
+      size_=static_cast<std::uint32_t>(new_end-begin());
+    }
+
+    return dest;
+  }
+
+  void swap(small_vectort &other)
+  {
+    if(!is_inline() && !other.is_inline())
+    {
+      std::swap(storage.heap, other.storage.heap);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+    }
+    else
+    {
+      small_vectort tmp(std::move(other));
+      other=std::move(*this);
+      *this=std::move(tmp);
+    }
+  }
+
+private:
+  std::uint32_t size_;
+  std::uint32_t capacity_;
+
+  union storaget
+  {
+    T *heap;
+    alignas(void *) unsigned char buffer[(N==0?1:N)*sizeof(void *)];
+  } storage;
+
+  T *inline_data()
+  {
+    static_assert(
+      N==0 || (sizeof(T)<=sizeof(void *) && alignof(T)<=alignof(void *)),
+      "elements kept inline must not be larger than a pointer");
+    return reinterpret_cast<T *>(storage.buffer);
+  }
+
+  const T *inline_data() const
+  {
+    return const_cast<small_vectort *>(this)->inline_data();
+  }
+
+  size_type grown_capacity(size_type n) const
+  {
+    // grow by 50% to keep the slack small, as most vectors are short
+    size_type grown=capacity_+capacity_/2;
+    if(grown>max_size())
+      grown=max_size();
+    return std::max(n, grown);
+  }
+
+  /// Move the elements into storage for n>=size() elements;
+  /// the inline buffer is used if it is large enough.
+  void reallocate(size_type n)
+  {
+    if(n>max_size())
+      throw std::length_error("small_vectort");
+
+    T *old_data=data();
+    const bool was_inline=is_inline();
+    T *new_data;
+
+    if(n<=N)
+    {
+      if(was_inline)
+        return;
+      new_data=inline_data();
+      n=N;
+    }
+    else
+      new_data=static_cast<T *>(::operator new(n*sizeof(T)));
+
+    // The inline buffer and the heap pointer share storage; keep the
+    // pointer to the heap block before it is overwritten.
+    for(size_type i=0; i<size_; i++)
+    {
+      new(new_data+i) T(std::move(old_data[i]));
+      old_data[i].~T();
+    }
+
+    if(!was_inline)
+      ::operator delete(old_data);
+
+    if(n>N)
+      storage.heap=new_data;
+
+    capacity_=static_cast<std::uint32_t>(n);
+  }
+
+  /// Take over the elements of other, which is left empty
+  void take(small_vectort &other)
+  {
+    if(other.is_inline())
+    {
+      size_=0;
+      capacity_=N;
+      for(auto &e : other)
+        emplace_back(std::move(e));
+      other.clear();
+    }
+    else
+    {
+      storage.heap=other.storage.heap;
+      size_=other.size_;
+      capacity_=other.capacity_;
+      other.size_=0;
+      other.capacity_=N;
+    }
+  }
+
+  void release()
+  {
+    if(!is_inline())
+      ::operator delete(storage.heap);
+    capacity_=N;
+  }
+
+  static void destroy(iterator first, iterator last)
+  {
+    for(; first!=last; ++first)
+      first->~T();
+  }
+};
+
+template<typename T, std::size_t N>
+bool operator==(const small_vectort<T, N> &a, const small_vectort<T, N> &b)
+{
+  return a.size()==b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template<typename T, std::size_t N>
+bool operator!=(const small_vectort<T, N> &a, const small_vectort<T, N> &b)
+{
+  return !(a==b);
+}
+
+template<typename T, std::size_t N>
+bool operator<(const small_vectort<T, N> &a, const small_vectort<T, N> &b)
+{
+  return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+template<typename T, std::size_t N>
+void swap(small_vectort<T, N> &a, small_vectort<T, N> &b)
+{
+  a.swap(b);
+}
+
+#endif // CPROVER_UTIL_SMALL_VECTOR_H
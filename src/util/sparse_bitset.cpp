@@ -0,0 +1,226 @@
+/*******************************************************************\
+
+Module: Compressed Sets of Small Numbers
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Compressed Sets of Small Numbers
+
+#include "sparse_bitset.h"
+
+#include <algorithm>
+
+static unsigned count_trailing_zeros(uint64_t word)
+{
+  #ifdef __GNUC__
+  return __builtin_ctzll(word);
+  #else
+  unsigned count=0;
+  for(; (word&1)==0; word>>=1)
+    count++;
+  return count;
+  #endif
+}
+
+static unsigned count_ones(uint64_t word)
+{
+  #ifdef __GNUC__
+  return __builtin_popcountll(word);
+  #else
+  unsigned count=0;
+  for(; word!=0; word&=word-1)
+    count++;
+  return count;
+  #endif
+}
+
+sparse_bitsett::blockst::iterator sparse_bitsett::find_block(
+  std::size_t index)
+{
+  return std::lower_bound(
+    blocks.begin(),
+    blocks.end(),
+    index,
+    [](const blockt &block, std::size_t i) { return block.index<i; });
+}
+
+sparse_bitsett::blockst::const_iterator sparse_bitsett::find_block(
+  std::size_t index) const
+{
+  return std::lower_bound(
+    blocks.begin(),
+    blocks.end(),
+    index,
+    [](const blockt &block, std::size_t i) { return block.index<i; });
+}
+
+std::size_t sparse_bitsett::size() const
+{
+  std::size_t result=0;
+
+  for(const auto &block : blocks)
+    result+=count_ones(block.bits);
+
+  return result;
+}
+
+bool sparse_bitsett::contains(std::size_t n) const
+{
+  blockst::const_iterator it=find_block(n/word_bits);
+
+  return it!=blocks.end() &&
+         it->index==n/word_bits &&
+         (it->bits&(wordt(1)<<(n%word_bits)))!=0;
+}
+
+bool sparse_bitsett::insert(std::size_t n)
+{
+  const wordt bit=wordt(1)<<(n%word_bits);
+  blockst::iterator it=find_block(n/word_bits);
+
+  if(it==blocks.end() || it->index!=n/word_bits)
+  {
+    blockt block;
+    block.index=n/word_bits;
+    block.bits=bit;
+    blocks.insert(it, block);
+    return true;
+  }
+
+  if((it->bits&bit)!=0)
+    return false;
+
+  it->bits|=bit;
+  return true;
+}
+
+bool sparse_bitsett::erase(std::size_t n)
+{
+  const wordt bit=wordt(1)<<(n%word_bits);
+  blockst::iterator it=find_block(n/word_bits);
+
+  if(it==blocks.end() || it->index!=n/word_bits || (it->bits&bit)==0)
+    return false;
+
+  it->bits&=~bit;
+
+  if(it->bits==0)
+    blocks.erase(it);
+
+  return true;
+}
+
+bool sparse_bitsett::insert(const sparse_bitsett &other)
+{
+  bool changed=false;
+  std::size_t missing=0;
+
+  // first the blocks that both sets have
+  blockst::iterator it=blocks.begin();
+  for(const auto &block : other.blocks)
+  {
+    while(it!=blocks.end() && it->index<block.index)
+      ++it;
+
+    if(it!=blocks.end() && it->index==block.index)
+    {
+      const wordt bits=it->bits|block.bits;
+
+      if(bits!=it->bits)
+      {
+        it->bits=bits;
+        changed=true;
+      }
+    }
+    else
+      missing++;
+  }
+
+  if(missing==0)
+    return changed;
+
+  blockst merged;
+  merged.reserve(blocks.size()+missing);
+
+  it=blocks.begin();
+  for(const auto &block : other.blocks)
+  {
+    while(it!=blocks.end() && it->index<block.index)
+      merged.push_back(*(it++));
+
+    if(it!=blocks.end() && it->index==block.index)
+      merged.push_back(*(it++));
+    else
+      merged.push_back(block);
+  }
+
+  merged.insert(merged.end(), it, blocks.end());
+  blocks.swap(merged);
+
+  return true;
+}
+
+bool sparse_bitsett::erase(const sparse_bitsett &other)
+{
+  bool changed=false;
+
+  blockst::iterator it=blocks.begin();
+  for(const auto &block : other.blocks)
+  {
+    while(it!=blocks.end() && it->index<block.index)
+      ++it;
+
+    if(it!=blocks.end() &&
+       it->index==block.index &&
+       (it->bits&block.bits)!=0)
+    {
+      it->bits&=~block.bits;
+      changed=true;
+    }
+  }
+
+  if(changed)
+    blocks.erase(
+      std::remove_if(
+        blocks.begin(),
+        blocks.end(),
+        [](const blockt &block) { return block.bits==0; }),
+      blocks.end());
+
+  return changed;
+}
+
+bool sparse_bitsett::operator==(const sparse_bitsett &other) const
+{
+  return blocks.size()==other.blocks.size() &&
+         std::equal(
+           blocks.begin(),
+           blocks.end(),
+           other.blocks.begin(),
+           [](const blockt &a, const blockt &b)
+           {
+             return a.index==b.index && a.bits==b.bits;
+           });
+}
+
+std::size_t sparse_bitsett::const_iterator::operator*() const
+{
+  return block->index*word_bits+count_trailing_zeros(bits);
+}
+
+sparse_bitsett::const_iterator &sparse_bitsett::const_iterator::operator++()
+{
+  bits&=bits-1;
+
+  if(bits==0)
+  {
+    ++block;
+    if(block!=end)
+      bits=block->bits;
+  }
+
+  return *this;
+}
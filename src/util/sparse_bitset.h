@@ -0,0 +1,145 @@
+/*******************************************************************\
+
+Module: Compressed Sets of Small Numbers
+
+Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Sets of numbers, such as those sparse_bitvector_analysist assigns, stored
+/// as the non-zero 64-bit words of a bit vector
+
+#ifndef CPROVER_UTIL_SPARSE_BITSET_H
+#define CPROVER_UTIL_SPARSE_BITSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+/// A set of numbers, stored as a sorted vector of the words of a bit vector
+/// that have a bit set. Unions and differences of sets are computed a word
+/// at a time. The set takes 16 bytes for up to 64 numbers that are close to
+/// each other, where std::set takes a tree node for each number.
+class sparse_bitsett
+{
+public:
+  bool empty() const
+  {
+    return blocks.empty();
+  }
+
+  std::size_t size() const;
+
+  void clear()
+  {
+    blocks.clear();
+  }
+
+  void swap(sparse_bitsett &other)
+  {
+    blocks.swap(other.blocks);
+  }
+
+  bool contains(std::size_t) const;
+
+  /// \return true if the number is new
+  bool insert(std::size_t);
+
+  /// \return true if the number has been in the set
+  bool erase(std::size_t);
+
+  /// Adds the numbers in `other`
+  /// \return true if any of them is new
+  bool insert(const sparse_bitsett &other);
+
+  /// Removes the numbers in `other`
+  /// \return true if any of them has been in the set
+  bool erase(const sparse_bitsett &other);
+
+  bool operator==(const sparse_bitsett &other) const;
+
+  bool operator!=(const sparse_bitsett &other) const
+  {
+    return !(*this==other);
+  }
+
+protected:
+  typedef uint64_t wordt;
+  static const std::size_t word_bits=64;
+
+  struct blockt
+  {
+    std::size_t index;
+    // never zero
+    wordt bits;
+  };
+
+  typedef std::vector<blockt> blockst;
+  blockst blocks;
+
+  blockst::iterator find_block(std::size_t index);
+  blockst::const_iterator find_block(std::size_t index) const;
+
+public:
+  /// Yields the numbers in ascending order
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::size_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const std::size_t *pointer;
+    typedef std::size_t reference;
+
+    std::size_t operator*() const;
+
+    const_iterator &operator++();
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return block==other.block && bits==other.bits;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return !(*this==other);
+    }
+
+  protected:
+    friend class sparse_bitsett;
+
+    const_iterator(
+      blockst::const_iterator _block,
+      blockst::const_iterator _end):
+      block(_block),
+      end(_end),
+      bits(_block==_end?0:_block->bits)
+    {
+    }
+
+    blockst::const_iterator block, end;
+    // the bits of the block that have not been visited
+    wordt bits;
+  };
+
+  const_iterator begin() const
+  {
+    return const_iterator(blocks.begin(), blocks.end());
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(blocks.end(), blocks.end());
+  }
+};
+
+#endif // CPROVER_UTIL_SPARSE_BITSET_H
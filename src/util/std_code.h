@@ -1474,7 +1474,7 @@ public:
     }
   };
 
-  typedef std::vector<exception_list_entryt> exception_listt;
+  typedef irep_sub_vectort<exception_list_entryt> exception_listt;
 
   code_push_catcht(
     const irep_idt &tag,
@@ -237,7 +237,7 @@ public:
     }
   };
 
-  typedef std::vector<componentt> componentst;
+  typedef irep_sub_vectort<componentt> componentst;
 
   const componentst &components() const
   {
@@ -372,7 +372,7 @@ public:
     }
   };
 
-  typedef std::vector<baset> basest;
+  typedef irep_sub_vectort<baset> basest;
 
   const basest &bases() const
   {
@@ -671,7 +671,7 @@ public:
     }
   };
 
-  typedef std::vector<c_enum_membert> memberst;
+  typedef irep_sub_vectort<c_enum_membert> memberst;
 
   const memberst &members() const
   {
@@ -846,7 +846,7 @@ public:
     add(ID_parameters).remove(ID_ellipsis);
   }
 
-  typedef std::vector<parametert> parameterst;
+  typedef irep_sub_vectort<parametert> parameterst;
 
   const typet &return_type() const
   {
@@ -13,7 +13,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <cstring>
 
-string_ptrt::string_ptrt(const char *_s):s(_s), len(strlen(_s))
+string_ptrt::string_ptrt(const char *_s):
+  s(_s), len(strlen(_s)), hash(hash_string(_s))
 {
 }
 
@@ -25,52 +26,129 @@ bool string_ptrt::operator==(const string_ptrt &other) const
   return len==0 || memcmp(s, other.s, len)==0;
 }
 
-string_containert::~string_containert()
+/// Spread the bits of hash_string, whose low bits depend mostly on the
+/// last character
+static std::size_t mix(std::size_t h)
 {
+  h^=h>>16;
+  h*=0x45d9f3b;
+  h^=h>>16;
+  return h;
 }
 
-unsigned string_containert::get(const char *s)
+string_containert::tablet::tablet(std::size_t size):
+  mask(size-1),
+  slots(new std::atomic<const entryt *>[size])
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+  for(std::size_t i=0; i<size; i++)
+    slots[i].store(nullptr, std::memory_order_relaxed);
+}
 
-  if(it!=hash_table.end())
-    return it->second;
+const string_containert::entryt *string_containert::tablet::find(
+  std::size_t index,
+  const string_ptrt &string_ptr) const
+{
+  for(;; index++)
+  {
+    const entryt *entry=slots[index&mask].load(std::memory_order_acquire);
+
+    if(entry==nullptr)
+      return nullptr;
+
+    if(entry->hash==string_ptr.hash &&
+       entry->s.size()==string_ptr.len &&
+       memcmp(entry->s.data(), string_ptr.s, string_ptr.len)==0)
+      return entry;
+  }
+}
 
-  size_t r=hash_table.size();
+void string_containert::tablet::insert(std::size_t index, const entryt &entry)
+{
+  while(slots[index&mask].load(std::memory_order_relaxed)!=nullptr)
+    index++;
 
-  // these are stable
-  string_list.push_back(std::string(s));
-  string_ptrt result(string_list.back());
+  slots[index&mask].store(&entry, std::memory_order_release);
+}
 
-  hash_table[result]=r;
+string_containert::shardt::shardt()
+{
+  tables.emplace_back(64);
+  table.store(&tables.back());
+}
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+string_containert::~string_containert()
+{
+  for(auto &segment : segments)
+    delete[] segment.load();
+}
 
-  return r;
+const std::string *&string_containert::string_slot(std::size_t no)
+{
+  std::size_t segment=no<first_segment_size?0:segment_of(no);
+  const std::string **strings=segments[segment].load(std::memory_order_acquire);
+
+  if(strings==nullptr)
+  {
+    // several threads may race to allocate the segment
+    const std::string **new_strings=
+      new const std::string *[segment_size(segment)];
+
+    if(segments[segment].compare_exchange_strong(
+         strings, new_strings, std::memory_order_acq_rel))
+      strings=new_strings;
+    else
+      delete[] new_strings;
+  }
+
+  return strings[no-segment_start(segment)];
 }
 
-unsigned string_containert::get(const std::string &s)
+unsigned string_containert::get(const string_ptrt &string_ptr)
 {
-  string_ptrt string_ptr(s);
+  std::size_t h=mix(string_ptr.hash);
+  shardt &shard=shards[h&(shard_count-1)];
+  std::size_t index=h>>shard_bits;
+
+  const entryt *entry=
+    shard.table.load(std::memory_order_acquire)->find(index, string_ptr);
+
+  if(entry!=nullptr)
+    return entry->no;
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  // another thread may have added the string in the meantime
+  tablet *table=shard.table.load(std::memory_order_relaxed);
+  entry=table->find(index, string_ptr);
+
+  if(entry!=nullptr)
+    return entry->no;
+
+  // keep the table at most half full
+  if((shard.entries.size()+1)*2>table->mask+1)
+  {
+    shard.tables.emplace_back((table->mask+1)*2);
+    tablet &new_table=shard.tables.back();
 
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+    for(const auto &e : shard.entries)
+      new_table.insert(mix(e.hash)>>shard_bits, e);
 
-  if(it!=hash_table.end())
-    return it->second;
+    shard.table.store(&new_table, std::memory_order_release);
+    table=&new_table;
+  }
 
-  size_t r=hash_table.size();
+  // Strings from different shards may be numbered in any order, but all
+  // numbers below next_no are taken.
+  unsigned r=next_no++;
 
-  // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
+  shard.entries.emplace_back(string_ptr, r);
+  const entryt &new_entry=shard.entries.back();
 
-  hash_table[result]=r;
+  // Threads that look up r are ordered after this store by whatever passed
+  // r to them.
+  string_slot(r)=&new_entry.s;
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  table->insert(index, new_entry);
 
   return r;
 }
@@ -12,7 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_STRING_CONTAINER_H
 #define CPROVER_UTIL_STRING_CONTAINER_H
 
+#include <atomic>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -22,6 +26,7 @@ struct string_ptrt
 {
   const char *s;
   size_t len;
+  size_t hash;
 
   const char *c_str() const
   {
@@ -30,7 +35,8 @@ struct string_ptrt
 
   explicit string_ptrt(const char *_s);
 
-  explicit string_ptrt(const std::string &_s):s(_s.c_str()), len(_s.size())
+  explicit string_ptrt(const std::string &_s):
+    s(_s.c_str()), len(_s.size()), hash(hash_string(_s))
   {
   }
 
@@ -41,20 +47,27 @@ struct string_ptrt
 class string_ptr_hash
 {
 public:
-  size_t operator()(const string_ptrt s) const { return hash_string(s.s); }
+  size_t operator()(const string_ptrt s) const { return s.hash; }
 };
 
+/// Interns strings, assigning consecutive numbers in the order in which the
+/// strings are first seen, starting with 0 for the empty string.
+///
+/// Strings may be added and looked up concurrently from several threads.
+/// Looking up a string that is already there and turning a number back into
+/// a string take no lock. Adding a string locks only one of several shards,
+/// chosen by the hash of the string.
 class string_containert
 {
 public:
   unsigned operator[](const char *s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   unsigned operator[](const std::string &s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   // constructor and destructor
@@ -64,29 +77,102 @@ public:
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    return string_vector[no]->c_str();
+    return get_string(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    return *string_vector[no];
+    if(no<first_segment_size)
+      return *segments[0].load(std::memory_order_acquire)[no];
+
+    std::size_t segment=segment_of(no);
+    return *segments[segment].load(std::memory_order_acquire)
+      [no-segment_start(segment)];
+  }
+
+  /// \return the number of strings
+  std::size_t size() const
+  {
+    return next_no.load();
   }
 
 protected:
-  // the 'unsigned' ought to be size_t
-  typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
-    hash_tablet;
-  hash_tablet hash_table;
+  struct entryt
+  {
+    entryt(const string_ptrt &string_ptr, unsigned _no):
+      s(string_ptr.s, string_ptr.len), hash(string_ptr.hash), no(_no)
+    {
+    }
+
+    std::string s;
+    std::size_t hash;
+    unsigned no;
+  };
+
+  /// A hash table with open addressing. Slots are only ever filled, and a
+  /// table that gets too full is replaced by a larger one, so that readers
+  /// never need to lock.
+  struct tablet
+  {
+    explicit tablet(std::size_t size);
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<const entryt *>[]> slots;
+
+    const entryt *find(std::size_t index, const string_ptrt &string_ptr) const;
+    void insert(std::size_t index, const entryt &entry);
+  };
+
+  struct shardt
+  {
+    shardt();
+
+    std::mutex mutex;
+    std::atomic<tablet *> table;
+
+    // these are stable
+    std::list<entryt> entries;
 
-  unsigned get(const char *s);
-  unsigned get(const std::string &s);
+    // replaced tables may still be in use by readers
+    std::list<tablet> tables;
+  };
 
-  typedef std::list<std::string> string_listt;
-  string_listt string_list;
+  static const std::size_t shard_bits=4;
+  static const std::size_t shard_count=1u<<shard_bits;
+  shardt shards[shard_count];
+
+  unsigned get(const string_ptrt &string_ptr);
+
+  // The strings by number, in segments that never move: segment 0 holds
+  // the first first_segment_size strings, and each further segment is as
+  // large as all previous ones together.
+  static const std::size_t first_segment_bits=12;
+  static const std::size_t first_segment_size=1u<<first_segment_bits;
+  static const std::size_t segment_count=33-first_segment_bits;
+
+  std::atomic<const std::string **> segments[segment_count];
+  std::atomic<unsigned> next_no;
+
+  static std::size_t segment_of(std::size_t no)
+  {
+    std::size_t segment=1;
+    for(no>>=first_segment_bits+1; no!=0; no>>=1)
+      segment++;
+    return segment;
+  }
+
+  static std::size_t segment_start(std::size_t segment)
+  {
+    return segment==0?0:first_segment_size<<(segment-1);
+  }
+
+  static std::size_t segment_size(std::size_t segment)
+  {
+    return segment==0?first_segment_size:first_segment_size<<(segment-1);
+  }
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  const std::string *&string_slot(std::size_t no);
 };
 
 string_containert &get_string_container();
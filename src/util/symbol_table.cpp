@@ -83,6 +83,8 @@ bool symbol_tablet::move(symbolt &symbol, symbolt *&new_symbol)
 /// \param entry: an iterator pointing at the symbol to remove
 void symbol_tablet::erase(const symbolst::const_iterator &entry)
 {
+  revision++;
+
   const symbolt &symbol=entry->second;
 
   symbol_base_mapt::const_iterator
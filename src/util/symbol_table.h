@@ -37,7 +37,8 @@ public:
     : symbol_table_baset(
         internal_symbols,
         internal_symbol_base_map,
-        internal_symbol_module_map)
+        internal_symbol_module_map),
+      revision(0)
   {
   }
 
@@ -48,7 +49,8 @@ public:
         internal_symbol_module_map),
       internal_symbols(other.internal_symbols),
       internal_symbol_base_map(other.internal_symbol_base_map),
-      internal_symbol_module_map(other.internal_symbol_module_map)
+      internal_symbol_module_map(other.internal_symbol_module_map),
+      revision(0)
   {
   }
 
@@ -65,8 +67,10 @@ public:
         internal_symbol_module_map),
       internal_symbols(std::move(other.internal_symbols)),
       internal_symbol_base_map(std::move(other.internal_symbol_base_map)),
-      internal_symbol_module_map(std::move(other.internal_symbol_module_map))
+      internal_symbol_module_map(std::move(other.internal_symbol_module_map)),
+      revision(0)
   {
+    other.revision++;
   }
 
   symbol_tablet &operator=(symbol_tablet &&other)
@@ -74,6 +78,8 @@ public:
     internal_symbols = std::move(other.internal_symbols);
     internal_symbol_base_map = std::move(other.internal_symbol_base_map);
     internal_symbol_module_map = std::move(other.internal_symbol_module_map);
+    revision++;
+    other.revision++;
     return *this;
   }
 
@@ -82,6 +88,17 @@ public:
     internal_symbols.swap(other.internal_symbols);
     internal_symbol_base_map.swap(other.internal_symbol_base_map);
     internal_symbol_module_map.swap(other.internal_symbol_module_map);
+    revision++;
+    other.revision++;
+  }
+
+  /// \return a number that grows whenever symbols in the table may have
+  ///   been changed via get_writeable(), or have been removed. Adding a
+  ///   symbol does not count, nor does changing a symbol via the reference
+  ///   that insert() or move() return.
+  std::size_t get_revision() const
+  {
+    return revision;
   }
 
 public:
@@ -95,6 +112,7 @@ public:
   /// \return a pointer to the found symbol if it exists, nullptr otherwise.
   virtual symbolt *get_writeable(const irep_idt &name) override
   {
+    revision++;
     symbolst::iterator it = internal_symbols.find(name);
     return it != internal_symbols.end() ? &it->second : nullptr;
   }
@@ -105,10 +123,14 @@ public:
   virtual void erase(const symbolst::const_iterator &entry) override;
   virtual void clear() override
   {
+    revision++;
     internal_symbols.clear();
     internal_symbol_base_map.clear();
     internal_symbol_module_map.clear();
   }
+
+private:
+  std::size_t revision;
 };
 
 #endif // CPROVER_UTIL_SYMBOL_TABLE_H
@@ -68,7 +68,7 @@ public:
   }
 };
 
-std::ostream &operator<<(std::ostream &out, const timert &timer)
+inline std::ostream &operator<<(std::ostream &out, const timert &timer)
 {
   return out << timer.total_time();
 }
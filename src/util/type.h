@@ -53,7 +53,7 @@ public:
   { return (typet &)add(ID_subtype); }
   #endif
 
-  typedef std::vector<typet> subtypest;
+  typedef irep_sub_vectort<typet> subtypest;
 
   subtypest &subtypes()
   #ifdef SUBTYPES_IN_GETSUB
@@ -144,7 +144,7 @@ public:
   explicit type_with_subtypest(const irep_idt &_id):typet(_id) { }
 
   #if 0
-  typedef std::vector<typet> subtypest;
+  typedef irep_sub_vectort<typet> subtypest;
 
   subtypest &subtypes()
   { return (subtypest &)add(ID_subtypes).get_sub(); }
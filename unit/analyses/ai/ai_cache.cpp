@@ -0,0 +1,273 @@
+/*******************************************************************\
+
+ Module: Unit tests for reusing the summaries of summary_ait in ai_cachet
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for reusing the summaries of summary_ait in ai_cachet
+
+#include <testing-utils/catch.hpp>
+
+#include <sstream>
+
+#include <analyses/ai_cache.h>
+#include <analyses/interval_domain.h>
+#include <analyses/summary_ai.h>
+
+#include <util/arith_tools.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+/// The entry point calls f and then g, where f sets x to 5, and g sets y
+/// to `value`
+static void make_program(goto_functionst &goto_functions, unsigned value)
+{
+  const unsignedbv_typet u32(32);
+  const symbol_exprt x("x", u32), y("y", u32);
+
+  goto_functions.clear();
+
+  for(const char *name : { "f", "g" })
+  {
+    goto_functionst::goto_functiont &function=
+      goto_functions.function_map[name];
+    function.type=code_typet();
+    goto_programt &body=function.body;
+
+    goto_programt::targett assignment=body.add_instruction(ASSIGN);
+    if(name==std::string("f"))
+      assignment->code=code_assignt(x, from_integer(5, u32));
+    else
+      assignment->code=code_assignt(y, from_integer(value, u32));
+
+    body.add_instruction(END_FUNCTION);
+  }
+
+  goto_functionst::goto_functiont &entry=
+    goto_functions.function_map[goto_functionst::entry_point()];
+  entry.type=code_typet();
+
+  for(const char *name : { "f", "g" })
+  {
+    code_function_callt call;
+    call.function()=symbol_exprt(name, code_typet());
+    entry.body.add_instruction(FUNCTION_CALL)->code=call;
+  }
+
+  entry.body.add_instruction(END_FUNCTION);
+  goto_functions.update();
+}
+
+/// \return the states of all locations, as written for the cache
+static std::string states(
+  const summary_ait<interval_domaint> &analysis,
+  const goto_functionst &goto_functions)
+{
+  std::ostringstream out;
+
+  forall_goto_functions(f_it, goto_functions)
+    forall_goto_program_instructions(i_it, f_it->second.body)
+      REQUIRE_FALSE(analysis[i_it].write(out));
+
+  return out.str();
+}
+
+SCENARIO(
+  "ai_cachet reuses the summaries of unchanged functions",
+  "[core][analyses][ai][ai_cache]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  GIVEN("The summaries of a program in a cache")
+  {
+    goto_functionst goto_functions;
+    make_program(goto_functions, 6);
+
+    ai_cachet cache("intervals");
+    cache.set_functions(goto_functions);
+
+    summary_ait<interval_domaint> analysis;
+    REQUIRE_FALSE(analysis.set_cache(cache));
+    analysis(goto_functions, ns);
+
+    REQUIRE(cache.hits==0);
+    REQUIRE(cache.misses==3);
+
+    std::stringstream file;
+    cache.write(file);
+
+    const std::string expected=states(analysis, goto_functions);
+
+    WHEN("The same program is analysed again")
+    {
+      ai_cachet cache2("intervals");
+      cache2.set_functions(goto_functions);
+      REQUIRE_FALSE(cache2.read(file));
+
+      summary_ait<interval_domaint> analysis2;
+      analysis2.set_cache(cache2);
+      analysis2(goto_functions, ns);
+
+      THEN("The summary of the entry point is reused, with its callees")
+      {
+        REQUIRE(cache2.hits==1);
+        REQUIRE(cache2.misses==0);
+        REQUIRE(analysis2.computed==0);
+        REQUIRE(states(analysis2, goto_functions)==expected);
+      }
+    }
+
+    WHEN("One function changes")
+    {
+      goto_functionst changed;
+      make_program(changed, 7);
+
+      ai_cachet cache2("intervals");
+      cache2.set_functions(changed);
+      REQUIRE_FALSE(cache2.read(file));
+
+      summary_ait<interval_domaint> analysis2;
+      analysis2.set_cache(cache2);
+      analysis2(changed, ns);
+
+      summary_ait<interval_domaint> fresh;
+      fresh(changed, ns);
+
+      THEN("Only the unchanged callee is reused")
+      {
+        REQUIRE(cache2.hits==1);
+        REQUIRE(cache2.misses==2);
+        REQUIRE(analysis2.computed==2);
+        REQUIRE(states(analysis2, changed)==states(fresh, changed));
+        REQUIRE(states(fresh, changed)!=expected);
+      }
+    }
+
+    WHEN("The cache is for another domain")
+    {
+      ai_cachet cache2("constants");
+      cache2.set_functions(goto_functions);
+
+      THEN("It is not read")
+      {
+        REQUIRE(cache2.read(file));
+      }
+    }
+  }
+}
+
+/// The entry point calls f and g in the given order. f calls h with x set
+/// to 1 and then to 2, g calls h with x set to each of `values`, and h
+/// sets y to x.
+static void make_calls(
+  goto_functionst &goto_functions,
+  bool f_first,
+  const std::vector<unsigned> &values)
+{
+  const unsignedbv_typet u32(32);
+  const symbol_exprt x("x", u32), y("y", u32);
+
+  goto_functions.clear();
+
+  code_function_callt call_h;
+  call_h.function()=symbol_exprt("h", code_typet());
+
+  for(const char *name : { "f", "g" })
+  {
+    goto_functionst::goto_functiont &function=
+      goto_functions.function_map[name];
+    function.type=code_typet();
+
+    const std::vector<unsigned> arguments=
+      name==std::string("f")?std::vector<unsigned>{ 1, 2 }:values;
+
+    for(const auto &value : arguments)
+    {
+      function.body.add_instruction(ASSIGN)->code=
+        code_assignt(x, from_integer(value, u32));
+      function.body.add_instruction(FUNCTION_CALL)->code=call_h;
+    }
+
+    function.body.add_instruction(END_FUNCTION);
+  }
+
+  goto_functionst::goto_functiont &h=goto_functions.function_map["h"];
+  h.type=code_typet();
+  h.body.add_instruction(ASSIGN)->code=code_assignt(y, x);
+  h.body.add_instruction(END_FUNCTION);
+
+  goto_functionst::goto_functiont &entry=
+    goto_functions.function_map[goto_functionst::entry_point()];
+  entry.type=code_typet();
+
+  for(const char *name : { "f", "g" })
+  {
+    code_function_callt call;
+    call.function()=symbol_exprt(f_first?name:(name[0]=='f'?"g":"f"),
+                                 code_typet());
+    entry.body.add_instruction(FUNCTION_CALL)->code=call;
+  }
+
+  entry.body.add_instruction(END_FUNCTION);
+  goto_functions.update();
+}
+
+SCENARIO(
+  "ai_cachet does not change the states when summaries are joined",
+  "[core][analyses][ai][ai_cache]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const unsignedbv_typet u32(32);
+  symbolt x;
+  x.name="x";
+  x.type=u32;
+  symbol_table.add(x);
+
+  for(bool f_first : { true, false })
+  {
+    GIVEN("The summaries of f and h, with two summaries per function")
+    {
+      goto_functionst goto_functions;
+      make_calls(goto_functions, f_first, {});
+
+      ai_cachet cache("intervals");
+      cache.set_functions(goto_functions);
+
+      summary_ait<interval_domaint> analysis(2);
+      analysis.set_cache(cache);
+      analysis(goto_functions, ns);
+
+      std::stringstream file;
+      cache.write(file);
+
+      WHEN("g calls h with a third value")
+      {
+        goto_functionst changed;
+        make_calls(changed, f_first, { 3 });
+
+        ai_cachet cache2("intervals");
+        cache2.set_functions(changed);
+        REQUIRE_FALSE(cache2.read(file));
+
+        summary_ait<interval_domaint> analysis2(2);
+        analysis2.set_cache(cache2);
+        analysis2(changed, ns);
+
+        summary_ait<interval_domaint> fresh(2);
+        fresh(changed, ns);
+
+        THEN("The states are those of an analysis without the cache")
+        {
+          REQUIRE(cache2.hits>0);
+          REQUIRE(states(analysis2, changed)==states(fresh, changed));
+        }
+      }
+    }
+  }
+}
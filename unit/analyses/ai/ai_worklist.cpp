@@ -0,0 +1,132 @@
+/*******************************************************************\
+
+ Module: Unit tests for the order in which ai_baset visits locations
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for the order in which ai_baset visits locations
+
+#include <testing-utils/catch.hpp>
+
+#include <set>
+
+#include <analyses/ai.h>
+
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+/// Records the locations that the paths into a location come from, and
+/// counts how often each location is visited
+class predecessors_domaint:public ai_domain_baset
+{
+public:
+  predecessors_domaint():reachable(false)
+  {
+  }
+
+  void transform(
+    locationt from,
+    locationt,
+    ai_baset &,
+    const namespacet &,
+    ai_domain_baset::edge_typet) override
+  {
+    visits[from->location_number]++;
+    predecessors={ from->location_number };
+  }
+
+  void make_bottom() override
+  {
+    reachable=false;
+    predecessors.clear();
+  }
+
+  void make_top() override
+  {
+    UNREACHABLE;
+  }
+
+  void make_entry() override
+  {
+    reachable=true;
+  }
+
+  bool is_bottom() const override
+  {
+    return !reachable;
+  }
+
+  bool is_top() const override
+  {
+    return false;
+  }
+
+  bool merge(const predecessors_domaint &b, locationt, locationt)
+  {
+    bool changed=!reachable;
+    reachable=true;
+
+    for(const auto &p : b.predecessors)
+      changed|=predecessors.insert(p).second;
+
+    return changed;
+  }
+
+  bool reachable;
+  std::set<unsigned> predecessors;
+
+  static std::map<unsigned, unsigned> visits;
+};
+
+std::map<unsigned, unsigned> predecessors_domaint::visits;
+
+SCENARIO(
+  "ai_baset visits locations in reverse postorder",
+  "[core][analyses][ai][ai_worklist]")
+{
+  GIVEN("A program where a join follows a jump forward and back")
+  {
+    // 0: IF c THEN GOTO 3
+    // 1: SKIP
+    // 2: GOTO 5
+    // 3: SKIP
+    // 4: GOTO 1
+    // 5: END_FUNCTION
+    goto_functionst::goto_functiont function;
+    goto_programt &body=function.body;
+
+    goto_programt::targett i0=body.add_instruction(GOTO);
+    goto_programt::targett i1=body.add_instruction(SKIP);
+    goto_programt::targett i2=body.add_instruction(GOTO);
+    goto_programt::targett i3=body.add_instruction(SKIP);
+    goto_programt::targett i4=body.add_instruction(GOTO);
+    goto_programt::targett i5=body.add_instruction(END_FUNCTION);
+
+    i0->guard=symbol_exprt("c", bool_typet());
+    i0->targets.push_back(i3);
+    i2->guard=true_exprt();
+    i2->targets.push_back(i5);
+    i4->guard=true_exprt();
+    i4->targets.push_back(i1);
+    body.update();
+
+    symbol_tablet symbol_table;
+    namespacet ns(symbol_table);
+
+    predecessors_domaint::visits.clear();
+    ait<predecessors_domaint> analysis;
+    analysis(function, ns);
+
+    THEN("Both paths into the join are merged before it is visited")
+    {
+      REQUIRE(
+        analysis[i1].predecessors==
+        std::set<unsigned>({ i0->location_number, i4->location_number }));
+      REQUIRE(predecessors_domaint::visits[i1->location_number]==1);
+      REQUIRE(predecessors_domaint::visits[i2->location_number]==1);
+    }
+  }
+}
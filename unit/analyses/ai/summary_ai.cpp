@@ -0,0 +1,207 @@
+/*******************************************************************\
+
+ Module: Unit tests for summary_ait
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for summary_ait
+
+#include <testing-utils/catch.hpp>
+
+#include <analyses/interval_domain.h>
+#include <analyses/summary_ai.h>
+
+#include <util/arith_tools.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+
+static const unsignedbv_typet u32(32);
+
+static void add_assignment(
+  goto_programt &body,
+  const exprt &lhs,
+  const exprt &rhs)
+{
+  body.add_instruction(ASSIGN)->code=code_assignt(lhs, rhs);
+}
+
+static void add_assignment(goto_programt &body, const exprt &lhs, int rhs)
+{
+  add_assignment(body, lhs, from_integer(rhs, u32));
+}
+
+static void add_call(goto_programt &body, const irep_idt &function)
+{
+  code_function_callt call;
+  call.function()=symbol_exprt(function, code_typet());
+  body.add_instruction(FUNCTION_CALL)->code=call;
+}
+
+static goto_programt &add_function(
+  goto_functionst &goto_functions,
+  const irep_idt &name)
+{
+  goto_functionst::goto_functiont &function=
+    goto_functions.function_map[name];
+  function.type=code_typet();
+  return function.body;
+}
+
+/// \return the expression interval_domaint gives for `lower<=s<=upper`
+static exprt interval(const symbol_exprt &s, int lower, int upper)
+{
+  return and_exprt(
+    binary_relation_exprt(s, ID_le, from_integer(upper, u32)),
+    binary_relation_exprt(from_integer(lower, u32), ID_le, s));
+}
+
+SCENARIO(
+  "summary_ait analyses a function once for each entry state",
+  "[core][analyses][ai][summary_ai]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const symbol_exprt x("x", u32), y("y", u32);
+  const symbol_exprt a("a", u32), b("b", u32);
+
+  GIVEN("A function that is called in two different states")
+  {
+    // main: x=1; f(); a=y; x=2; f(); b=y;
+    // f: y=x;
+    goto_functionst goto_functions;
+
+    goto_programt &f=add_function(goto_functions, "f");
+    add_assignment(f, y, x);
+    f.add_instruction(END_FUNCTION);
+
+    goto_programt &main=
+      add_function(goto_functions, goto_functionst::entry_point());
+    add_assignment(main, x, 1);
+    add_call(main, "f");
+    add_assignment(main, a, y);
+    add_assignment(main, x, 2);
+    add_call(main, "f");
+    add_assignment(main, b, y);
+    goto_programt::const_targett end=main.add_instruction(END_FUNCTION);
+
+    goto_functions.update();
+
+    WHEN("The calls are summarized")
+    {
+      summary_ait<interval_domaint> analysis;
+      analysis(goto_functions, ns);
+
+      THEN("Each call gets the result for its own state")
+      {
+        REQUIRE(analysis.computed==3);
+        REQUIRE(analysis[end].make_expression(a)==interval(a, 1, 1));
+        REQUIRE(analysis[end].make_expression(b)==interval(b, 2, 2));
+      }
+
+      THEN("The state in the function is the join over both calls")
+      {
+        REQUIRE(
+          analysis[std::next(f.instructions.begin())].make_expression(y)==
+          interval(y, 1, 2));
+      }
+    }
+
+    WHEN("The calls are not summarized")
+    {
+      ait<interval_domaint> analysis;
+      analysis(goto_functions, ns);
+
+      THEN("The states of the calls are joined")
+      {
+        REQUIRE(analysis[end].make_expression(b)==interval(b, 1, 2));
+      }
+    }
+
+    WHEN("There can be one summary only")
+    {
+      summary_ait<interval_domaint> analysis(1);
+      analysis(goto_functions, ns);
+
+      THEN("The states of the calls are joined")
+      {
+        REQUIRE(analysis[end].make_expression(b)==interval(b, 1, 2));
+      }
+    }
+  }
+
+  GIVEN("A function that is called twice in the same state")
+  {
+    // main: if(c) goto L; f(); goto E; L: f(); E:
+    // f: y=5;
+    goto_functionst goto_functions;
+
+    goto_programt &f=add_function(goto_functions, "f");
+    add_assignment(f, y, 5);
+    f.add_instruction(END_FUNCTION);
+
+    goto_programt &main=
+      add_function(goto_functions, goto_functionst::entry_point());
+    goto_programt::targett branch=main.add_instruction(GOTO);
+    add_call(main, "f");
+    goto_programt::targett skip=main.add_instruction(GOTO);
+    goto_programt::targett label=main.add_instruction(SKIP);
+    add_call(main, "f");
+    goto_programt::targett end=main.add_instruction(END_FUNCTION);
+
+    branch->guard=symbol_exprt("c", bool_typet());
+    branch->targets.push_back(label);
+    skip->guard=true_exprt();
+    skip->targets.push_back(end);
+
+    goto_functions.update();
+
+    summary_ait<interval_domaint> analysis;
+    analysis(goto_functions, ns);
+
+    THEN("The summary is applied to the second call")
+    {
+      REQUIRE(analysis.computed==2);
+      REQUIRE(analysis.applied==1);
+      REQUIRE(analysis[end].make_expression(y)==interval(y, 5, 5));
+    }
+  }
+
+  GIVEN("A recursive function")
+  {
+    // main: x=3; f();
+    // f: if(c) goto L; f(); L: y=x; x=7;
+    goto_functionst goto_functions;
+
+    goto_programt &f=add_function(goto_functions, "f");
+    goto_programt::targett branch=f.add_instruction(GOTO);
+    add_call(f, "f");
+    goto_programt::targett label=f.add_instruction(SKIP);
+    add_assignment(f, y, x);
+    add_assignment(f, x, 7);
+    f.add_instruction(END_FUNCTION);
+
+    branch->guard=symbol_exprt("c", bool_typet());
+    branch->targets.push_back(label);
+
+    goto_programt &main=
+      add_function(goto_functions, goto_functionst::entry_point());
+    add_assignment(main, x, 3);
+    add_call(main, "f");
+    goto_programt::targett end=main.add_instruction(END_FUNCTION);
+
+    goto_functions.update();
+
+    summary_ait<interval_domaint> analysis;
+    analysis(goto_functions, ns);
+
+    THEN("The summary includes the returns of the recursive calls")
+    {
+      REQUIRE(analysis[end].make_expression(x)==interval(x, 7, 7));
+      REQUIRE(analysis[end].make_expression(y)==interval(y, 3, 7));
+    }
+  }
+}
@@ -31,13 +31,13 @@ static symbolt create_void_function_symbol(
   return function;
 }
 
-const std::set<goto_programt::const_targett>&
+const sparse_bitsett &
     dependence_graph_test_get_control_deps(const dep_graph_domaint &domain)
 {
   return domain.control_deps;
 }
 
-const std::set<goto_programt::const_targett>&
+const sparse_bitsett &
     dependence_graph_test_get_data_deps(const dep_graph_domaint &domain)
 {
   return domain.data_deps;
@@ -134,9 +134,9 @@ SCENARIO("dependence_graph", "[core][analyses][dependence_graph]")
         {
           const dep_nodet &node = dep_graph[node_idx];
           const dep_graph_domaint &node_domain = dep_graph[node.PC];
-          const std::set<goto_programt::const_targett> &control_deps =
+          const sparse_bitsett &control_deps =
             dependence_graph_test_get_control_deps(node_domain);
-          const std::set<goto_programt::const_targett> &data_deps =
+          const sparse_bitsett &data_deps =
             dependence_graph_test_get_data_deps(node_domain);
 
           std::size_t domain_dep_count =
@@ -147,9 +147,9 @@ SCENARIO("dependence_graph", "[core][analyses][dependence_graph]")
           for(const auto &dep_edge : node.in)
           {
             if(dep_edge.second.get() == dep_edget::kindt::CTRL)
-              REQUIRE(control_deps.count(dep_graph[dep_edge.first].PC));
+              REQUIRE(control_deps.contains(dep_edge.first));
             else if(dep_edge.second.get() == dep_edget::kindt::DATA)
-              REQUIRE(data_deps.count(dep_graph[dep_edge.first].PC));
+              REQUIRE(data_deps.contains(dep_edge.first));
           }
         }
       }
@@ -0,0 +1,240 @@
+/*******************************************************************\
+
+ Module: Unit tests for reading and writing goto binaries
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <util/c_types.h>
+#include <util/cmdline.h>
+#include <util/message.h>
+#include <util/std_code.h>
+#include <util/symbol_table.h>
+#include <util/tempfile.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/lazy_goto_model.h>
+#include <goto-programs/mapped_goto_binary.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+/// Builds a model with a global variable and a function that increments
+/// it in a loop
+static void make_model(goto_modelt &goto_model)
+{
+  const signedbv_typet int_type(32);
+
+  symbolt x;
+  x.name="x";
+  x.base_name="x";
+  x.type=int_type;
+  x.is_static_lifetime=true;
+  x.is_lvalue=true;
+  goto_model.symbol_table.add(x);
+
+  symbolt f;
+  f.name="f";
+  f.base_name="f";
+  f.type=code_typet();
+  goto_model.symbol_table.add(f);
+
+  goto_functionst::goto_functiont &function=
+    goto_model.goto_functions.function_map["f"];
+  function.type=to_code_type(f.type);
+
+  goto_programt &body=function.body;
+  goto_programt::targett loop=body.add_instruction(ASSIGN);
+  loop->code=code_assignt(
+    x.symbol_expr(), plus_exprt(x.symbol_expr(), x.symbol_expr()));
+  loop->function="f";
+  goto_programt::targett back=body.add_instruction(GOTO);
+  back->targets.push_back(loop);
+  back->guard=true_exprt();
+  back->function="f";
+  body.add_instruction(END_FUNCTION)->function="f";
+  body.update();
+}
+
+/// Adds a function with the given name whose body calls the given function,
+/// if any
+static void add_caller(
+  goto_modelt &goto_model,
+  const irep_idt &name,
+  const irep_idt &callee)
+{
+  symbolt symbol;
+  symbol.name=name;
+  symbol.base_name=name;
+  symbol.type=code_typet();
+  goto_model.symbol_table.add(symbol);
+
+  goto_functionst::goto_functiont &function=
+    goto_model.goto_functions.function_map[name];
+  function.type=to_code_type(symbol.type);
+
+  if(!callee.empty())
+  {
+    code_function_callt call;
+    call.function()=symbol_exprt(callee, code_typet());
+    goto_programt::targett instruction=
+      function.body.add_instruction(FUNCTION_CALL);
+    instruction->code=call;
+    instruction->function=name;
+  }
+
+  function.body.add_instruction(END_FUNCTION)->function=name;
+  function.body.update();
+}
+
+static void require_same_body(
+  const goto_programt &expected,
+  const goto_programt &actual)
+{
+  REQUIRE(actual.instructions.size()==expected.instructions.size());
+
+  goto_programt::const_targett it=actual.instructions.begin();
+  for(const auto &instruction : expected.instructions)
+  {
+    REQUIRE(it->type==instruction.type);
+    REQUIRE(it->code==instruction.code);
+    REQUIRE(it->guard==instruction.guard);
+    REQUIRE(it->targets.size()==instruction.targets.size());
+    it++;
+  }
+
+  // the jump goes back to the first instruction
+  REQUIRE(
+    std::next(actual.instructions.begin())->get_target()==
+    actual.instructions.begin());
+}
+
+static void require_round_trip(const goto_modelt &goto_model, int version)
+{
+  null_message_handlert message_handler;
+  std::stringstream binary;
+  REQUIRE(!write_goto_binary(binary, goto_model, version));
+
+  goto_modelt read_model;
+  REQUIRE(
+    !read_bin_goto_object(
+      binary,
+      "",
+      read_model.symbol_table,
+      read_model.goto_functions,
+      message_handler));
+
+  REQUIRE(read_model.symbol_table.symbols.size()==2);
+  REQUIRE(read_model.symbol_table.lookup_ref("x").is_static_lifetime);
+  require_same_body(
+    goto_model.goto_functions.function_map.at("f").body,
+    read_model.goto_functions.function_map.at("f").body);
+}
+
+SCENARIO(
+  "Goto binaries can be written and read back",
+  "[core][goto-programs][goto_binary]")
+{
+  goto_modelt goto_model;
+  make_model(goto_model);
+  null_message_handlert message_handler;
+
+  GIVEN("A goto binary of version 3")
+  {
+    THEN("reading it yields the same symbols and functions")
+    {
+      require_round_trip(goto_model, 3);
+    }
+  }
+
+  GIVEN("A goto binary of version 4")
+  {
+    THEN("reading it yields the same symbols and functions")
+    {
+      require_round_trip(goto_model, 4);
+    }
+  }
+
+  GIVEN("A goto binary with an index")
+  {
+    temporary_filet file("goto_binary", ".gb");
+
+    {
+      std::ofstream out(file(), std::ios::binary);
+      REQUIRE(!write_goto_binary(out, goto_model, 4));
+    }
+
+    REQUIRE(mapped_goto_binaryt::has_index(file()));
+
+    mapped_goto_binaryt binary;
+    REQUIRE(!binary.open(file(), message_handler));
+
+    THEN("symbols and function bodies can be read individually")
+    {
+      symbolt x;
+      REQUIRE(!binary.read_symbol("x", x));
+      REQUIRE(x.type==signedbv_typet(32));
+      REQUIRE(binary.read_symbol("y", x));
+
+      REQUIRE(binary.has_function_body("f"));
+      goto_functionst::goto_functiont f;
+      REQUIRE(!binary.read_function_body("f", f));
+      require_same_body(
+        goto_model.goto_functions.function_map.at("f").body, f.body);
+
+      symbol_tablet symbol_table;
+      binary.read_symbols(symbol_table);
+      REQUIRE(symbol_table.symbols.size()==2);
+    }
+  }
+}
+
+SCENARIO(
+  "Only the reachable functions of a goto binary with an index are loaded",
+  "[core][goto-programs][goto_binary]")
+{
+  goto_modelt goto_model;
+  make_model(goto_model);
+  add_caller(goto_model, goto_functionst::entry_point(), "f");
+  add_caller(goto_model, "g", "f");
+
+  temporary_filet file("goto_binary", ".gb");
+
+  {
+    std::ofstream out(file(), std::ios::binary);
+    REQUIRE(!write_goto_binary(out, goto_model, 4));
+  }
+
+  null_message_handlert message_handler;
+  cmdlinet cmdline;
+  cmdline.args.push_back(file());
+
+  lazy_goto_modelt lazy_goto_model(
+    [] (goto_model_functiont &) { },
+    [] (goto_modelt &) { return false; },
+    message_handler);
+  lazy_goto_model.initialize(cmdline);
+  lazy_goto_model.load_reachable_functions();
+
+  std::unique_ptr<goto_modelt> loaded=
+    lazy_goto_modelt::process_whole_model_and_freeze(
+      std::move(lazy_goto_model));
+  REQUIRE(loaded!=nullptr);
+
+  const goto_functionst::function_mapt &function_map=
+    loaded->goto_functions.function_map;
+
+  REQUIRE(function_map.count(goto_functionst::entry_point())==1);
+  require_same_body(
+    goto_model.goto_functions.function_map.at("f").body,
+    function_map.at("f").body);
+  // g calls f, but nothing calls g
+  REQUIRE(function_map.count("g")==0);
+  REQUIRE(loaded->symbol_table.has_symbol("g"));
+}
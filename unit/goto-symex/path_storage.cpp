@@ -0,0 +1,89 @@
+/*******************************************************************\
+
+ Module: Unit tests for the storage of symbolic execution paths
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <goto-symex/path_storage.h>
+
+#include <util/std_expr.h>
+
+static path_storaget::segment_ptrt segment(
+  const path_storaget::segment_ptrt &parent,
+  const std::vector<std::string> &names)
+{
+  symex_target_equationt::SSA_stepst steps;
+  for(const auto &name : names)
+  {
+    steps.push_back(symex_target_equationt::SSA_stept());
+    steps.back().cond_expr=symbol_exprt(name, bool_typet());
+  }
+  return std::make_shared<path_storaget::segmentt>(parent, std::move(steps));
+}
+
+static std::vector<std::string> names(
+  const symex_target_equationt::SSA_stepst &steps)
+{
+  std::vector<std::string> result;
+  for(const auto &step : steps)
+    result.push_back(
+      id2string(to_symbol_expr(step.cond_expr).get_identifier()));
+  return result;
+}
+
+SCENARIO(
+  "path_storaget shares the steps of common prefixes",
+  "[core][goto-symex][path_storage]")
+{
+  GIVEN("Two paths saved at each of two nested branches")
+  {
+    path_lifot storage;
+    goto_symex_statet state;
+
+    path_storaget::segment_ptrt root=segment(nullptr, {"a", "b"});
+    storage.push(root, state);
+
+    path_storaget::segment_ptrt inner=segment(root, {"c"});
+    storage.push(inner, state);
+    storage.push(inner, state);
+
+    THEN("The paths refer to the saved segments rather than copies")
+    {
+      // one reference each here, in the saved paths and in the child
+      REQUIRE(root.use_count()==3);
+      REQUIRE(inner.use_count()==3);
+    }
+
+    THEN("The steps of a path are those of its segments in order")
+    {
+      std::list<path_storaget::patht> next;
+      storage.pop(next);
+      symex_target_equationt::SSA_stepst steps;
+      path_storaget::get_SSA_steps(next.front().prefix, steps);
+      REQUIRE(names(steps)==std::vector<std::string>({"a", "b", "c"}));
+
+      storage.pop(next);
+      storage.pop(next);
+      steps.clear();
+      path_storaget::get_SSA_steps(next.back().prefix, steps);
+      REQUIRE(names(steps)==std::vector<std::string>({"a", "b"}));
+    }
+  }
+
+  GIVEN("A path with a very long chain of segments")
+  {
+    path_storaget::segment_ptrt last;
+    for(std::size_t i=0; i<1000000; i++)
+      last=segment(last, {});
+
+    THEN("Releasing it does not exhaust the stack")
+    {
+      last.reset();
+      REQUIRE(last==nullptr);
+    }
+  }
+}
@@ -0,0 +1,125 @@
+/*******************************************************************\
+
+ Module: Unit tests for the word-level preprocessing of the SSA equation
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <goto-symex/preprocess_equation.h>
+
+#include <solvers/flattening/boolbv.h>
+#include <solvers/sat/cnf_clause_list.h>
+
+#include <util/arith_tools.h>
+#include <util/namespace.h>
+#include <util/ssa_expr.h>
+#include <util/std_types.h>
+#include <util/symbol_table.h>
+
+static ssa_exprt ssa(const std::string &name, const typet &type)
+{
+  ssa_exprt result(symbol_exprt(name, type));
+  result.set_level_2(1);
+  return result;
+}
+
+class equation_buildert
+{
+public:
+  explicit equation_buildert(const namespacet &ns):equation(ns)
+  {
+  }
+
+  void assign(const ssa_exprt &lhs, const exprt &rhs)
+  {
+    equation.assignment(
+      true_exprt(),
+      lhs,
+      lhs,
+      lhs.get_original_expr(),
+      rhs,
+      source,
+      symex_targett::assignment_typet::STATE);
+  }
+
+  symex_target_equationt equation;
+  symex_targett::sourcet source;
+};
+
+/// Builds the equation of
+///   unsigned x=nondet(), y=x, t=x*y; unsigned char c=t;
+///   assume(x<100); assert(c!=7);
+/// \param [out] x_cond: the converted definition of x
+/// \param [out] c_rhs: the right-hand side of the definition of c
+static std::size_t clauses(bool preprocess, exprt &x_cond, exprt &c_rhs)
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  equation_buildert builder(ns);
+
+  const unsignedbv_typet u32(32), u8(8);
+  const ssa_exprt x=ssa("x", u32), y=ssa("y", u32), t=ssa("t", u32);
+  const ssa_exprt c=ssa("c", u8);
+
+  builder.assign(x, nondet_symbol_exprt("symex::nondet0", u32));
+  builder.assign(y, x);
+  builder.assign(t, mult_exprt(x, y));
+  builder.assign(c, typecast_exprt(t, u8));
+  builder.equation.assumption(
+    true_exprt(),
+    binary_relation_exprt(x, ID_lt, from_integer(100, u32)),
+    builder.source);
+  builder.equation.assertion(
+    true_exprt(),
+    notequal_exprt(c, from_integer(7, u8)),
+    "",
+    builder.source);
+
+  if(preprocess)
+  {
+    const preprocess_equation_statisticst stats=
+      preprocess_equation(builder.equation, ns);
+
+    // y is replaced by x, and t is read in 8 bits only
+    REQUIRE(stats.substitutions>=1);
+    REQUIRE(stats.narrowed_bits==32-7);
+    REQUIRE(stats.sliced_bits==32-8);
+  }
+
+  x_cond=builder.equation.SSA_steps.begin()->cond_expr;
+  c_rhs=std::prev(builder.equation.SSA_steps.end(), 3)->ssa_rhs;
+
+  cnf_clause_listt cnf;
+  boolbvt solver(ns, cnf);
+  builder.equation.convert(solver);
+
+  return cnf.no_clauses();
+}
+
+TEST_CASE(
+  "preprocess_equation substitutes, narrows and slices",
+  "[core][goto-symex][preprocess_equation]")
+{
+  exprt original_x, preprocessed_x, original, preprocessed;
+  const std::size_t before=clauses(false, original_x, original);
+  const std::size_t after=clauses(true, preprocessed_x, preprocessed);
+
+  // x is defined by the zero extension of an input with 7 bits
+  REQUIRE(original_x.id()==ID_equal);
+  REQUIRE(original_x.op1().id()==ID_nondet_symbol);
+  REQUIRE(preprocessed_x.id()==ID_equal);
+  REQUIRE(preprocessed_x.op1().id()==ID_typecast);
+  REQUIRE(preprocessed_x.op1().op0().id()==ID_nondet_symbol);
+  REQUIRE(preprocessed_x.op1().op0().type()==unsignedbv_typet(7));
+
+  // the multiplication is inlined into c, in 8 bits
+  REQUIRE(original.id()==ID_typecast);
+  REQUIRE(preprocessed.id()==ID_mult);
+  REQUIRE(preprocessed.type()==unsignedbv_typet(8));
+
+  INFO("clauses before: " << before << ", after: " << after);
+  REQUIRE(after*4<before);
+}
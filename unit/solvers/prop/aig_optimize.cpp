@@ -0,0 +1,139 @@
+/*******************************************************************\
+
+ Module: Unit tests for the optimisation of And-Inverter Graphs
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <testing-utils/dpll_sat.h>
+
+#include <random>
+
+#include <solvers/prop/aig_optimize.h>
+#include <solvers/prop/aig_prop.h>
+
+static bool evaluate(
+  const aigt &aig,
+  literalt l,
+  const std::vector<bool> &inputs)
+{
+  if(l.is_constant())
+    return l.is_true();
+
+  const aigt::nodet &node=aig.nodes[l.var_no()];
+  const bool value=node.is_var()?
+    inputs[l.var_no()]:
+    evaluate(aig, node.a, inputs) && evaluate(aig, node.b, inputs);
+
+  return value!=l.sign();
+}
+
+TEST_CASE(
+  "aig_merge_equivalent merges nodes with the same function",
+  "[core][solvers][prop][aig_optimize]")
+{
+  aigt src;
+  src.new_node();
+  const literalt a=src.new_var_node();
+  const literalt b=src.new_var_node();
+
+  // a xor b, as a disjunction and as a negated equality
+  const literalt xor1=!src.new_and_node(
+    !src.new_and_node(a, !b), !src.new_and_node(!a, b));
+  const literalt xor2=src.new_and_node(
+    !src.new_and_node(a, b), !src.new_and_node(!a, !b));
+  const literalt equal=src.new_and_node(!xor1, !xor2);
+
+  aigt dest;
+  aig_buildert builder(dest);
+  std::vector<literalt> map;
+  REQUIRE(aig_merge_equivalent(src, builder, map)>0);
+
+  REQUIRE(map_literal(map, xor1)==map_literal(map, xor2));
+  REQUIRE(map_literal(map, equal)==map_literal(map, !xor1));
+}
+
+TEST_CASE(
+  "aig_balance minimises the depth of trees of AND nodes",
+  "[core][solvers][prop][aig_optimize]")
+{
+  aigt src;
+  src.new_node();
+
+  literalt chain=src.new_var_node();
+  for(int i=0; i<7; i++)
+    chain=src.new_and_node(chain, src.new_var_node());
+
+  aigt dest;
+  aig_buildert builder(dest);
+  std::vector<literalt> map;
+  aig_balance(src, { chain }, builder, map);
+
+  REQUIRE(builder.level(map_literal(map, chain))==3);
+  REQUIRE(aig_cone_size(dest, { map_literal(map, chain) })==7);
+}
+
+TEST_CASE(
+  "aig_prop_solvert agrees with the evaluation of the AIG",
+  "[core][solvers][prop][aig_optimize]")
+{
+  std::mt19937 generator(0);
+
+  for(int round=0; round<50; round++)
+  {
+    dpll_satt sat;
+    aig_prop_solvert solver(sat);
+
+    bvt literals;
+    for(int i=0; i<6; i++)
+      literals.push_back(solver.new_variable());
+
+    auto pick=[&]()
+    {
+      const literalt l=literals[generator()%literals.size()];
+      return l^((generator()&1)!=0);
+    };
+
+    for(int i=0; i<30; i++)
+    {
+      switch(generator()%3)
+      {
+      case 0: literals.push_back(solver.land(pick(), pick())); break;
+      case 1: literals.push_back(solver.lxor(pick(), pick())); break;
+      default: literals.push_back(solver.lselect(pick(), pick(), pick()));
+      }
+    }
+
+    // check once, and then again with a further constraint
+    for(int step=0; step<2; step++)
+    {
+      solver.l_set_to_true(pick());
+      solver.l_set_to_true(pick());
+
+      bool satisfiable=false;
+      for(unsigned value=0; value<64 && !satisfiable; value++)
+      {
+        std::vector<bool> inputs(solver.aig.nodes.size(), false);
+        for(unsigned v=0; v<6; v++)
+          inputs[literals[v].var_no()]=((value>>v)&1)!=0;
+
+        satisfiable=true;
+        for(const auto &c : solver.aig.constraints)
+          satisfiable&=evaluate(solver.aig, c, inputs);
+      }
+
+      const propt::resultt result=solver.prop_solve();
+      REQUIRE(
+        result==(satisfiable?propt::resultt::P_SATISFIABLE:
+                             propt::resultt::P_UNSATISFIABLE));
+
+      if(!satisfiable)
+        break;
+
+      for(const auto &c : solver.aig.constraints)
+        REQUIRE(solver.l_get(c).is_true());
+    }
+  }
+}
@@ -0,0 +1,218 @@
+/*******************************************************************\
+
+ Module: Unit tests for the polarity-aware encoding of prop_conv_solvert
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <testing-utils/dpll_sat.h>
+
+#include <iostream>
+#include <random>
+
+#include <solvers/prop/prop_conv.h>
+#include <solvers/sat/cnf_clause_list.h>
+
+#include <util/message.h>
+#include <util/namespace.h>
+#include <util/symbol_table.h>
+
+static bool evaluate(const exprt &expr, const std::vector<bool> &values)
+{
+  const exprt::operandst &op=expr.operands();
+
+  if(expr.id()==ID_symbol)
+    return values[std::stoul(id2string(expr.get(ID_identifier)).substr(1))];
+  else if(expr.id()==ID_not)
+    return !evaluate(op[0], values);
+  else if(expr.id()==ID_implies)
+    return !evaluate(op[0], values) || evaluate(op[1], values);
+
+  bool conjunction=true, disjunction=false;
+  for(const auto &o : op)
+  {
+    const bool value=evaluate(o, values);
+    conjunction&=value;
+    disjunction|=value;
+  }
+
+  if(expr.id()==ID_and)
+    return conjunction;
+  else if(expr.id()==ID_nand)
+    return !conjunction;
+  else if(expr.id()==ID_or)
+    return disjunction;
+  else
+    return !disjunction;
+}
+
+class formulast
+{
+public:
+  explicit formulast(unsigned seed):generator(seed)
+  {
+    for(unsigned i=0; i<variables; i++)
+      pool.push_back(symbol_exprt("v"+std::to_string(i), bool_typet()));
+
+    // later formulas share the earlier ones
+    for(unsigned i=0; i<30; i++)
+    {
+      static const irep_idt ids[]=
+        { ID_and, ID_or, ID_nand, ID_nor, ID_implies, ID_not };
+      const irep_idt &id=ids[generator()%6];
+
+      exprt expr(id, bool_typet());
+      const unsigned operands=id==ID_not?1:id==ID_implies?2:
+        2+generator()%2;
+      for(unsigned j=0; j<operands; j++)
+        expr.copy_to_operands(pick());
+
+      pool.push_back(expr);
+    }
+  }
+
+  exprt pick()
+  {
+    return pool[generator()%pool.size()];
+  }
+
+  static const unsigned variables=6;
+
+protected:
+  std::mt19937 generator;
+  std::vector<exprt> pool;
+};
+
+TEST_CASE(
+  "polarity-aware encoding is equisatisfiable",
+  "[core][solvers][prop][prop_conv]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  null_message_handlert message_handler;
+
+  for(unsigned round=0; round<200; round++)
+  {
+    formulast formulas(round);
+    const exprt positive=formulas.pick();
+    const exprt negative=formulas.pick();
+    const exprt implication=
+      implies_exprt(formulas.pick(), formulas.pick());
+    const exprt converted=formulas.pick();
+
+    bool satisfiable=false;
+    for(unsigned value=0; value<64 && !satisfiable; value++)
+    {
+      std::vector<bool> values;
+      for(unsigned v=0; v<formulast::variables; v++)
+        values.push_back(((value>>v)&1)!=0);
+
+      satisfiable=
+        evaluate(positive, values) &&
+        !evaluate(negative, values) &&
+        evaluate(implication, values);
+    }
+
+    for(bool polarity_aware : { false, true })
+    {
+      dpll_satt sat;
+      prop_conv_solvert prop_conv(ns, sat);
+      prop_conv.set_message_handler(message_handler);
+      prop_conv.polarity_aware=polarity_aware;
+
+      prop_conv.set_to_true(positive);
+      prop_conv.set_to_false(negative);
+      prop_conv.set_to_true(implication);
+      const literalt l=prop_conv.convert(converted);
+
+      const decision_proceduret::resultt result=prop_conv.dec_solve();
+      REQUIRE(
+        result==(satisfiable?decision_proceduret::resultt::D_SATISFIABLE:
+                             decision_proceduret::resultt::D_UNSATISFIABLE));
+
+      if(!satisfiable)
+        continue;
+
+      std::vector<bool> values;
+      for(unsigned v=0; v<formulast::variables; v++)
+      {
+        const symbol_exprt symbol("v"+std::to_string(v), bool_typet());
+        values.push_back(prop_conv.get(symbol).is_true());
+      }
+
+      REQUIRE(evaluate(positive, values));
+      REQUIRE_FALSE(evaluate(negative, values));
+      REQUIRE(evaluate(implication, values));
+
+      // the literals that convert() returns are exact
+      REQUIRE(prop_conv.l_get(l).is_true()==evaluate(converted, values));
+    }
+  }
+}
+
+/// Adds the constraints of a program with a sequence of branches: the
+/// guard of each branch is the conjunction of the conditions of the
+/// branches before, each branch assumes a disjunction, and the assertion
+/// at the end is a disjunction of conjunctions.
+/// \return the number of clauses
+static std::size_t guarded_clauses(bool polarity_aware, unsigned branches)
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  null_message_handlert message_handler;
+
+  cnf_clause_listt cnf;
+  prop_conv_solvert prop_conv(ns, cnf);
+  prop_conv.set_message_handler(message_handler);
+  prop_conv.polarity_aware=polarity_aware;
+
+  auto symbol=[](const std::string &name, unsigned i)
+  {
+    return symbol_exprt(name+std::to_string(i), bool_typet());
+  };
+
+  exprt guard=true_exprt();
+  exprt::operandst violations;
+
+  for(unsigned i=0; i<branches; i++)
+  {
+    guard=and_exprt(guard, symbol("c", i));
+
+    prop_conv.set_to_true(
+      implies_exprt(
+        guard,
+        or_exprt(symbol("x", i), symbol("y", i), symbol("z", i))));
+
+    violations.push_back(
+      and_exprt(guard, not_exprt(symbol("x", i)), symbol("z", i)));
+  }
+
+  prop_conv.set_to_false(not_exprt(disjunction(violations)));
+
+  return cnf.no_clauses();
+}
+
+TEST_CASE(
+  "polarity-aware encoding needs fewer clauses",
+  "[core][solvers][prop][prop_conv]")
+{
+  REQUIRE(guarded_clauses(true, 20)<guarded_clauses(false, 20));
+}
+
+// Run with: unit_tests "[benchmark]"
+TEST_CASE(
+  "polarity-aware encoding clause count benchmark",
+  "[.][benchmark][prop_conv]")
+{
+  for(unsigned branches : { 10, 100, 1000 })
+  {
+    const std::size_t full=guarded_clauses(false, branches);
+    const std::size_t polarity=guarded_clauses(true, branches);
+
+    std::cout << branches << " branches: " << full << " clauses, "
+              << polarity << " polarity-aware ("
+              << 100-100*polarity/full << "% fewer)\n";
+  }
+}
@@ -0,0 +1,148 @@
+/*******************************************************************\
+
+ Module: Unit tests for the lazy encoding of integer arithmetic in
+   solvers/refinement/refine_arithmetic.cpp
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <testing-utils/dpll_sat.h>
+
+#include <iostream>
+
+#include <solvers/refinement/bv_refinement.h>
+
+#include <util/arith_tools.h>
+#include <util/config.h>
+#include <util/namespace.h>
+#include <util/simplify_expr.h>
+#include <util/symbol_table.h>
+
+TEST_CASE(
+  "lazy products, quotients and remainders agree with the arithmetic",
+  "[core][solvers][refinement][bv_refinement]")
+{
+  // the pointer width
+  config.ansi_c.set_ILP32();
+
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  null_message_handlert message_handler;
+
+  for(const typet &type : { typet(unsignedbv_typet(5)),
+                            typet(signedbv_typet(5)) })
+  {
+    for(const auto &values : { std::make_pair(7, 3),
+                               std::make_pair(-13, 4),
+                               std::make_pair(11, -5),
+                               std::make_pair(-9, -2),
+                               std::make_pair(15, 15) })
+    {
+      const symbol_exprt x("x", type), y("y", type);
+      const exprt a=from_integer(values.first, type);
+      const exprt b=from_integer(values.second, type);
+
+      dpll_satt sat;
+      bv_refinementt::infot info;
+      info.ns=&ns;
+      info.prop=&sat;
+      bv_refinementt solver(info);
+      solver.set_message_handler(message_handler);
+
+      // the operands are not constants to the conversion
+      solver.set_to_true(equal_exprt(x, a));
+      solver.set_to_true(equal_exprt(y, b));
+
+      const exprt operations[]=
+      {
+        mult_exprt(x, y), div_exprt(x, y), mod_exprt(x, y)
+      };
+
+      std::vector<symbol_exprt> results;
+      for(const auto &operation : operations)
+      {
+        results.emplace_back(
+          "r"+std::to_string(results.size()), operation.type());
+        solver.set_to_true(equal_exprt(results.back(), operation));
+      }
+
+      REQUIRE(
+        solver.dec_solve()==decision_proceduret::resultt::D_SATISFIABLE);
+
+      for(std::size_t i=0; i<results.size(); i++)
+      {
+        exprt expected=operations[i];
+        expected.op0()=a;
+        expected.op1()=b;
+        simplify(expected, ns);
+
+        REQUIRE(solver.get(results[i])==expected);
+      }
+    }
+  }
+}
+
+/// Solves x*y==6 && x<4 && y<4 for unsigned x and y
+/// \return the number of clauses
+static std::size_t product_clauses(bool refine_arithmetic, std::size_t width)
+{
+  // the pointer width
+  config.ansi_c.set_ILP32();
+
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+  null_message_handlert message_handler;
+
+  const unsignedbv_typet type(width);
+  const symbol_exprt x("x", type), y("y", type);
+
+  dpll_satt sat;
+  bv_refinementt::infot info;
+  info.ns=&ns;
+  info.prop=&sat;
+  info.refine_arithmetic=refine_arithmetic;
+  bv_refinementt solver(info);
+  solver.set_message_handler(message_handler);
+
+  solver.set_to_true(
+    equal_exprt(mult_exprt(x, y), from_integer(6, type)));
+  solver.set_to_true(binary_relation_exprt(x, ID_lt, from_integer(4, type)));
+  solver.set_to_true(binary_relation_exprt(y, ID_lt, from_integer(4, type)));
+
+  REQUIRE(solver.dec_solve()==decision_proceduret::resultt::D_SATISFIABLE);
+
+  mp_integer x_value, y_value;
+  REQUIRE_FALSE(to_integer(solver.get(x), x_value));
+  REQUIRE_FALSE(to_integer(solver.get(y), y_value));
+  REQUIRE(x_value*y_value==6);
+
+  return sat.no_clauses();
+}
+
+TEST_CASE(
+  "lazy products encode only the partial products that are needed",
+  "[core][solvers][refinement][bv_refinement]")
+{
+  const std::size_t eager=product_clauses(false, 16);
+  const std::size_t lazy=product_clauses(true, 16);
+
+  INFO("eager: " << eager << " clauses, lazy: " << lazy);
+  REQUIRE(lazy*2<eager);
+}
+
+// Run with: unit_tests "[benchmark]"
+TEST_CASE(
+  "lazy product clause count benchmark",
+  "[.][benchmark][bv_refinement]")
+{
+  for(std::size_t width : { 8, 16, 32, 64 })
+  {
+    const std::size_t eager=product_clauses(false, width);
+    const std::size_t lazy=product_clauses(true, width);
+
+    std::cout << width << " bits: " << eager << " clauses, "
+              << lazy << " lazy (" << 100-100*lazy/eager << "% fewer)\n";
+  }
+}
@@ -113,7 +113,7 @@ std::set<std::pair<T, U>> product(const std::set<T> ts, const std::set<U> us)
 exprt combine_lemmas(const std::vector<exprt> &lemmas, const namespacet &ns)
 {
   // Conjunction of new lemmas
-  exprt conj=conjunction(lemmas);
+  exprt conj=conjunction(exprt::operandst(lemmas.begin(), lemmas.end()));
   // Simplify
   simplify(conj, ns);
 
@@ -0,0 +1,235 @@
+/*******************************************************************\
+
+ Module: Unit tests for the definition of shared subterms in
+   solvers/smt2/smt2_conv.cpp
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <solvers/smt2/smt2_conv.h>
+
+#include <util/arith_tools.h>
+#include <util/hash_cons.h>
+#include <util/namespace.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+/// \return the number of occurrences of `what` in `s`
+static std::size_t count(const std::string &s, const std::string &what)
+{
+  std::size_t result=0;
+  for(std::size_t pos=s.find(what);
+      pos!=std::string::npos;
+      pos=s.find(what, pos+1))
+    result++;
+  return result;
+}
+
+/// \return x+x, (x+x)+(x+x), ... with `depth` additions, which is a tree
+///   with 2^depth leaves, but has few nodes per level in memory
+/// \param table: if not null, the levels are hash consed as they are built
+static exprt doubling(
+  const exprt &x,
+  std::size_t depth,
+  hash_cons_tablet *table)
+{
+  exprt result=x;
+  for(std::size_t i=0; i<depth; i++)
+  {
+    result=plus_exprt(result, result);
+    if(table!=nullptr)
+      (*table)(result);
+  }
+  return result;
+}
+
+/// \return the formula for doubling(x, 40)==y && doubling(x, 40)!=0
+static std::string doubling_formula(bool hash_consing)
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const unsignedbv_typet type(32);
+  const symbol_exprt x("x", type), y("y", type);
+
+  std::ostringstream out;
+  smt2_convt smt2(ns, "", "", "QF_BV", smt2_convt::solvert::GENERIC, out);
+
+  hash_cons_tablet table;
+  const exprt sum=doubling(x, 40, hash_consing?&table:nullptr);
+
+  smt2.set_to_true(equal_exprt(sum, y));
+  smt2.set_to_true(notequal_exprt(sum, from_integer(0, type)));
+
+  return out.str();
+}
+
+TEST_CASE(
+  "smt2_convt defines shared subterms once",
+  "[core][solvers][smt2][smt2_conv]")
+{
+  // the copies made by the constructors share the operands only
+  const std::string copied=doubling_formula(false);
+  INFO(copied);
+  REQUIRE(count(copied, "(define-fun share.")<=2*40);
+  REQUIRE(copied.size()<20000);
+
+  // with hash consing, each level is defined once, and read twice by the
+  // next one; the last level is defined when the second assertion reads it
+  const std::string shared=doubling_formula(true);
+  INFO(shared);
+  REQUIRE(count(shared, "(define-fun share.")==40);
+  REQUIRE(count(shared, "(bvadd share.37 share.37)")==1);
+  REQUIRE(count(shared, "(define-fun share.39 () (_ BitVec 32) "
+                        "(bvadd share.38 share.38))")==1);
+  REQUIRE(count(shared, "(assert (not (= share.39 (_ bv0 32))))")==1);
+  REQUIRE(count(shared, "(bvadd |x| |x|)")==1);
+  REQUIRE(count(shared, "(declare-fun |x|")==1);
+}
+
+/// \return the formulas sum==y0, ..., sum==y`n-1`, where sum is
+///   x*0+x*1+...+x*49, in which no node occurs twice
+static std::string sum_formulas(std::size_t n)
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const unsignedbv_typet type(32);
+  const symbol_exprt x("x", type);
+
+  exprt sum=mult_exprt(x, from_integer(0, type));
+  for(std::size_t i=1; i<50; i++)
+    sum=plus_exprt(sum, mult_exprt(x, from_integer(i, type)));
+
+  std::ostringstream out;
+  smt2_convt smt2(ns, "", "", "QF_BV", smt2_convt::solvert::GENERIC, out);
+
+  for(std::size_t i=0; i<n; i++)
+    smt2.set_to_true(
+      equal_exprt(sum, symbol_exprt("y"+std::to_string(i), type)));
+
+  return out.str();
+}
+
+TEST_CASE(
+  "smt2_convt defines subterms that are shared between formulas",
+  "[core][solvers][smt2][smt2_conv]")
+{
+  const std::string one=sum_formulas(1);
+  const std::string ten=sum_formulas(10);
+  INFO(ten);
+
+  // the constructors copy the top node of the sum, but share its operands,
+  // which are written out by the first formula, defined when the second
+  // one reads them, and referred to by name from then on
+  REQUIRE(count(one, "(define-fun share.")==0);
+  REQUIRE(count(ten, "(define-fun share.")==2);
+  REQUIRE(count(ten, "(bvmul |x| (_ bv7 32))")==2);
+  REQUIRE(count(ten, "(= (bvadd share.1 share.0) |y")==9);
+  REQUIRE(ten.size()<3*one.size());
+}
+
+TEST_CASE(
+  "smt2_convt does not use shared definitions under binders",
+  "[core][solvers][smt2][smt2_conv]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const unsignedbv_typet type(8);
+  const symbol_exprt x("x", type);
+  const exprt shared=plus_exprt(x, from_integer(1, type));
+
+  std::ostringstream out;
+  smt2_convt smt2(ns, "", "", "QF_BV", smt2_convt::solvert::GENERIC, out);
+
+  // x is free in the first two conjuncts, and bound in the quantifier
+  exprt quantifier(ID_forall, bool_typet());
+  quantifier.copy_to_operands(x, notequal_exprt(shared, shared));
+
+  exprt formula=
+    and_exprt(
+      equal_exprt(shared, shared),
+      or_exprt(binary_relation_exprt(shared, ID_lt, x), quantifier));
+
+  hash_cons_tablet table;
+  table(formula);
+  smt2.set_to_true(formula);
+
+  const std::string result=out.str();
+  INFO(result);
+
+  REQUIRE(count(result, "(define-fun share.")==1);
+  REQUIRE(count(result, "(not (= (bvadd |x| (_ bv1 8))")==1);
+}
+
+/// \return `steps` assignments in the way symbolic execution produces
+///   them: each right-hand side reads the previous definition, under a
+///   guard that grows, and is shared by all later assignments
+static std::vector<exprt> assignments(std::size_t steps)
+{
+  const unsignedbv_typet type(32);
+  std::vector<exprt> result;
+
+  symbol_exprt previous("input", type);
+  exprt guard=true_exprt();
+
+  for(std::size_t i=0; i<steps; i++)
+  {
+    const symbol_exprt current("main::1::x!0@1#"+std::to_string(i), type);
+
+    if(i%16==0)
+      guard=and_exprt(
+        guard,
+        binary_relation_exprt(previous, ID_lt, from_integer(i, type)));
+
+    result.push_back(
+      equal_exprt(
+        current,
+        if_exprt(
+          guard,
+          plus_exprt(mult_exprt(previous, previous), from_integer(i, type)),
+          previous)));
+
+    previous=current;
+  }
+
+  return result;
+}
+
+// Run with: unit_tests "[benchmark]"
+TEST_CASE(
+  "smt2_convt emission throughput benchmark",
+  "[.][benchmark][smt2_conv]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  for(std::size_t steps : { 1000, 10000, 100000 })
+  {
+    const std::vector<exprt> formulas=assignments(steps);
+    std::ostringstream out;
+
+    const auto start=std::chrono::steady_clock::now();
+
+    smt2_convt smt2(ns, "", "", "QF_BV", smt2_convt::solvert::GENERIC, out);
+    for(const exprt &formula : formulas)
+      smt2.set_to_true(formula);
+
+    const std::chrono::duration<double> seconds=
+      std::chrono::steady_clock::now()-start;
+    const double megabytes=static_cast<double>(out.tellp())/1e6;
+
+    std::cout << steps << " steps: " << megabytes << " MB in "
+              << seconds.count() << "s, "
+              << megabytes/seconds.count() << " MB/s\n";
+  }
+}
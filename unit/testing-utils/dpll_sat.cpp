@@ -0,0 +1,101 @@
+/*******************************************************************\
+
+ Module: Unit test utilities
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// A SAT solver for the small formulas of unit tests
+
+#include "dpll_sat.h"
+
+#include <algorithm>
+
+propt::resultt dpll_satt::prop_solve()
+{
+  assignment.assign(no_variables(), tvt::unknown());
+  conflict=assumptions;
+
+  for(const auto &l : assumptions)
+  {
+    if(l_get(l).is_false())
+      return resultt::P_UNSATISFIABLE;
+    if(!l.is_constant())
+      assignment[l.var_no()]=tvt(!l.sign());
+  }
+
+  if(!solve())
+    return resultt::P_UNSATISFIABLE;
+
+  conflict.clear();
+  return resultt::P_SATISFIABLE;
+}
+
+bool dpll_satt::is_in_conflict(literalt l) const
+{
+  return std::find(conflict.begin(), conflict.end(), l)!=conflict.end();
+}
+
+bool dpll_satt::solve()
+{
+  const assignmentt saved=assignment;
+
+  // propagate the unit clauses to a fixed point
+  for(bool changed=true; changed;)
+  {
+    changed=false;
+
+    for(const auto &clause : clauses)
+    {
+      std::size_t unknown=0;
+      literalt last;
+      bool satisfied=false;
+
+      for(const auto &l : clause)
+      {
+        const tvt value=l_get(l);
+        satisfied|=value.is_true();
+        if(value.is_unknown())
+        {
+          unknown++;
+          last=l;
+        }
+      }
+
+      if(satisfied)
+        continue;
+
+      if(unknown==0)
+      {
+        assignment=saved;
+        return false;
+      }
+
+      if(unknown==1)
+      {
+        assignment[last.var_no()]=tvt(!last.sign());
+        changed=true;
+      }
+    }
+  }
+
+  for(std::size_t v=1; v<assignment.size(); v++)
+  {
+    if(assignment[v].is_unknown())
+    {
+      for(bool value : { false, true })
+      {
+        assignment[v]=tvt(value);
+        if(solve())
+          return true;
+      }
+
+      assignment=saved;
+      return false;
+    }
+  }
+
+  return true;
+}
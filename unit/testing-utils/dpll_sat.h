@@ -0,0 +1,42 @@
+/*******************************************************************\
+
+ Module: Unit test utilities
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+/// \file
+/// A SAT solver for the small formulas of unit tests
+
+#ifndef CPROVER_TESTING_UTILS_DPLL_SAT_H
+#define CPROVER_TESTING_UTILS_DPLL_SAT_H
+
+#include <solvers/sat/cnf_clause_list.h>
+
+/// Solves with unit propagation and backtracking, for small formulas only
+class dpll_satt:public cnf_clause_list_assignmentt
+{
+public:
+  resultt prop_solve() override;
+
+  void set_assumptions(const bvt &_assumptions) override
+  {
+    assumptions=_assumptions;
+  }
+
+  bool has_set_assumptions() const override { return true; }
+
+  // every assumption counts as part of the conflict
+  bool is_in_conflict(literalt l) const override;
+  bool has_is_in_conflict() const override { return true; }
+
+protected:
+  bvt assumptions;
+  // the assumptions of the last call that was unsatisfiable
+  bvt conflict;
+
+  bool solve();
+};
+
+#endif // CPROVER_TESTING_UTILS_DPLL_SAT_H
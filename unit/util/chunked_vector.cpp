@@ -0,0 +1,153 @@
+/*******************************************************************\
+
+ Module: chunked_vectort unit tests
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <map>
+#include <string>
+
+#include <util/chunked_vector.h>
+
+TEST_CASE(
+  "chunked_vectort keeps iterators valid at either end",
+  "[core][util][chunked_vector]")
+{
+  chunked_vectort<std::string, 4> v;
+  REQUIRE(v.empty());
+  REQUIRE(v.heap_size()==0);
+
+  v.push_back("b");
+  chunked_vectort<std::string, 4>::iterator b=v.begin();
+  const std::string *b_address=&v.front();
+
+  for(int i=0; i<10; i++)
+    v.push_back("c"+std::to_string(i));
+
+  v.push_front("a");
+  for(int i=0; i<10; i++)
+    v.emplace_front("_");
+
+  REQUIRE(v.size()==22);
+  REQUIRE(*b=="b");
+  REQUIRE(&*b==b_address);
+  REQUIRE(*std::prev(b)=="a");
+  REQUIRE(b-v.begin()==11);
+  REQUIRE(v[11]=="b");
+  REQUIRE(v.back()=="c9");
+  REQUIRE(v.heap_size()%(4*sizeof(std::string))==0);
+
+  // iterators are ordered by position
+  std::map<chunked_vectort<std::string, 4>::const_iterator, int> order;
+  order[std::next(v.begin(), 3)]=3;
+  order[v.begin()]=0;
+  order[std::next(v.begin(), 15)]=15;
+  REQUIRE(order.begin()->second==0);
+  REQUIRE(order.rbegin()->second==15);
+
+  std::string reversed;
+  for(auto it=v.rbegin(); it!=v.rend() && *it!="a"; it++)
+    reversed+=*it;
+  REQUIRE(reversed=="c9c8c7c6c5c4c3c2c1c0b");
+
+  v.pop_back();
+  REQUIRE(v.back()=="c8");
+}
+
+TEST_CASE(
+  "chunked_vectort is copied and moved element-wise",
+  "[core][util][chunked_vector]")
+{
+  chunked_vectort<std::string, 2> v;
+  for(int i=0; i<5; i++)
+    v.push_back(std::to_string(i));
+
+  chunked_vectort<std::string, 2> copy(v);
+  REQUIRE(copy.size()==5);
+  REQUIRE(&copy.front()!=&v.front());
+
+  const std::string *front=&v.front();
+  chunked_vectort<std::string, 2> moved(std::move(v));
+  REQUIRE(v.empty());
+  REQUIRE(&moved.front()==front);
+
+  copy.swap(v);
+  REQUIRE(copy.empty());
+  REQUIRE(v.size()==5);
+  REQUIRE(v[4]=="4");
+
+  v=moved;
+  REQUIRE(v.size()==5);
+  v.clear();
+  REQUIRE(v.empty());
+  REQUIRE(v.heap_size()==0);
+}
+
+// Run with: unit_tests "[benchmark]"
+TEST_CASE(
+  "chunked_vectort iteration benchmark",
+  "[.][benchmark][chunked_vector]")
+{
+  // about the size of an SSA step
+  typedef std::array<std::size_t, 28> stept;
+  const std::size_t steps=1000000;
+  const std::size_t rounds=20;
+
+  std::list<stept> list;
+  chunked_vectort<stept> chunked;
+
+  for(std::size_t i=0; i<steps; i++)
+  {
+    stept step;
+    step.fill(i);
+    list.push_back(step);
+    chunked.push_back(step);
+  }
+
+  auto iterate=[&](const char *name, std::function<std::size_t()> f)
+  {
+    auto start=std::chrono::steady_clock::now();
+    std::size_t sum=0;
+    for(std::size_t r=0; r<rounds; r++)
+      sum+=f();
+    std::chrono::duration<double> seconds=
+      std::chrono::steady_clock::now()-start;
+
+    std::cout << name << ": "
+              << steps*rounds/seconds.count()/1e6
+              << " million steps/s (checksum " << sum << ")\n";
+  };
+
+  iterate("std::list", [&]()
+  {
+    std::size_t sum=0;
+    for(const auto &step : list)
+      sum+=step[0];
+    return sum;
+  });
+
+  iterate("chunked_vectort", [&]()
+  {
+    std::size_t sum=0;
+    for(const auto &step : chunked)
+      sum+=step[0];
+    return sum;
+  });
+
+  // the list allocates a node with two pointers per step, before any
+  // overhead of the allocator
+  std::cout << "bytes per step: std::list "
+            << sizeof(stept)+2*sizeof(void *)
+            << "+, chunked_vectort "
+            << static_cast<double>(chunked.heap_size())/chunked.size()
+            << "\n";
+}
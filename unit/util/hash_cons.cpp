@@ -0,0 +1,119 @@
+/*******************************************************************\
+
+ Module: hash_cons_tablet unit tests
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <util/hash_cons.h>
+
+#ifdef SHARING
+
+TEST_CASE("hash_cons_tablet shares equal ireps", "[core][util][hash_cons]")
+{
+  hash_cons_tablet table;
+
+  irept a("plus");
+  a.get_sub().push_back(irept("x"));
+  a.get_sub().push_back(irept("y"));
+  a.set("type", irept("int"));
+
+  irept b("plus");
+  b.get_sub().push_back(irept("x"));
+  b.get_sub().push_back(irept("y"));
+  b.set("type", irept("int"));
+
+  REQUIRE(&a.read()!=&b.read());
+
+  table(a);
+  table(b);
+
+  // non-const access would unshare a
+  const irept &const_a=a;
+
+  REQUIRE(&a.read()==&b.read());
+  REQUIRE(table.is_representative(a));
+  REQUIRE(table.is_representative(const_a.get_sub()[0]));
+  // plus, x, y, int
+  REQUIRE(table.size()==4);
+
+  // representatives are returned without rebuilding them
+  REQUIRE(&table.representative(a).read()==&a.read());
+  REQUIRE(table.size()==4);
+
+  // modifying a copy leaves the representative intact
+  irept c=a;
+  c.id("minus");
+  REQUIRE(a.id()=="plus");
+  REQUIRE(!table.is_representative(c));
+  table(c);
+  const irept &const_c=c;
+  REQUIRE(&const_c.get_sub()[1].read()==&const_a.get_sub()[1].read());
+  REQUIRE(table.size()==5);
+}
+
+TEST_CASE("hash_cons_tablet respects comments", "[core][util][hash_cons]")
+{
+  hash_cons_tablet table;
+
+  irept a("x");
+  irept b("x");
+  b.set("#comment", irept("c"));
+
+  table(a);
+  table(b);
+
+  REQUIRE(a==b);
+  REQUIRE(&a.read()!=&b.read());
+  REQUIRE(b.find("#comment").id()=="c");
+
+  table.clear();
+  REQUIRE(table.size()==0);
+  REQUIRE(!table.is_representative(a));
+}
+
+TEST_CASE(
+  "hash_cons_tablet rebuilds shared nodes once",
+  "[core][util][hash_cons]")
+{
+  hash_cons_tablet table;
+
+  // 64 nested x+x: a DAG of 65 nodes that unfolds into a tree of 2^65-1
+  irept dag("x");
+  for(std::size_t i=0; i<64; i++)
+  {
+    irept plus("plus");
+    plus.get_sub().push_back(dag);
+    plus.get_sub().push_back(dag);
+    dag=plus;
+  }
+
+  table(dag);
+  REQUIRE(table.size()==65);
+  REQUIRE(table.is_representative(dag));
+
+  // a guard chain, each link of which is hash-consed through a copy, as
+  // the guards of the steps of an equation are
+  irept chain("g0");
+  for(std::size_t i=1; i<64; i++)
+  {
+    irept next("and");
+    next.get_sub().push_back(chain);
+    next.get_sub().push_back(irept("c"));
+    chain=next;
+
+    irept guard=chain;
+    table(guard);
+    REQUIRE(table.is_representative(guard));
+    REQUIRE(!table.is_representative(chain));
+    REQUIRE(&table.representative(chain).read()==&guard.read());
+  }
+
+  // g0, c and the links
+  REQUIRE(table.size()==65+2+63);
+}
+
+#endif
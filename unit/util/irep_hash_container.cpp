@@ -0,0 +1,39 @@
+/*******************************************************************\
+
+ Module: irep_hash_containert unit tests
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <util/irep.h>
+#include <util/irep_hash_container.h>
+
+SCENARIO(
+  "irep_hash_containert numbers ireps by their content",
+  "[core][util][irep_hash_container]")
+{
+  irep_full_hash_containert container;
+  const irept a("a");
+  const irept b("b");
+
+  GIVEN("A container that numbered an irep")
+  {
+    REQUIRE(container.number(a)==0);
+    REQUIRE(container.number(irept("a"))==0);
+    REQUIRE(container.number(b)==1);
+
+    WHEN("It is cleared")
+    {
+      container.clear();
+
+      THEN("The irep does not keep the number it had before")
+      {
+        REQUIRE(container.number(b)==0);
+        REQUIRE(container.number(a)==1);
+      }
+    }
+  }
+}
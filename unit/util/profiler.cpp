@@ -0,0 +1,60 @@
+/*******************************************************************\
+
+ Module: Unit tests of the profiler
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <util/profiler.h>
+
+TEST_CASE("profilert records nested phases", "[core][util][profiler]")
+{
+  profilert profiler;
+
+  profiler.start("front-end");
+  profiler.start("parsing");
+  profiler.set_count("files", 2);
+  profiler.stop();
+  profiler.start("typecheck");
+  profiler.stop();
+  profiler.stop();
+  profiler.start("symex");
+
+  const json_objectt json=profiler.output_json();
+  const jsont::arrayt &phases=json["phases"].array;
+  REQUIRE(phases.size()==2);
+
+  const jsont &front_end=phases.front();
+  REQUIRE(front_end["name"].value=="front-end");
+  REQUIRE(front_end["cumulativePeakRSS"].kind==jsont::kindt::J_NUMBER);
+  REQUIRE(front_end["wallTime"].kind==jsont::kindt::J_NUMBER);
+  REQUIRE(front_end["cpuTime"].kind==jsont::kindt::J_NUMBER);
+
+  const jsont::arrayt &nested=front_end["phases"].array;
+  REQUIRE(nested.size()==2);
+
+  const jsont &parsing=nested.front();
+  REQUIRE(parsing["name"].value=="parsing");
+  REQUIRE(parsing["counts"]["files"].value=="2");
+
+  // phases that are still running are included
+  const jsont &symex=phases.back();
+  REQUIRE(symex["name"].value=="symex");
+  REQUIRE(symex["phases"].is_null());
+}
+
+TEST_CASE("profile_phaset is inactive by default", "[core][util][profiler]")
+{
+  {
+    profile_phaset phase("unused");
+    phase.next("unused either");
+    profile_count("ignored", 1);
+  }
+
+  REQUIRE(!global_profiler().is_enabled());
+  const json_objectt json=global_profiler().output_json();
+  REQUIRE(json["phases"].array.empty());
+}
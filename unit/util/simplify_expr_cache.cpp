@@ -0,0 +1,113 @@
+/*******************************************************************\
+
+ Module: Unit tests of the simplifier cache
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/config.h>
+#include <util/namespace.h>
+#include <util/simplify_expr.h>
+#include <util/simplify_expr_cache.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+TEST_CASE("simplify_expr_cachet evicts the least recently used entry")
+{
+  simplify_expr_cachet cache(2);
+  exprt a("a"), b("b"), c("c"), result;
+
+  cache.insert(a, exprt("A"));
+  cache.insert(b, exprt());
+
+  REQUIRE(cache.find(a, result));
+  REQUIRE(result.id()=="A");
+  REQUIRE(cache.find(b, result));
+  REQUIRE(result.id().empty());
+
+  // a is now the least recently used entry
+  cache.insert(c, exprt("C"));
+  REQUIRE(cache.size()==2);
+  REQUIRE(!cache.find(a, result));
+  REQUIRE(cache.find(b, result));
+  REQUIRE(cache.find(c, result));
+
+  REQUIRE(cache.get_hits()==4);
+  REQUIRE(cache.get_misses()==1);
+
+  // comments are taken into account
+  exprt c_with_comment=c;
+  c_with_comment.set("#comment", "x");
+  REQUIRE(!cache.find(c_with_comment, result));
+}
+
+TEST_CASE("Simplifier results are memoized per namespace")
+{
+  config.set_arch("none");
+
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  REQUIRE(ns.get_simplify_cache()==nullptr);
+
+  ns.enable_simplify_cache();
+  const simplify_expr_cachet &cache=*ns.get_simplify_cache();
+
+  symbol_exprt x("x", signedbv_typet(32));
+  plus_exprt x_plus_0(x, from_integer(0, x.type()));
+
+  REQUIRE(simplify_expr(x_plus_0, ns)==x);
+  REQUIRE(cache.get_misses()==1);
+  REQUIRE(cache.get_hits()==0);
+
+  REQUIRE(simplify_expr(x_plus_0, ns)==x);
+  REQUIRE(cache.get_hits()==1);
+
+  // unchanged expressions are remembered as well
+  exprt tmp=x;
+  REQUIRE(simplify(tmp, ns));
+  REQUIRE(simplify(tmp, ns));
+  REQUIRE(cache.get_hits()==2);
+
+  // another namespace has its own cache
+  namespacet other_ns(symbol_table);
+  other_ns.enable_simplify_cache();
+  REQUIRE(simplify_expr(x_plus_0, other_ns)==x);
+  REQUIRE(cache.get_hits()==2);
+  REQUIRE(other_ns.get_simplify_cache()->get_misses()==1);
+}
+
+TEST_CASE("The simplifier cache is emptied when symbols change")
+{
+  config.set_arch("none");
+
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  ns.enable_simplify_cache();
+
+  symbolt symbol;
+  symbol.name="x";
+  symbol.base_name="x";
+  symbol.type=signedbv_typet(32);
+  symbol_table.add(symbol);
+
+  symbol_exprt x("x", symbol.type);
+  plus_exprt x_plus_0(x, from_integer(0, x.type()));
+
+  REQUIRE(simplify_expr(x_plus_0, ns)==x);
+  REQUIRE(ns.get_simplify_cache()->size()==1);
+
+  // adding a symbol keeps the results
+  symbolt other=symbol;
+  other.name="y";
+  other.base_name="y";
+  symbol_table.add(other);
+  REQUIRE(ns.get_simplify_cache()->size()==1);
+
+  symbol_table.get_writeable_ref("x").value=from_integer(1, x.type());
+  REQUIRE(ns.get_simplify_cache()->size()==0);
+}
@@ -0,0 +1,133 @@
+/*******************************************************************\
+
+ Module: small_vectort unit tests
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <string>
+
+#include <util/irep.h>
+#include <util/small_vector.h>
+
+TEST_CASE(
+  "small_vectort keeps few elements inline",
+  "[core][util][small_vector]")
+{
+  small_vectort<int, 3> v;
+  REQUIRE(v.empty());
+  REQUIRE(v.capacity()==3);
+  REQUIRE(sizeof(v)==8+3*sizeof(void *));
+
+  v.push_back(1);
+  v.push_back(2);
+  v.push_back(3);
+  REQUIRE(v.is_inline());
+  REQUIRE(v.heap_size()==0);
+
+  v.push_back(4);
+  REQUIRE_FALSE(v.is_inline());
+  REQUIRE(v.size()==4);
+  REQUIRE(v.heap_size()==v.capacity()*sizeof(int));
+
+  for(int i=0; i<4; i++)
+    REQUIRE(v[i]==i+1);
+
+  v.pop_back();
+  v.shrink_to_fit();
+  REQUIRE(v.is_inline());
+  REQUIRE(v==(small_vectort<int, 3>{1, 2, 3}));
+}
+
+TEST_CASE("small_vectort insert and erase", "[core][util][small_vector]")
+{
+  small_vectort<int, 3> v={1, 4};
+
+  v.insert(v.begin()+1, 3);
+  v.insert(v.begin()+1, 2);
+  v.insert(v.end(), 2, 5);
+  REQUIRE(v==(small_vectort<int, 3>{1, 2, 3, 4, 5, 5}));
+
+  auto it=v.erase(v.begin()+1, v.begin()+3);
+  REQUIRE(*it==4);
+  REQUIRE(v==(small_vectort<int, 3>{1, 4, 5, 5}));
+
+  v.erase(v.begin());
+  REQUIRE(v==(small_vectort<int, 3>{4, 5, 5}));
+
+  v.resize(1);
+  REQUIRE(v==(small_vectort<int, 3>{4}));
+
+  v.resize(3, 7);
+  REQUIRE(v==(small_vectort<int, 3>{4, 7, 7}));
+
+  // the iterators of a temporary can be incremented in place
+  REQUIRE(*++v.begin()==7);
+}
+
+TEST_CASE("small_vectort copy, move and swap", "[core][util][small_vector]")
+{
+  small_vectort<int, 2> inline_v={1};
+  small_vectort<int, 2> heap_v={1, 2, 3};
+
+  small_vectort<int, 2> copy(heap_v);
+  REQUIRE(copy==heap_v);
+
+  small_vectort<int, 2> moved(std::move(copy));
+  REQUIRE(moved==heap_v);
+  REQUIRE(copy.empty()); // NOLINT(bugprone-use-after-move)
+
+  inline_v.swap(moved);
+  REQUIRE(inline_v==heap_v);
+  REQUIRE(moved==(small_vectort<int, 2>{1}));
+
+  moved=inline_v;
+  REQUIRE(moved==heap_v);
+  REQUIRE(moved<(small_vectort<int, 2>{1, 3}));
+}
+
+TEST_CASE(
+  "small_vectort without inline storage",
+  "[core][util][small_vector]")
+{
+  small_vectort<std::string, 0> v;
+  REQUIRE(sizeof(v)==8+sizeof(void *));
+
+  v.push_back("b");
+  v.emplace(v.begin(), "a");
+  v.push_back(v.front()); // refers to an element when growing
+  REQUIRE(v.size()==3);
+  REQUIRE(v[0]=="a");
+  REQUIRE(v[1]=="b");
+  REQUIRE(v[2]=="a");
+  REQUIRE(v.heap_size()==v.capacity()*sizeof(std::string));
+}
+
+TEST_CASE("small_vectort of ireps", "[core][util][small_vector]")
+{
+  small_vectort<irept, 3> v;
+  irept a("a");
+
+  for(int i=0; i<5; i++)
+    v.push_back(a);
+
+  v.insert(v.begin(), irept("b"));
+  v.erase(v.begin()+1, v.begin()+4);
+
+  REQUIRE(v.size()==3);
+  REQUIRE(v[0].id()=="b");
+  REQUIRE(v[1]==a);
+  REQUIRE(v[2]==a);
+
+  v.shrink_to_fit();
+  REQUIRE(v.is_inline());
+
+  small_vectort<irept, 3> copy=v;
+  v.clear();
+  REQUIRE(copy.size()==3);
+  REQUIRE(copy[1].id()=="a");
+  REQUIRE(a.id()=="a");
+}
@@ -0,0 +1,101 @@
+/*******************************************************************\
+
+ Module: sparse_bitsett unit tests
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <set>
+#include <vector>
+
+#include <util/sparse_bitset.h>
+
+static std::vector<std::size_t> elements(const sparse_bitsett &s)
+{
+  return std::vector<std::size_t>(s.begin(), s.end());
+}
+
+TEST_CASE(
+  "sparse_bitsett inserts and erases numbers",
+  "[core][util][sparse_bitset]")
+{
+  sparse_bitsett s;
+  REQUIRE(s.empty());
+  REQUIRE(s.begin()==s.end());
+
+  REQUIRE(s.insert(64));
+  REQUIRE(s.insert(3));
+  REQUIRE(s.insert(1000000));
+  REQUIRE(s.insert(63));
+  REQUIRE_FALSE(s.insert(3));
+
+  REQUIRE(s.size()==4);
+  REQUIRE(s.contains(63));
+  REQUIRE_FALSE(s.contains(62));
+  REQUIRE_FALSE(s.contains(999999));
+  REQUIRE(elements(s)==std::vector<std::size_t>({ 3, 63, 64, 1000000 }));
+
+  REQUIRE(s.erase(64));
+  REQUIRE_FALSE(s.erase(64));
+  REQUIRE_FALSE(s.erase(5));
+  REQUIRE(elements(s)==std::vector<std::size_t>({ 3, 63, 1000000 }));
+
+  REQUIRE(s.erase(1000000));
+  REQUIRE(s.erase(3));
+  REQUIRE(s.erase(63));
+  REQUIRE(s.empty());
+}
+
+TEST_CASE(
+  "sparse_bitsett computes unions and differences",
+  "[core][util][sparse_bitset]")
+{
+  std::set<std::size_t> expected_a, expected_b;
+  sparse_bitsett a, b;
+
+  for(std::size_t i=0; i<1000; i+=7)
+  {
+    a.insert(i);
+    expected_a.insert(i);
+  }
+
+  for(std::size_t i=500; i<2000; i+=11)
+  {
+    b.insert(i);
+    expected_b.insert(i);
+  }
+
+  sparse_bitsett u(a);
+  REQUIRE(u.insert(b));
+  REQUIRE_FALSE(u.insert(b));
+  REQUIRE_FALSE(u.insert(a));
+
+  std::set<std::size_t> expected_u(expected_a);
+  expected_u.insert(expected_b.begin(), expected_b.end());
+  REQUIRE(
+    elements(u)==
+    std::vector<std::size_t>(expected_u.begin(), expected_u.end()));
+
+  sparse_bitsett d(u);
+  REQUIRE(d.erase(b));
+  REQUIRE_FALSE(d.erase(b));
+
+  std::set<std::size_t> expected_d;
+  for(const auto &n : expected_a)
+    if(expected_b.count(n)==0)
+      expected_d.insert(n);
+
+  REQUIRE(
+    elements(d)==
+    std::vector<std::size_t>(expected_d.begin(), expected_d.end()));
+
+  REQUIRE(d!=a);
+  REQUIRE(d.insert(a));
+  REQUIRE(d==a);
+
+  REQUIRE(u.erase(u));
+  REQUIRE(u.empty());
+}
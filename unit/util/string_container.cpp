@@ -0,0 +1,126 @@
+/*******************************************************************\
+
+ Module: string_containert unit tests
+
+ Author: agent, agent@local
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <util/string_container.h>
+
+/// Let each thread intern the same strings, starting at different offsets
+/// \param prefix: prefix of the strings, to make them unique to the caller
+/// \param threads: number of threads
+/// \param strings: number of distinct strings
+/// \param rounds: how often each thread interns each string
+/// \return the numbers each thread obtained for the strings
+static std::vector<std::vector<unsigned>> intern_concurrently(
+  const std::string &prefix,
+  std::size_t threads,
+  std::size_t strings,
+  std::size_t rounds)
+{
+  std::vector<std::string> names;
+  for(std::size_t i=0; i<strings; i++)
+    names.push_back(prefix+std::to_string(i));
+
+  std::vector<std::vector<unsigned>> numbers(
+    threads, std::vector<unsigned>(strings));
+  std::vector<std::thread> workers;
+
+  for(std::size_t t=0; t<threads; t++)
+    workers.emplace_back([&names, &numbers, t, strings, rounds]() {
+      string_containert &container=get_string_container();
+      for(std::size_t r=0; r<rounds; r++)
+        for(std::size_t i=0; i<strings; i++)
+        {
+          std::size_t j=(i+t*strings/4)%strings;
+          numbers[t][j]=container[names[j]];
+        }
+    });
+
+  for(auto &worker : workers)
+    worker.join();
+
+  return numbers;
+}
+
+TEST_CASE(
+  "string_containert numbers strings consecutively",
+  "[core][util][string_container]")
+{
+  string_containert &container=get_string_container();
+
+  REQUIRE(container[""]==0);
+
+  std::size_t size=container.size();
+  unsigned a=container["string_container_test_a"];
+  unsigned b=container[std::string("string_container_test_b")];
+
+  REQUIRE(a==size);
+  REQUIRE(b==size+1);
+  REQUIRE(container["string_container_test_a"]==a);
+  REQUIRE(container.get_string(b)=="string_container_test_b");
+  REQUIRE(container.size()==size+2);
+}
+
+TEST_CASE(
+  "string_containert interns strings from several threads",
+  "[core][util][string_container]")
+{
+  string_containert &container=get_string_container();
+  const std::size_t threads=4;
+  const std::size_t strings=10000;
+
+  std::size_t size=container.size();
+  auto numbers=intern_concurrently("concurrent_", threads, strings, 2);
+
+  // all threads agree on the numbers
+  for(std::size_t t=1; t<threads; t++)
+    REQUIRE(numbers[t]==numbers[0]);
+
+  // the numbers are contiguous
+  std::set<unsigned> distinct(numbers[0].begin(), numbers[0].end());
+  REQUIRE(distinct.size()==strings);
+  REQUIRE(*distinct.begin()==size);
+  REQUIRE(*distinct.rbegin()==size+strings-1);
+  REQUIRE(container.size()==size+strings);
+
+  for(std::size_t i=0; i<strings; i++)
+    REQUIRE(
+      container.get_string(numbers[0][i])=="concurrent_"+std::to_string(i));
+}
+
+// Run with: unit_tests "[benchmark]"
+TEST_CASE(
+  "string_containert contention benchmark",
+  "[.][benchmark][string_container]")
+{
+  const std::size_t strings=100000;
+  const std::size_t rounds=10;
+  std::size_t max_threads=std::thread::hardware_concurrency();
+  if(max_threads==0)
+    max_threads=4;
+
+  for(std::size_t threads=1; threads<=max_threads; threads*=2)
+  {
+    auto start=std::chrono::steady_clock::now();
+    intern_concurrently(
+      "benchmark_"+std::to_string(threads)+"_", threads, strings, rounds);
+    std::chrono::duration<double> seconds=
+      std::chrono::steady_clock::now()-start;
+
+    std::cout << threads << " threads: "
+              << threads*strings*rounds/seconds.count()/1e6
+              << " million lookups/s\n";
+  }
+}